@@ -0,0 +1,404 @@
+/**
+ * @file emCore_bench.cpp
+ * @brief Host-side messaging benchmark (message_broker, zero_copy_pool,
+ *        rtos_message_queue, event_log, field_encoder)
+ *
+ * Runs on the POSIX backend. Each row reports throughput and the
+ * publish->receive latency distribution, measured from the header timestamp
+ * that publish stamps (or the wrapper timestamp for rtos_message_queue).
+ *
+ * Usage: emCore_bench [--quick] [--messages N]
+ */
+
+#include <emCore/messaging/message_broker.hpp>
+#include <emCore/messaging/zero_copy.hpp>
+#include <emCore/messaging/rtos_message_queue.hpp>
+#include <emCore/messaging/event_log.hpp>
+#include <emCore/protocol/encoder.hpp>
+#include <emCore/os/tasks.hpp>
+#include <emCore/os/time.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace emCore;
+using namespace emCore::messaging;
+
+namespace {
+
+constexpr size_t bench_max_tasks = 16;
+
+struct bench_row {
+    const char* suite;
+    size_t msg_bytes;
+    size_t subscribers;
+    size_t topics;
+    size_t producers;
+    u64 published;
+    u64 received;
+    u64 dropped;
+    double elapsed_s;
+    std::vector<u64> latencies_us;
+};
+
+u64 percentile(std::vector<u64>& sorted, double p) {
+    if (sorted.empty()) { return 0; }
+    const size_t idx = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1));
+    return sorted[idx];
+}
+
+void print_header() {
+    std::printf("%-11s %6s %4s %6s %5s %9s %9s %8s %12s %8s %8s %8s\n",
+                "suite", "bytes", "subs", "topics", "prod", "published", "received", "dropped",
+                "msg/s", "p50_us", "p99_us", "p999_us");
+}
+
+void print_row(bench_row& row) {
+    std::sort(row.latencies_us.begin(), row.latencies_us.end());
+    const double rate = (row.elapsed_s > 0.0) ? static_cast<double>(row.received) / row.elapsed_s : 0.0;
+    std::printf("%-11s %6zu %4zu %6zu %5zu %9llu %9llu %8llu %12.0f %8llu %8llu %8llu\n",
+                row.suite, row.msg_bytes, row.subscribers, row.topics, row.producers,
+                static_cast<unsigned long long>(row.published), static_cast<unsigned long long>(row.received),
+                static_cast<unsigned long long>(row.dropped), rate,
+                static_cast<unsigned long long>(percentile(row.latencies_us, 0.50)),
+                static_cast<unsigned long long>(percentile(row.latencies_us, 0.99)),
+                static_cast<unsigned long long>(percentile(row.latencies_us, 0.999)));
+    std::fflush(stdout);
+}
+
+/* Start barrier: workers register first, then wait for the go flag */
+struct start_gate {
+    std::atomic<size_t> ready{0};
+    std::atomic<bool> go{false};
+
+    void arrive_and_wait() {
+        ready.fetch_add(1);
+        while (!go.load()) { std::this_thread::yield(); }
+    }
+    void open_when(size_t count) {
+        while (ready.load() < count) { std::this_thread::yield(); }
+        go.store(true);
+    }
+};
+
+/*
+ * Broker / zero-copy broker fan-out: P producers round-robin over T topics,
+ * S subscriber threads each subscribed to every topic and blocking in receive().
+ */
+template <typename BrokerT, typename MakeMsg, typename Payload>
+bench_row run_broker_case(const char* suite, size_t msg_bytes, size_t subscribers, size_t topics,
+                          size_t producers, size_t per_producer, MakeMsg&& make_msg, Payload&& payload_size) {
+    auto broker = std::make_unique<BrokerT>();
+    start_gate gate;
+    std::atomic<size_t> producers_done{0};
+    std::atomic<u64> published{0};
+    std::vector<std::vector<u64>> per_sub(subscribers);
+    std::vector<u64> received(subscribers, 0);
+    std::vector<timestamp_t> last_rx(subscribers, 0);
+
+    std::vector<std::thread> threads;
+    for (size_t s = 0; s < subscribers; ++s) {
+        threads.emplace_back([&, s]() {
+            const task_id_t id(static_cast<u16>(s));
+            (void)broker->register_task(id, os::current_task());
+            (void)broker->set_overflow_policy(id, false);
+            for (size_t t = 0; t < topics; ++t) {
+                (void)broker->subscribe(topic_id_t(static_cast<u16>(t + 1)), id);
+            }
+            per_sub[s].reserve(producers * per_producer);
+            gate.arrive_and_wait();
+            for (;;) {
+                auto r = broker->receive(id, timeout_ms_t(20));
+                if (r.is_ok()) {
+                    const timestamp_t now = os::time_us();
+                    per_sub[s].push_back(now - r.value().header.timestamp);
+                    (void)payload_size(r.value());
+                    ++received[s];
+                    last_rx[s] = now;
+                } else if (producers_done.load() == producers) {
+                    break;
+                }
+            }
+        });
+    }
+
+    const timestamp_t start = os::time_us();
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p]() {
+            const task_id_t from(static_cast<u16>(subscribers + p));
+            gate.arrive_and_wait();
+            for (size_t i = 0; i < per_producer; ++i) {
+                auto msg = make_msg(msg_bytes);
+                const u16 topic = static_cast<u16>((i % topics) + 1);
+                for (int attempt = 0; attempt < 1000; ++attempt) {
+                    msg.header.timestamp = 0;  // let publish stamp it
+                    if (broker->publish(topic, msg, from).is_ok()) {
+                        published.fetch_add(1);
+                        break;
+                    }
+                    std::this_thread::yield();  // every mailbox full: back off
+                }
+            }
+            producers_done.fetch_add(1);
+        });
+    }
+    gate.open_when(subscribers + producers);
+    for (auto& th : threads) { th.join(); }
+
+    bench_row row{suite, msg_bytes, subscribers, topics, producers, published.load(), 0,
+                  broker->total_dropped(), 0.0, {}};
+    timestamp_t end = start;
+    for (size_t s = 0; s < subscribers; ++s) {
+        row.received += received[s];
+        end = std::max(end, last_rx[s]);
+        row.latencies_us.insert(row.latencies_us.end(), per_sub[s].begin(), per_sub[s].end());
+    }
+    row.elapsed_s = static_cast<double>(end - start) / 1e6;
+    return row;
+}
+
+template <typename MessageT>
+void sweep_broker(const char* suite, size_t per_producer) {
+    using broker_t = message_broker<MessageT, bench_max_tasks>;
+    constexpr size_t capacity = sizeof(MessageT{}.payload);
+    const size_t sub_counts[] = {1, 2, 4};
+    const size_t topic_counts[] = {1, 2, 4};
+    const size_t producer_counts[] = {1, 2, 4};
+    for (size_t subs : sub_counts) {
+        for (size_t topics : topic_counts) {
+            for (size_t prods : producer_counts) {
+                auto row = run_broker_case<broker_t>(
+                    suite, capacity, subs, topics, prods, per_producer,
+                    [](size_t bytes) {
+                        MessageT msg{};
+                        std::memset(msg.payload, 0xA5, bytes);
+                        msg.header.payload_size = static_cast<u16>(bytes);
+                        return msg;
+                    },
+                    [](const MessageT& msg) { return msg.header.payload_size; });
+                print_row(row);
+            }
+        }
+    }
+}
+
+/* Zero-copy broker: one pool block per publish, a refcounted handle per mailbox */
+template <typename PoolT>
+void sweep_zero_copy(const char* suite, size_t per_producer) {
+    using msg_t = zc_message_envelope<PoolT>;
+    using broker_t = message_broker<msg_t, bench_max_tasks>;
+    auto pool = std::make_unique<PoolT>();
+    const size_t sub_counts[] = {1, 2, 4};
+    const size_t producer_counts[] = {1, 2, 4};
+    for (size_t subs : sub_counts) {
+        for (size_t prods : producer_counts) {
+            PoolT* pool_ptr = pool.get();
+            auto row = run_broker_case<broker_t>(
+                suite, PoolT::block_capacity(), subs, 1, prods, per_producer,
+                [pool_ptr](size_t bytes) {
+                    msg_t msg{};
+                    for (int attempt = 0; attempt < 1000 && !msg.handle.valid(); ++attempt) {
+                        msg.handle = pool_ptr->allocate(static_cast<u16>(bytes));
+                        if (!msg.handle.valid()) { std::this_thread::yield(); }
+                    }
+                    if (msg.handle.valid()) { std::memset(msg.handle.data(), 0xA5, bytes); }
+                    msg.header.payload_size = static_cast<u16>(bytes);
+                    return msg;
+                },
+                [](const msg_t& msg) { return msg.payload_size(); });
+            print_row(row);
+        }
+    }
+}
+
+/* Pool alloc/copy/release cost without a broker in the path */
+template <typename PoolT>
+void bench_pool_cycle(const char* suite, size_t iterations, size_t threads_count) {
+    auto pool = std::make_unique<PoolT>();
+    start_gate gate;
+    std::atomic<u64> done{0};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threads_count; ++t) {
+        threads.emplace_back([&]() {
+            u8 src[PoolT::block_capacity()];
+            std::memset(src, 0x5A, sizeof(src));
+            gate.arrive_and_wait();
+            for (size_t i = 0; i < iterations; ++i) {
+                auto handle = pool->allocate(static_cast<u16>(sizeof(src)));
+                if (handle.valid()) {
+                    std::memcpy(handle.data(), src, sizeof(src));
+                    auto copy = handle;  // add_ref + release pair
+                    (void)copy;
+                    done.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    const timestamp_t start = os::time_us();
+    gate.open_when(threads_count);
+    for (auto& th : threads) { th.join(); }
+    bench_row row{suite, PoolT::block_capacity(), 0, 0, threads_count, iterations * threads_count, done.load(),
+                  iterations * threads_count - done.load(), static_cast<double>(os::time_us() - start) / 1e6, {}};
+    print_row(row);
+}
+
+/* rtos_message_queue: SPSC, pointer hand-off, latency from wrapper timestamp */
+template <typename MessageT>
+void bench_rtos_queue(const char* suite, size_t iterations) {
+    using queue_t = rtos_message_queue<MessageT, 32>;
+    auto queue = std::make_unique<queue_t>();
+    auto messages = std::make_unique<MessageT[]>(iterations);
+    std::vector<u64> latencies;
+    latencies.reserve(iterations);
+    std::atomic<bool> producer_done{false};
+    u64 published = 0;
+    u64 received = 0;
+    timestamp_t last_rx = 0;
+
+    const timestamp_t start = os::time_us();
+    std::thread consumer([&]() {
+        for (;;) {
+            auto r = queue->receive(20000);
+            if (r.is_ok()) {
+                last_rx = os::time_us();
+                latencies.push_back(last_rx - r.value().timestamp);
+                ++received;
+            } else if (producer_done.load()) {
+                break;
+            }
+        }
+    });
+    for (size_t i = 0; i < iterations; ++i) {
+        while (!queue->send_nonblocking(&messages[i]).is_ok()) { std::this_thread::yield(); }
+        ++published;
+    }
+    producer_done.store(true);
+    consumer.join();
+
+    bench_row row{suite, sizeof(MessageT{}.payload), 1, 1, 1, published, received, published - received,
+                  static_cast<double>(std::max(last_rx, start) - start) / 1e6, std::move(latencies)};
+    print_row(row);
+}
+
+/* event_log: append throughput and replay cost (latency column = per-append cost) */
+template <typename MessageT>
+void bench_event_log(const char* suite, size_t iterations) {
+    using log_t = event_log<MessageT, 128, true>;
+    auto log = std::make_unique<log_t>();
+    MessageT msg{};
+    std::vector<u64> append_cost;
+    append_cost.reserve(iterations);
+    const timestamp_t start = os::time_us();
+    for (size_t i = 0; i < iterations; ++i) {
+        const timestamp_t t0 = os::time_us();
+        (void)log->append(msg);
+        append_cost.push_back(os::time_us() - t0);
+    }
+    const timestamp_t appended_at = os::time_us();
+    u64 replayed = 0;
+    log->replay_all([&replayed](u64, const MessageT&) { ++replayed; });
+    const auto sts = log->get_stats();
+    bench_row row{suite, sizeof(MessageT{}.payload), 0, 0, 1, sts.appended, replayed, sts.dropped,
+                  static_cast<double>(appended_at - start) / 1e6, std::move(append_cost)};
+    print_row(row);
+}
+
+/* field_encoder: streaming encode_step() against one-pass encode_into() (latency column = per-frame cost) */
+struct bench_packet_config {
+    static constexpr size_t PACKET_SYNC_LEN = 2;
+    static constexpr bool PACKET_LENGTH_16BIT = true;
+    static inline constexpr u8 PACKET_SYNC[PACKET_SYNC_LEN] = {0x55, 0xAA};
+};
+
+struct bench_command {
+    u8 mode;
+    u16 address;
+    u32 value;
+    const u8* data;
+    size_t data_len;
+};
+
+void bench_encoder(const char* suite, size_t iterations, bool streaming) {
+    static constexpr u8 opcode = 0x01;
+    static const protocol::field_def fields[] = {
+        {protocol::FieldType::U8, offsetof(bench_command, mode), "mode"},
+        {protocol::FieldType::U16, offsetof(bench_command, address), "address"},
+        {protocol::FieldType::U32, offsetof(bench_command, value), "value"},
+        {protocol::FieldType::U8_ARRAY, offsetof(bench_command, data), "data"},
+    };
+    auto encoder = std::make_unique<protocol::field_encoder<4>>();
+    (void)encoder->set_field_layout(opcode, fields, sizeof(fields) / sizeof(fields[0]));
+    u8 data[32];
+    std::memset(data, 0x5A, sizeof(data));
+    const bench_command cmd{1, 0x1234, 0xDEADBEEF, data, sizeof(data)};
+
+    u8 reference[64];
+    const size_t frame_len = encoder->encode_into<bench_packet_config>(opcode, &cmd, reference, sizeof(reference));
+    u8 frame[64];
+    u64 encoded = 0;
+    std::vector<u64> frame_cost;
+    frame_cost.reserve(iterations);
+    const timestamp_t start = os::time_us();
+    for (size_t i = 0; i < iterations; ++i) {
+        const timestamp_t t0 = os::time_us();
+        size_t len = 0;
+        if (streaming) {
+            (void)encoder->start_encode(opcode, &cmd);
+            u8 byte = 0;
+            while (len < sizeof(frame) && encoder->encode_step<bench_packet_config>(byte)) { frame[len++] = byte; }
+        } else {
+            len = encoder->encode_into<bench_packet_config>(opcode, &cmd, frame, sizeof(frame));
+        }
+        frame_cost.push_back(os::time_us() - t0);
+        if (len == frame_len && std::memcmp(frame, reference, len) == 0) { ++encoded; }
+    }
+    bench_row row{suite, frame_len, 0, 0, 1, iterations, encoded, iterations - encoded,
+                  static_cast<double>(os::time_us() - start) / 1e6, std::move(frame_cost)};
+    print_row(row);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t messages = 20000;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--quick") == 0) {
+            messages = 2000;
+        } else if (std::strcmp(argv[i], "--messages") == 0 && i + 1 < argc) {
+            messages = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+    }
+
+    std::printf("emCore_bench: %zu messages per producer\n", messages);
+    print_header();
+
+    sweep_broker<small_message>("broker", messages);
+    sweep_broker<medium_message>("broker", messages);
+    sweep_broker<large_message>("broker", messages);
+
+    sweep_zero_copy<zero_copy_pool<256, 64>>("zc_locked", messages);
+    sweep_zero_copy<lockfree_zero_copy_pool<256, 64>>("zc_lockfree", messages);
+    bench_pool_cycle<zero_copy_pool<256, 64>>("pool_lock", messages * 10, 1);
+    bench_pool_cycle<zero_copy_pool<256, 64>>("pool_lock", messages * 10, 4);
+    bench_pool_cycle<lockfree_zero_copy_pool<256, 64>>("pool_lf", messages * 10, 1);
+    bench_pool_cycle<lockfree_zero_copy_pool<256, 64>>("pool_lf", messages * 10, 4);
+
+    bench_rtos_queue<small_message>("rtos_q", messages);
+    bench_rtos_queue<medium_message>("rtos_q", messages);
+    bench_rtos_queue<large_message>("rtos_q", messages);
+
+    bench_event_log<small_message>("event_log", messages * 10);
+    bench_event_log<medium_message>("event_log", messages * 10);
+    bench_event_log<large_message>("event_log", messages * 10);
+
+    bench_encoder("enc_step", messages * 10, true);
+    bench_encoder("enc_into", messages * 10, false);
+    return 0;
+}
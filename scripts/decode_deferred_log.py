@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+"""
+Decode the binary deferred log stream (platform::log_drain_into) on the host
+Usage: python decode_deferred_log.py <firmware.elf> [stream.bin]   (stdin when no stream file)
+
+Each record is little endian: u32 format address, u32 timestamp_us, u8 argc,
+argc x u32. Format strings are read from the ELF at their load address, so
+only the firmware image that produced the stream can decode it.
+Requires pyelftools: pip install pyelftools
+"""
+import re
+import struct
+import sys
+from pathlib import Path
+
+try:
+    from elftools.elf.elffile import ELFFile
+    from elftools.elf.constants import SH_FLAGS
+except ImportError:
+    print("ERROR: pyelftools not installed. Install with: pip install pyelftools")
+    sys.exit(1)
+
+# C conversions the device emits (args are u32); length modifiers are dropped
+_CONVERSION = re.compile(r'%([-+ #0]*\d*(?:\.\d+)?)(?:hh|h|ll|l|z|j|t)?([diouxXc%])')
+
+
+class StringTable:
+    """Reads NUL-terminated strings at load addresses of allocated ELF sections"""
+
+    def __init__(self, elf_path: Path):
+        self._sections = []
+        with open(elf_path, 'rb') as f:
+            elf = ELFFile(f)
+            for sec in elf.iter_sections():
+                if sec['sh_flags'] & SH_FLAGS.SHF_ALLOC and sec['sh_type'] != 'SHT_NOBITS' and sec['sh_size']:
+                    self._sections.append((sec['sh_addr'], sec.data()))
+        self._cache = {}
+
+    def at(self, addr: int):
+        if addr in self._cache:
+            return self._cache[addr]
+        text = None
+        for base, data in self._sections:
+            if base <= addr < base + len(data):
+                end = data.find(b'\0', addr - base)
+                text = data[addr - base:end if end >= 0 else len(data)].decode('utf-8', 'replace')
+                break
+        self._cache[addr] = text
+        return text
+
+
+def format_record(fmt: str, args):
+    it = iter(args)
+
+    def conv(m):
+        flags, kind = m.group(1), m.group(2)
+        if kind == '%':
+            return '%'
+        value = next(it, 0)
+        if kind in 'di':
+            value = value - (1 << 32) if value & 0x80000000 else value
+            kind = 'd'
+        elif kind == 'c':
+            return chr(value & 0xFF)
+        return ('%' + flags + kind) % value
+
+    return _CONVERSION.sub(conv, fmt)
+
+
+def decode(strings: StringTable, stream: bytes):
+    pos = 0
+    while pos + 9 <= len(stream):
+        addr, ts, argc = struct.unpack_from('<IIB', stream, pos)
+        if argc > 5 or pos + 9 + 4 * argc > len(stream):
+            break
+        args = struct.unpack_from(f'<{argc}I', stream, pos + 9) if argc else ()
+        pos += 9 + 4 * argc
+        fmt = strings.at(addr)
+        if fmt is None:
+            text = f"<unknown format 0x{addr:08X}> {' '.join(f'0x{a:X}' for a in args)}"
+        else:
+            text = fmt if argc == 0 else format_record(fmt, args)
+        yield ts, text
+    if pos != len(stream):
+        print(f"warning: {len(stream) - pos} trailing bytes not decoded", file=sys.stderr)
+
+
+def main():
+    if len(sys.argv) < 2:
+        print("Usage: python decode_deferred_log.py <firmware.elf> [stream.bin]")
+        sys.exit(1)
+    strings = StringTable(Path(sys.argv[1]))
+    stream = Path(sys.argv[2]).read_bytes() if len(sys.argv) > 2 else sys.stdin.buffer.read()
+    for ts, text in decode(strings, stream):
+        print(f"[{ts / 1e6:12.6f}] {text}")
+
+
+if __name__ == '__main__':
+    main()
@@ -10,6 +10,9 @@ import sys
 from pathlib import Path
 from datetime import datetime
 
+sys.path.insert(0, str(Path(__file__).resolve().parent))
+from generate_packet_config import emit_field_codec, validate_codec_fields  # noqa: E402
+
 def generate_command_table(yaml_file: Path, output_file: Path):
     """Generate C++ command table from YAML configuration"""
     
@@ -24,6 +27,13 @@ def generate_command_table(yaml_file: Path, output_file: Path):
     sequential = cmd_config.get('sequential_opcodes', False)
     error_handler = cmd_config.get('error_handler', 'cmd_unknown_command')
     
+    errors = []
+    for cmd in commands:
+        errors.extend(validate_codec_fields(cmd.get('parameters') or [], f"{cmd['name']}.parameters"))
+    if errors:
+        print("Error: invalid command parameters:\n - " + "\n - ".join(errors))
+        sys.exit(1)
+
     # Generate header content
     content = f"""#pragma once
 // Auto-generated command dispatcher setup from commands.yaml
@@ -34,6 +44,9 @@ def generate_command_table(yaml_file: Path, output_file: Path):
 #include <emCore/protocol/packet_runtime.hpp>
 #include <emCore/protocol/decoder.hpp>
 #include <emCore/protocol/encoder.hpp>
+#include <emCore/protocol/field_codec.hpp>
+#include <emCore/protocol/command_dispatcher.hpp>
+#include <etl/array.h>
 #include <cstddef>  // for offsetof
 
 // Note: Packet configuration symbols (emCore::protocol::gen::*) are provided by packet_runtime.hpp
@@ -80,8 +93,16 @@ constexpr size_t GENERATED_COMMAND_COUNT = {len(commands)};
             content += f"void {cmd['function']}();\n"
     content += f"void {error_handler}(emCore::u8 opcode);\n\n"
     
+    # Generate compile-time codecs (used by the wrappers and encode helpers below)
+    content += "// Auto-generated compile-time payload codecs\n"
+    for cmd in commands:
+        if 'parameters' in cmd and cmd['parameters']:
+            struct_name = f"{cmd['name'].lower()}_params"
+            content += emit_field_codec(cmd['name'].lower(), struct_name, cmd['parameters']) + "\n"
+
     # Generate field definitions for each command
-    content += "// Auto-generated field definitions for structured decoding\n"
+    content += "#if EMCORE_PROTOCOL_RUNTIME_LAYOUTS\n"
+    content += "// Auto-generated field definitions for runtime field_decoder/field_encoder layouts\n"
     for cmd in commands:
         if 'parameters' in cmd and cmd['parameters']:
             struct_name = f"{cmd['name'].lower()}_params"
@@ -107,8 +128,10 @@ constexpr size_t GENERATED_COMMAND_COUNT = {len(commands)};
             
             content += f"}};\n\n"
     
-    # Generate automatic decoding wrapper functions using field decoder
-    content += "// Auto-generated packet decoding wrapper functions using field decoder\n"
+    content += "#endif // EMCORE_PROTOCOL_RUNTIME_LAYOUTS\n\n"
+
+    # Generate automatic decoding wrapper functions using the compile-time codecs
+    content += "// Auto-generated packet decoding wrapper functions (straight-line codecs)\n"
     for cmd in commands:
         wrapper_name = f"_decode_{cmd['function']}"
         content += f"inline void {wrapper_name}(const emCore::protocol::runtime::PacketT& packet) {{\n"
@@ -116,9 +139,7 @@ constexpr size_t GENERATED_COMMAND_COUNT = {len(commands)};
         if 'parameters' in cmd and cmd['parameters']:
             struct_name = f"{cmd['name'].lower()}_params"
             content += f"    {struct_name} params{{}};\n"
-            content += f"    auto& decoder = emCore::protocol::runtime::get_field_decoder();\n"
-            content += f"    \n"
-            content += f"    if (decoder.decode_fields(packet, &params)) {{\n"
+            content += f"    if (decode_{cmd['name'].lower()}(packet, params)) {{\n"
             content += f"        {cmd['function']}(params);\n"
             content += f"    }}\n"
         else:
@@ -126,6 +147,34 @@ constexpr size_t GENERATED_COMMAND_COUNT = {len(commands)};
         
         content += f"}}\n\n"
     
+    # Generate unknown-opcode wrapper and the dense opcode table
+    content += f"""// Unknown command wrapper (opcode-only error handler)
+inline void _unknown_command(const emCore::protocol::runtime::PacketT& packet) {{
+    {error_handler}(packet.opcode);
+}}
+
+// Dense opcode -> handler table (nullptr = unknown), usable without any registration
+using command_handler_table_t = etl::array<emCore::protocol::command_handler_t<emCore::protocol::runtime::PacketT>,
+                                           emCore::protocol::gen::OPCODE_SPACE>;
+"""
+    for cmd in commands:
+        content += (f"static_assert(0x{cmd['opcode']:02X} < emCore::protocol::gen::OPCODE_SPACE, "
+                    f"\"{cmd['name']} opcode outside OPCODE_SPACE\");\n")
+    content += "inline constexpr command_handler_table_t command_handler_table = [] {\n"
+    content += "    command_handler_table_t table{};\n"
+    for cmd in commands:
+        content += f"    table[0x{cmd['opcode']:02X}] = _decode_{cmd['function']};\n"
+    content += """    return table;
+}();
+
+// Flash-resident dispatcher over command_handler_table: dispatch is one indexed call.
+// Use it directly (e.g. as a packet_pipeline DispatcherT) when handlers never change at runtime.
+using const_dispatcher_t = emCore::protocol::const_command_dispatcher<
+    emCore::protocol::runtime::PacketT, emCore::protocol::gen::OPCODE_SPACE, command_handler_table,
+    _unknown_command, (EMCORE_PROTOCOL_DISPATCH_HITS != 0)>;
+
+"""
+
     # Generate encoding helper functions
     content += "// Auto-generated encoding helper functions\n"
     for cmd in commands:
@@ -134,8 +183,20 @@ constexpr size_t GENERATED_COMMAND_COUNT = {len(commands)};
             encode_func_name = f"encode_{cmd['name'].lower()}_command"
             content += f"""template<typename OutputFunc>
 bool {encode_func_name}(const {struct_name}& params, OutputFunc output_byte) noexcept {{
-    auto& encoder = emCore::protocol::runtime::get_field_encoder();
-    return encoder.encode_command<emCore::protocol::gen::packet_config>(0x{cmd['opcode']:02X}, &params, output_byte);
+    emCore::u8 payload[emCore::protocol::gen::PACKET_MAX_PAYLOAD];
+    const size_t size = encode_{cmd['name'].lower()}(params, payload, sizeof(payload));
+    if (size == emCore::protocol::codec::encode_error) {{ return false; }}
+    return emCore::protocol::write_frame<emCore::protocol::gen::packet_config>(0x{cmd['opcode']:02X}, payload, size, output_byte);
+}}
+
+// Whole frame straight into buf (e.g. a TX DMA buffer); returns bytes written or 0
+inline size_t {encode_func_name}_into(const {struct_name}& params, emCore::u8* buf, size_t cap) noexcept {{
+    using cfg = emCore::protocol::gen::packet_config;
+    constexpr size_t header = emCore::protocol::frame_header_size<cfg>();
+    if (buf == nullptr || cap < emCore::protocol::frame_size<cfg>(0)) {{ return 0; }}
+    const size_t size = encode_{cmd['name'].lower()}(params, buf + header, cap - emCore::protocol::frame_size<cfg>(0));
+    if (size == emCore::protocol::codec::encode_error) {{ return 0; }}
+    return emCore::protocol::finish_frame<cfg>(0x{cmd['opcode']:02X}, size, buf, cap);
 }}
 
 """
@@ -143,8 +204,11 @@ bool {encode_func_name}(const {struct_name}& params, OutputFunc output_byte) noe
             encode_func_name = f"encode_{cmd['name'].lower()}_command"
             content += f"""template<typename OutputFunc>
 bool {encode_func_name}(OutputFunc output_byte) noexcept {{
-    auto& encoder = emCore::protocol::runtime::get_field_encoder();
-    return encoder.encode_command<emCore::protocol::gen::packet_config>(0x{cmd['opcode']:02X}, nullptr, output_byte);
+    return emCore::protocol::write_frame<emCore::protocol::gen::packet_config>(0x{cmd['opcode']:02X}, nullptr, 0, output_byte);
+}}
+
+inline size_t {encode_func_name}_into(emCore::u8* buf, size_t cap) noexcept {{
+    return emCore::protocol::finish_frame<emCore::protocol::gen::packet_config>(0x{cmd['opcode']:02X}, 0, buf, cap);
 }}
 
 """
@@ -153,10 +217,11 @@ bool {encode_func_name}(OutputFunc output_byte) noexcept {{
     content += f"""// Setup command dispatcher, field decoder, and field encoder with all handlers
 inline void setup_command_dispatcher() noexcept {{
     auto& dispatcher = emCore::protocol::runtime::get_dispatcher();
+#if EMCORE_PROTOCOL_RUNTIME_LAYOUTS
     auto& decoder = emCore::protocol::runtime::get_field_decoder();
     auto& encoder = emCore::protocol::runtime::get_field_encoder();
     
-    // Register field layouts for structured decoding and encoding
+    // Register field layouts for code that still uses field_decoder/field_encoder directly
 """
     
     for cmd in commands:
@@ -166,7 +231,11 @@ inline void setup_command_dispatcher() noexcept {{
             content += f"    decoder.set_field_layout(0x{cmd['opcode']:02X}, &{field_array_name}[0], {field_count});\n"
             content += f"    encoder.set_field_layout(0x{cmd['opcode']:02X}, &{field_array_name}[0], {field_count});\n"
     
-    content += f"""
+    content += f"""#endif
+#if EMCORE_PROTOCOL_INDEXED_DISPATCH
+    // Indexed dispatcher: copy the whole generated table in one go
+    dispatcher.load(command_handler_table, _unknown_command);
+#else
     // Register all command handlers
 """
     
@@ -176,9 +245,8 @@ inline void setup_command_dispatcher() noexcept {{
     
     content += f"""    
     // Set unknown command handler (wrapper for opcode-only signature)
-    dispatcher.set_unknown_handler([](const emCore::protocol::runtime::PacketT& packet) {{
-        {error_handler}(packet.opcode);
-    }});
+    dispatcher.set_unknown_handler(_unknown_command);
+#endif
 }}
 
 // Process command using the dispatcher (replaces manual table lookup)
@@ -0,0 +1,237 @@
+#!/usr/bin/env python3
+"""
+Generate the event name catalog header from events.yaml
+Usage: python generate_event_config.py <events.yaml> [output.hpp]
+
+Outputs: src/emCore/generated/event_config.hpp (by default)
+
+events.yaml:
+  events:
+    - category: sensor          # built-in category name, or a new name with `value: 14..254`
+      codes:
+        - threshold_high        # code = previous + 1 (first is 0)
+        - name: link_down
+          code: 0x20           # explicit code
+
+Names become perfect-hash tables (see emCore/event/event_names.hpp): the
+generator searches for a seed under which every name lands in its own slot,
+so lookup_category()/lookup_code() are one hash and one compare, and both are
+constexpr (EMCORE_EVENT_ID("sensor", "link_down") resolves at compile time).
+"""
+import sys
+from pathlib import Path
+
+try:
+    import yaml
+except ImportError:
+    print("ERROR: PyYAML not installed. Install with: pip install pyyaml")
+    sys.exit(1)
+
+
+# Mirrors emCore::events::category
+BUILTIN_CATEGORIES = {
+    'system': 0, 'task': 1, 'messaging': 2, 'protocol': 3, 'io': 4, 'sensor': 5,
+    'network': 6, 'storage': 7, 'security': 8, 'power': 9, 'timer': 10,
+    'statemachine': 11, 'user': 12, 'custom': 13,
+}
+CODE_WILDCARD = 0xFFFF
+FNV_PRIME = 16777619
+MAX_SEED_TRIES = 1 << 20
+
+
+def _to_int(v):
+    if isinstance(v, int):
+        return v
+    return int(str(v), 0)
+
+
+def _step(h: int, byte: int) -> int:
+    return ((h ^ byte) * FNV_PRIME) & 0xFFFFFFFF
+
+
+def name_hash(name: str, basis: int) -> int:
+    """Same as emCore::events::name_hash"""
+    h = basis
+    for b in name.encode('utf-8'):
+        h = _step(h, b)
+    return h
+
+
+def _slots_for(count: int) -> int:
+    """Power of two with load factor <= 1/2 (keeps the seed search short)"""
+    slots = 1
+    while slots < 2 * max(count, 1):
+        slots <<= 1
+    return slots
+
+
+def find_seed(keys, slots: int) -> int:
+    """keys: list of (scope, name); seed making slot = hash & (slots - 1) unique"""
+    for seed in range(2166136261, 2166136261 + MAX_SEED_TRIES):
+        seed &= 0xFFFFFFFF
+        used = set()
+        for scope, name in keys:
+            slot = name_hash(name, _step(seed, scope)) & (slots - 1)
+            if slot in used:
+                break
+            used.add(slot)
+        else:
+            return seed
+    raise RuntimeError(f"no collision-free seed for {len(keys)} names in {slots} slots")
+
+
+def validate_events_yaml(cfg: dict):
+    """Return (categories, errors); categories = [(name, value, [(code_name, code)])]"""
+    errors = []
+    categories = []
+    entries = (cfg or {}).get('events', [])
+    if not isinstance(entries, list):
+        return [], ["'events' must be a list"]
+    seen_cat_names = set()
+    seen_cat_values = set()
+    for i, entry in enumerate(entries):
+        where = f"events[{i}]"
+        if not isinstance(entry, dict) or not isinstance(entry.get('category'), str):
+            errors.append(f"{where} must be a mapping with a 'category' name")
+            continue
+        cat_name = entry['category'].strip()
+        if cat_name in BUILTIN_CATEGORIES and 'value' not in entry:
+            cat_value = BUILTIN_CATEGORIES[cat_name]
+        else:
+            try:
+                cat_value = _to_int(entry.get('value'))
+            except Exception:
+                errors.append(f"{where}: category '{cat_name}' is not built in and needs a numeric 'value'")
+                continue
+            if not 0 <= cat_value <= 0xFE:
+                errors.append(f"{where}: category value {cat_value} must be in [0, 254] (255 is 'any')")
+                continue
+        if cat_name in seen_cat_names or cat_value in seen_cat_values:
+            errors.append(f"{where}: duplicate category '{cat_name}' / value {cat_value}")
+            continue
+        seen_cat_names.add(cat_name)
+        seen_cat_values.add(cat_value)
+
+        codes = []
+        seen_codes = {}
+        next_code = 0
+        for j, c in enumerate(entry.get('codes', []) or []):
+            cwhere = f"{where}.codes[{j}]"
+            if isinstance(c, str):
+                code_name, code = c.strip(), next_code
+            elif isinstance(c, dict) and isinstance(c.get('name'), str):
+                code_name = c['name'].strip()
+                try:
+                    code = _to_int(c['code']) if 'code' in c else next_code
+                except Exception:
+                    errors.append(f"{cwhere}: code must be an integer")
+                    continue
+            else:
+                errors.append(f"{cwhere} must be a name or a mapping with 'name'")
+                continue
+            if not code_name or not 0 <= code < CODE_WILDCARD:
+                errors.append(f"{cwhere}: needs a name and a code in [0, 0xFFFE]")
+                continue
+            if code_name in seen_codes or code in seen_codes.values():
+                errors.append(f"{cwhere}: duplicate code '{code_name}' / {code} in '{cat_name}'")
+                continue
+            seen_codes[code_name] = code
+            codes.append((code_name, code))
+            next_code = code + 1
+        categories.append((cat_name, cat_value, codes))
+    return categories, errors
+
+
+def _c_str(name: str) -> str:
+    return '"' + name.replace('\\', '\\\\').replace('"', '\\"') + '"'
+
+
+def _emit_table(var: str, keys_values, lines):
+    """keys_values: list of (scope, name, value)"""
+    slots = _slots_for(len(keys_values))
+    seed = find_seed([(s, n) for s, n, _ in keys_values], slots)
+    table = [None] * slots
+    for scope, name, value in keys_values:
+        table[name_hash(name, _step(seed, scope)) & (slots - 1)] = (scope, name, value)
+    lines.append(f"inline constexpr name_table<{slots}> {var}{{0x{seed:08X}U, {{{{")
+    for entry in table:
+        if entry is None:
+            lines.append("    name_slot{},")
+        else:
+            scope, name, value = entry
+            lines.append(f"    name_slot{{{_c_str(name)}, {scope}U, {value}U}},")
+    lines.append("}}};")
+
+
+def generate_event_header(categories, out_path: Path):
+    lines = []
+    lines.append("#pragma once")
+    lines.append("// Auto-generated event name catalog from events.yaml")
+    lines.append("// DO NOT EDIT - regenerate with scripts/generate_event_config.py")
+    lines.append("")
+    lines.append("#include <emCore/event/event_names.hpp>")
+    lines.append("")
+    lines.append("namespace emCore::events::gen {")
+    lines.append("")
+    for name, value, _ in categories:
+        lines.append(f"// {name} = {value}")
+    lines.append("")
+    _emit_table("category_names", [(0, n, v) for n, v, _ in categories], lines)
+    lines.append("")
+    _emit_table("code_names", [(v, cn, c) for _, v, codes in categories for cn, c in codes], lines)
+    lines.append("")
+    lines.append("constexpr bool lookup_category(const char* name, size_t len, category& out) noexcept {")
+    lines.append("    const name_slot* slot = category_names.find(0U, name, len);")
+    lines.append("    if (slot == nullptr) { return false; }")
+    lines.append("    out = static_cast<category>(slot->value);")
+    lines.append("    return true;")
+    lines.append("}")
+    lines.append("constexpr bool lookup_category(const char* name, category& out) noexcept {")
+    lines.append("    return lookup_category(name, name_length(name), out);")
+    lines.append("}")
+    lines.append("")
+    lines.append("constexpr bool lookup_code(category cat, const char* name, size_t len, code_t& out) noexcept {")
+    lines.append("    const name_slot* slot = code_names.find(static_cast<u8>(cat), name, len);")
+    lines.append("    if (slot == nullptr) { return false; }")
+    lines.append("    out = slot->value;")
+    lines.append("    return true;")
+    lines.append("}")
+    lines.append("constexpr bool lookup_code(category cat, const char* name, code_t& out) noexcept {")
+    lines.append("    return lookup_code(cat, name, name_length(name), out);")
+    lines.append("}")
+    lines.append("")
+    total = sum(len(codes) for _, _, codes in categories)
+    lines.append(f"inline constexpr size_t category_count = {len(categories)};")
+    lines.append(f"inline constexpr size_t code_count = {total};")
+    lines.append("")
+    lines.append("} // namespace emCore::events::gen")
+    lines.append("")
+
+    out_path.parent.mkdir(parents=True, exist_ok=True)
+    with open(out_path, 'w') as f:
+        f.write("\n".join(lines))
+
+
+def main():
+    if len(sys.argv) < 2:
+        print("Usage: python generate_event_config.py <events.yaml> [output.hpp]")
+        sys.exit(1)
+    yaml_file = Path(sys.argv[1])
+    out_file = Path(sys.argv[2]) if len(sys.argv) > 2 else \
+        Path(__file__).resolve().parent.parent / 'src' / 'emCore' / 'generated' / 'event_config.hpp'
+    if not yaml_file.exists():
+        print(f"Error: {yaml_file} not found")
+        sys.exit(1)
+    with open(yaml_file, 'r') as f:
+        cfg = yaml.safe_load(f)
+    categories, errors = validate_events_yaml(cfg)
+    if errors:
+        print("Error: invalid events YAML:\n - " + "\n - ".join(errors))
+        sys.exit(1)
+    generate_event_header(categories, out_file)
+    print(f"Generated {out_file} from {yaml_file}: "
+          f"{len(categories)} categories, {sum(len(c) for _, _, c in categories)} codes")
+
+
+if __name__ == '__main__':
+    main()
@@ -33,6 +33,87 @@ def _to_byte(x):
     return int(x, 0) & 0xFF
 
 
+CODEC_FIELD_TYPES = {'u8': 1, 'u16': 2, 'u32': 4, 'u8[]': 0}
+
+
+def validate_codec_fields(fields, where: str):
+    """Return a list of errors for a codec field list (u8[] must be last)"""
+    errors = []
+    if not isinstance(fields, list):
+        return [f"{where} must be a list"]
+    for i, fld in enumerate(fields):
+        if not isinstance(fld, dict) or not isinstance(fld.get('name'), str) or not fld.get('name'):
+            errors.append(f"{where}[{i}] must be a mapping with a non-empty name")
+            continue
+        if fld.get('type') not in CODEC_FIELD_TYPES:
+            errors.append(f"{where}[{i}].type must be one of {', '.join(CODEC_FIELD_TYPES)}")
+        elif fld['type'] == 'u8[]' and i != len(fields) - 1:
+            errors.append(f"{where}[{i}]: u8[] consumes the rest of the payload and must be the last field")
+    return errors
+
+
+def emit_codec_struct(struct_name: str, fields) -> str:
+    """C++ struct for a field list; u8[] becomes pointer + <name>_length"""
+    text = f"struct {struct_name} {{\n"
+    for fld in fields:
+        if fld['type'] == 'u8[]':
+            text += f"    const emCore::u8* {fld['name']};\n"
+            text += f"    size_t {fld['name']}_length;\n"
+        else:
+            text += f"    emCore::{fld['type']} {fld['name']};\n"
+    return text + "};\n"
+
+
+def emit_field_codec(suffix: str, struct_name: str, fields) -> str:
+    """
+    Straight-line constexpr decode_<suffix>/encode_<suffix> for a field list.
+    Offsets and the fused length check are resolved here, so no runtime layout
+    table is needed. Semantics match field_decoder/field_encoder: big-endian
+    fields, trailing u8[] takes the remaining bytes (at least one on decode).
+    """
+    ns = "::emCore::protocol::codec"
+    fixed = sum(CODEC_FIELD_TYPES[f['type']] for f in fields)
+    array = fields[-1] if fields and fields[-1]['type'] == 'u8[]' else None
+    min_len = fixed + (1 if array else 0)
+
+    dec = (f"constexpr bool decode_{suffix}(const emCore::u8* data, size_t len, {struct_name}& out) noexcept {{\n")
+    if min_len > 0:
+        dec += f"    if (len < {min_len}) {{ return false; }}\n"
+    else:
+        dec += "    (void)data; (void)len; (void)out;\n"
+    enc = (f"constexpr size_t encode_{suffix}(const {struct_name}& in, emCore::u8* out, size_t cap) noexcept {{\n")
+    size_expr = f"{fixed}" + (f" + in.{array['name']}_length" if array else "")
+    enc += f"    const size_t size = {size_expr};\n"
+    enc += f"    if (size > cap) {{ return {ns}::encode_error; }}\n"
+    if not fields:
+        enc += "    (void)in; (void)out;\n"
+
+    offset = 0
+    for fld in fields:
+        name, ftype = fld['name'], fld['type']
+        if ftype == 'u8':
+            dec += f"    out.{name} = data[{offset}];\n"
+            enc += f"    out[{offset}] = in.{name};\n"
+        elif ftype == 'u16':
+            dec += f"    out.{name} = {ns}::load_be16(data + {offset});\n"
+            enc += f"    {ns}::store_be16(out + {offset}, in.{name});\n"
+        elif ftype == 'u32':
+            dec += f"    out.{name} = {ns}::load_be32(data + {offset});\n"
+            enc += f"    {ns}::store_be32(out + {offset}, in.{name});\n"
+        else:
+            dec += f"    out.{name} = data + {offset};\n"
+            dec += f"    out.{name}_length = len - {offset};\n"
+            enc += f"    for (size_t i = 0; i < in.{name}_length; ++i) {{ out[{offset} + i] = in.{name}[i]; }}\n"
+        offset += CODEC_FIELD_TYPES[ftype]
+    dec += "    return true;\n}\n"
+    enc += "    return size;\n}\n"
+
+    pkt = (f"template <size_t MaxPayload>\n"
+           f"constexpr bool decode_{suffix}(const ::emCore::protocol::packet<MaxPayload>& pkt, {struct_name}& out) noexcept {{\n"
+           f"    return decode_{suffix}(pkt.data.data(), pkt.length, out);\n}}\n")
+    return dec + pkt + enc
+
+
 def validate_packet_yaml(cfg: dict):
     errors = []
     pkt = cfg.get('packet', {}) or {}
@@ -75,6 +156,8 @@ def validate_packet_yaml(cfg: dict):
                 errors.append(f"Duplicate opcode name: {name}")
             else:
                 seen_names.add(name)
+            if 'fields' in op:
+                errors.extend(validate_codec_fields(op['fields'], f"opcodes[{idx}].fields"))
             if code is None or not _is_hex_byte(code):
                 errors.append(f"opcodes[{idx}].code must be a byte (int or 0xNN string)")
             else:
@@ -126,6 +209,7 @@ def generate_packet_header(cfg: dict, out_path: Path):
     header.append("#pragma once")
     header.append("")
     header.append("#include <emCore/protocol/packet_parser.hpp>")
+    header.append("#include <emCore/protocol/field_codec.hpp>")
     header.append("")
     header.append("#ifndef EMCORE_GENERATED_PACKET_CONFIG_HPP")
     header.append("#define EMCORE_GENERATED_PACKET_CONFIG_HPP")
@@ -160,6 +244,7 @@ def generate_packet_header(cfg: dict, out_path: Path):
     header.append("using ParserT = packet_parser<PACKET_MAX_PAYLOAD, PACKET_SYNC_LEN, PACKET_LENGTH_16BIT, PACKET_SYNC>;")
     header.append("template <size_t MaxHandlers>")
     header.append("using DispatcherT = command_dispatcher<MaxHandlers, PacketT>;")
+    header.append("using IndexedDispatcherT = indexed_command_dispatcher<OPCODE_SPACE, PacketT>;")
     header.append("")
 
     # Compile-time safety: ensure space is sufficient
@@ -170,6 +255,18 @@ def generate_packet_header(cfg: dict, out_path: Path):
     header.append(f"static_assert(OPCODE_SPACE >= {required_space}, \"OPCODE_SPACE must be >= max(opcodes)+1\");")
     header.append("")
 
+    # Compile-time codecs for opcodes that declare a payload layout
+    codec_ops = [op for op in opcodes if op.get('fields') is not None]
+    if codec_ops:
+        header.append("// Compile-time payload codecs (straight-line, no runtime layout tables)")
+        for op in codec_ops:
+            suffix = op['name'].lower()
+            struct_name = f"{suffix}_fields"
+            header.extend(emit_codec_struct(struct_name, op['fields']).rstrip("\n").split("\n"))
+            header.append("")
+            header.extend(emit_field_codec(suffix, struct_name, op['fields']).rstrip("\n").split("\n"))
+            header.append("")
+
     header.append("} // namespace emCore::protocol::gen")
     header.append("")
     header.append("#endif // EMCORE_GENERATED_PACKET_CONFIG_HPP")
@@ -140,6 +140,9 @@ def validate_yaml(config: dict) -> None:
             no = messaging.get('notify_on_empty_only', None)
             if no is not None and not isinstance(no, bool):
                 errors.append("messaging.notify_on_empty_only must be boolean")
+            mp = messaging.get('mailbox_policy', None)
+            if mp is not None and str(mp).lower() not in ('locked', 'spsc', 'mpsc', 'auto'):
+                errors.append(f"messaging.mailbox_policy invalid: {mp} (expected locked|spsc|mpsc|auto)")
 
     # Tasks
     if not isinstance(tasks, list):
@@ -190,6 +193,32 @@ def validate_yaml(config: dict) -> None:
     if errors:
         raise ValueError("YAML validation failed:\n - " + "\n - ".join(errors))
 
+def _channel_name(entry) -> str:
+    return entry.get('channel', '') if isinstance(entry, dict) else str(entry)
+
+def derive_mailbox_policy(tasks, setting) -> int:
+    """Map messaging.mailbox_policy to EMCORE_MSG_MAILBOX_POLICY (0 locked, 1 spsc, 2 mpsc).
+    'auto' picks spsc only when every mailbox is fed by at most one publishing task."""
+    setting = str(setting).lower()
+    if setting == 'locked':
+        return 0
+    if setting == 'spsc':
+        return 1
+    if setting == 'mpsc':
+        return 2
+    publishers = {}
+    for task in tasks:
+        name = task.get('TaskName', task.get('name', ''))
+        for pub in task.get('publishes_to', []) or []:
+            publishers.setdefault(_channel_name(pub), set()).add(name)
+    for task in tasks:
+        producers = set()
+        for sub in task.get('subscribes_to', []) or []:
+            producers |= publishers.get(_channel_name(sub), set())
+        if len(producers) > 1:
+            return 2
+    return 1
+
 def priority_to_cpp(priority_str):
     """Convert priority string to C++ enum"""
     priority_map = {
@@ -236,6 +265,104 @@ struct {name} {{""")
     
     return '\n'.join(message_code)
 
+def generate_routing_table(channels, tasks, topic_id_by_channel):
+    """Emit a constexpr topic -> (mailbox, slot) table for messaging::static_routed_broker.
+    Mailboxes are dense over subscribing tasks; task indices follow enabled-task order,
+    which is the task_id order assigned by taskmaster::create_all_tasks()."""
+    enabled = [t for t in tasks if t.get('enabled', True)]
+    queue_size = {ch.get('name', ''): int(ch.get('queue_size', 4) or 4) for ch in channels}
+
+    mailbox_of_task = []
+    slots_of_task = []  # per mailbox: ordered channel names (slot index == position)
+    depth_of = {}
+    for task_idx, task in enumerate(enabled):
+        subs = []
+        for sub in task.get('subscribes_to', []) or []:
+            ch = _channel_name(sub)
+            if ch in topic_id_by_channel and ch not in subs:
+                subs.append(ch)
+                depth = int(sub.get('mailbox_depth', 0) or 0) if isinstance(sub, dict) else 0
+                depth_of[(task_idx, ch)] = depth if depth > 0 else queue_size.get(ch, 4)
+        if subs:
+            mailbox_of_task.append(len(slots_of_task))
+            slots_of_task.append((task_idx, subs))
+        else:
+            mailbox_of_task.append(0xFF)
+
+    if not slots_of_task:
+        return []
+
+    ordered = [ch.get('name', '') for ch in channels]
+    targets = []
+    offsets = [0]
+    for ch in ordered:
+        for mbox, (task_idx, subs) in enumerate(slots_of_task):
+            if ch in subs:
+                targets.append((mbox, subs.index(ch), depth_of[(task_idx, ch)], ch))
+        offsets.append(len(targets))
+
+    # The table stores these as u8 (0xFF marks "no mailbox") and depths as u16
+    if len(slots_of_task) > 0xFE:
+        raise ValueError(f"Routing table needs {len(slots_of_task)} mailboxes; at most 254 fit a u8 index")
+    if offsets[-1] > 0xFF:
+        raise ValueError(f"Routing table has {offsets[-1]} targets; target_offset is u8 (max 255)")
+    for (mbox, slot, depth, ch) in targets:
+        if slot > 0xFF or depth > 0xFFFF:
+            raise ValueError(f"Route '{ch}' -> mailbox {mbox}: slot {slot} / depth {depth} out of range (u8 / u16)")
+
+    slots_per_mailbox = max(len(subs) for _, subs in slots_of_task)
+    slot_capacity = max(2, max(d for (_, _, d, _) in targets))
+
+    out = []
+    out.append("// Build-time routing table for emCore::messaging::static_routed_broker")
+    out.append("struct yaml_routes {")
+    out.append(f"    static constexpr size_t topic_count = {len(ordered)};")
+    out.append(f"    static constexpr size_t mailbox_count = {len(slots_of_task)};")
+    out.append(f"    static constexpr size_t slots_per_mailbox = {slots_per_mailbox};")
+    out.append(f"    static constexpr size_t slot_capacity = {slot_capacity};")
+    out.append(f"    static constexpr size_t task_count = {len(enabled)};")
+    out.append("    static constexpr u16 topic_ids[topic_count] = {")
+    for ch in ordered:
+        out.append(f"        static_cast<u16>(yaml_topic::{ch.replace('_channel', '')}),")
+    out.append("    };")
+    out.append("    static constexpr u8 target_offset[topic_count + 1] = { " + ", ".join(str(o) for o in offsets) + " };")
+    out.append(f"    static constexpr emCore::messaging::route_target targets[{max(1, len(targets))}] = {{")
+    for (mbox, slot, depth, ch) in targets:
+        out.append(f"        {{ {mbox}, {slot}, {depth} }},  // {ch}")
+    if not targets:
+        out.append("        { 0, 0, 0 },")
+    out.append("    };")
+    out.append("    static constexpr u8 mailbox_of_task[task_count] = { " + ", ".join(f"0x{m:02X}" for m in mailbox_of_task) + " };")
+    out.append("    static constexpr int index_of(u16 topic_id) noexcept {")
+    out.append("        switch (topic_id) {")
+    for idx, ch in enumerate(ordered):
+        out.append(f"            case static_cast<u16>(yaml_topic::{ch.replace('_channel', '')}): return {idx};")
+    out.append("            default: return -1;")
+    out.append("        }")
+    out.append("    }")
+    out.append("};")
+    out.append("")
+    out.append("using yaml_routed_broker = emCore::messaging::static_routed_broker<emCore::messaging::medium_message, yaml_routes>;")
+    out.append("")
+    # Routing indices assume create_all_tasks(task_table) numbers the enabled tasks in table order
+    table_pos = [pos for pos, t in enumerate(tasks) if t.get('enabled', True)]
+    out.append("// Task id create_all_tasks(task_table) assigns to the entry at table_pos (enabled entries in order)")
+    out.append("constexpr size_t yaml_task_id_at(size_t table_pos) noexcept {")
+    out.append("    size_t id = 0;")
+    out.append("    for (size_t i = 0; i < table_pos; ++i) {")
+    out.append("        if (task_table[i].enabled) { ++id; }")
+    out.append("    }")
+    out.append("    return id;")
+    out.append("}")
+    out.append("static_assert(yaml_task_id_at(task_table_size) == yaml_routes::task_count,")
+    out.append("              \"yaml_routes::task_count must match the enabled entries of task_table\");")
+    for task_idx, _ in slots_of_task:
+        pos = table_pos[task_idx]
+        out.append(f"static_assert(task_table[{pos}].enabled && yaml_task_id_at({pos}) == {task_idx},")
+        out.append(f"              \"routing index of task_table[{pos}] must equal its create_all_tasks() task id\");")
+    out.append("")
+    return out
+
 def generate_communication_setup(channels, tasks, messaging_cfg):
     """Generate C++ communication setup code using YAML-aware broker system"""
     if not channels:
@@ -262,6 +389,7 @@ def generate_communication_setup(channels, tasks, messaging_cfg):
     comm_code.append("enum class yaml_topic : u16 {")
     
     used_ids = set()
+    topic_id_by_channel = {}
     for channel in channels:
         name = channel.get('name', '')
         # Deterministic hash with range 0x1000-0xEFFF to avoid system reserved ranges
@@ -271,9 +399,12 @@ def generate_communication_setup(channels, tasks, messaging_cfg):
         while topic_id in used_ids:
             topic_id = 0x1000 + ((topic_id - 0x1000 + 1) % 0xE000)
         used_ids.add(topic_id)
+        topic_id_by_channel[name] = topic_id
         comm_code.append(f"    {name.replace('_channel', '')} = 0x{topic_id:04X},  // {name} (hash-based)")
     comm_code.append("};")
     comm_code.append("")
+
+    comm_code.extend(generate_routing_table(channels, tasks, topic_id_by_channel))
     
     # Generate helper functions for YAML message packing/unpacking - Library heavy lifting
     comm_code.append("// Helper functions for YAML message types - Library heavy lifting")
@@ -647,6 +778,9 @@ def generate_task_config_header(yaml_file, output_file):
                 messaging_cfg += f"#define EMCORE_MSG_TOPIC_HIGH_RATIO_NUM {int(hrn)}\n"
             if isinstance(hrd, int) and hrd > 0:
                 messaging_cfg += f"#define EMCORE_MSG_TOPIC_HIGH_RATIO_DEN {int(hrd)}\n"
+            mp = messaging_root.get('mailbox_policy', None)
+            if mp is not None:
+                messaging_cfg += f"#define EMCORE_MSG_MAILBOX_POLICY {derive_mailbox_policy(tasks, mp)}\n"
         # Format with actual yaml file name visible in header comment
         messaging_cfg = messaging_cfg.replace("{yaml_file}", str(Path(yaml_file).name))
         with open(messaging_cfg_path, 'w') as f:
@@ -184,7 +184,7 @@ def _list_yaml_files(project_dir: Path):
         ".pio", "libdeps", ".git", ".svn", ".hg", ".vscode", ".idea", ".cache", ".vs",
         "build", "cmake", "out", "dist", "node_modules", "external", "third_party",
     }
-    merged_file_names = {"merged_tasks.yaml", "merged_packet.yml", "merged_commands.yaml"}
+    merged_file_names = {"merged_tasks.yaml", "merged_packet.yml", "merged_commands.yaml", "merged_events.yaml"}
 
     results = []
     seen_paths = set()
@@ -750,6 +750,72 @@ def generate_command_if_needed():
         print("⚠️  Build will continue, but generated_command_table.hpp may be missing")
 
 
+def generate_events_if_needed():
+    """Generate the event name catalog if any user YAML has an 'events' section."""
+    project_dir = Path(env.get("PROJECT_DIR"))
+    try:
+        import yaml  # type: ignore
+    except Exception:
+        print("⚠️  emCore: PyYAML unavailable; skipping event catalog generation")
+        return
+
+    # Merge 'events' sections by category name (last writer wins)
+    by_category = {}
+    for path in _list_yaml_files(project_dir):
+        try:
+            with open(path, 'r', encoding='utf-8') as f:
+                doc = yaml.safe_load(f)
+        except Exception:
+            continue
+        if not isinstance(doc, dict) or not isinstance(doc.get('events'), list):
+            continue
+        for entry in doc['events']:
+            if isinstance(entry, dict) and isinstance(entry.get('category'), str):
+                by_category[entry['category'].strip()] = entry
+    if not by_category:
+        print("📝 emCore: No 'events' YAML section found; skipping event catalog generation")
+        return
+
+    merged_events_yaml = project_dir / ".pio" / "emcore" / "merged_events.yaml"
+    if not _write_merged_yaml({'events': list(by_category.values())}, merged_events_yaml):
+        print("📝 emCore: Failed to write merged events YAML; skipping event catalog generation")
+        return
+
+    lib_dir = _resolve_lib_dir(project_dir)
+    if not lib_dir:
+        print("❌ emCore ERROR: Could not find library directory for event catalog generation")
+        return
+    generator_script = lib_dir / "scripts" / "generate_event_config.py"
+    if not generator_script.exists():
+        print(f"❌ emCore ERROR: Event generator script not found: {generator_script}")
+        return
+
+    # event_runtime.hpp picks the catalog up from <emCore/generated/event_config.hpp>
+    generated_header = lib_dir / "src" / "emCore" / "generated" / "event_config.hpp"
+    try:
+        env_vars = os.environ.copy()
+        env_vars['PYTHONPATH'] = os.pathsep.join([str(p) for p in sys.path])
+        result = subprocess.run([
+            sys.executable,
+            str(generator_script),
+            str(merged_events_yaml),
+            str(generated_header)
+        ], cwd=str(project_dir), capture_output=True, text=True, check=True, env=env_vars)
+        print(f"✅ emCore: Event catalog generated ({len(by_category)} categories): {generated_header}")
+        if result.stdout.strip():
+            print(result.stdout)
+    except subprocess.CalledProcessError as e:
+        print(f"❌ emCore ERROR: Event generator failed with exit code {e.returncode}")
+        if e.stdout:
+            print(f"STDOUT: {e.stdout}")
+        if e.stderr:
+            print(f"STDERR: {e.stderr}")
+        print("⚠️  Build will continue without named events")
+    except Exception as e:
+        print(f"❌ emCore ERROR: Unexpected error (events): {e}")
+        print("⚠️  Build will continue without named events")
+
+
 # Note: No link-time RAM budget injection here; compile-time budgeting is enforced
 # via src/emCore/memory/budget.hpp. Keep this script limited to code generation.
 
@@ -771,6 +837,7 @@ if not hasattr(env, '_emcore_generators_run'):
         generate_tasks_if_needed()
         generate_packet_if_needed()
         generate_command_if_needed()
+        generate_events_if_needed()
         print("✅ emCore: Generators completed!")
         env._emcore_generators_run = True
     except Exception as e:
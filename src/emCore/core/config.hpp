@@ -10,9 +10,80 @@
 #define EMCORE_BSS_ATTR
 #endif
 
+// Per-region placement of the runtime arena (memory/layout.hpp). Each region is carved from
+// the arena of its memory class; the attributes below decide where those arenas live, e.g.
+//   ESP32-S3 : EMCORE_FAST_RAM_ATTR=DRAM_ATTR  EMCORE_EXT_RAM_ATTR=EXT_RAM_BSS_ATTR
+//   STM32F7/H7: EMCORE_FAST_RAM_ATTR=__attribute__((section(".dtcmram")))
+#define EMCORE_MEM_INTERNAL 0
+#define EMCORE_MEM_FAST     1
+#define EMCORE_MEM_EXTERNAL 2
+#ifndef EMCORE_FAST_RAM_ATTR
+#define EMCORE_FAST_RAM_ATTR
+#endif
+#ifndef EMCORE_EXT_RAM_ATTR
+#define EMCORE_EXT_RAM_ATTR
+#endif
+#ifndef EMCORE_CACHE_LINE_BYTES
+#define EMCORE_CACHE_LINE_BYTES 32
+#endif
+#ifndef EMCORE_MESSAGING_MEM_CLASS
+#define EMCORE_MESSAGING_MEM_CLASS EMCORE_MEM_INTERNAL
+#endif
+#ifndef EMCORE_EVENTS_MEM_CLASS
+#define EMCORE_EVENTS_MEM_CLASS EMCORE_MEM_INTERNAL
+#endif
+#ifndef EMCORE_TASKS_MEM_CLASS
+#define EMCORE_TASKS_MEM_CLASS EMCORE_MEM_INTERNAL
+#endif
+#ifndef EMCORE_OS_MEM_CLASS
+#define EMCORE_OS_MEM_CLASS EMCORE_MEM_INTERNAL
+#endif
+#ifndef EMCORE_PROTOCOL_MEM_CLASS
+#define EMCORE_PROTOCOL_MEM_CLASS EMCORE_MEM_INTERNAL
+#endif
+#ifndef EMCORE_DIAGNOSTICS_MEM_CLASS
+#define EMCORE_DIAGNOSTICS_MEM_CLASS EMCORE_MEM_INTERNAL
+#endif
+#ifndef EMCORE_SLABS_MEM_CLASS
+#define EMCORE_SLABS_MEM_CLASS EMCORE_MEM_INTERNAL
+#endif
+#ifndef EMCORE_SCRATCH_MEM_CLASS
+#define EMCORE_SCRATCH_MEM_CLASS EMCORE_MEM_INTERNAL
+#endif
+// Hot regions start on a cache line (1) instead of 8 bytes (0): mailbox rings, event queue, slab pages
+#ifndef EMCORE_MESSAGING_CACHE_ALIGN
+#define EMCORE_MESSAGING_CACHE_ALIGN 1
+#endif
+#ifndef EMCORE_EVENTS_CACHE_ALIGN
+#define EMCORE_EVENTS_CACHE_ALIGN 1
+#endif
+#ifndef EMCORE_TASKS_CACHE_ALIGN
+#define EMCORE_TASKS_CACHE_ALIGN 0
+#endif
+#ifndef EMCORE_OS_CACHE_ALIGN
+#define EMCORE_OS_CACHE_ALIGN 0
+#endif
+#ifndef EMCORE_PROTOCOL_CACHE_ALIGN
+#define EMCORE_PROTOCOL_CACHE_ALIGN 0
+#endif
+#ifndef EMCORE_DIAGNOSTICS_CACHE_ALIGN
+#define EMCORE_DIAGNOSTICS_CACHE_ALIGN 0
+#endif
+#ifndef EMCORE_SLABS_CACHE_ALIGN
+#define EMCORE_SLABS_CACHE_ALIGN 1
+#endif
+#ifndef EMCORE_SCRATCH_CACHE_ALIGN
+#define EMCORE_SCRATCH_CACHE_ALIGN 0
+#endif
+
 // Feature toggles (macros for preprocessor guards)
+// Slab broker: one broker whose envelopes reference size-classed payload blocks.
+// When enabled, the small and zero-copy brokers default to off.
+#ifndef EMCORE_ENABLE_SLAB_BROKER
+#define EMCORE_ENABLE_SLAB_BROKER 0
+#endif
 #ifndef EMCORE_ENABLE_ZC
-#define EMCORE_ENABLE_ZC 1
+#define EMCORE_ENABLE_ZC (EMCORE_ENABLE_SLAB_BROKER ? 0 : 1)
 #endif
 #ifndef EMCORE_ENABLE_EVENT_LOGS
 #define EMCORE_ENABLE_EVENT_LOGS 0
@@ -20,7 +91,28 @@
 
 // Enable/disable small-message broker
 #ifndef EMCORE_ENABLE_SMALL_BROKER
-#define EMCORE_ENABLE_SMALL_BROKER 1
+#define EMCORE_ENABLE_SMALL_BROKER (EMCORE_ENABLE_SLAB_BROKER ? 0 : 1)
+#endif
+
+// Construct the taskmaster's event logs on first use and its brokers and pools in
+// initialize() (0 = everything in its constructor)
+#ifndef EMCORE_LAZY_SUBSYSTEMS
+#define EMCORE_LAZY_SUBSYSTEMS 1
+#endif
+// Zero subsystem storage before construction. It lives in BSS that startup has
+// already cleared, so 0 skips a memset per subsystem at boot; keep 1 when
+// EMCORE_BSS_ATTR moves it to a section that is not cleared.
+#ifndef EMCORE_ZERO_SUBSYSTEM_STORAGE
+#define EMCORE_ZERO_SUBSYSTEM_STORAGE 1
+#endif
+#if EMCORE_ZERO_SUBSYSTEM_STORAGE
+#define EMCORE_SUBSYSTEM_STORAGE_INIT {}
+#else
+#define EMCORE_SUBSYSTEM_STORAGE_INIT
+#endif
+// Boot-phase timestamps (diagnostics/boot_timeline.hpp)
+#ifndef EMCORE_BOOT_TIMELINE
+#define EMCORE_BOOT_TIMELINE 1
 #endif
 
 // Core caps defaults for no-YAML/no-flags builds
@@ -30,6 +122,80 @@
 #ifndef EMCORE_MAX_EVENTS
 #define EMCORE_MAX_EVENTS 16
 #endif
+#ifndef EMCORE_MAX_EVENT_HANDLERS
+#define EMCORE_MAX_EVENT_HANDLERS 16
+#endif
+// Depth of each event_bus severity lane (power of two; six lanes)
+#ifndef EMCORE_EVENT_LANE_CAPACITY
+#define EMCORE_EVENT_LANE_CAPACITY 16
+#endif
+// Per-id coalescing / rate-limit rules an event_bus can hold
+#ifndef EMCORE_EVENT_FLOW_RULES
+#define EMCORE_EVENT_FLOW_RULES 8
+#endif
+// Concurrent post_after / post_every timers and their wheel resolution (power of two, ms)
+#ifndef EMCORE_EVENT_MAX_TIMERS
+#define EMCORE_EVENT_MAX_TIMERS 16
+#endif
+#ifndef EMCORE_EVENT_TIMER_TICK_MS
+#define EMCORE_EVENT_TIMER_TICK_MS 1
+#endif
+
+// Cooperative scheduler idle: 0 = poll with delay_ms(1), 1 = sleep until the next due task
+#ifndef EMCORE_TASK_TICKLESS_IDLE
+#define EMCORE_TASK_TICKLESS_IDLE 0
+#endif
+// Worker contexts for cooperative tasks (> 1 enables the work-stealing executor)
+#ifndef EMCORE_TASK_WORKERS
+#define EMCORE_TASK_WORKERS 1
+#endif
+// Core placement for native tasks: upper bound on cores tracked, and whether tasks
+// without an explicit affinity are spread by declared load instead of left floating
+#ifndef EMCORE_MAX_CPU_CORES
+#define EMCORE_MAX_CPU_CORES 2
+#endif
+#ifndef EMCORE_TASK_AUTO_PLACEMENT
+#define EMCORE_TASK_AUTO_PLACEMENT 0
+#endif
+// Stackless coroutine tasks (task/coroutine.hpp; needs compiler/library C++20 coroutine support)
+#ifndef EMCORE_ENABLE_COROUTINES
+#define EMCORE_ENABLE_COROUTINES 0
+#endif
+#ifndef EMCORE_MAX_COROUTINES
+#define EMCORE_MAX_COROUTINES 16
+#endif
+#ifndef EMCORE_COROUTINE_FRAME_BYTES
+#define EMCORE_COROUTINE_FRAME_BYTES 256
+#endif
+// Buckets of the per-task release jitter / start latency histograms (log2 of us)
+#ifndef EMCORE_TASK_JITTER_BUCKETS
+#define EMCORE_TASK_JITTER_BUCKETS 16
+#endif
+// Profiler log-linear histograms (us): 2^(SUB_BITS-1) sub-buckets per octave, values >= 2^MAX_BITS overflow
+#ifndef EMCORE_PROFILER_HIST_SUB_BITS
+#define EMCORE_PROFILER_HIST_SUB_BITS 3
+#endif
+#ifndef EMCORE_PROFILER_HIST_MAX_BITS
+#define EMCORE_PROFILER_HIST_MAX_BITS 22
+#endif
+// Scoped profiling zones (diagnostics/profile_zone.hpp): cycle-timed [task][zone] slots, compiled out when 0
+#ifndef EMCORE_ENABLE_PROFILE_ZONES
+#define EMCORE_ENABLE_PROFILE_ZONES 0
+#endif
+#ifndef EMCORE_PROFILE_MAX_ZONES
+#define EMCORE_PROFILE_MAX_ZONES 16
+#endif
+// Task watchdog timing wheel: slots (power of two) and ms per slot (power of two)
+#ifndef EMCORE_WATCHDOG_WHEEL_SLOTS
+#define EMCORE_WATCHDOG_WHEEL_SLOTS 64
+#endif
+#ifndef EMCORE_WATCHDOG_TICK_MS
+#define EMCORE_WATCHDOG_TICK_MS 8
+#endif
+// Longest single tickless sleep when no periodic task is pending (ms)
+#ifndef EMCORE_TASK_TICKLESS_MAX_SLEEP_MS
+#define EMCORE_TASK_TICKLESS_MAX_SLEEP_MS 1000
+#endif
 
 // Global memory budget default for no-YAML/no-flags builds
 #ifndef EMCORE_MEMORY_BUDGET_BYTES
@@ -63,6 +229,10 @@
 #ifndef EMCORE_POOLS_THREAD_SAFE
 #define EMCORE_POOLS_THREAD_SAFE 0
 #endif
+// memory_pool default: lock-free tagged free list instead of the critical section
+#ifndef EMCORE_POOLS_LOCK_FREE
+#define EMCORE_POOLS_LOCK_FREE 0
+#endif
 
 // Reserve sizes and bookkeeping (moved from memory/budget.hpp)
 #ifndef EMCORE_MSG_OVERHEAD_BYTES
@@ -90,6 +260,45 @@
 #define EMCORE_DIAGNOSTICS_MEM_BYTES 0
 #endif
 
+// Per-invocation scratch arenas (memory/scratch_arena.hpp): one slot of SCRATCH_ARENA_BYTES per
+// cooperative worker plus SCRATCH_NATIVE_SLOTS for native tasks, reset after every task run
+#ifndef EMCORE_ENABLE_SCRATCH_ARENA
+#define EMCORE_ENABLE_SCRATCH_ARENA 0
+#endif
+#ifndef EMCORE_SCRATCH_ARENA_BYTES
+#define EMCORE_SCRATCH_ARENA_BYTES 2048
+#endif
+#ifndef EMCORE_SCRATCH_NATIVE_SLOTS
+#define EMCORE_SCRATCH_NATIVE_SLOTS 4
+#endif
+
+// Binary trace streaming (diagnostics/trace_stream.hpp): one lock-free ring of TRACE_RING_RECORDS
+// 12-byte records per core, drained as a CTF stream; hooks compile out when disabled
+#ifndef EMCORE_ENABLE_TRACE
+#define EMCORE_ENABLE_TRACE 0
+#endif
+#ifndef EMCORE_TRACE_RING_RECORDS
+#define EMCORE_TRACE_RING_RECORDS 256
+#endif
+
+// Size-class slab allocator (memory/slab_allocator.hpp) carved from its own arena region:
+// classes are powers of two from 2^MIN_SHIFT; pages of PAGE_BYTES are handed to classes on demand
+#ifndef EMCORE_ENABLE_SLAB_ALLOCATOR
+#define EMCORE_ENABLE_SLAB_ALLOCATOR 0
+#endif
+#ifndef EMCORE_SLAB_ALLOC_BYTES
+#define EMCORE_SLAB_ALLOC_BYTES 16384
+#endif
+#ifndef EMCORE_SLAB_ALLOC_MIN_SHIFT
+#define EMCORE_SLAB_ALLOC_MIN_SHIFT 4
+#endif
+#ifndef EMCORE_SLAB_ALLOC_CLASSES
+#define EMCORE_SLAB_ALLOC_CLASSES 8
+#endif
+#ifndef EMCORE_SLAB_ALLOC_PAGE_BYTES
+#define EMCORE_SLAB_ALLOC_PAGE_BYTES 2048
+#endif
+
 #ifndef EMCORE_PROTOCOL_PACKET_SIZE
 #define EMCORE_PROTOCOL_PACKET_SIZE 64
 #endif
@@ -99,6 +308,29 @@
 #ifndef EMCORE_PROTOCOL_RING_SIZE
 #define EMCORE_PROTOCOL_RING_SIZE 512
 #endif
+// 1 = the protocol ring is a dma_byte_ring (storage is the UART RX DMA target)
+#ifndef EMCORE_PROTOCOL_DMA_RX
+#define EMCORE_PROTOCOL_DMA_RX 0
+#endif
+// Number of protocol links (ring + parser each) sharing one dispatcher; see packet_channels.hpp
+#ifndef EMCORE_PROTOCOL_CHANNELS
+#define EMCORE_PROTOCOL_CHANNELS 1
+#endif
+// 0 = generated codecs only: field_decoder/field_encoder layouts shrink to one slot
+#ifndef EMCORE_PROTOCOL_RUNTIME_LAYOUTS
+#define EMCORE_PROTOCOL_RUNTIME_LAYOUTS 1
+#endif
+// 1 = runtime dispatcher is a dense OPCODE_SPACE-indexed table; HITS adds per-opcode counters
+#ifndef EMCORE_PROTOCOL_INDEXED_DISPATCH
+#define EMCORE_PROTOCOL_INDEXED_DISPATCH 0
+#endif
+#ifndef EMCORE_PROTOCOL_DISPATCH_HITS
+#define EMCORE_PROTOCOL_DISPATCH_HITS 0
+#endif
+// 1 = bulk Fletcher-16 uses SSSE3 when the target has it (host/gateway builds)
+#ifndef EMCORE_PROTOCOL_SIMD_CHECKSUM
+#define EMCORE_PROTOCOL_SIMD_CHECKSUM 1
+#endif
 
 // If available, include generated messaging configuration macros produced from YAML.
 // This allows YAML to override the default capacities at compile time.
@@ -115,10 +347,29 @@ namespace emCore::config {
         constexpr size_t max_tasks = EMCORE_MAX_TASKS;
         constexpr size_t max_task_name_length = 32;
         constexpr duration_t default_task_timeout = 1000; // ms
+        constexpr bool task_tickless_idle = (EMCORE_TASK_TICKLESS_IDLE != 0);
+        constexpr duration_t task_tickless_max_sleep_ms = EMCORE_TASK_TICKLESS_MAX_SLEEP_MS;
+        constexpr size_t task_workers = EMCORE_TASK_WORKERS;
+        constexpr size_t task_jitter_buckets = EMCORE_TASK_JITTER_BUCKETS;
+        constexpr u8 profiler_hist_sub_bits = EMCORE_PROFILER_HIST_SUB_BITS;
+        constexpr u8 profiler_hist_max_bits = EMCORE_PROFILER_HIST_MAX_BITS;
+        constexpr bool enable_profile_zones = (EMCORE_ENABLE_PROFILE_ZONES != 0);
+        constexpr bool lazy_subsystems = (EMCORE_LAZY_SUBSYSTEMS != 0);
+        constexpr bool boot_timeline = (EMCORE_BOOT_TIMELINE != 0);
+        constexpr size_t profile_max_zones = EMCORE_PROFILE_MAX_ZONES;
+        constexpr size_t max_cpu_cores = EMCORE_MAX_CPU_CORES;
+        constexpr size_t max_coroutines = EMCORE_MAX_COROUTINES;
+        constexpr size_t coroutine_frame_bytes = EMCORE_COROUTINE_FRAME_BYTES;
+        constexpr bool task_auto_placement = (EMCORE_TASK_AUTO_PLACEMENT != 0);
+        constexpr size_t watchdog_wheel_slots = EMCORE_WATCHDOG_WHEEL_SLOTS;
+        constexpr duration_t watchdog_tick_ms = EMCORE_WATCHDOG_TICK_MS;
         
         constexpr size_t max_events = EMCORE_MAX_EVENTS;
-        constexpr size_t max_event_handlers = 16;
-        constexpr size_t event_queue_size = 64;
+        constexpr size_t max_event_handlers = EMCORE_MAX_EVENT_HANDLERS;
+        constexpr size_t event_lane_capacity = EMCORE_EVENT_LANE_CAPACITY;
+        constexpr size_t event_flow_rules = EMCORE_EVENT_FLOW_RULES;
+        constexpr size_t event_max_timers = EMCORE_EVENT_MAX_TIMERS;
+        constexpr duration_t event_timer_tick_ms = EMCORE_EVENT_TIMER_TICK_MS;
         
         // Messaging system configuration - defaults when not specified in YAML
         // These provide minimum safe values. Generators (YAML) can override at build time
@@ -139,6 +390,10 @@ namespace emCore::config {
         constexpr bool enable_diagnostics = (EMCORE_ENABLE_DIAGNOSTICS != 0);
         constexpr bool enable_pools_region= (EMCORE_ENABLE_POOLS_REGION != 0);
         constexpr bool pools_thread_safe  = (EMCORE_POOLS_THREAD_SAFE != 0);
+        constexpr bool pools_lock_free    = (EMCORE_POOLS_LOCK_FREE != 0);
+        constexpr bool enable_slab_allocator = (EMCORE_ENABLE_SLAB_ALLOCATOR != 0);
+        constexpr bool enable_scratch_arena = (EMCORE_ENABLE_SCRATCH_ARENA != 0);
+        constexpr bool enable_trace         = (EMCORE_ENABLE_TRACE != 0);
 
         // Reserve sizes exposed as constexpr
         constexpr size_t msg_overhead_bytes         = EMCORE_MSG_OVERHEAD_BYTES;
@@ -149,11 +404,20 @@ namespace emCore::config {
         constexpr size_t os_mem_bytes               = EMCORE_OS_MEM_BYTES;
         constexpr size_t protocol_mem_bytes         = EMCORE_PROTOCOL_MEM_BYTES;
         constexpr size_t diagnostics_mem_bytes      = EMCORE_DIAGNOSTICS_MEM_BYTES;
+        constexpr size_t slab_alloc_bytes           = EMCORE_SLAB_ALLOC_BYTES;
+        constexpr size_t slab_alloc_min_shift       = EMCORE_SLAB_ALLOC_MIN_SHIFT;
+        constexpr size_t slab_alloc_classes         = EMCORE_SLAB_ALLOC_CLASSES;
+        constexpr size_t slab_alloc_page_bytes      = EMCORE_SLAB_ALLOC_PAGE_BYTES;
+        constexpr size_t scratch_arena_bytes        = EMCORE_SCRATCH_ARENA_BYTES;
+        constexpr size_t scratch_native_slots       = EMCORE_SCRATCH_NATIVE_SLOTS;
+        constexpr size_t trace_ring_records         = EMCORE_TRACE_RING_RECORDS;
+        constexpr size_t cache_line_bytes           = EMCORE_CACHE_LINE_BYTES;
 
         // Protocol minimal sizing knobs as constexpr
         constexpr size_t protocol_packet_size   = EMCORE_PROTOCOL_PACKET_SIZE;
         constexpr size_t protocol_max_handlers  = EMCORE_PROTOCOL_MAX_HANDLERS;
         constexpr size_t protocol_ring_size     = EMCORE_PROTOCOL_RING_SIZE;
+        constexpr size_t protocol_channels      = EMCORE_PROTOCOL_CHANNELS;
 
         #ifdef EMCORE_MSG_MAX_TOPICS
         constexpr size_t default_max_topics = EMCORE_MSG_MAX_TOPICS;
@@ -188,6 +452,42 @@ namespace emCore::config {
         constexpr size_t default_topic_high_ratio_den = 4;
         #endif
 
+        // Mailbox synchronisation policy (see messaging::mailbox_policy)
+        // 0 = critical section, 1 = lock-free SPSC, 2 = lock-free MPSC,
+        // 3 = shared envelope store with u16 index queues
+        #ifdef EMCORE_MSG_MAILBOX_POLICY
+        constexpr u8 default_mailbox_policy = EMCORE_MSG_MAILBOX_POLICY;
+        #else
+        constexpr u8 default_mailbox_policy = 0;
+        #endif
+
+        // Shared-store policy: envelopes in flight across all mailboxes of one broker
+        #ifdef EMCORE_MSG_SHARED_STORE_CAPACITY
+        constexpr size_t default_shared_store_capacity = EMCORE_MSG_SHARED_STORE_CAPACITY;
+        #else
+        constexpr size_t default_shared_store_capacity = 64;
+        #endif
+
+        // Shared-payload fan-out thresholds (messaging::fanout_broker)
+        #ifdef EMCORE_MSG_FANOUT_MIN_SUBSCRIBERS
+        constexpr size_t default_fanout_min_subscribers = EMCORE_MSG_FANOUT_MIN_SUBSCRIBERS;
+        #else
+        constexpr size_t default_fanout_min_subscribers = 3;
+        #endif
+
+        #ifdef EMCORE_MSG_FANOUT_MIN_PAYLOAD
+        constexpr size_t default_fanout_min_payload = EMCORE_MSG_FANOUT_MIN_PAYLOAD;
+        #else
+        constexpr size_t default_fanout_min_payload = 128; // bytes of envelope payload capacity
+        #endif
+
+        // Producers that may block in publish_when_ready() on one broker at a time
+        #ifdef EMCORE_MSG_CREDIT_WAITERS
+        constexpr size_t default_credit_waiters = EMCORE_MSG_CREDIT_WAITERS;
+        #else
+        constexpr size_t default_credit_waiters = 4;
+        #endif
+
         // QoS / Delivery settings (overridable via build defines)
         #ifdef EMCORE_MSG_QOS_PENDING_LIMIT
         constexpr size_t default_qos_pending_limit = EMCORE_MSG_QOS_PENDING_LIMIT;
@@ -201,6 +501,30 @@ namespace emCore::config {
         constexpr u32 default_ack_timeout_us = 500000; // 500 ms
         #endif
 
+        #ifdef EMCORE_MSG_QOS_MAX_ATTEMPTS
+        constexpr u8 default_qos_max_attempts = EMCORE_MSG_QOS_MAX_ATTEMPTS;
+        #else
+        constexpr u8 default_qos_max_attempts = 5; // transmissions before a pending entry is dropped
+        #endif
+
+        #ifdef EMCORE_MSG_QOS_MAX_BACKOFF_MS
+        constexpr u32 default_qos_max_backoff_ms = EMCORE_MSG_QOS_MAX_BACKOFF_MS;
+        #else
+        constexpr u32 default_qos_max_backoff_ms = 8000; // retransmit interval ceiling
+        #endif
+
+        #ifdef EMCORE_MSG_QOS_ACK_BATCH
+        constexpr u16 default_qos_ack_batch = EMCORE_MSG_QOS_ACK_BATCH;
+        #else
+        constexpr u16 default_qos_ack_batch = 8; // cumulative mode: messages per ACK
+        #endif
+
+        #ifdef EMCORE_MSG_QOS_ACK_DELAY_US
+        constexpr u32 default_qos_ack_delay_us = EMCORE_MSG_QOS_ACK_DELAY_US;
+        #else
+        constexpr u32 default_qos_ack_delay_us = 50000; // cumulative mode: max ACK hold time
+        #endif
+
         #ifdef EMCORE_MSG_REPUBLISH_BUFFER
         constexpr size_t default_republish_buffer = EMCORE_MSG_REPUBLISH_BUFFER;
         #else
@@ -220,6 +544,45 @@ namespace emCore::config {
         constexpr size_t zc_block_count = 4;  // conservative default
         #endif
 
+        // Slab broker size classes (payload bytes) and block counts
+        #ifdef EMCORE_SLAB_SMALL_SIZE
+        constexpr size_t slab_small_size = EMCORE_SLAB_SMALL_SIZE;
+        #else
+        constexpr size_t slab_small_size = 16;
+        #endif
+        #ifdef EMCORE_SLAB_MEDIUM_SIZE
+        constexpr size_t slab_medium_size = EMCORE_SLAB_MEDIUM_SIZE;
+        #else
+        constexpr size_t slab_medium_size = 64;
+        #endif
+        #ifdef EMCORE_SLAB_LARGE_SIZE
+        constexpr size_t slab_large_size = EMCORE_SLAB_LARGE_SIZE;
+        #else
+        constexpr size_t slab_large_size = 256;
+        #endif
+        #ifdef EMCORE_SLAB_SMALL_COUNT
+        constexpr size_t slab_small_count = EMCORE_SLAB_SMALL_COUNT;
+        #else
+        constexpr size_t slab_small_count = 16;
+        #endif
+        #ifdef EMCORE_SLAB_MEDIUM_COUNT
+        constexpr size_t slab_medium_count = EMCORE_SLAB_MEDIUM_COUNT;
+        #else
+        constexpr size_t slab_medium_count = 8;
+        #endif
+        #ifdef EMCORE_SLAB_LARGE_COUNT
+        constexpr size_t slab_large_count = EMCORE_SLAB_LARGE_COUNT;
+        #else
+        constexpr size_t slab_large_count = 2;
+        #endif
+
+        // Lock-free zero-copy pool (atomic refcounts, tagged free list) instead of the locked one
+        #ifdef EMCORE_ZC_LOCK_FREE
+        constexpr bool zc_lock_free = (EMCORE_ZC_LOCK_FREE != 0);
+        #else
+        constexpr bool zc_lock_free = false;
+        #endif
+
         // Event log capacities (constexpr used by templates)
         #ifdef EMCORE_EVENT_LOG_MED_CAP
         constexpr size_t event_log_med_cap = EMCORE_EVENT_LOG_MED_CAP;
@@ -271,6 +634,41 @@ namespace emCore::config {
         // -------- Compile-time sanity checks for YAML/flags interrelations --------
         static_assert(max_tasks >= 1, "EMCORE_MAX_TASKS must be >= 1");
         static_assert(max_events >= 1, "EMCORE_MAX_EVENTS must be >= 1");
+        static_assert(max_event_handlers >= 1 && max_event_handlers <= 255, "EMCORE_MAX_EVENT_HANDLERS must be in [1, 255]");
+        static_assert(event_lane_capacity >= 1 && (event_lane_capacity & (event_lane_capacity - 1)) == 0,
+                      "EMCORE_EVENT_LANE_CAPACITY must be a power of two");
+        static_assert(event_max_timers >= 1 && event_max_timers < 0xFFFF, "EMCORE_EVENT_MAX_TIMERS must be in [1, 65534]");
+        static_assert(event_timer_tick_ms >= 1 && (event_timer_tick_ms & (event_timer_tick_ms - 1U)) == 0,
+                      "EMCORE_EVENT_TIMER_TICK_MS must be a power of two");
+        static_assert(max_cpu_cores >= 1 && max_cpu_cores <= 32, "EMCORE_MAX_CPU_CORES must be in [1, 32]");
+        static_assert(max_coroutines >= 1 && max_coroutines <= 32, "EMCORE_MAX_COROUTINES must be in [1, 32]");
+        static_assert(coroutine_frame_bytes >= 64, "EMCORE_COROUTINE_FRAME_BYTES must be >= 64");
+        static_assert(task_workers >= 1 && task_workers <= 32, "EMCORE_TASK_WORKERS must be in [1, 32]");
+        static_assert(task_tickless_max_sleep_ms >= 1, "EMCORE_TASK_TICKLESS_MAX_SLEEP_MS must be >= 1");
+        static_assert(slab_alloc_min_shift >= 3 && slab_alloc_classes >= 1 &&
+                      (slab_alloc_min_shift + slab_alloc_classes) <= 24,
+                      "EMCORE_SLAB_ALLOC_MIN_SHIFT/CLASSES out of range");
+        static_assert((slab_alloc_page_bytes & (slab_alloc_page_bytes - 1U)) == 0 &&
+                      slab_alloc_page_bytes >= (size_t{1} << (slab_alloc_min_shift + slab_alloc_classes - 1U)),
+                      "EMCORE_SLAB_ALLOC_PAGE_BYTES must be a power of two holding the largest class");
+        static_assert(!enable_slab_allocator || (slab_alloc_bytes >= slab_alloc_page_bytes),
+                      "EMCORE_SLAB_ALLOC_BYTES must hold at least one page");
+        static_assert(cache_line_bytes >= 8 && (cache_line_bytes & (cache_line_bytes - 1U)) == 0,
+                      "EMCORE_CACHE_LINE_BYTES must be a power of two >= 8");
+        static_assert(scratch_arena_bytes >= 64 && (scratch_arena_bytes % 8U) == 0,
+                      "EMCORE_SCRATCH_ARENA_BYTES must be a multiple of 8 and >= 64");
+        static_assert(scratch_native_slots < 0xFF, "EMCORE_SCRATCH_NATIVE_SLOTS must be < 255");
+        static_assert(profiler_hist_sub_bits >= 1 && profiler_hist_sub_bits < profiler_hist_max_bits &&
+                          profiler_hist_max_bits <= 32,
+                      "EMCORE_PROFILER_HIST_SUB_BITS must be >= 1 and below EMCORE_PROFILER_HIST_MAX_BITS (<= 32)");
+        static_assert(profile_max_zones >= 1 && profile_max_zones < 0xFF, "EMCORE_PROFILE_MAX_ZONES must be in [1, 254]");
+        static_assert(max_tasks < 0xFF, "profile zone rows are indexed by u8 task ids");
+        static_assert(trace_ring_records >= 2 && (trace_ring_records & (trace_ring_records - 1U)) == 0,
+                      "EMCORE_TRACE_RING_RECORDS must be a power of two >= 2");
+        static_assert(watchdog_wheel_slots >= 2 && (watchdog_wheel_slots & (watchdog_wheel_slots - 1U)) == 0,
+                      "EMCORE_WATCHDOG_WHEEL_SLOTS must be a power of two >= 2");
+        static_assert(watchdog_tick_ms >= 1 && (watchdog_tick_ms & (watchdog_tick_ms - 1U)) == 0,
+                      "EMCORE_WATCHDOG_TICK_MS must be a power of two");
 
         // Messaging
         static_assert(!enable_messaging || (default_mailbox_queue_capacity >= 1),
@@ -288,6 +686,10 @@ namespace emCore::config {
                       "EMCORE_MSG_TOPIC_HIGH_RATIO_NUM must be <= DEN");
         static_assert(!enable_messaging || (default_max_topic_queues_per_mailbox <= default_mailbox_queue_capacity),
                       "Per-mailbox topic queues should not exceed total mailbox queue capacity");
+        static_assert(default_mailbox_policy <= 3,
+                      "EMCORE_MSG_MAILBOX_POLICY must be 0 (locked), 1 (spsc), 2 (mpsc) or 3 (shared store)");
+        static_assert(default_shared_store_capacity >= 1 && default_shared_store_capacity < 0xFFFF,
+                      "EMCORE_MSG_SHARED_STORE_CAPACITY must be in [1, 65534]");
 
         // Protocol
         static_assert(!enable_protocol || (protocol_max_handlers >= 1),
@@ -296,6 +698,8 @@ namespace emCore::config {
                       "EMCORE_PROTOCOL_PACKET_SIZE must be >= 1 when protocol is enabled");
         static_assert(!enable_protocol || (protocol_ring_size >= protocol_packet_size),
                       "EMCORE_PROTOCOL_RING_SIZE must be >= EMCORE_PROTOCOL_PACKET_SIZE");
+        static_assert(protocol_channels >= 1 && protocol_channels <= 255,
+                      "EMCORE_PROTOCOL_CHANNELS must be in [1, 255]");
 
         // Pools
         static_assert(!enable_pools_region || (small_block_size > 0 && medium_block_size > 0 && large_block_size > 0),
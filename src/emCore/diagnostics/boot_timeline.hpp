@@ -0,0 +1,95 @@
+#pragma once
+
+// Boot-phase timeline: the taskmaster stamps each startup milestone once with
+// os::time_us() (time since reset on MCU ports), so the cold-boot budget can be
+// split into constructor, initialize(), create_all_tasks() and the wait until
+// the first task release. Read it through performance_profiler::boot_timeline().
+
+#include <cstddef>
+
+#include "../core/types.hpp"
+#include "../core/config.hpp"
+#include "../os/time.hpp"
+
+#include <etl/array.h>
+#include <etl/atomic.h>
+
+namespace emCore::diagnostics {
+
+enum class boot_phase : u8 {
+    construct_begin = 0,  // taskmaster constructor entered
+    constructed,          // taskmaster constructor done
+    initialized,          // taskmaster::initialize() done
+    tasks_created,        // create_all_tasks() done
+    first_release,        // first task invocation started
+    count
+};
+
+inline constexpr size_t boot_phase_count = static_cast<size_t>(boot_phase::count);
+
+inline constexpr const char* boot_phase_name(boot_phase phase) noexcept {
+    switch (phase) {
+        case boot_phase::construct_begin: return "construct_begin";
+        case boot_phase::constructed:     return "constructed";
+        case boot_phase::initialized:     return "initialized";
+        case boot_phase::tasks_created:   return "tasks_created";
+        case boot_phase::first_release:   return "first_release";
+        default: break;
+    }
+    return "?";
+}
+
+/**
+ * @brief First-time stamps of the boot phases (u32 microseconds, 0 = not reached)
+ *
+ * mark() keeps the earliest stamp of a phase and costs one load once it is
+ * set, so it can sit on hot paths such as the task release.
+ */
+class boot_timeline {
+public:
+    boot_timeline() noexcept = default;
+    boot_timeline(const boot_timeline&) = delete;
+    boot_timeline& operator=(const boot_timeline&) = delete;
+    boot_timeline(boot_timeline&&) = delete;
+    boot_timeline& operator=(boot_timeline&&) = delete;
+    ~boot_timeline() = default;
+
+    void mark(boot_phase phase) noexcept {
+        if constexpr (config::boot_timeline) {
+            etl::atomic<u32>& stamp = stamps_[static_cast<size_t>(phase)];
+            if (stamp.load(etl::memory_order_relaxed) != 0U) {
+                return;
+            }
+            const u32 now = static_cast<u32>(os::time_us());
+            u32 expected = 0;
+            (void)stamp.compare_exchange_strong(expected, (now == 0U) ? 1U : now);
+        }
+    }
+
+    [[nodiscard]] bool reached(boot_phase phase) const noexcept { return at_us(phase) != 0U; }
+    [[nodiscard]] u32 at_us(boot_phase phase) const noexcept {
+        return stamps_[static_cast<size_t>(phase)].load(etl::memory_order_relaxed);
+    }
+
+    // Time from the previous reached phase to this one; 0 when either is missing
+    [[nodiscard]] u32 phase_us(boot_phase phase) const noexcept {
+        const u32 end = at_us(phase);
+        for (size_t i = static_cast<size_t>(phase); end != 0U && i > 0U; --i) {
+            const u32 begin = stamps_[i - 1U].load(etl::memory_order_relaxed);
+            if (begin != 0U) {
+                return end - begin;
+            }
+        }
+        return 0U;
+    }
+
+private:
+    etl::array<etl::atomic<u32>, boot_phase_count> stamps_{};
+};
+
+inline boot_timeline& get_boot_timeline() noexcept {
+    static boot_timeline timeline;
+    return timeline;
+}
+
+}  // namespace emCore::diagnostics
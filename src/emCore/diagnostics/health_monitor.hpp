@@ -9,6 +9,8 @@
 #include "../runtime.hpp"
 
 #include <etl/vector.h>
+#include <etl/array.h>
+#include <etl/algorithm.h>
 #include <cstddef>
 
 
@@ -28,6 +30,8 @@ enum class task_health_status : u8 {
 
 /**
  * @brief System health status
+ *
+ * Percentages are fixed-point, percent * 100 (7550 = 75.50%).
  */
 struct system_health_status {
     // Task health
@@ -39,14 +43,14 @@ struct system_health_status {
     // Message system health
     u32 messages_in_flight{0};
     u32 messages_dropped_total{0};
-    f32 queue_utilization_percent{0.0F};
-    f32 message_throughput_per_sec{0.0F};
+    u16 queue_utilization_x100{0};
+    u32 message_throughput_per_sec{0};
     
     // System resources
-    f32 cpu_utilization_percent{0.0F};
+    u16 cpu_utilization_x100{0};
     size_t free_memory_bytes{0};
     size_t total_memory_bytes{0};
-    f32 memory_utilization_percent{0.0F};
+    u16 memory_utilization_x100{0};
     
     // Error rates
     u32 error_rate_per_min{0};
@@ -60,18 +64,30 @@ struct system_health_status {
     task_health_status overall_health{task_health_status::unknown};
 };
 
-// Strong types for threshold parameters to prevent argument swapping
+// Strong types for threshold parameters to prevent argument swapping (percent * 100)
 struct cpu_warning_tag final {};
-using cpu_warning_pct = core::strong_type<f32, cpu_warning_tag>;
+using cpu_warning_pct = core::strong_type<u16, cpu_warning_tag>;
 
 struct cpu_critical_tag final {};
-using cpu_critical_pct = core::strong_type<f32, cpu_critical_tag>;
+using cpu_critical_pct = core::strong_type<u16, cpu_critical_tag>;
 
 struct mem_warning_tag final {};
-using mem_warning_pct = core::strong_type<f32, mem_warning_tag>;
+using mem_warning_pct = core::strong_type<u16, mem_warning_tag>;
 
 struct mem_critical_tag final {};
-using mem_critical_pct = core::strong_type<f32, mem_critical_tag>;
+using mem_critical_pct = core::strong_type<u16, mem_critical_tag>;
+
+/**
+ * @brief Health state transition; task_id is invalid_task_id for the overall system health
+ */
+struct health_event {
+    task_id_t task_id{invalid_task_id};
+    task_health_status from{task_health_status::unknown};
+    task_health_status to{task_health_status::unknown};
+    timestamp_t timestamp_us{0};
+};
+
+using health_event_callback_t = void (*)(const health_event& event) noexcept;
 
 /**
  * @brief Task health entry
@@ -82,132 +98,170 @@ struct task_health_entry {
     timestamp_t last_seen{0};
     u32 error_count{0};
     u32 timeout_count{0};
-    f32 cpu_usage_percent{0.0F};
+    u16 cpu_usage_x100{0};
     duration_t avg_response_time_us{0};
     bool is_responsive{true};
     
     /**
-     * @brief Update health status based on metrics
+     * @brief Take the task's latest metrics; returns the status they imply
      */
-    void update_health(const task_performance_metrics& metrics) noexcept {
-        last_seen = platform::get_system_time_us();
+    task_health_status update_health(const task_performance_metrics& metrics, timestamp_t now) noexcept {
+        last_seen = now;
+        is_responsive = true;
         error_count = metrics.error_count;
-        
-        // Calculate CPU usage percentage
-        if (metrics.execution_count > 0) {
-            cpu_usage_percent = static_cast<f32>(metrics.cpu_usage_percent_x100) / 100.0F;
-        }
-        
+        cpu_usage_x100 = static_cast<u16>(etl::min<u32>(metrics.cpu_usage_percent_x100, 10000U));
         avg_response_time_us = metrics.avg_latency_us;
         
-        // Determine health status
         if (error_count > 10) {
-            status = task_health_status::critical;
-        } else if (error_count > 5 || avg_response_time_us > 10000) { // >10ms latency
-            status = task_health_status::warning;
-        } else if (metrics.execution_count > 0) {
-            status = task_health_status::healthy;
-        } else {
-            status = task_health_status::unknown;
+            return task_health_status::critical;
         }
-        
-        // Check responsiveness (last seen within 30 seconds)
-        timestamp_t now = platform::get_system_time_us();
-        is_responsive = (now - last_seen) < static_cast<timestamp_t>(30000000); // 30 seconds in microseconds
-        
-        if (!is_responsive) {
-            status = task_health_status::unresponsive;
+        if (error_count > 5 || avg_response_time_us > 10000) { // >10ms latency
+            return task_health_status::warning;
         }
+        return (metrics.execution_count > 0) ? task_health_status::healthy : task_health_status::unknown;
     }
 };
 
 /**
  * @brief System health monitor
+ *
+ * Evaluation is incremental: the profiler pushes each metrics change through
+ * its observer hook, only that task's thresholds are checked, and the
+ * per-status task counts and the CPU sum are adjusted by the delta, so the
+ * overall health is recomputed in O(1) and only when something changed. All
+ * arithmetic is integer. Status changes, per task and overall, are reported
+ * through the event callback. update_health_status() is left with the
+ * time-based part: marking tasks that went silent as unresponsive.
  */
 class health_monitor {
 private:
     static constexpr size_t max_tasks = config::max_tasks;
     static constexpr duration_t update_interval_ms = 5000; // 5 seconds
+    static constexpr timestamp_t unresponsive_after_us = 30000000; // 30 seconds
+    static constexpr size_t status_count = 5;
+    static constexpr u8 no_slot = 0xFF;
     
     etl::vector<task_health_entry, max_tasks> task_health_;
+    etl::array<u8, max_tasks> slot_of_{};
+    etl::array<u8, status_count> status_tasks_{};
+    u32 cpu_sum_x100_{0};   // over tasks whose status is not unknown
     system_health_status system_health_;
     timestamp_t last_update_time_{0};
     bool monitoring_enabled_{false};
+    health_event_callback_t event_callback_{nullptr};
     
-    // Health thresholds
-    f32 cpu_warning_threshold_{75.0F};     // 75% CPU usage
-    f32 cpu_critical_threshold_{90.0F};    // 90% CPU usage
-    f32 memory_warning_threshold_{80.0F};  // 80% memory usage
-    f32 memory_critical_threshold_{95.0F}; // 95% memory usage
+    // Health thresholds (percent * 100)
+    u16 cpu_warning_threshold_{7500};     // 75% CPU usage
+    u16 cpu_critical_threshold_{9000};    // 90% CPU usage
+    u16 memory_warning_threshold_{8000};  // 80% memory usage
+    u16 memory_critical_threshold_{9500}; // 95% memory usage
     
     /**
-     * @brief Find task health entry
+     * @brief Index of a task's entry: direct for taskmaster ids, scan otherwise; size() if absent
      */
-    task_health_entry* find_task_health(task_id_t task_id) noexcept {
-        for (auto& entry : task_health_) {
-            if (entry.task_id == task_id) {
-                return &entry;
+    [[nodiscard]] size_t slot_for(task_id_t task_id) const noexcept {
+        if (task_id.value() < max_tasks) {
+            const u8 slot = slot_of_[task_id.value()];
+            return (slot == no_slot) ? task_health_.size() : slot;
+        }
+        for (size_t i = 0; i < task_health_.size(); ++i) {
+            if (task_health_[i].task_id == task_id) {
+                return i;
             }
         }
-        return nullptr;
+        return task_health_.size();
     }
-    
+
+    task_health_entry* find_task_health(task_id_t task_id) noexcept {
+        const size_t slot = slot_for(task_id);
+        return (slot < task_health_.size()) ? &task_health_[slot] : nullptr;
+    }
+
+    static constexpr size_t index_of(task_health_status status) noexcept { return static_cast<size_t>(status); }
+
+    void emit(task_id_t task_id, task_health_status from, task_health_status to, timestamp_t now) const noexcept {
+        if (event_callback_ != nullptr) {
+            event_callback_(health_event{task_id, from, to, now});
+        }
+    }
+
     /**
-     * @brief Calculate overall system health
+     * @brief Move one task to a new status and CPU share, keeping the aggregates in step
      */
-    void calculate_overall_health() noexcept {
-        u8 healthy_tasks = 0;
-        u8 warning_tasks = 0;
-        u8 critical_tasks = 0;
-        u8 unresponsive_tasks = 0;
-        
-        for (const auto& entry : task_health_) {
-            switch (entry.status) {
-                case task_health_status::healthy:
-                    healthy_tasks++;
-                    break;
-                case task_health_status::warning:
-                    warning_tasks++;
-                    break;
-                case task_health_status::critical:
-                    critical_tasks++;
-                    break;
-                case task_health_status::unresponsive:
-                    unresponsive_tasks++;
-                    break;
-                default:
-                    break;
-            }
+    void apply(task_health_entry& entry, task_health_status status, u16 old_cpu_x100, timestamp_t now) noexcept {
+        const task_health_status previous = entry.status;
+        if (previous != task_health_status::unknown) { cpu_sum_x100_ -= old_cpu_x100; }
+        if (status != task_health_status::unknown) { cpu_sum_x100_ += entry.cpu_usage_x100; }
+        if (status != previous) {
+            --status_tasks_[index_of(previous)];
+            ++status_tasks_[index_of(status)];
+            entry.status = status;
+            emit(entry.task_id, previous, status, now);
         }
+        calculate_overall_health(now);
+    }
+    
+    /**
+     * @brief Calculate overall system health from the running counts
+     */
+    void calculate_overall_health(timestamp_t now) noexcept {
+        const u8 healthy_tasks = status_tasks_[index_of(task_health_status::healthy)];
+        const u8 warning_tasks = status_tasks_[index_of(task_health_status::warning)];
+        const u8 critical_tasks = status_tasks_[index_of(task_health_status::critical)];
+        const u8 unresponsive_tasks = status_tasks_[index_of(task_health_status::unresponsive)];
+        const size_t half = task_health_.size() / 2;
         
         system_health_.tasks_running = healthy_tasks + warning_tasks;
         system_health_.tasks_faulted = critical_tasks + unresponsive_tasks;
         system_health_.tasks_total = static_cast<u8>(task_health_.size());
+
+        const u32 active = static_cast<u32>(healthy_tasks) + warning_tasks + critical_tasks + unresponsive_tasks;
+        system_health_.cpu_utilization_x100 = (active > 0U) ? static_cast<u16>(cpu_sum_x100_ / active) : 0U;
+        const u16 cpu = system_health_.cpu_utilization_x100;
+        const u16 mem = system_health_.memory_utilization_x100;
         
         // Determine overall health
-        if (unresponsive_tasks > 0 || critical_tasks > task_health_.size() / 2) {
-            system_health_.overall_health = task_health_status::critical;
-        } else if (critical_tasks > 0 || warning_tasks > task_health_.size() / 2) {
-            system_health_.overall_health = task_health_status::warning;
+        task_health_status overall = task_health_status::unknown;
+        if (unresponsive_tasks > 0 || critical_tasks > half || cpu >= cpu_critical_threshold_ ||
+            mem >= memory_critical_threshold_) {
+            overall = task_health_status::critical;
+        } else if (critical_tasks > 0 || warning_tasks > half || cpu >= cpu_warning_threshold_ ||
+                   mem >= memory_warning_threshold_) {
+            overall = task_health_status::warning;
         } else if (healthy_tasks > 0) {
-            system_health_.overall_health = task_health_status::healthy;
-        } else {
-            system_health_.overall_health = task_health_status::unknown;
+            overall = task_health_status::healthy;
+        }
+        if (overall != system_health_.overall_health) {
+            const task_health_status previous = system_health_.overall_health;
+            system_health_.overall_health = overall;
+            emit(invalid_task_id, previous, overall, now);
         }
     }
+
+    // Profiler observer; forwards to the global monitor
+    static void on_metrics_changed(task_id_t task_id, const task_performance_metrics& metrics) noexcept;
     
 public:
-    health_monitor() noexcept = default;
+    health_monitor() noexcept {
+        slot_of_.fill(no_slot);
+        status_tasks_.fill(0);
+    }
     
     /**
-     * @brief Enable/disable health monitoring
+     * @brief Enable/disable health monitoring; subscribes to the global profiler's metric updates
      */
     void enable_monitoring(bool enable = true) noexcept {
         monitoring_enabled_ = enable;
+        get_global_profiler().set_metrics_observer(enable ? &health_monitor::on_metrics_changed : nullptr);
         if (enable) {
             last_update_time_ = platform::get_system_time_us();
         }
     }
+
+    /**
+     * @brief Receive every task and overall status transition
+     */
+    void set_event_callback(health_event_callback_t callback) noexcept { event_callback_ = callback; }
     
     /**
      * @brief Register a task for health monitoring
@@ -220,12 +274,49 @@ public:
         task_health_entry entry;
         entry.task_id = task_id;
         entry.last_seen = platform::get_system_time_us();
+        if (task_id.value() < max_tasks) {
+            slot_of_[task_id.value()] = static_cast<u8>(task_health_.size());
+        }
         task_health_.push_back(entry);
+        ++status_tasks_[index_of(task_health_status::unknown)];
+        calculate_overall_health(entry.last_seen);
         return true;
     }
+
+    /**
+     * @brief Delta entry point: re-check one task after its metrics changed
+     */
+    void on_task_metrics(task_id_t task_id, const task_performance_metrics& metrics) noexcept {
+        if (!monitoring_enabled_) {
+            return;
+        }
+        task_health_entry* entry = find_task_health(task_id);
+        if (entry == nullptr) {
+            return;
+        }
+        const u16 old_cpu = entry->cpu_usage_x100;
+        const timestamp_t now = platform::get_system_time_us();
+        const task_health_status status = entry->update_health(metrics, now);
+        if (status != entry->status || old_cpu != entry->cpu_usage_x100) {
+            apply(*entry, status, old_cpu, now);
+        }
+    }
+
+    /**
+     * @brief Memory figures for the utilization thresholds
+     */
+    void update_memory(size_t free_bytes, size_t total_bytes) noexcept {
+        system_health_.free_memory_bytes = free_bytes;
+        system_health_.total_memory_bytes = total_bytes;
+        if (total_bytes > 0 && free_bytes <= total_bytes) {
+            const u64 used = static_cast<u64>(total_bytes - free_bytes);
+            system_health_.memory_utilization_x100 = static_cast<u16>((used * 10000U) / total_bytes);
+        }
+        calculate_overall_health(platform::get_system_time_us());
+    }
     
     /**
-     * @brief Update health status (should be called periodically)
+     * @brief Time-based checks (call periodically): silent tasks become unresponsive
      */
     void update_health_status() noexcept {
         if (!monitoring_enabled_) {
@@ -238,42 +329,21 @@ public:
             return; // Too soon for update
         }
         
-        auto& profiler = get_global_profiler();
-        
-        // Update per-task health
         for (auto& entry : task_health_) {
-            const auto* metrics = profiler.get_task_metrics(entry.task_id);
-            if (metrics != nullptr) {
-                entry.update_health(*metrics);
+            if (entry.is_responsive && entry.status != task_health_status::unknown &&
+                (now - entry.last_seen) >= unresponsive_after_us) {
+                entry.is_responsive = false;
+                apply(entry, task_health_status::unresponsive, entry.cpu_usage_x100, now);
             }
         }
         
-        // Update system health
-        const auto& sys_metrics = profiler.get_system_metrics();
+        const auto& sys_metrics = get_global_profiler().get_system_metrics();
         system_health_.uptime_ms = static_cast<timestamp_t>(sys_metrics.system_uptime_us / 1000);
-        system_health_.free_memory_bytes = sys_metrics.free_heap_bytes;
         system_health_.messages_dropped_total = sys_metrics.total_messages_dropped;
         system_health_.error_rate_per_min = sys_metrics.total_errors; // Simplified
-        
-        // Calculate CPU utilization
-        f32 total_cpu = 0.0F;
-        u8 active_tasks = 0;
-        for (const auto& entry : task_health_) {
-            if (entry.status != task_health_status::unknown) {
-                total_cpu += entry.cpu_usage_percent;
-                active_tasks++;
-            }
+        if (sys_metrics.free_heap_bytes != 0) {
+            system_health_.free_memory_bytes = sys_metrics.free_heap_bytes;
         }
-        system_health_.cpu_utilization_percent = active_tasks > 0 ? total_cpu / static_cast<f32>(active_tasks) : 0.0F;
-        
-        // Calculate memory utilization
-        if (system_health_.total_memory_bytes > 0) {
-            size_t used_memory = system_health_.total_memory_bytes - system_health_.free_memory_bytes;
-            system_health_.memory_utilization_percent = 
-                (static_cast<f32>(used_memory) / static_cast<f32>(system_health_.total_memory_bytes)) * 100.0F;
-        }
-        
-        calculate_overall_health();
         
         system_health_.last_update_time = now;
         last_update_time_ = now;
@@ -290,12 +360,8 @@ public:
      * @brief Get task health status
      */
     [[nodiscard]] const task_health_entry* get_task_health(task_id_t task_id) const noexcept {
-        for (const auto& entry : task_health_) {
-            if (entry.task_id == task_id) {
-                return &entry;
-            }
-        }
-        return nullptr;
+        const size_t slot = slot_for(task_id);
+        return (slot < task_health_.size()) ? &task_health_[slot] : nullptr;
     }
     
     /**
@@ -318,7 +384,7 @@ public:
         platform::log("=== SYSTEM HEALTH REPORT ===");
         
         // Overall status
-        platform::log("Overall Health: HEALTHY");
+        platform::logf("Overall Health: %u", static_cast<u32>(system_health_.overall_health));
         platform::logf("Uptime: %u ms", static_cast<u32>(system_health_.uptime_ms));
         platform::logf("Tasks: %u running, %u faulted, %u total",
                       static_cast<u32>(system_health_.tasks_running),
@@ -326,10 +392,11 @@ public:
                       static_cast<u32>(system_health_.tasks_total));
         
         // Resource utilization
-        platform::logf("CPU Usage: %u%%", static_cast<u32>(system_health_.cpu_utilization_percent));
+        platform::logf("CPU Usage: %u.%02u%%", static_cast<u32>(system_health_.cpu_utilization_x100 / 100U),
+                      static_cast<u32>(system_health_.cpu_utilization_x100 % 100U));
         platform::logf("Memory: %u bytes free (%u%% used)",
                       static_cast<u32>(system_health_.free_memory_bytes),
-                      static_cast<u32>(system_health_.memory_utilization_percent));
+                      static_cast<u32>(system_health_.memory_utilization_x100 / 100U));
         
         // Error statistics
         platform::logf("Messages dropped: %u", system_health_.messages_dropped_total);
@@ -338,8 +405,9 @@ public:
         // Per-task health
         platform::log("\n--- TASK HEALTH ---");
         for (const auto& entry : task_health_) {
-            platform::logf("Task %u: (Errors: %u)",
+            platform::logf("Task %u: status %u (Errors: %u)",
                           static_cast<u32>(entry.task_id.value()),
+                          static_cast<u32>(entry.status),
                           entry.error_count);
         }
         
@@ -347,7 +415,7 @@ public:
     }
     
     /**
-     * @brief Set health thresholds
+     * @brief Set health thresholds (percent * 100)
      */
     void set_thresholds(cpu_warning_pct cpu_warning,
                        cpu_critical_pct cpu_critical,
@@ -357,6 +425,7 @@ public:
         cpu_critical_threshold_ = cpu_critical.value();
         memory_warning_threshold_ = mem_warning.value();
         memory_critical_threshold_ = mem_critical.value();
+        calculate_overall_health(platform::get_system_time_us());
     }
 };
 
@@ -380,5 +449,9 @@ inline health_monitor& get_global_health_monitor() noexcept {
     }
 }
 
+inline void health_monitor::on_metrics_changed(task_id_t task_id, const task_performance_metrics& metrics) noexcept {
+    get_global_health_monitor().on_task_metrics(task_id, metrics);
+}
+
 } // namespace emCore::diagnostics
 
@@ -0,0 +1,273 @@
+#pragma once
+
+// Scoped profiling zones: EMCORE_PROFILE_ZONE("name") times the rest of the
+// enclosing scope in CPU cycles and accumulates it in a [task][zone] slot.
+// Compiled out entirely unless EMCORE_ENABLE_PROFILE_ZONES is set.
+
+#include <cstddef>
+
+#include "../core/types.hpp"
+#include "../core/config.hpp"
+#include "../os/time.hpp"
+#include "../os/tasks.hpp"
+#include "../os/sync.hpp"
+#include "../platform/platform.hpp"
+
+#include <etl/array.h>
+#include <etl/atomic.h>
+
+namespace emCore::diagnostics {
+
+// FNV-1a over the zone name; evaluated at compile time at every zone site
+constexpr u32 zone_hash(const char* name) noexcept {
+    u32 h = 2166136261U;
+    for (; *name != '\0'; ++name) {
+        h = (h ^ static_cast<u8>(*name)) * 16777619U;
+    }
+    return h;
+}
+
+// Snapshot of one [row][zone] slot
+struct zone_stats {
+    u32 count{0};
+    u32 min_cycles{0xFFFFFFFFU};
+    u32 max_cycles{0};
+    u64 total_cycles{0};
+};
+
+/**
+ * @brief Zone name registry and per-task, per-zone cycle statistics
+ *
+ * Each zone site interns its name once (a function-local static), after which
+ * entering a zone is two cycle-counter reads, a short lookup of the running
+ * execution context and a [task][zone] index. The taskmaster tags the context
+ * (native task or worker thread, keyed by its task handle) with the task id
+ * around every invocation, so a task preempted on its core keeps its own row.
+ * Zones opened from an ISR land in the isr row, zones outside any invocation
+ * in the unattributed row. Slots are updated with relaxed atomics because the
+ * shared rows see several cores and interrupt levels at once.
+ */
+class zone_profiler {
+public:
+    static constexpr size_t max_zones = config::profile_max_zones;
+    static constexpr size_t rows = config::max_tasks + 2U;
+    static constexpr size_t unattributed = config::max_tasks;
+    static constexpr size_t isr_row = config::max_tasks + 1U;
+    static constexpr u8 no_zone = 0xFF;
+
+    zone_profiler() noexcept = default;
+    zone_profiler(const zone_profiler&) = delete;
+    zone_profiler& operator=(const zone_profiler&) = delete;
+    zone_profiler(zone_profiler&&) = delete;
+    zone_profiler& operator=(zone_profiler&&) = delete;
+
+    // Slot for a zone name; no_zone once max_zones distinct names are in use
+    u8 intern(u32 id, const char* name) noexcept {
+        u8 slot = no_zone;
+        cs_.enter();
+        for (size_t i = 0; i < zone_count_; ++i) {
+            if (ids_[i] == id) { slot = static_cast<u8>(i); }
+        }
+        if (slot == no_zone && zone_count_ < max_zones) {
+            slot = static_cast<u8>(zone_count_++);
+            ids_[slot] = id;
+            names_[slot] = name;
+        }
+        cs_.exit();
+        return slot;
+    }
+
+    // Taskmaster hooks: attribute zones of the calling context to task_id until leave_task()
+    void enter_task(task_id_t task_id) noexcept {
+        attribution* ctx = context_slot(true);
+        if (ctx != nullptr) {
+            ctx->row.store((task_id.value() < config::max_tasks) ? static_cast<u8>(task_id.value())
+                                                                 : static_cast<u8>(unattributed),
+                           etl::memory_order_relaxed);
+        }
+    }
+    void leave_task() noexcept {
+        attribution* ctx = context_slot(false);
+        if (ctx != nullptr) {
+            ctx->row.store(static_cast<u8>(unattributed), etl::memory_order_relaxed);
+        }
+    }
+
+    [[nodiscard]] u8 current_row() noexcept {
+        if (os::in_isr()) {
+            return static_cast<u8>(isr_row);
+        }
+        const attribution* ctx = context_slot(false);
+        return (ctx != nullptr) ? ctx->row.load(etl::memory_order_relaxed) : static_cast<u8>(unattributed);
+    }
+
+    void record(u8 row, u8 slot, u32 cycles) noexcept {
+        zone_cell& z = stats_[row][slot];
+        (void)z.count.fetch_add(1U, etl::memory_order_relaxed);
+        const u32 lo = z.total_lo.fetch_add(cycles, etl::memory_order_relaxed);
+        if (lo + cycles < lo) {
+            (void)z.total_hi.fetch_add(1U, etl::memory_order_relaxed);
+        }
+        u32 seen = z.min_cycles.load(etl::memory_order_relaxed);
+        while (cycles < seen && !z.min_cycles.compare_exchange_weak(seen, cycles, etl::memory_order_relaxed)) {}
+        seen = z.max_cycles.load(etl::memory_order_relaxed);
+        while (cycles > seen && !z.max_cycles.compare_exchange_weak(seen, cycles, etl::memory_order_relaxed)) {}
+    }
+
+    // Statistics of one zone; row is a task id, unattributed or isr_row (fields may be a record apart)
+    [[nodiscard]] zone_stats get(size_t row, size_t slot) const noexcept {
+        const zone_cell& z = stats_[(row < rows) ? row : unattributed][(slot < max_zones) ? slot : 0U];
+        zone_stats out{};
+        out.count = z.count.load(etl::memory_order_relaxed);
+        out.min_cycles = z.min_cycles.load(etl::memory_order_relaxed);
+        out.max_cycles = z.max_cycles.load(etl::memory_order_relaxed);
+        out.total_cycles = (static_cast<u64>(z.total_hi.load(etl::memory_order_relaxed)) << 32U) |
+                           z.total_lo.load(etl::memory_order_relaxed);
+        return out;
+    }
+    [[nodiscard]] size_t zone_count() const noexcept { return zone_count_; }
+    [[nodiscard]] const char* zone_name(size_t slot) const noexcept {
+        return (slot < zone_count_) ? names_[slot] : nullptr;
+    }
+    [[nodiscard]] u32 zone_id(size_t slot) const noexcept { return (slot < zone_count_) ? ids_[slot] : 0U; }
+
+    void reset() noexcept {
+        for (auto& row : stats_) {
+            for (zone_cell& z : row) {
+                z.count.store(0U, etl::memory_order_relaxed);
+                z.min_cycles.store(0xFFFFFFFFU, etl::memory_order_relaxed);
+                z.max_cycles.store(0U, etl::memory_order_relaxed);
+                z.total_lo.store(0U, etl::memory_order_relaxed);
+                z.total_hi.store(0U, etl::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Per zone name, one line per task that entered it: count, avg / min / max in us
+    void generate_report() const noexcept {
+        platform::log("=== PROFILE ZONES ===");
+        for (size_t slot = 0; slot < zone_count_; ++slot) {
+            platform::log(names_[slot]);
+            for (size_t row = 0; row < rows; ++row) {
+                const zone_stats z = get(row, slot);
+                if (z.count == 0U) {
+                    continue;
+                }
+                const u32 avg = os::cycles_to_us(static_cast<u32>(z.total_cycles / z.count));
+                const u32 lo = os::cycles_to_us(z.min_cycles);
+                const u32 hi = os::cycles_to_us(z.max_cycles);
+                if (row == isr_row) {
+                    platform::logf("  isr: n=%u avg/min/max=%u/%u/%u us", z.count, avg, lo, hi);
+                } else if (row == unattributed) {
+                    platform::logf("  unattributed: n=%u avg/min/max=%u/%u/%u us", z.count, avg, lo, hi);
+                } else {
+                    platform::logf("  task %u: n=%u avg/min/max=%u/%u/%u us", static_cast<u32>(row), z.count, avg, lo, hi);
+                }
+            }
+        }
+    }
+
+private:
+    struct zone_cell {
+        etl::atomic<u32> count{0};
+        etl::atomic<u32> min_cycles{0xFFFFFFFFU};
+        etl::atomic<u32> max_cycles{0};
+        etl::atomic<u32> total_lo{0};  // total cycles, low word; carries into total_hi
+        etl::atomic<u32> total_hi{0};
+    };
+
+    // Row currently charged by one execution context
+    struct attribution {
+        etl::atomic<os::task_handle_t> handle{nullptr};
+        etl::atomic<u8> row{static_cast<u8>(unattributed)};
+    };
+
+    // Native tasks plus one worker thread per core
+    static constexpr size_t max_contexts = config::max_tasks + config::max_cpu_cores;
+
+    /*
+     * Slot of the calling context, claimed on first enter_task(). Kernels
+     * without task handles fall back to one slot per core; nullptr once every
+     * slot is claimed, which leaves the context unattributed.
+     */
+    attribution* context_slot(bool claim) noexcept {
+        const os::task_handle_t self = os::current_task();
+        if (self == nullptr) {
+            return &per_core_[os::current_core() % config::max_cpu_cores];
+        }
+        for (attribution& ctx : contexts_) {
+            if (ctx.handle.load(etl::memory_order_acquire) == self) {
+                return &ctx;
+            }
+        }
+        if (!claim) {
+            return nullptr;
+        }
+        for (attribution& ctx : contexts_) {
+            os::task_handle_t expected = nullptr;
+            if (ctx.handle.load(etl::memory_order_relaxed) == nullptr &&
+                ctx.handle.compare_exchange_strong(expected, self, etl::memory_order_acq_rel)) {
+                return &ctx;
+            }
+        }
+        return nullptr;
+    }
+
+    etl::array<etl::array<zone_cell, max_zones>, rows> stats_{};
+    etl::array<u32, max_zones> ids_{};
+    etl::array<const char*, max_zones> names_{};
+    etl::array<attribution, max_contexts> contexts_{};
+    etl::array<attribution, config::max_cpu_cores> per_core_{};
+    size_t zone_count_{0};
+    os::critical_section cs_;
+};
+
+inline zone_profiler& get_global_zone_profiler() noexcept {
+    static zone_profiler profiler;
+    return profiler;
+}
+
+/**
+ * @brief RAII zone: cycle count at construction, recorded on destruction
+ */
+class profile_zone {
+public:
+    explicit profile_zone(u8 slot) noexcept
+        : slot_(slot), row_(get_global_zone_profiler().current_row()), start_(os::cycles()) {}
+    ~profile_zone() noexcept {
+        const u32 elapsed = os::cycles() - start_;
+        if (slot_ != zone_profiler::no_zone) {
+            get_global_zone_profiler().record(row_, slot_, elapsed);
+        }
+    }
+    profile_zone(const profile_zone&) = delete;
+    profile_zone& operator=(const profile_zone&) = delete;
+    profile_zone(profile_zone&&) = delete;
+    profile_zone& operator=(profile_zone&&) = delete;
+
+private:
+    u8 slot_;
+    u8 row_;
+    u32 start_;
+};
+
+}  // namespace emCore::diagnostics
+
+#define EMCORE_PZ_CAT_(a, b) a##b
+#define EMCORE_PZ_CAT(a, b) EMCORE_PZ_CAT_(a, b)
+
+#if EMCORE_ENABLE_PROFILE_ZONES
+#define EMCORE_PROFILE_ZONE(name)                                                                            \
+    static constexpr ::emCore::u32 EMCORE_PZ_CAT(emcore_zone_id_, __LINE__) =                               \
+        ::emCore::diagnostics::zone_hash(name);                                                             \
+    static const ::emCore::u8 EMCORE_PZ_CAT(emcore_zone_slot_, __LINE__) =                                  \
+        ::emCore::diagnostics::get_global_zone_profiler().intern(EMCORE_PZ_CAT(emcore_zone_id_, __LINE__), name); \
+    const ::emCore::diagnostics::profile_zone EMCORE_PZ_CAT(emcore_zone_, __LINE__)(                          \
+        EMCORE_PZ_CAT(emcore_zone_slot_, __LINE__))
+#define EMCORE_PROFILE_ENTER_TASK(task_id) ::emCore::diagnostics::get_global_zone_profiler().enter_task(task_id)
+#define EMCORE_PROFILE_LEAVE_TASK() ::emCore::diagnostics::get_global_zone_profiler().leave_task()
+#else
+#define EMCORE_PROFILE_ZONE(name) ((void)0)
+#define EMCORE_PROFILE_ENTER_TASK(task_id) ((void)0)
+#define EMCORE_PROFILE_LEAVE_TASK() ((void)0)
+#endif
@@ -3,8 +3,11 @@
 #include "../core/types.hpp"
 #include "../core/config.hpp"
 #include "../platform/platform.hpp"
+#include "../task/histogram.hpp"
+#include "boot_timeline.hpp"
 #include <etl/vector.h>
 #include <etl/circular_buffer.h>
+#include <etl/array.h>
 #include <cstddef>
 
  #include <etl/algorithm.h>
@@ -12,6 +15,11 @@
 
 namespace emCore::diagnostics {
 
+/**
+ * @brief Log-linear histogram of microsecond samples, shaped by EMCORE_PROFILER_HIST_*
+ */
+using profiler_histogram = task::log_linear_histogram<config::profiler_hist_sub_bits, config::profiler_hist_max_bits>;
+
 /**
  * @brief Task performance metrics
  */
@@ -20,7 +28,7 @@ struct task_performance_metrics {
     duration_t min_execution_time_us{0xFFFFFFFF};
     duration_t max_execution_time_us{0};
     duration_t avg_execution_time_us{0};
-    duration_t total_execution_time_us{0};
+    u64 total_execution_time_us{0};
     
     // Latency statistics (microseconds)
     duration_t min_latency_us{0xFFFFFFFF};
@@ -41,6 +49,11 @@ struct task_performance_metrics {
     
     // Last update timestamp
     timestamp_t last_update_time{0};
+
+    // Tail distributions (microseconds); copy one to snapshot it, merge() to combine
+    profiler_histogram execution_histogram{};
+    profiler_histogram latency_histogram{};
+    profiler_histogram scheduling_delay_histogram{};
     
     /**
      * @brief Update execution time statistics
@@ -52,7 +65,8 @@ struct task_performance_metrics {
         min_execution_time_us = etl::min(min_execution_time_us, execution_time_us);
         max_execution_time_us = etl::max(max_execution_time_us, execution_time_us);
         
-        avg_execution_time_us = total_execution_time_us / execution_count;
+        avg_execution_time_us = static_cast<duration_t>(total_execution_time_us / execution_count);
+        execution_histogram.record(execution_time_us);
         last_update_time = platform::get_system_time_us();
     }
     
@@ -71,6 +85,20 @@ struct task_performance_metrics {
         } else {
             avg_latency_us = (avg_latency_us * 7 + latency_us) / 8; // 7/8 weight to previous
         }
+        latency_histogram.record(latency_us);
+    }
+
+    /**
+     * @brief Record the delay between a task's release and the start of its run
+     */
+    void update_scheduling_delay(duration_t delay_us) noexcept {
+        scheduling_delay_histogram.record(delay_us);
+    }
+
+    [[nodiscard]] task::percentiles execution_percentiles() const noexcept { return execution_histogram.summary(); }
+    [[nodiscard]] task::percentiles latency_percentiles() const noexcept { return latency_histogram.summary(); }
+    [[nodiscard]] task::percentiles scheduling_delay_percentiles() const noexcept {
+        return scheduling_delay_histogram.summary();
     }
     
     /**
@@ -97,6 +125,9 @@ struct task_performance_metrics {
         cpu_usage_percent_x100 = 0;
         stack_usage_bytes = 0;
         peak_stack_usage_bytes = 0;
+        execution_histogram.clear();
+        latency_histogram.clear();
+        scheduling_delay_histogram.clear();
     }
 };
 
@@ -141,6 +172,11 @@ struct trace_entry {
     u16 data{0};       // Event-specific data
 };
 
+/**
+ * @brief Called after a task's metrics changed (task context; keep it short)
+ */
+using metrics_observer_t = void (*)(task_id_t task_id, const task_performance_metrics& metrics) noexcept;
+
 /**
  * @brief Performance profiler
  */
@@ -155,6 +191,8 @@ private:
     // Per-task metrics
     etl::vector<task_performance_metrics, max_tasks> task_metrics_;
     etl::vector<task_id_t, max_tasks> task_ids_;
+    // Metrics slot by task id for ids below max_tasks (0xFF = unregistered)
+    etl::array<u8, max_tasks> slot_of_{make_slot_table()};
     
     // System metrics
     system_performance_metrics system_metrics_;
@@ -166,17 +204,44 @@ private:
     bool profiling_enabled_{false};
     bool tracing_enabled_{false};
     timestamp_t profiling_start_time_{0};
+    metrics_observer_t observer_{nullptr};
     
+    static constexpr u8 no_slot = 0xFF;
+
+    static constexpr etl::array<u8, max_tasks> make_slot_table() noexcept {
+        etl::array<u8, max_tasks> table{};
+        for (auto& slot : table) { slot = no_slot; }
+        return table;
+    }
+
     /**
-     * @brief Find task metrics by ID
+     * @brief Metrics slot of a task: direct index for taskmaster ids, scan otherwise
      */
-    task_performance_metrics* find_task_metrics(task_id_t task_id) noexcept {
+    [[nodiscard]] size_t slot_of(task_id_t task_id) const noexcept {
+        if (task_id.value() < max_tasks) {
+            const u8 slot = slot_of_[task_id.value()];
+            return (slot == no_slot) ? task_ids_.size() : slot;
+        }
         for (size_t i = 0; i < task_ids_.size(); ++i) {
             if (task_ids_[i] == task_id) {
-                return &task_metrics_[i];
+                return i;
             }
         }
-        return nullptr;
+        return task_ids_.size();
+    }
+
+    void notify(task_id_t task_id, const task_performance_metrics& metrics) const noexcept {
+        if (observer_ != nullptr) {
+            observer_(task_id, metrics);
+        }
+    }
+
+    /**
+     * @brief Find task metrics by ID
+     */
+    task_performance_metrics* find_task_metrics(task_id_t task_id) noexcept {
+        const size_t slot = slot_of(task_id);
+        return (slot < task_ids_.size()) ? &task_metrics_[slot] : nullptr;
     }
     
 public:
@@ -212,6 +277,9 @@ public:
             return false;
         }
         
+        if (task_id.value() < max_tasks) {
+            slot_of_[task_id.value()] = static_cast<u8>(task_ids_.size());
+        }
         task_ids_.push_back(task_id);
         task_metrics_.emplace_back();
         return true;
@@ -228,10 +296,11 @@ public:
         auto* metrics = find_task_metrics(task_id);
         if (metrics != nullptr) {
             metrics->update_execution_time(execution_time_us);
+            notify(task_id, *metrics);
         }
         
-        // Add to trace if enabled
-        if (tracing_enabled_ && !trace_buffer_.full()) {
+        // Add to trace if enabled; the ring overwrites its oldest entry when full
+        if (tracing_enabled_) {
             trace_entry entry;
             entry.task_id = task_id;
             entry.timestamp = platform::get_system_time_us();
@@ -252,12 +321,13 @@ public:
         auto* metrics = find_task_metrics(task_id);
         if (metrics != nullptr) {
             metrics->update_latency(latency_us);
+            notify(task_id, *metrics);
         }
         
         system_metrics_.total_messages_received++;
         
-        // Add to trace if enabled
-        if (tracing_enabled_ && !trace_buffer_.full()) {
+        // Add to trace if enabled; the ring overwrites its oldest entry when full
+        if (tracing_enabled_) {
             trace_entry entry;
             entry.task_id = task_id;
             entry.timestamp = platform::get_system_time_us();
@@ -267,6 +337,20 @@ public:
         }
     }
     
+    /**
+     * @brief Record scheduling delay (release to start of execution)
+     */
+    void record_scheduling_delay(task_id_t task_id, duration_t delay_us) noexcept {
+        if (!profiling_enabled_) {
+            return;
+        }
+
+        auto* metrics = find_task_metrics(task_id);
+        if (metrics != nullptr) {
+            metrics->update_scheduling_delay(delay_us);
+        }
+    }
+    
     /**
      * @brief Record error
      */
@@ -278,21 +362,38 @@ public:
         auto* metrics = find_task_metrics(task_id);
         if (metrics != nullptr) {
             metrics->error_count++;
+            notify(task_id, *metrics);
         }
         
         system_metrics_.total_errors++;
     }
+
+    /**
+     * @brief Record CPU usage of a task (percent * 100)
+     */
+    void record_cpu_usage(task_id_t task_id, u32 usage_percent_x100) noexcept {
+        if (!profiling_enabled_) {
+            return;
+        }
+
+        auto* metrics = find_task_metrics(task_id);
+        if (metrics != nullptr) {
+            metrics->update_cpu_usage(usage_percent_x100);
+            notify(task_id, *metrics);
+        }
+    }
+
+    /**
+     * @brief Push every metrics change to observer (nullptr to stop); one observer at a time
+     */
+    void set_metrics_observer(metrics_observer_t observer) noexcept { observer_ = observer; }
     
     /**
      * @brief Get task metrics
      */
     const task_performance_metrics* get_task_metrics(task_id_t task_id) const noexcept {
-        for (size_t i = 0; i < task_ids_.size(); ++i) {
-            if (task_ids_[i] == task_id) {
-                return &task_metrics_[i];
-            }
-        }
-        return nullptr;
+        const size_t slot = slot_of(task_id);
+        return (slot < task_ids_.size()) ? &task_metrics_[slot] : nullptr;
     }
     
     /**
@@ -309,6 +410,13 @@ public:
         return trace_buffer_;
     }
     
+    /**
+     * @brief Boot-phase stamps recorded by the taskmaster (kept across reset_statistics())
+     */
+    [[nodiscard]] const diagnostics::boot_timeline& boot_timeline() const noexcept {
+        return get_boot_timeline();
+    }
+    
     /**
      * @brief Update system statistics
      */
@@ -375,6 +483,18 @@ public:
         platform::logf("Total errors: %u", system_metrics_.total_errors);
         platform::logf("Free heap: %u bytes", static_cast<u32>(system_metrics_.free_heap_bytes));
         
+        // Boot phases (time since reset, and since the previous phase)
+        const diagnostics::boot_timeline& boot = get_boot_timeline();
+        if (boot.reached(boot_phase::construct_begin)) {
+            platform::log("\n--- BOOT TIMELINE ---");
+            for (size_t i = 0; i < boot_phase_count; ++i) {
+                const auto phase = static_cast<boot_phase>(i);
+                if (boot.reached(phase)) {
+                    platform::logf("  Phase %u at %u us (+%u us)", static_cast<u32>(i), boot.at_us(phase), boot.phase_us(phase));
+                }
+            }
+        }
+        
         // Per-task statistics
         platform::log("\n--- TASK STATISTICS ---");
         for (size_t i = 0; i < task_ids_.size(); ++i) {
@@ -385,11 +505,19 @@ public:
                 platform::logf("  Avg exec time: %u us", metrics.avg_execution_time_us);
                 platform::logf("  Min/Max exec: %u/%u us", 
                               metrics.min_execution_time_us, metrics.max_execution_time_us);
+                const task::percentiles exec = metrics.execution_percentiles();
+                platform::logf("  Exec p50/p90/p99/p999: %u/%u/%u/%u us", exec.p50, exec.p90, exec.p99, exec.p999);
+                if (metrics.scheduling_delay_histogram.total > 0) {
+                    const task::percentiles delay = metrics.scheduling_delay_percentiles();
+                    platform::logf("  Delay p50/p90/p99/p999: %u/%u/%u/%u us", delay.p50, delay.p90, delay.p99, delay.p999);
+                }
                 if (metrics.message_count > 0) {
                     platform::logf("  Messages: %u", metrics.message_count);
                     platform::logf("  Avg latency: %u us", metrics.avg_latency_us);
                     platform::logf("  Min/Max latency: %u/%u us",
                                   metrics.min_latency_us, metrics.max_latency_us);
+                    const task::percentiles lat = metrics.latency_percentiles();
+                    platform::logf("  Latency p50/p90/p99/p999: %u/%u/%u/%u us", lat.p50, lat.p90, lat.p99, lat.p999);
                 }
                 platform::logf("  Errors: %u", metrics.error_count);
             }
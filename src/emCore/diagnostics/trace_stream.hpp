@@ -0,0 +1,214 @@
+#pragma once
+
+// Continuous binary tracing: per-core lock-free rings of 12-byte records and a
+// drain stage that emits a CTF 1.8 stream (Trace Compass, babeltrace).
+//
+// Host side: save ctf_metadata() as `metadata` and the drained bytes, starting
+// with write_packet_header(), as `stream_0` in one directory, then open that
+// directory as a CTF trace. Timestamps are the low 32 bits of os::time_us();
+// the CTF clock reconstruction handles the wrap as long as events are less
+// than ~71 minutes apart.
+
+#include <cstddef>
+
+#include "../core/types.hpp"
+#include "../core/config.hpp"
+#include "../os/time.hpp"
+#include "../os/tasks.hpp"
+#include "../messaging/lockfree_ring.hpp"
+
+#include <etl/array.h>
+#include <etl/atomic.h>
+
+namespace emCore::diagnostics {
+
+enum class trace_kind : u8 {
+    task_switch = 1,  // id = task, arg = worker (native_worker for native tasks)
+    task_end    = 2,  // id = task, arg = worker; duration is the gap to task_switch
+    msg_publish = 3,  // id = topic, arg = sender << 16 | sequence
+    msg_receive = 4,  // id = topic, arg = sender << 16 | sequence
+    isr_enter   = 5,  // id = irq number
+    isr_exit    = 6,  // id = irq number
+    user        = 7   // id / arg chosen by the caller
+};
+
+static constexpr u32 trace_native_worker = 0xFFFFFFFFU;
+
+struct trace_record {
+    u32 timestamp_us{0};
+    u8 kind{0};
+    u8 core{0};
+    u16 id{0};
+    u32 arg{0};
+};
+
+/**
+ * @brief Per-core trace rings with a timestamp-ordered binary drain
+ *
+ * record() reserves a slot in the ring of the calling core with one CAS and never
+ * blocks or masks interrupts, so it is safe from tasks and ISRs; when a ring is
+ * full the record is counted as dropped instead of stopping the trace. One
+ * drain context (a low-priority task) merges the rings by timestamp and writes
+ * records in the wire layout described by ctf_metadata().
+ */
+template <size_t Cores = config::max_cpu_cores, size_t Records = config::trace_ring_records>
+class trace_stream {
+public:
+    static_assert(Cores >= 1, "trace_stream needs at least one core");
+    static constexpr size_t record_bytes = 12;
+    static constexpr size_t packet_header_bytes = 8;
+    static constexpr u32 ctf_magic = 0xC1FC1FC1U;
+
+    trace_stream() noexcept = default;
+    trace_stream(const trace_stream&) = delete;
+    trace_stream& operator=(const trace_stream&) = delete;
+    trace_stream(trace_stream&&) = delete;
+    trace_stream& operator=(trace_stream&&) = delete;
+
+    void enable(bool on = true) noexcept { enabled_.store(on, etl::memory_order_release); }
+    [[nodiscard]] bool enabled() const noexcept { return enabled_.load(etl::memory_order_relaxed); }
+
+    // Any context
+    void record(trace_kind kind, u16 id, u32 arg = 0) noexcept {
+        if (!enabled_.load(etl::memory_order_relaxed)) {
+            return;
+        }
+        const u8 core = static_cast<u8>(os::current_core() % Cores);
+        const trace_record r{static_cast<u32>(os::time_us()), static_cast<u8>(kind), core, id, arg};
+        if (!rings_[core].try_push(r)) {
+            dropped_[core].fetch_add(1U, etl::memory_order_relaxed);
+        }
+    }
+
+    // CTF packet header; write once at the start of the stream file
+    static size_t write_packet_header(u8* buf, size_t cap) noexcept {
+        if (cap < packet_header_bytes) {
+            return 0;
+        }
+        put_u32(buf, ctf_magic);
+        put_u32(buf + 4, 0U);  // stream_id
+        return packet_header_bytes;
+    }
+
+    /*
+     * Move as many whole records as fit into buf, oldest first across cores.
+     * Returns bytes written (0 when empty). Matches packet_tx_pipeline::
+     * submit_with(), so a trace link can be fed straight from the TX path.
+     */
+    size_t drain_into(u8* buf, size_t cap) noexcept {
+        size_t written = 0;
+        while (cap - written >= record_bytes) {
+            const size_t core = oldest_core();
+            if (core == Cores) {
+                break;
+            }
+            encode(*rings_[core].front(), buf + written);
+            rings_[core].pop();
+            written += record_bytes;
+        }
+        drained_ += static_cast<u32>(written / record_bytes);
+        return written;
+    }
+
+    // Stream everything queued to write(const u8*, size_t), in chunks; returns records sent
+    template <typename Fn>
+    size_t drain(Fn&& write) noexcept {
+        etl::array<u8, record_bytes * 8U> chunk{};
+        size_t records = 0;
+        for (size_t n = drain_into(chunk.data(), chunk.size()); n != 0U; n = drain_into(chunk.data(), chunk.size())) {
+            write(static_cast<const u8*>(chunk.data()), n);
+            records += n / record_bytes;
+        }
+        return records;
+    }
+
+    [[nodiscard]] u32 dropped(size_t core) const noexcept {
+        return (core < Cores) ? dropped_[core].load(etl::memory_order_relaxed) : 0U;
+    }
+    [[nodiscard]] u32 drained() const noexcept { return drained_; }
+    [[nodiscard]] size_t pending() const noexcept {
+        size_t n = 0;
+        for (const auto& ring : rings_) { n += ring.size(); }
+        return n;
+    }
+
+    // TSDL description of the stream produced above
+    static constexpr const char* ctf_metadata() noexcept {
+        return "/* CTF 1.8 */\n"
+               "typealias integer { size = 8; align = 8; signed = false; } := uint8_t;\n"
+               "typealias integer { size = 16; align = 8; signed = false; } := uint16_t;\n"
+               "typealias integer { size = 32; align = 8; signed = false; } := uint32_t;\n"
+               "trace { major = 1; minor = 8; byte_order = le;\n"
+               "  packet.header := struct { uint32_t magic; uint32_t stream_id; }; };\n"
+               "env { domain = \"emCore\"; };\n"
+               "clock { name = monotonic; freq = 1000000; };\n"
+               "typealias integer { size = 32; align = 8; signed = false; map = clock.monotonic.value; } := clock_us_t;\n"
+               "stream { id = 0;\n"
+               "  event.header := struct { clock_us_t timestamp; uint8_t id; };\n"
+               "  event.context := struct { uint8_t cpu_id; }; };\n"
+               "event { name = \"task_switch\"; id = 1; stream_id = 0; fields := struct { uint16_t task; uint32_t worker; }; };\n"
+               "event { name = \"task_end\"; id = 2; stream_id = 0; fields := struct { uint16_t task; uint32_t worker; }; };\n"
+               "event { name = \"msg_publish\"; id = 3; stream_id = 0; fields := struct { uint16_t topic; uint16_t sequence; uint16_t sender; }; };\n"
+               "event { name = \"msg_receive\"; id = 4; stream_id = 0; fields := struct { uint16_t topic; uint16_t sequence; uint16_t sender; }; };\n"
+               "event { name = \"isr_enter\"; id = 5; stream_id = 0; fields := struct { uint16_t irq; uint32_t arg; }; };\n"
+               "event { name = \"isr_exit\"; id = 6; stream_id = 0; fields := struct { uint16_t irq; uint32_t arg; }; };\n"
+               "event { name = \"user\"; id = 7; stream_id = 0; fields := struct { uint16_t id; uint32_t value; }; };\n";
+    }
+
+private:
+    static void put_u16(u8* p, u16 v) noexcept {
+        p[0] = static_cast<u8>(v);
+        p[1] = static_cast<u8>(v >> 8U);
+    }
+    static void put_u32(u8* p, u32 v) noexcept {
+        put_u16(p, static_cast<u16>(v));
+        put_u16(p + 2, static_cast<u16>(v >> 16U));
+    }
+
+    // Wire layout: timestamp, kind (event id), core (cpu_id), id, arg; little endian
+    static void encode(const trace_record& r, u8* out) noexcept {
+        put_u32(out, r.timestamp_us);
+        out[4] = r.kind;
+        out[5] = r.core;
+        put_u16(out + 6, r.id);
+        put_u32(out + 8, r.arg);
+    }
+
+    // Core whose oldest record is earliest (wrap-aware); Cores when all are empty
+    size_t oldest_core() const noexcept {
+        size_t best = Cores;
+        u32 best_ts = 0;
+        for (size_t c = 0; c < Cores; ++c) {
+            const trace_record* head = rings_[c].front();
+            if (head != nullptr && (best == Cores || static_cast<i32>(head->timestamp_us - best_ts) < 0)) {
+                best = c;
+                best_ts = head->timestamp_us;
+            }
+        }
+        return best;
+    }
+
+    etl::array<messaging::mpsc_ring<trace_record, Records>, Cores> rings_{};
+    etl::array<etl::atomic<u32>, Cores> dropped_{};
+    etl::atomic<bool> enabled_{true};
+    u32 drained_{0};
+};
+
+inline trace_stream<>& get_global_trace() noexcept {
+    static trace_stream<> trace;
+    return trace;
+}
+
+}  // namespace emCore::diagnostics
+
+// Instrumentation points; compiled out unless EMCORE_ENABLE_TRACE is set
+#if EMCORE_ENABLE_TRACE
+#define EMCORE_TRACE(kind, id, arg) \
+    ::emCore::diagnostics::get_global_trace().record(::emCore::diagnostics::trace_kind::kind, static_cast<::emCore::u16>(id), static_cast<::emCore::u32>(arg))
+#else
+#define EMCORE_TRACE(kind, id, arg) ((void)0)
+#endif
+#define EMCORE_TRACE_ISR_ENTER(irq) EMCORE_TRACE(isr_enter, (irq), 0)
+#define EMCORE_TRACE_ISR_EXIT(irq)  EMCORE_TRACE(isr_exit, (irq), 0)
+#define EMCORE_TRACE_MSG(kind, header) \
+    EMCORE_TRACE(kind, (header).type, (static_cast<::emCore::u32>((header).sender_id) << 16U) | (header).sequence_number)
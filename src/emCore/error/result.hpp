@@ -17,7 +17,8 @@ enum class error_code : int8_t {
     not_found = -4,
     already_exists = -5,
     not_initialized = -6,
-    hardware_error = -7
+    hardware_error = -7,
+    not_schedulable = -8
 };
 
 // Result type for error handling without exceptions
@@ -26,6 +26,7 @@ struct Event {
     severity level{severity::info};
     flags attr{flags::none};
     timestamp_t ts{0};
+    u32 count{1};          // posts this event stands for (> 1 when coalesced, see flags::aggregated)
     payload_t data;
 
     Event() = default;
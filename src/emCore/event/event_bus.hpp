@@ -4,8 +4,14 @@
 #include "../core/config.hpp"
 #include "event.hpp"
 #include"event_types.hpp"
+#include "event_timers.hpp"
+#include "../os/wake.hpp"
+#include "../os/time.hpp"
+#include "../messaging/lockfree_ring.hpp"
 #include <etl/vector.h>
-#include <etl/deque.h>
+#include <etl/array.h>
+#include <etl/atomic.h>
+#include <etl/algorithm.h>
 #include <etl/delegate.h>
 #include <cstddef>
 namespace emCore::events {
@@ -19,13 +25,67 @@ struct handler_registration {
 };
 
 // Universal event bus (no RTTI/alloc). Copy/move disabled.
+//
+// Handlers are kept sorted by (category bucket, code) with one offset table per
+// bucket, so dispatch() binary-searches the event's code inside its category
+// bucket, runs that bucket's code-wildcard tail, then does the same in the
+// category-wildcard bucket; only matching handlers are touched. Unregistering
+// compacts the table. Changes made by a handler while dispatch() is running
+// are deferred (removals are masked, additions are staged) until it returns.
+//
+// post() is lock-free and safe from ISRs and any core: each severity has its
+// own MPSC ring, and process() always takes the next event from the most
+// severe non-empty lane, so a flood of info events cannot delay a critical
+// one by more than the event being dispatched. Handler registration and
+// process()/dispatch() belong to the single context that drains the bus.
+//
+// Flow rules (set_coalescing / set_rate_limit) apply to one exact id. A
+// coalesced id holds at most one queued event: later posts only bump a counter
+// and the handler sees the first event with count = occurrences and
+// flags::aggregated. A rate-limited id passes a token bucket (kept as one
+// theoretical-arrival-time word, so the check is a single CAS) and excess
+// posts are refused and counted. Configure rules before posting starts.
+//
+// post_after / post_every park an event on one timer wheel and post it when
+// advance_timers() passes its deadline; the taskmaster advances the wheel on
+// every scheduling pass and sleeps no longer than next_timer_due() when idle.
 class event_bus {
 private:
     static constexpr size_t max_handlers = config::max_event_handlers;
-    static constexpr size_t queue_cap    = config::event_queue_size;
+    static constexpr size_t lane_cap     = config::event_lane_capacity;
+    static constexpr size_t lane_count   = static_cast<size_t>(severity::critical) + 1U;
+    static constexpr code_t any_code     = 0xFFFFU;
+
+    // One bucket per named category, one shared by out-of-range values, one for category::any
+    static constexpr size_t named_buckets   = static_cast<size_t>(category::custom) + 1U;
+    static constexpr size_t other_bucket    = named_buckets;
+    static constexpr size_t wildcard_bucket = named_buckets + 1U;
+    static constexpr size_t bucket_count    = named_buckets + 2U;
 
     etl::vector<handler_registration, max_handlers> handlers_;
-    etl::deque<Event, queue_cap> queue_;
+    etl::array<u8, bucket_count + 1U> bucket_begin_{};  // handlers_[begin[b], begin[b + 1]) is bucket b
+    etl::array<messaging::mpsc_ring<Event, lane_cap>, lane_count> lanes_{};
+    etl::array<etl::atomic<u32>, lane_count> dropped_{};
+
+    static constexpr size_t max_rules = config::event_flow_rules;
+    static constexpr u32 queued_bit   = 0x80000000U;
+
+    struct flow_rule {
+        id ident{};
+        bool coalesce{false};
+        u32 interval_us{0};              // 0 = no rate limit
+        u32 tolerance_us{0};             // (burst - 1) * interval
+        etl::atomic<u32> state{0};       // coalesce: queued_bit | posts folded into the queued event
+        etl::atomic<u32> tat{0};         // token bucket: theoretical arrival time (low 32 bits of time_us)
+        etl::atomic<u32> limited{0};
+        etl::atomic<u32> merged{0};
+    };
+    etl::array<flow_rule, max_rules> rules_{};
+    etl::atomic<u32> rule_count_{0};
+
+    event_timer_wheel<config::event_max_timers> timers_;
+    u8 dispatch_depth_{0};
+    bool dirty_{false};
     bool initialized_{false};
 
 public:
@@ -42,61 +102,294 @@ public:
         if (!initialized_ || handlers_.full()) { return false; }
         handler_registration reg; reg.ident = ident; reg.fn = hnd; reg.active = true;
         handlers_.push_back(reg);
+        changed();
         return true;
     }
 
     bool unregister_handler(id ident) noexcept {
         if (!initialized_) { return false; }
         for (auto& hnd : handlers_) {
-            if (hnd.active && hnd.ident.cat == ident.cat && hnd.ident.code == ident.code) { hnd.active = false; return true; }
+            if (hnd.active && hnd.ident.cat == ident.cat && hnd.ident.code == ident.code) {
+                hnd.active = false;
+                changed();
+                return true;
+            }
         }
         return false;
     }
 
-    // Post event by value (Event is a small value type)
+    // Coalesce repeated posts of ident while one is still queued; false when the rule table is full
+    bool set_coalescing(id ident, bool enable = true) noexcept {
+        flow_rule* rule = rule_slot(ident);
+        if (rule == nullptr) { return false; }
+        rule->coalesce = enable;
+        return true;
+    }
+
+    // Admit at most events_per_second posts of ident, with bursts of up to burst; 0 removes the limit.
+    // false when the rule table is full or burst * interval does not fit the signed 32-bit us clock
+    bool set_rate_limit(id ident, u32 events_per_second, u16 burst = 1) noexcept {
+        const u32 interval = (events_per_second == 0U) ? 0U : etl::max<u32>(1000000U / events_per_second, 1U);
+        const u64 tolerance = static_cast<u64>(interval) * ((burst > 1U) ? burst - 1U : 0U);
+        if (tolerance + interval > 0x7FFFFFFFU) { return false; }
+        flow_rule* rule = rule_slot(ident);
+        if (rule == nullptr) { return false; }
+        rule->interval_us = interval;
+        rule->tolerance_us = static_cast<u32>(tolerance);
+        return true;
+    }
+
+    // Post event by value into its severity lane (any context, including ISRs)
+    // false if rate limited or the lane is full; a coalesced post returns true
     bool post(const Event& evt) noexcept {
-        if (!initialized_ || queue_.full()) { return false; }
-        queue_.push_back(evt);
+        if (!initialized_) { return false; }
+        flow_rule* rule = find_rule(evt.ident);
+        if (rule != nullptr) {
+            if (!admit(*rule)) {
+                rule->limited.fetch_add(1U, etl::memory_order_relaxed);
+                return false;
+            }
+            if (rule->coalesce && fold(*rule)) { return true; }
+        }
+        const size_t lane = lane_of(evt.level);
+        if (!lanes_[lane].try_push(evt)) {
+            u32 lost = 1U;
+            if (rule != nullptr && rule->coalesce) {
+                lost += rule->state.exchange(0U, etl::memory_order_acq_rel) & ~queued_bit;
+            }
+            dropped_[lane].fetch_add(lost, etl::memory_order_relaxed);
+            return false;
+        }
+        os::wake_cooperative();  // whoever drains the bus may be a sleeping cooperative task
         return true;
     }
 
+    // Post evt once, delay_ms from now; invalid_timer when all timers are in use
+    event_timer_id post_after(duration_t delay_ms, const Event& evt) noexcept {
+        if (!initialized_) { return invalid_timer; }
+        return timers_.start(evt, os::time_ms(), delay_ms, 0U);
+    }
+
+    // Post evt every period_ms, the first time one period from now, until cancel_timer()
+    event_timer_id post_every(duration_t period_ms, const Event& evt) noexcept {
+        if (!initialized_ || period_ms == 0U) { return invalid_timer; }
+        return timers_.start(evt, os::time_ms(), period_ms, period_ms);
+    }
+
+    // false if the timer already fired (one-shot) or was cancelled
+    bool cancel_timer(event_timer_id timer) noexcept { return timers_.cancel(timer); }
+
+    // Post every timed event due at now_ms (os::time_ms scale); returns the number fired
+    size_t advance_timers(timestamp_t now_ms) noexcept {
+        return timers_.advance(now_ms, [this](const Event& evt) { (void)post(evt); });
+    }
+
+    [[nodiscard]] timestamp_t next_timer_due() const noexcept { return timers_.next_due(); }
+    [[nodiscard]] size_t active_timers() const noexcept { return timers_.active(); }
+
     // Convenience builders
     bool post(category cat, code_t code, severity lvl = severity::info, flags flg = flags::none) noexcept {
         Event evt = Event::make(cat, code, lvl, flg); evt.ts = 0; return post(evt);
     }
 
-    // Process up to max events
+    // Process up to max events, most severe first (lanes are re-checked after every event)
     size_t process(size_t max_events = static_cast<size_t>(-1)) noexcept {
         if (!initialized_) { return 0; }
         size_t count = 0;
-        while (!queue_.empty() && count < max_events) {
-            Event evt = queue_.front();
-            queue_.pop_front();
+        Event evt;
+        while (count < max_events && pop_next(evt)) {
+            settle(evt);
             dispatch(evt);
             ++count;
         }
         return count;
     }
 
-    // Dispatch immediately to all matching handlers
+    // Dispatch immediately to all matching handlers: exact, code wildcard, then category wildcard
     void dispatch(const Event& evt) noexcept {
-        for (const auto& hnd : handlers_) {
-            if (!hnd.active) { continue; }
-            const bool cat_match = (hnd.ident.cat == category::any) || (hnd.ident.cat == evt.ident.cat);
-            const bool code_match = (hnd.ident.code == 0xFFFFU) || (hnd.ident.code == evt.ident.code);
-            if (cat_match && code_match) {
-                hnd.fn(evt);
-            }
+        ++dispatch_depth_;
+        const size_t bucket = bucket_of(evt.ident.cat);
+        dispatch_bucket(bucket, evt, bucket == other_bucket);
+        if (bucket != wildcard_bucket) {
+            dispatch_bucket(wildcard_bucket, evt, false);  // category::any events already walked it
         }
+        if (--dispatch_depth_ == 0U && dirty_) { reindex(); }
     }
 
     // Introspection helpers
-    [[nodiscard]] size_t pending() const noexcept { return queue_.size(); }
+    [[nodiscard]] size_t pending() const noexcept {
+        size_t cnt = 0;
+        for (const auto& lane : lanes_) { cnt += lane.size(); }
+        return cnt;
+    }
+    [[nodiscard]] size_t pending(severity lvl) const noexcept { return lanes_[lane_of(lvl)].size(); }
+    // Posts refused because the lane was full
+    [[nodiscard]] u32 dropped(severity lvl) const noexcept {
+        return dropped_[lane_of(lvl)].load(etl::memory_order_relaxed);
+    }
+    // Posts of ident refused by its rate limit
+    [[nodiscard]] u32 rate_limited(id ident) const noexcept {
+        const flow_rule* rule = find_rule(ident);
+        return (rule != nullptr) ? rule->limited.load(etl::memory_order_relaxed) : 0U;
+    }
+    // Posts of ident folded into an already queued event
+    [[nodiscard]] u32 coalesced(id ident) const noexcept {
+        const flow_rule* rule = find_rule(ident);
+        return (rule != nullptr) ? rule->merged.load(etl::memory_order_relaxed) : 0U;
+    }
     [[nodiscard]] size_t active_handlers() const noexcept {
         size_t cnt = 0;
         for (const auto& hnd : handlers_) { if (hnd.active) { ++cnt; } }
         return cnt;
     }
+
+private:
+    static size_t lane_of(severity lvl) noexcept {
+        const size_t lane = static_cast<u8>(lvl);
+        return (lane < lane_count) ? lane : lane_count - 1U;
+    }
+
+    bool pop_next(Event& out) noexcept {
+        for (size_t lane = lane_count; lane-- > 0U;) {
+            if (lanes_[lane].try_pop(out)) { return true; }
+        }
+        return false;
+    }
+
+    // Index of the rule for ident; max_rules when there is none
+    size_t rule_index(id ident) const noexcept {
+        const u32 n = rule_count_.load(etl::memory_order_acquire);
+        for (u32 i = 0; i < n; ++i) {
+            if (rules_[i].ident.cat == ident.cat && rules_[i].ident.code == ident.code) { return i; }
+        }
+        return max_rules;
+    }
+    flow_rule* find_rule(id ident) noexcept {
+        const size_t i = rule_index(ident);
+        return (i < max_rules) ? &rules_[i] : nullptr;
+    }
+    const flow_rule* find_rule(id ident) const noexcept {
+        const size_t i = rule_index(ident);
+        return (i < max_rules) ? &rules_[i] : nullptr;
+    }
+
+    flow_rule* rule_slot(id ident) noexcept {
+        flow_rule* rule = find_rule(ident);
+        const u32 n = rule_count_.load(etl::memory_order_relaxed);
+        if (rule != nullptr || n >= max_rules) { return rule; }
+        rules_[n].ident = ident;
+        rule_count_.store(n + 1U, etl::memory_order_release);
+        return &rules_[n];
+    }
+
+    // Token bucket as GCRA: admit if the theoretical arrival time is at most tolerance ahead of now
+    static bool admit(flow_rule& rule) noexcept {
+        if (rule.interval_us == 0U) { return true; }
+        const u32 now = static_cast<u32>(os::time_us());
+        u32 tat = rule.tat.load(etl::memory_order_relaxed);
+        for (;;) {
+            // A stored TAT is never more than tolerance + interval ahead; anything else is stale or wrapped
+            const i32 ahead = static_cast<i32>(tat - now);
+            const u32 base = (ahead < 0 || static_cast<u32>(ahead) > rule.tolerance_us + rule.interval_us) ? now : tat;
+            if (base - now > rule.tolerance_us) { return false; }
+            if (rule.tat.compare_exchange_weak(tat, base + rule.interval_us, etl::memory_order_relaxed)) { return true; }
+        }
+    }
+
+    // true if an event for this rule is already queued (the post is folded into it)
+    static bool fold(flow_rule& rule) noexcept {
+        u32 state = rule.state.load(etl::memory_order_relaxed);
+        for (;;) {
+            const bool queued = (state & queued_bit) != 0U;
+            const u32 next = queued ? state + ((state & ~queued_bit) != ~queued_bit ? 1U : 0U) : queued_bit;
+            if (rule.state.compare_exchange_weak(state, next, etl::memory_order_acq_rel, etl::memory_order_relaxed)) {
+                if (queued) { rule.merged.fetch_add(1U, etl::memory_order_relaxed); }
+                return queued;
+            }
+        }
+    }
+
+    // Consumer side: close the coalescing window of a dequeued event and stamp its count
+    void settle(Event& evt) noexcept {
+        if (rule_count_.load(etl::memory_order_relaxed) == 0U) { return; }
+        flow_rule* rule = find_rule(evt.ident);
+        if (rule == nullptr || !rule->coalesce) { return; }
+        const u32 folded = rule->state.exchange(0U, etl::memory_order_acq_rel) & ~queued_bit;
+        if (folded != 0U) {
+            evt.count = folded + 1U;
+            evt.attr = evt.attr | flags::aggregated;
+        }
+    }
+
+    static size_t bucket_of(category cat) noexcept {
+        if (cat == category::any) { return wildcard_bucket; }
+        const size_t value = static_cast<u8>(cat);
+        return (value < named_buckets) ? value : other_bucket;
+    }
+
+    static bool key_less(const handler_registration& lhs, const handler_registration& rhs) noexcept {
+        const size_t lb = bucket_of(lhs.ident.cat);
+        const size_t rb = bucket_of(rhs.ident.cat);
+        return (lb != rb) ? (lb < rb) : (lhs.ident.code < rhs.ident.code);
+    }
+
+    // First index in [first, last) whose code is >= code
+    size_t lower_bound(size_t first, size_t last, code_t code) const noexcept {
+        while (first < last) {
+            const size_t mid = first + ((last - first) / 2U);
+            if (handlers_[mid].ident.code < code) { first = mid + 1U; } else { last = mid; }
+        }
+        return first;
+    }
+
+    // The wildcard code sorts last, so a bucket is [exact codes ..., any_code ...]
+    void dispatch_bucket(size_t bucket, const Event& evt, bool check_cat) const noexcept {
+        const size_t begin = bucket_begin_[bucket];
+        const size_t end = bucket_begin_[bucket + 1U];
+        const size_t wild = lower_bound(begin, end, any_code);
+        if (evt.ident.code != any_code) {
+            for (size_t i = lower_bound(begin, wild, evt.ident.code); i < wild && handlers_[i].ident.code == evt.ident.code; ++i) {
+                invoke(handlers_[i], evt, check_cat);
+            }
+        }
+        for (size_t i = wild; i < end; ++i) { invoke(handlers_[i], evt, check_cat); }
+    }
+
+    static void invoke(const handler_registration& hnd, const Event& evt, bool check_cat) noexcept {
+        if (hnd.active && (!check_cat || hnd.ident.cat == evt.ident.cat)) { hnd.fn(evt); }
+    }
+
+    void changed() noexcept {
+        if (dispatch_depth_ != 0U) { dirty_ = true; return; }
+        reindex();
+    }
+
+    // Drop inactive entries, stable-sort by key (insertion sort: the table is almost sorted) and rebuild offsets
+    void reindex() noexcept {
+        size_t live = 0;
+        for (size_t i = 0; i < handlers_.size(); ++i) {
+            if (handlers_[i].active) {
+                if (live != i) { handlers_[live] = handlers_[i]; }
+                ++live;
+            }
+        }
+        while (handlers_.size() > live) { handlers_.pop_back(); }
+
+        for (size_t i = 1; i < handlers_.size(); ++i) {
+            const handler_registration moving = handlers_[i];
+            size_t j = i;
+            for (; j > 0U && key_less(moving, handlers_[j - 1U]); --j) { handlers_[j] = handlers_[j - 1U]; }
+            handlers_[j] = moving;
+        }
+
+        size_t idx = 0;
+        for (size_t b = 0; b < bucket_count; ++b) {
+            bucket_begin_[b] = static_cast<u8>(idx);
+            while (idx < handlers_.size() && bucket_of(handlers_[idx].ident.cat) == b) { ++idx; }
+        }
+        bucket_begin_[bucket_count] = static_cast<u8>(idx);
+        dirty_ = false;
+    }
 };
 
 } // namespace emCore::events
@@ -0,0 +1,93 @@
+#pragma once
+
+// Name -> id tables for generated event catalogs (scripts/generate_event_config.py).
+// The generator picks a seed that makes name_hash() collision-free over the
+// table, so a lookup is one hash of the name, one slot and one compare, and
+// it is constexpr: named ids in source resolve at compile time.
+
+#include <cstddef>
+
+#include "../core/types.hpp"
+#include "event_types.hpp"
+
+#include <etl/array.h>
+
+namespace emCore::events {
+
+inline constexpr u32 name_hash_prime = 16777619U;
+
+constexpr u32 name_hash_step(u32 h, u8 byte) noexcept { return (h ^ byte) * name_hash_prime; }
+
+// FNV-1a from basis over a NUL-terminated name, or its first len bytes
+constexpr u32 name_hash(const char* name, u32 basis) noexcept {
+    u32 h = basis;
+    for (; *name != '\0'; ++name) { h = name_hash_step(h, static_cast<u8>(*name)); }
+    return h;
+}
+constexpr u32 name_hash(const char* name, size_t len, u32 basis) noexcept {
+    u32 h = basis;
+    for (size_t i = 0; i < len; ++i) { h = name_hash_step(h, static_cast<u8>(name[i])); }
+    return h;
+}
+
+// stored (NUL-terminated) equals the len bytes at name
+constexpr bool name_equal(const char* stored, const char* name, size_t len) noexcept {
+    for (size_t i = 0; i < len; ++i) {
+        if (stored[i] != name[i] || stored[i] == '\0') { return false; }
+    }
+    return stored[len] == '\0';
+}
+constexpr size_t name_length(const char* name) noexcept {
+    size_t len = 0;
+    while (name[len] != '\0') { ++len; }
+    return len;
+}
+
+struct name_slot {
+    const char* name{nullptr};  // nullptr = empty slot
+    u8 scope{0};                // owning category value for codes, 0 for categories
+    u16 value{0};
+};
+
+/**
+ * @brief Perfect-hash table of names; Slots is a power of two
+ *
+ * Slot of a name = name_hash(name, basis(scope)) & (Slots - 1), where the
+ * basis folds the seed and the scope byte, so codes of different categories
+ * share one table.
+ */
+template <size_t Slots>
+struct name_table {
+    static_assert(Slots >= 1 && (Slots & (Slots - 1U)) == 0, "name_table slots must be a power of two");
+
+    u32 seed;
+    etl::array<name_slot, Slots> slots;
+
+    [[nodiscard]] constexpr u32 basis(u8 scope) const noexcept { return name_hash_step(seed, scope); }
+
+    [[nodiscard]] constexpr const name_slot* find(u8 scope, const char* name, size_t len) const noexcept {
+        const name_slot& slot = slots[name_hash(name, len, basis(scope)) & (Slots - 1U)];
+        return (slot.name != nullptr && slot.scope == scope && name_equal(slot.name, name, len)) ? &slot : nullptr;
+    }
+    [[nodiscard]] constexpr const name_slot* find(u8 scope, const char* name) const noexcept {
+        return find(scope, name, name_length(name));
+    }
+};
+
+// id packed into 24 bits (category << 16 | code); invalid_packed_id when a name is unknown
+inline constexpr u32 invalid_packed_id = 0xFFFFFFFFU;
+constexpr u32 pack_id(id ident) noexcept {
+    return (static_cast<u32>(static_cast<u8>(ident.cat)) << 16U) | ident.code;
+}
+constexpr id unpack_id(u32 packed) noexcept {
+    return id{static_cast<category>(static_cast<u8>(packed >> 16U)), static_cast<code_t>(packed & 0xFFFFU)};
+}
+
+// Compile-time checked name: instantiating it with an unknown name fails the build
+template <u32 Packed>
+struct checked_id {
+    static_assert(Packed != invalid_packed_id, "unknown event category or code name");
+    static constexpr id value = unpack_id(Packed);
+};
+
+}  // namespace emCore::events
@@ -7,6 +7,7 @@
 #include "event_bus.hpp"
 #include "event_types.hpp"
 #include "events_global.hpp"
+#include "event_names.hpp"
 
 #if defined(__has_include)
   #if __has_include(<emCore/generated/event_config.hpp>)
@@ -34,22 +35,50 @@ inline bool post(category cat, code_t code, severity level = severity::info, fla
 
 #if EMCORE_EVENT_CONFIG_AVAILABLE
 // Optional name-based posting if a generated catalog exists
-// The generated header should define:
-//   bool lookup_category(const char* name, category& out);
-//   bool lookup_code(category cat, const char* name, code_t& out);
+// The generated header (scripts/generate_event_config.py) defines constexpr
+// perfect-hash lookups, with and without an explicit length:
+//   bool lookup_category(const char* name, [size_t len,] category& out);
+//   bool lookup_code(category cat, const char* name, [size_t len,] code_t& out);
+
+// Packed id of a category/code name pair; invalid_packed_id if either is unknown
+constexpr u32 resolve_packed(const char* cat_name, const char* code_name) noexcept { // NOLINT(bugprone-easily-swappable-parameters)
+    category cat{}; code_t code{};
+    if (!::emCore::events::gen::lookup_category(cat_name, cat)) { return invalid_packed_id; }
+    if (!::emCore::events::gen::lookup_code(cat, code_name, code)) { return invalid_packed_id; }
+    return pack_id(id{cat, code});
+}
+
 inline bool post_named(const char* cat_name, const char* code_name, // NOLINT(bugprone-easily-swappable-parameters)
                        severity lvl = severity::info, flags flag_bits = flags::none) noexcept {
+    const u32 packed = resolve_packed(cat_name, code_name);
+    if (packed == invalid_packed_id) { return false; }
+    const id ident = unpack_id(packed);
+    return post(ident.cat, ident.code, lvl, flag_bits);
+}
+
+// Names that are not NUL-terminated (e.g. fields of a host protocol packet)
+inline bool post_named(const char* cat_name, size_t cat_len, const char* code_name, size_t code_len,
+                       severity lvl = severity::info, flags flag_bits = flags::none) noexcept {
     category cat{}; code_t code{};
-    if (!::emCore::events::gen::lookup_category(cat_name, cat)) { return false; }
-    if (!::emCore::events::gen::lookup_code(cat, code_name, code)) { return false; }
+    if (!::emCore::events::gen::lookup_category(cat_name, cat_len, cat)) { return false; }
+    if (!::emCore::events::gen::lookup_code(cat, code_name, code_len, code)) { return false; }
     return post(cat, code, lvl, flag_bits);
 }
+
+// Compile-time id from names; an unknown name is a build error
+#define EMCORE_EVENT_ID(cat_name, code_name) \
+    (::emCore::events::checked_id<::emCore::events::runtime::resolve_packed(cat_name, code_name)>::value)
 #else
 inline bool post_named(const char* cat_name, const char* code_name, // NOLINT(bugprone-easily-swappable-parameters)
                        severity lvl = severity::info, flags flag_bits = flags::none) noexcept {
     (void)cat_name; (void)code_name; (void)lvl; (void)flag_bits;
     return false;
 }
+inline bool post_named(const char* cat_name, size_t cat_len, const char* code_name, size_t code_len,
+                       severity lvl = severity::info, flags flag_bits = flags::none) noexcept {
+    (void)cat_name; (void)cat_len; (void)code_name; (void)code_len; (void)lvl; (void)flag_bits;
+    return false;
+}
 #endif
 
 } // namespace emCore::events::runtime
@@ -0,0 +1,300 @@
+#pragma once
+
+#include <cstddef>
+
+#include "../core/types.hpp"
+#include "../core/config.hpp"
+#include "../os/sync.hpp"
+#include "../utils/helpers.hpp"
+#include "event.hpp"
+
+#include <etl/algorithm.h>
+#include <etl/array.h>
+
+namespace emCore::events {
+
+// Handle returned by post_after / post_every; 0 never names a timer
+using event_timer_id = u32;
+inline constexpr event_timer_id invalid_timer = 0;
+
+/**
+ * @brief Two-level hashed timer wheel holding events to post later
+ *
+ * Level 0 has one slot per tick for the next 64 ticks, level 1 one slot per
+ * 64-tick block for the next 64 blocks; at each block boundary the level-1
+ * slot of that block is cascaded into level 0. Longer delays park in the
+ * farthest level-1 slot and are re-placed when it cascades. Inserting and
+ * cancelling touch one slot list, and advance() skips empty stretches a block
+ * at a time, so the cost follows the number of timers rather than elapsed
+ * ticks. Lists are guarded by a critical section; the fire callback runs
+ * outside it and may start or cancel timers.
+ */
+template <size_t MaxTimers>
+class event_timer_wheel {
+public:
+    static_assert(MaxTimers >= 1 && MaxTimers < 0xFFFF, "event_timer_wheel supports 1..65534 timers");
+    static constexpr timestamp_t never = static_cast<timestamp_t>(-1);
+
+    event_timer_wheel() noexcept {
+        heads_.fill(npos);
+        for (size_t i = 0; i < MaxTimers; ++i) {
+            timers_[i].next = (i + 1U < MaxTimers) ? static_cast<u16>(i + 1U) : npos;
+        }
+        free_ = 0;
+    }
+    event_timer_wheel(const event_timer_wheel&) = delete;
+    event_timer_wheel& operator=(const event_timer_wheel&) = delete;
+    event_timer_wheel(event_timer_wheel&&) = delete;
+    event_timer_wheel& operator=(event_timer_wheel&&) = delete;
+    ~event_timer_wheel() = default;
+
+    // Queue evt for now_ms + delay_ms, then every period_ms if non-zero; invalid_timer when full
+    event_timer_id start(const Event& evt, timestamp_t now_ms, duration_t delay_ms, duration_t period_ms) noexcept {
+        cs_.enter();
+        if (free_ == npos) {
+            cs_.exit();
+            return invalid_timer;
+        }
+        const u16 idx = free_;
+        timer& t = timers_[idx];
+        free_ = t.next;
+        if (active_ == 0U) {
+            processed_tick_ = etl::max(processed_tick_, now_ms >> tick_shift);  // idle wheel: skip the gap
+        }
+        ++active_;
+        t.evt = evt;
+        // Never early: a delay straddling a tick boundary rounds up
+        t.deadline_tick = (now_ms + delay_ms + tick_ms - 1U) >> tick_shift;
+        t.period_ticks = (period_ms == 0U) ? 0U : etl::max<u32>((period_ms + tick_ms - 1U) >> tick_shift, 1U);
+        link(idx);
+        const event_timer_id id = handle(idx);
+        cs_.exit();
+        return id;
+    }
+
+    bool cancel(event_timer_id id) noexcept {
+        const u32 slot = id & 0xFFFFU;
+        if (slot == 0U || slot > MaxTimers) {
+            return false;
+        }
+        const u16 idx = static_cast<u16>(slot - 1U);
+        cs_.enter();
+        const bool live = timers_[idx].list != no_list && handle(idx) == id;
+        if (live) {
+            unlink(idx);
+            release(idx);
+        }
+        cs_.exit();
+        return live;
+    }
+
+    /*
+     * Move the wheel up to now_ms and hand each due event to fire(const Event&).
+     * Periodic timers are re-armed from their previous deadline, skipping
+     * periods that were missed entirely. Returns the number of events fired.
+     */
+    template <typename Fn>
+    size_t advance(timestamp_t now_ms, Fn&& fire) noexcept {
+        const u64 target = now_ms >> tick_shift;
+        cs_.enter();
+        if (active_ == 0U) {
+            processed_tick_ = etl::max(processed_tick_, target);
+        }
+        while (processed_tick_ < target) {
+            u64 tick = processed_tick_ + 1U;
+            if ((tick & slot_mask) != 0U && level0_count_ == 0U) {
+                tick = etl::min<u64>((tick | slot_mask) + 1U, target);  // nothing this block: jump to its end
+            }
+            if ((tick & slot_mask) == 0U) {
+                processed_tick_ = tick - 1U;
+                cascade(level1 + static_cast<size_t>((tick >> slot_bits) & slot_mask));
+            }
+            collect(static_cast<size_t>(tick & slot_mask), tick);
+            processed_tick_ = tick;
+        }
+        cs_.exit();
+
+        size_t fired = 0;
+        Event evt;
+        while (pop_due(evt)) {
+            fire(static_cast<const Event&>(evt));
+            ++fired;
+        }
+        return fired;
+    }
+
+    // Earliest time advance() has work (a level-1 cascade counts); never when idle
+    [[nodiscard]] timestamp_t next_due() const noexcept {
+        cs_.enter();
+        timestamp_t due = never;
+        if (heads_[due_list] != npos) {
+            due = processed_tick_ << tick_shift;
+        } else if (level0_count_ != 0U) {
+            for (u64 tick = processed_tick_ + 1U; tick <= processed_tick_ + slots && due == never; ++tick) {
+                for (u16 i = heads_[static_cast<size_t>(tick & slot_mask)]; i != npos; i = timers_[i].next) {
+                    if (timers_[i].deadline_tick == tick) {
+                        due = tick << tick_shift;
+                        break;
+                    }
+                }
+            }
+        }
+        if (due == never && active_ != 0U) {
+            const u64 block = processed_tick_ >> slot_bits;
+            for (u64 b = block + 1U; b <= block + slots; ++b) {
+                if (heads_[level1 + static_cast<size_t>(b & slot_mask)] != npos) {
+                    due = (b << slot_bits) << tick_shift;
+                    break;
+                }
+            }
+        }
+        cs_.exit();
+        return due;
+    }
+
+    [[nodiscard]] size_t active() const noexcept { return active_; }
+    static constexpr size_t capacity() noexcept { return MaxTimers; }
+
+private:
+    static constexpr u8 slot_bits = 6;
+    static constexpr size_t slots = size_t{1} << slot_bits;
+    static constexpr u64 slot_mask = slots - 1U;
+    static constexpr size_t level1 = slots;          // heads_[slots .. 2 * slots) are level 1
+    static constexpr size_t due_list = 2U * slots;   // fired but not yet handed to the callback
+    static constexpr u8 no_list = 0xFF;
+    static constexpr u16 npos = 0xFFFF;
+    static constexpr u64 tick_ms = config::event_timer_tick_ms;
+    static constexpr u8 tick_shift = utils::highest_set_bit(static_cast<u32>(config::event_timer_tick_ms));
+
+    struct timer {
+        Event evt{};
+        u64 deadline_tick{0};
+        u32 period_ticks{0};
+        u16 next{npos};
+        u16 generation{0};
+        u8 list{no_list};
+    };
+
+    event_timer_id handle(u16 idx) const noexcept {
+        return (static_cast<u32>(timers_[idx].generation) << 16U) | (static_cast<u32>(idx) + 1U);
+    }
+
+    void push(size_t list, u16 idx) noexcept {
+        timers_[idx].list = static_cast<u8>(list);
+        timers_[idx].next = heads_[list];
+        heads_[list] = idx;
+        if (list < level1) { ++level0_count_; }
+    }
+
+    // The due list is FIFO so events fire in deadline order
+    void append_due(u16 idx) noexcept {
+        timers_[idx].list = static_cast<u8>(due_list);
+        timers_[idx].next = npos;
+        if (heads_[due_list] == npos) {
+            heads_[due_list] = idx;
+        } else {
+            timers_[due_tail_].next = idx;
+        }
+        due_tail_ = idx;
+    }
+
+    void unlink(u16 idx) noexcept {
+        const size_t list = timers_[idx].list;
+        u16 prev = npos;
+        for (u16* cur = &heads_[list]; *cur != npos; prev = *cur, cur = &timers_[*cur].next) {
+            if (*cur == idx) {
+                *cur = timers_[idx].next;
+                break;
+            }
+        }
+        if (list == due_list && due_tail_ == idx) { due_tail_ = prev; }
+        timers_[idx].list = no_list;
+        if (list < level1) { --level0_count_; }
+    }
+
+    void release(u16 idx) noexcept {
+        timer& t = timers_[idx];
+        t.evt = Event{};
+        ++t.generation;
+        t.next = free_;
+        free_ = idx;
+        --active_;
+    }
+
+    // Place a timer by its deadline relative to processed_tick_
+    void link(u16 idx) noexcept {
+        timer& t = timers_[idx];
+        if (t.deadline_tick <= processed_tick_) {
+            t.deadline_tick = processed_tick_ + 1U;
+        }
+        const u64 block = processed_tick_ >> slot_bits;
+        if (t.deadline_tick - processed_tick_ <= slots) {
+            push(static_cast<size_t>(t.deadline_tick & slot_mask), idx);
+        } else if ((t.deadline_tick >> slot_bits) - block < slots) {
+            push(level1 + static_cast<size_t>((t.deadline_tick >> slot_bits) & slot_mask), idx);
+        } else {
+            push(level1 + static_cast<size_t>((block + slots - 1U) & slot_mask), idx);  // re-placed on cascade
+        }
+    }
+
+    void cascade(size_t list) noexcept {
+        u16 idx = heads_[list];
+        heads_[list] = npos;
+        while (idx != npos) {
+            const u16 next = timers_[idx].next;
+            link(idx);
+            idx = next;
+        }
+    }
+
+    // Move the timers of level-0 slot `slot` that expire at tick onto the due list
+    void collect(size_t slot, u64 tick) noexcept {
+        u16* cur = &heads_[slot];
+        while (*cur != npos) {
+            const u16 idx = *cur;
+            if (timers_[idx].deadline_tick <= tick) {
+                *cur = timers_[idx].next;
+                --level0_count_;
+                append_due(idx);
+            } else {
+                cur = &timers_[idx].next;
+            }
+        }
+    }
+
+    bool pop_due(Event& out) noexcept {
+        cs_.enter();
+        const u16 idx = heads_[due_list];
+        if (idx == npos) {
+            cs_.exit();
+            return false;
+        }
+        timer& t = timers_[idx];
+        heads_[due_list] = t.next;
+        t.list = no_list;
+        out = t.evt;
+        if (t.period_ticks != 0U) {
+            t.deadline_tick += t.period_ticks;
+            if (t.deadline_tick <= processed_tick_) {
+                const u64 behind = processed_tick_ - t.deadline_tick;
+                t.deadline_tick += (behind / t.period_ticks + 1U) * t.period_ticks;
+            }
+            link(idx);
+        } else {
+            release(idx);
+        }
+        cs_.exit();
+        return true;
+    }
+
+    etl::array<timer, MaxTimers> timers_{};
+    etl::array<u16, (2U * slots) + 1U> heads_{};
+    u64 processed_tick_{0};
+    size_t active_{0};
+    size_t level0_count_{0};
+    u16 free_{npos};
+    u16 due_tail_{npos};
+    mutable os::critical_section cs_;
+};
+
+}  // namespace emCore::events
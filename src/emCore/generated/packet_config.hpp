@@ -1,6 +1,7 @@
 #pragma once
 
 #include <emCore/protocol/packet_parser.hpp>
+#include <emCore/protocol/field_codec.hpp>
 
 #ifndef EMCORE_GENERATED_PACKET_CONFIG_HPP
 #define EMCORE_GENERATED_PACKET_CONFIG_HPP
@@ -31,6 +32,7 @@ using PacketT = packet<PACKET_MAX_PAYLOAD>;
 using ParserT = packet_parser<PACKET_MAX_PAYLOAD, PACKET_SYNC_LEN, PACKET_LENGTH_16BIT, PACKET_SYNC>;
 template <size_t MaxHandlers>
 using DispatcherT = command_dispatcher<MaxHandlers, PacketT>;
+using IndexedDispatcherT = indexed_command_dispatcher<OPCODE_SPACE, PacketT>;
 
 static_assert(OPCODE_SPACE >= 5, "OPCODE_SPACE must be >= max(opcodes)+1");
 
@@ -49,6 +49,8 @@ constexpr std::size_t kMsgMaxSubsPerTopic        = ::emCore::config::default_max
 constexpr std::size_t kMsgQueuesPerMailbox       = ::emCore::config::default_max_topic_queues_per_mailbox;
 constexpr std::size_t kMsgOverheadBytes          = ::emCore::config::msg_overhead_bytes;
 constexpr std::size_t kEventHandlerCap           = ::emCore::config::max_event_handlers;
+constexpr std::size_t kEventLaneCapacity         = ::emCore::config::event_lane_capacity;
+constexpr std::size_t kEventLanes                = static_cast<std::size_t>(::emCore::events::severity::critical) + 1U;
 constexpr std::size_t kTaskMemBytes              = ::emCore::config::task_mem_bytes;
 constexpr std::size_t kOsMemBytes                = ::emCore::config::os_mem_bytes;
 constexpr std::size_t kProtocolMemBytes          = ::emCore::config::protocol_mem_bytes;
@@ -57,21 +59,35 @@ constexpr std::size_t kDiagnosticsMemBytes       = ::emCore::config::diagnostics
 // -------- Conservative upper-bounds for subsystem memory footprints --------
 // Messaging broker: For each task mailbox, we bound memory by total per-mailbox
 // queue capacity times message size. This safely upper-bounds high+normal shards.
-inline constexpr std::size_t per_mailbox_bytes = kMsgQueueCapacity * sizeof(message_t);
+// With the shared-store policy (3) a mailbox only queues u16 indices (high and normal
+// FIFOs) and the envelopes live once in the broker's store, sized for messages in flight.
+inline constexpr bool kMsgSharedStore = (::emCore::config::default_mailbox_policy == 3U);
+inline constexpr std::size_t kMsgSharedStoreCapacity = ::emCore::config::default_shared_store_capacity;
+inline constexpr std::size_t per_mailbox_bytes =
+    kMsgSharedStore ? (2U * kMsgQueueCapacity * sizeof(unsigned short)) : (kMsgQueueCapacity * sizeof(message_t));
+inline constexpr std::size_t messaging_store_bytes =
+    kMsgSharedStore ? (kMsgSharedStoreCapacity * (sizeof(message_t) + 8U)) : 0U;
 // Add a small fixed overhead per per-mailbox topic queue entry for bookkeeping.
 inline constexpr std::size_t per_mailbox_topic_overhead = kMsgQueuesPerMailbox * 32U;
 inline constexpr std::size_t messaging_mailboxes_bytes = kMaxTasks * (per_mailbox_bytes + per_mailbox_topic_overhead);
 // Add global broker tables overhead (topics/subscribers registries, indices, etc.)
 inline constexpr std::size_t messaging_global_overhead_bytes = kMsgOverheadBytes;
 inline constexpr std::size_t messaging_total_upper =
-    (::emCore::config::enable_messaging ? (messaging_mailboxes_bytes + messaging_global_overhead_bytes) : 0U);
+    (::emCore::config::enable_messaging ? (messaging_mailboxes_bytes + messaging_global_overhead_bytes + messaging_store_bytes) : 0U);
 
 // Events: queue + handlers
+// One MPSC ring per severity lane (sequence word + event per cell)
 inline constexpr std::size_t event_queue_bytes   =
-    (::emCore::config::enable_events ? (kMaxEvents * sizeof(event_t)) : 0U);
+    (::emCore::config::enable_events
+         ? (kEventLanes * kEventLaneCapacity * (sizeof(event_t) + sizeof(::emCore::u32))) : 0U);
 inline constexpr std::size_t event_handlers_bytes =
     (::emCore::config::enable_events ? (kEventHandlerCap * sizeof(handler_registration_t)) : 0U);
-inline constexpr std::size_t events_total_upper  = event_queue_bytes + event_handlers_bytes;
+// Flow rules, the timer wheel and the dispatch index live in the bus object itself
+inline constexpr std::size_t events_total_upper  =
+    (::emCore::config::enable_events
+         ? ((sizeof(::emCore::events::event_bus) > event_queue_bytes + event_handlers_bytes)
+                ? sizeof(::emCore::events::event_bus) : event_queue_bytes + event_handlers_bytes)
+         : 0U);
 
 // Tasks/OS/Protocol/Diagnostics reserved blocks
 // Compute a compile-time minimum for the tasks region without including taskmaster.hpp (avoid cycles).
@@ -91,8 +107,8 @@ static_assert(!::emCore::config::enable_tasks_region || (kTaskMemBytesEffective
 inline constexpr std::size_t os_total_upper          = (::emCore::config::enable_os_region ? kOsMemBytes : 0U);
 
 // Compute a conservative minimum for protocol region based on config knobs only.
-inline constexpr std::size_t kProtoRingBytes      = ::emCore::config::protocol_ring_size;
-inline constexpr std::size_t kProtoPacketsBytes   = ::emCore::config::protocol_packet_size * 4U; // staging
+inline constexpr std::size_t kProtoRingBytes      = ::emCore::config::protocol_ring_size * ::emCore::config::protocol_channels;
+inline constexpr std::size_t kProtoPacketsBytes   = ::emCore::config::protocol_packet_size * 4U * ::emCore::config::protocol_channels; // staging
 inline constexpr std::size_t kProtoHandlersBytes  = ::emCore::config::protocol_max_handlers * 64U; // dispatch tables
 inline constexpr std::size_t kProtoFixedOverhead  = 1024U; // parsers/encoders/pipeline bookkeeping
 inline constexpr std::size_t kProtocolMemBytesMin = kProtoRingBytes + kProtoPacketsBytes + kProtoHandlersBytes + kProtoFixedOverhead;
@@ -110,9 +126,68 @@ inline constexpr std::size_t pools_medium_bytes = ::emCore::config::medium_block
 inline constexpr std::size_t pools_large_bytes  = ::emCore::config::large_block_size  * ::emCore::config::large_pool_count;
 inline constexpr std::size_t pools_total_upper  = (::emCore::config::enable_pools_region ? (pools_small_bytes + pools_medium_bytes + pools_large_bytes) : 0U);
 
+// Slab allocator region (memory/slab_allocator.hpp)
+inline constexpr std::size_t slabs_total_upper = (::emCore::config::enable_slab_allocator ? ::emCore::config::slab_alloc_bytes : 0U);
+
+// Scratch arenas: one slot per cooperative worker plus the native-task slots
+inline constexpr std::size_t scratch_total_upper =
+    (::emCore::config::enable_scratch_arena
+         ? ::emCore::config::scratch_arena_bytes * (::emCore::config::task_workers + ::emCore::config::scratch_native_slots)
+         : 0U);
+
+// -------- Region placement (memory class + start alignment) --------
+enum class memory_class : unsigned char {
+    internal = EMCORE_MEM_INTERNAL,  // default SRAM
+    fast     = EMCORE_MEM_FAST,      // DTCM / internal DRAM pinned for hot state
+    external = EMCORE_MEM_EXTERNAL   // PSRAM / external SDRAM
+};
+inline constexpr std::size_t memory_class_count = 3;
+
+constexpr const char* memory_class_name(memory_class cls) noexcept {
+    return (cls == memory_class::fast) ? "fast" : (cls == memory_class::external) ? "external" : "internal";
+}
+
+enum class region_id : unsigned char { messaging, events, tasks, os, protocol, diagnostics, slabs, scratch };
+inline constexpr std::size_t region_count = 8;
+
+struct region_placement {
+    const char* name;
+    std::size_t bytes;
+    memory_class cls;
+    std::size_t align;
+};
+
+namespace detail {
+constexpr region_placement placement(const char* name, std::size_t bytes, int cls, int cache_align) noexcept {
+    return region_placement{ name, bytes, static_cast<memory_class>(cls),
+                             (cache_align != 0) ? ::emCore::config::cache_line_bytes : std::size_t{8} };
+}
+} // namespace detail
+
+// Indexed by region_id
+inline constexpr region_placement region_placements[region_count] = {
+    detail::placement("messaging",   messaging_total_upper,   EMCORE_MESSAGING_MEM_CLASS,   EMCORE_MESSAGING_CACHE_ALIGN),
+    detail::placement("events",      events_total_upper,      EMCORE_EVENTS_MEM_CLASS,      EMCORE_EVENTS_CACHE_ALIGN),
+    detail::placement("tasks",       tasks_total_upper,       EMCORE_TASKS_MEM_CLASS,       EMCORE_TASKS_CACHE_ALIGN),
+    detail::placement("os",          os_total_upper,          EMCORE_OS_MEM_CLASS,          EMCORE_OS_CACHE_ALIGN),
+    detail::placement("protocol",    protocol_total_upper,    EMCORE_PROTOCOL_MEM_CLASS,    EMCORE_PROTOCOL_CACHE_ALIGN),
+    detail::placement("diagnostics", diagnostics_total_upper, EMCORE_DIAGNOSTICS_MEM_CLASS, EMCORE_DIAGNOSTICS_CACHE_ALIGN),
+    detail::placement("slabs",       slabs_total_upper,       EMCORE_SLABS_MEM_CLASS,       EMCORE_SLABS_CACHE_ALIGN),
+    detail::placement("scratch",     scratch_total_upper,     EMCORE_SCRATCH_MEM_CLASS,     EMCORE_SCRATCH_CACHE_ALIGN),
+};
+
+constexpr bool placements_valid() noexcept {
+    for (const auto& p : region_placements) {
+        if (static_cast<std::size_t>(p.cls) >= memory_class_count) { return false; }
+    }
+    return true;
+}
+static_assert(placements_valid(), "EMCORE_*_MEM_CLASS must be EMCORE_MEM_INTERNAL, EMCORE_MEM_FAST or EMCORE_MEM_EXTERNAL");
+
 // Sum all uppers
 inline constexpr std::size_t total_required_upper =
-    messaging_total_upper + events_total_upper + tasks_total_upper + os_total_upper + protocol_total_upper + diagnostics_total_upper + pools_total_upper;
+    messaging_total_upper + events_total_upper + tasks_total_upper + os_total_upper + protocol_total_upper + diagnostics_total_upper + pools_total_upper +
+    slabs_total_upper + scratch_total_upper;
 
 // -------- Budget enforcement --------
 // Require the integrator to provide a global memory budget and always enforce it.
@@ -179,12 +254,23 @@ struct budget_report {
     std::size_t protocol_bytes;
     std::size_t diagnostics_bytes;
     std::size_t pools_bytes;
+    std::size_t slabs_bytes;
+    std::size_t scratch_bytes;
     std::size_t total_upper;
+    // Placement report: every arena region with its bytes, memory class and alignment
+    region_placement regions[region_count];
+    std::size_t class_bytes[memory_class_count];  // region bytes per memory class (before padding)
 };
 
 constexpr budget_report report() noexcept {
-    return budget_report{ messaging_total_upper, events_total_upper, tasks_total_upper, os_total_upper,
-                          protocol_total_upper, diagnostics_total_upper, pools_total_upper, total_required_upper };
+    budget_report r{ messaging_total_upper, events_total_upper, tasks_total_upper, os_total_upper,
+                     protocol_total_upper, diagnostics_total_upper, pools_total_upper, slabs_total_upper,
+                     scratch_total_upper, total_required_upper, {}, {} };
+    for (std::size_t i = 0; i < region_count; ++i) {
+        r.regions[i] = region_placements[i];
+        r.class_bytes[static_cast<std::size_t>(region_placements[i].cls)] += region_placements[i].bytes;
+    }
+    return r;
 }
 
 } // namespace emCore::memory
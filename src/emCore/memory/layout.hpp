@@ -1,7 +1,9 @@
 #pragma once
 
 // Compile-time memory layout for emCore subsystems.
-// Pure header-only: computes offsets from sizes in budget.hpp.
+// Pure header-only: computes offsets from sizes in budget.hpp. Each region is
+// placed in the arena of its memory class (EMCORE_<REGION>_MEM_CLASS), so hot
+// messaging state can sit in fast RAM while bulk buffers go to PSRAM.
 
 #include <cstddef>
 #include "budget.hpp"
@@ -9,8 +11,10 @@
 namespace emCore::memory {
 
 struct region {
-    std::size_t offset;
+    std::size_t offset;  // from the base of the arena of its memory class
     std::size_t size;
+    memory_class cls;
+    std::size_t align;
 };
 
 constexpr std::size_t align_up(std::size_t v, std::size_t a) {
@@ -24,19 +28,36 @@ struct layout {
     region os;           // user-reserved
     region protocol;     // user-reserved
     region diagnostics;  // user-reserved
+    region slabs;        // slab allocator pages
+    region scratch;      // per-invocation scratch arenas
+    std::size_t class_total[memory_class_count];  // arena size per memory class, padding included
     std::size_t total;   // total upper-bound including alignment padding
 
+    // Regions are packed per memory class in region_id order, each at its own alignment
     static constexpr layout compute() {
-        constexpr std::size_t A = 8; // 8-byte alignment for mixed types
-        std::size_t off = 0;
         layout L{};
-        off = align_up(off, A); L.messaging    = { off, messaging_total_upper };    off += messaging_total_upper;
-        off = align_up(off, A); L.events       = { off, events_total_upper };       off += events_total_upper;
-        off = align_up(off, A); L.tasks        = { off, tasks_total_upper };        off += tasks_total_upper;
-        off = align_up(off, A); L.os           = { off, os_total_upper };           off += os_total_upper;
-        off = align_up(off, A); L.protocol     = { off, protocol_total_upper };     off += protocol_total_upper;
-        off = align_up(off, A); L.diagnostics  = { off, diagnostics_total_upper };  off += diagnostics_total_upper;
-        L.total = align_up(off, A);
+        std::size_t off[memory_class_count]{};
+        const auto place = [&off](region_id id) {
+            const region_placement& p = region_placements[static_cast<std::size_t>(id)];
+            std::size_t& o = off[static_cast<std::size_t>(p.cls)];
+            o = align_up(o, p.align);
+            const region r{ o, p.bytes, p.cls, p.align };
+            o += p.bytes;
+            return r;
+        };
+        L.messaging   = place(region_id::messaging);
+        L.events      = place(region_id::events);
+        L.tasks       = place(region_id::tasks);
+        L.os          = place(region_id::os);
+        L.protocol    = place(region_id::protocol);
+        L.diagnostics = place(region_id::diagnostics);
+        L.slabs       = place(region_id::slabs);
+        L.scratch     = place(region_id::scratch);
+        L.total = 0;
+        for (std::size_t c = 0; c < memory_class_count; ++c) {
+            L.class_total[c] = align_up(off[c], ::emCore::config::cache_line_bytes);
+            L.total += L.class_total[c];
+        }
         return L;
     }
 };
@@ -44,9 +65,19 @@ struct layout {
 inline constexpr layout kLayout = layout::compute();
 inline constexpr std::size_t required_bytes = kLayout.total;
 
+// Backing array size of one memory class (never zero, so every arena can be declared)
+constexpr std::size_t arena_bytes(memory_class cls) noexcept {
+    const std::size_t n = kLayout.class_total[static_cast<std::size_t>(cls)];
+    return (n != 0U) ? n : 1U;
+}
+
 #ifdef EMCORE_MEMORY_BUDGET_BYTES
 static_assert(required_bytes <= static_cast<std::size_t>(EMCORE_MEMORY_BUDGET_BYTES),
               "emCore layout exceeds EMCORE_MEMORY_BUDGET_BYTES: raise budget or lower caps");
 #endif
+#ifdef EMCORE_FAST_RAM_BUDGET_BYTES
+static_assert(kLayout.class_total[static_cast<std::size_t>(memory_class::fast)] <= static_cast<std::size_t>(EMCORE_FAST_RAM_BUDGET_BYTES),
+              "emCore regions placed in fast RAM exceed EMCORE_FAST_RAM_BUDGET_BYTES");
+#endif
 
 } // namespace emCore::memory
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+#include "../core/types.hpp"
+#include "../core/config.hpp"
+#include "../os/tasks.hpp"
+
+#include <etl/atomic.h>
+
+namespace emCore::memory {
+
+/**
+ * @brief In-place storage for a subsystem constructed on first use
+ *
+ * get() placement-constructs T the first time it is called and returns it
+ * from then on; racing first callers wait (yielding) for the winner, so any
+ * task or core may be first. Nothing runs for a subsystem that is never
+ * touched. The storage is zeroed with the owner unless
+ * EMCORE_ZERO_SUBSYSTEM_STORAGE is 0.
+ *
+ * The first get() must run in task context: an ISR that lands on a half-built
+ * object would spin on os::yield() forever. Objects an ISR can reach are built
+ * up front (taskmaster::initialize() does this for the brokers and pools).
+ */
+template <typename T>
+class lazy_object {
+public:
+    lazy_object() noexcept = default;
+    lazy_object(const lazy_object&) = delete;
+    lazy_object& operator=(const lazy_object&) = delete;
+    lazy_object(lazy_object&&) = delete;
+    lazy_object& operator=(lazy_object&&) = delete;
+    ~lazy_object() {
+        if (state_.load(etl::memory_order_acquire) == ready) {
+            object()->~T();
+        }
+    }
+
+    T& get() noexcept {
+        if (state_.load(etl::memory_order_acquire) != ready) {
+            construct();
+        }
+        return *object();
+    }
+    T& operator*() noexcept { return get(); }
+    T* operator->() noexcept { return &get(); }
+
+    // The object if it exists; never constructs (for stats and teardown paths)
+    [[nodiscard]] T* get_if() noexcept {
+        return (state_.load(etl::memory_order_acquire) == ready) ? object() : nullptr;
+    }
+    [[nodiscard]] bool constructed() const noexcept { return state_.load(etl::memory_order_acquire) == ready; }
+
+private:
+    static constexpr u8 empty = 0;
+    static constexpr u8 building = 1;
+    static constexpr u8 ready = 2;
+
+    T* object() noexcept { return std::launder(reinterpret_cast<T*>(storage_)); }
+
+    void construct() noexcept {
+        u8 expected = empty;
+        if (state_.compare_exchange_strong(expected, building)) {
+            (void)::new (static_cast<void*>(storage_)) T();
+            state_.store(ready, etl::memory_order_release);
+            return;
+        }
+        while (state_.load(etl::memory_order_acquire) != ready) {
+            os::yield();
+        }
+    }
+
+    alignas(T) unsigned char EMCORE_BSS_ATTR storage_[sizeof(T)] EMCORE_SUBSYSTEM_STORAGE_INIT;
+    etl::atomic<u8> state_{empty};
+};
+
+}  // namespace emCore::memory
@@ -3,7 +3,13 @@
 #include "../core/types.hpp"
 #include "../core/config.hpp"
 #include <etl/array.h>
+#include <etl/atomic.h>
+#include <etl/type_traits.h>
 #include "../os/sync.hpp"
+#if EMCORE_ENABLE_SLAB_ALLOCATOR
+#include "slab_allocator.hpp"
+#include "../runtime.hpp"
+#endif
 #include <cstddef>
 
 namespace emCore {
@@ -19,30 +25,135 @@ namespace emCore {
         memory_block_header() noexcept : size(0), is_free(true), next(nullptr) {}
     };
     
+    /**
+     * @brief Block header for lock-free pools: tagged free-list link and free flag
+     */
+    struct lock_free_block_header {
+        etl::atomic<u32> next{0xFFFFU};  // index of the next free block
+        etl::atomic<u8> is_free{1};
+    };
+    
     /**
      * @brief Fixed-size memory pool without dynamic allocation
      * @tparam BlockSize Size of each memory block
      * @tparam BlockCount Number of blocks in the pool
+     * @tparam LockFree Tagged Treiber free list over block indices instead of the
+     *         critical section: safe from ISRs and both cores without masking
+     *         interrupts. The double-free check is an atomic exchange on the
+     *         block's free flag, so it needs no lock either.
      */
-    template<size_t BlockSize, size_t BlockCount>
+    template<size_t BlockSize, size_t BlockCount, bool LockFree = config::pools_lock_free>
     class memory_pool {
+    public:
+        using header_t = typename etl::conditional<LockFree, lock_free_block_header, memory_block_header>::type;
+        
     private:
         // Ensure robust alignment for MCU/peripheral (DMA-safe) access and allow
         // relocating pool storage via EMCORE_BSS_ATTR (e.g., PSRAM on ESP32).
         EMCORE_BSS_ATTR alignas(std::max_align_t) u8 pool_[BlockSize * BlockCount];
-        etl::array<memory_block_header, BlockCount> headers_;
+        // Headers are touched on every allocate/free: keep them off the payload's cache lines
+        alignas(config::cache_line_bytes) etl::array<header_t, BlockCount> headers_;
         // Indirection pointers to allow optional external backing without changing API
         u8* pool_ptr_;
-        memory_block_header* headers_ptr_;
-        memory_block_header* free_list_;
-        size_t allocated_count_;
+        header_t* headers_ptr_;
+        // Free list head: header pointer when locked; {tag:16, index:16} when lock-free (the tag defeats ABA on pop)
+        typename etl::conditional<LockFree, etl::atomic<u32>, memory_block_header*>::type free_list_{};
+        etl::atomic<size_t> allocated_count_;
         // Optional thread-safety
         mutable os::critical_section cs_;
         
+        static constexpr u32 index_mask = 0xFFFFU;
+        static constexpr u32 empty_index = 0xFFFFU;
+        
+        struct cs_scope {
+            os::critical_section& c;
+            explicit cs_scope(os::critical_section& c_) : c(c_) { if (config::pools_thread_safe && !LockFree) c.enter(); }
+            ~cs_scope() { if (config::pools_thread_safe && !LockFree) c.exit(); }
+            cs_scope(const cs_scope&) = delete;
+            cs_scope& operator=(const cs_scope&) = delete;
+        };
+        
+        static constexpr u32 next_tag(u32 head) noexcept { return (head & ~index_mask) + 0x10000U; }
+        
+        u32 pop_free() noexcept {
+            u32 head = free_list_.load(etl::memory_order_acquire);
+            for (;;) {
+                const u32 idx = head & index_mask;
+                if (idx == empty_index) { return empty_index; }
+                const u32 next = headers_ptr_[idx].next.load(etl::memory_order_relaxed);
+                const u32 replacement = next_tag(head) | (next & index_mask);
+                if (free_list_.compare_exchange_weak(head, replacement, etl::memory_order_acq_rel, etl::memory_order_acquire)) {
+                    return idx;
+                }
+            }
+        }
+        
+        void push_free(u32 index) noexcept {
+            u32 head = free_list_.load(etl::memory_order_relaxed);
+            for (;;) {
+                headers_ptr_[index].next.store(head & index_mask, etl::memory_order_relaxed);
+                const u32 replacement = next_tag(head) | index;
+                if (free_list_.compare_exchange_weak(head, replacement, etl::memory_order_release, etl::memory_order_relaxed)) {
+                    return;
+                }
+            }
+        }
+        
+        // Block index of an owned pointer, BlockCount when foreign or not a block boundary
+        size_t index_of(const void* ptr) const noexcept {
+            if (!owns(ptr)) {
+                return BlockCount;
+            }
+            const size_t offset = static_cast<size_t>(static_cast<const u8*>(ptr) - pool_ptr_);
+            return ((offset % BlockSize) == 0U) ? (offset / BlockSize) : BlockCount;
+        }
+        
+        // Take one block off the free list; caller holds cs_ in locked mode
+        void* take_block() noexcept {
+            if constexpr (LockFree) {
+                const u32 idx = pop_free();
+                if (idx == empty_index) {
+                    return nullptr;
+                }
+                headers_ptr_[idx].is_free.store(0U, etl::memory_order_relaxed);
+                return &pool_ptr_[static_cast<size_t>(idx) * BlockSize];
+            } else {
+                if (free_list_ == nullptr) {
+                    return nullptr;
+                }
+                memory_block_header* block = free_list_;
+                free_list_ = block->next;
+                block->is_free = false;
+                block->next = nullptr;
+                const size_t index = static_cast<size_t>(block - &headers_ptr_[0]);
+                return &pool_ptr_[index * BlockSize];
+            }
+        }
+        
+        // Return one block by index; false on double free. Caller holds cs_ in locked mode
+        bool give_block(size_t index) noexcept {
+            if constexpr (LockFree) {
+                if (headers_ptr_[index].is_free.exchange(1U, etl::memory_order_acq_rel) != 0U) {
+                    return false; // Double free
+                }
+                push_free(static_cast<u32>(index));
+            } else {
+                memory_block_header* block = &headers_ptr_[index];
+                if (block->is_free) {
+                    return false; // Double free
+                }
+                block->is_free = true;
+                block->next = free_list_;
+                free_list_ = block;
+            }
+            return true;
+        }
+        
     public:
         static_assert(BlockSize > 0, "memory_pool BlockSize must be > 0");
         static_assert(BlockCount > 0, "memory_pool BlockCount must be > 0");
-        memory_pool() noexcept : pool_ptr_(pool_), headers_ptr_(headers_.data()), free_list_(nullptr), allocated_count_(0) {
+        static_assert(!LockFree || BlockCount < 0xFFFF, "lock-free memory_pool supports at most 65534 blocks");
+        memory_pool() noexcept : pool_ptr_(pool_), headers_ptr_(headers_.data()), allocated_count_(0) {
             initialize();
         }
         /**
@@ -54,9 +165,9 @@ namespace emCore {
          */
         memory_pool(u8* external_buffer,
                     size_t external_buffer_bytes,
-                    memory_block_header* external_headers,
+                    header_t* external_headers,
                     size_t header_count) noexcept
-            : pool_ptr_(pool_), headers_ptr_(headers_.data()), free_list_(nullptr), allocated_count_(0) {
+            : pool_ptr_(pool_), headers_ptr_(headers_.data()), allocated_count_(0) {
             // Validate and adopt external buffers if sizes match, otherwise fall back to internal storage.
             if (external_buffer != nullptr && external_buffer_bytes >= storage_bytes()) {
                 pool_ptr_ = external_buffer;
@@ -69,18 +180,28 @@ namespace emCore {
         
         /**
          * @brief Initialize the memory pool
+         * Not thread-safe: call before the pool is shared
          */
         void initialize() noexcept {
-            // Initialize free list
-            free_list_ = &headers_ptr_[0];
-            
-            for (size_t i = 0; i < BlockCount; ++i) {
-                headers_ptr_[i].size = BlockSize;
-                headers_ptr_[i].is_free = true;
-                headers_ptr_[i].next = (i < BlockCount - 1) ? &headers_ptr_[i + 1] : nullptr;
+            if constexpr (LockFree) {
+                for (size_t i = 0; i < BlockCount; ++i) {
+                    headers_ptr_[i].is_free.store(1U, etl::memory_order_relaxed);
+                    headers_ptr_[i].next.store((i < BlockCount - 1) ? static_cast<u32>(i + 1) : empty_index,
+                                               etl::memory_order_relaxed);
+                }
+                free_list_.store(0U, etl::memory_order_release);
+            } else {
+                // Initialize free list
+                free_list_ = &headers_ptr_[0];
+                
+                for (size_t i = 0; i < BlockCount; ++i) {
+                    headers_ptr_[i].size = BlockSize;
+                    headers_ptr_[i].is_free = true;
+                    headers_ptr_[i].next = (i < BlockCount - 1) ? &headers_ptr_[i + 1] : nullptr;
+                }
             }
             
-            allocated_count_ = 0;
+            allocated_count_.store(0, etl::memory_order_relaxed);
         }
         
         /**
@@ -89,24 +210,16 @@ namespace emCore {
          * @return Pointer to allocated memory or nullptr if failed
          */
         void* allocate(size_t size) noexcept {
+            if (size > BlockSize) {
+                return nullptr;
+            }
             // Optional thread-safety scope
-            struct cs_scope { os::critical_section& c; explicit cs_scope(os::critical_section& c_) : c(c_) { if (config::pools_thread_safe) c.enter(); } ~cs_scope(){ if (config::pools_thread_safe) c.exit(); } };
             cs_scope guard(cs_);
-            if (size > BlockSize || free_list_ == nullptr) {
-                return nullptr;
+            void* block = take_block();
+            if (block != nullptr) {
+                allocated_count_.fetch_add(1, etl::memory_order_relaxed);
             }
-            
-            memory_block_header* block = free_list_;
-            free_list_ = block->next;
-            
-            block->is_free = false;
-            block->next = nullptr;
-            
-            ++allocated_count_;
-            
-            // Calculate memory address from header index
-            size_t index = static_cast<size_t>(block - &headers_ptr_[0]);
-            return &pool_ptr_[index * BlockSize];
+            return block;
         }
         
         /**
@@ -115,45 +228,72 @@ namespace emCore {
          * @return True if successful, false otherwise
          */
         bool deallocate(void* ptr) noexcept {
-            if (ptr == nullptr) {
-                return false;
-            }
-            
             // Calculate block index from memory address
-            u8* mem_ptr = static_cast<u8*>(ptr);
-            if (mem_ptr < pool_ptr_ || mem_ptr >= (pool_ptr_ + storage_bytes())) {
+            const size_t index = index_of(ptr);
+            if (index >= BlockCount) {
                 return false; // Not from this pool
             }
             
             // Optional thread-safety scope
-            struct cs_scope { os::critical_section& c; explicit cs_scope(os::critical_section& c_) : c(c_) { if (config::pools_thread_safe) c.enter(); } ~cs_scope(){ if (config::pools_thread_safe) c.exit(); } };
             cs_scope guard(cs_);
-
-            size_t index = static_cast<size_t>((mem_ptr - pool_ptr_) / BlockSize);
-            if (index >= BlockCount) {
+            if (!give_block(index)) {
                 return false;
             }
-            
-            memory_block_header* block = &headers_ptr_[index];
-            if (block->is_free) {
-                return false; // Double free
-            }
-            
-            // Add back to free list
-            block->is_free = true;
-            block->next = free_list_;
-            free_list_ = block;
-            
-            --allocated_count_;
+            allocated_count_.fetch_sub(1, etl::memory_order_relaxed);
             return true;
         }
         
+        /**
+         * @brief Allocate up to count blocks under a single lock
+         * @param out Receives the block pointers
+         * @param count Maximum number of blocks
+         * @return Number of blocks allocated
+         */
+        size_t allocate_batch(void** out, size_t count) noexcept {
+            cs_scope guard(cs_);
+            size_t taken = 0;
+            while (taken < count) {
+                void* block = take_block();
+                if (block == nullptr) {
+                    break;
+                }
+                out[taken++] = block;
+            }
+            allocated_count_.fetch_add(taken, etl::memory_order_relaxed);
+            return taken;
+        }
+
+        /**
+         * @brief Return count blocks under a single lock
+         * @return Number of blocks accepted (foreign pointers and double frees are skipped)
+         */
+        size_t deallocate_batch(void* const* blocks, size_t count) noexcept {
+            cs_scope guard(cs_);
+            size_t returned = 0;
+            for (size_t i = 0; i < count; ++i) {
+                const size_t index = index_of(blocks[i]);
+                if (index < BlockCount && give_block(index)) {
+                    ++returned;
+                }
+            }
+            allocated_count_.fetch_sub(returned, etl::memory_order_relaxed);
+            return returned;
+        }
+
+        /**
+         * @brief Check whether ptr lies inside this pool's data area
+         */
+        bool owns(const void* ptr) const noexcept {
+            const u8* mem_ptr = static_cast<const u8*>(ptr);
+            return mem_ptr != nullptr && mem_ptr >= pool_ptr_ && mem_ptr < (pool_ptr_ + storage_bytes());
+        }
+        
         /**
          * @brief Get number of allocated blocks
          * @return Number of allocated blocks
          */
         size_t get_allocated_count() const noexcept {
-            return allocated_count_;
+            return allocated_count_.load(etl::memory_order_relaxed);
         }
         
         /**
@@ -161,7 +301,7 @@ namespace emCore {
          * @return Number of free blocks
          */
         size_t get_free_count() const noexcept {
-            return BlockCount - allocated_count_;
+            return BlockCount - get_allocated_count();
         }
         
         /**
@@ -169,7 +309,7 @@ namespace emCore {
          * @return True if no free blocks available
          */
         bool is_full() const noexcept {
-            return allocated_count_ == BlockCount;
+            return get_allocated_count() == BlockCount;
         }
         
         /**
@@ -196,14 +336,112 @@ namespace emCore {
         }
     };
     
+    /**
+     * @brief Allocation cache counters (hit = served without touching the shared pool)
+     */
+    struct pool_cache_stats {
+        u32 hits;
+        u32 misses;
+        u32 refills;
+        u32 spills;
+    };
+
+    /**
+     * @brief Per-task (or per-core) block cache in front of a shared memory_pool
+     *
+     * Holds up to CacheSize free blocks. An empty cache refills half its
+     * capacity with one allocate_batch(); a full cache spills half with one
+     * deallocate_batch(). The cache itself is not locked: give each task or
+     * core its own instance. Cached blocks count as allocated in the pool.
+     *
+     * @tparam PoolT memory_pool<...>
+     * @tparam CacheSize Number of blocks held locally
+     */
+    template<typename PoolT, size_t CacheSize = 8>
+    class pool_cache {
+    private:
+        static_assert(CacheSize >= 2, "pool_cache needs room for at least two blocks");
+        static constexpr size_t batch_ = CacheSize / 2;
+
+        PoolT& pool_;
+        void* blocks_[CacheSize]{};
+        size_t count_{0};
+        pool_cache_stats stats_{};
+
+    public:
+        explicit pool_cache(PoolT& pool) noexcept : pool_(pool) {}
+        ~pool_cache() { flush(); }
+        pool_cache(const pool_cache&) = delete;
+        pool_cache& operator=(const pool_cache&) = delete;
+        pool_cache(pool_cache&&) = delete;
+        pool_cache& operator=(pool_cache&&) = delete;
+
+        /**
+         * @brief Allocate a block, refilling from the shared pool when empty
+         */
+        void* allocate(size_t size) noexcept {
+            if (size > pool_.get_block_size()) {
+                return nullptr;
+            }
+            if (count_ == 0) {
+                ++stats_.misses;
+                count_ = pool_.allocate_batch(blocks_, batch_);
+                if (count_ == 0) {
+                    return nullptr;
+                }
+                ++stats_.refills;
+            } else {
+                ++stats_.hits;
+            }
+            return blocks_[--count_];
+        }
+
+        /**
+         * @brief Return a block to the cache, spilling half to the shared pool when full
+         */
+        bool deallocate(void* ptr) noexcept {
+            if (!pool_.owns(ptr)) {
+                return false;
+            }
+            if (count_ == CacheSize) {
+                (void)pool_.deallocate_batch(&blocks_[CacheSize - batch_], batch_);
+                count_ -= batch_;
+                ++stats_.spills;
+            }
+            blocks_[count_++] = ptr;
+            return true;
+        }
+
+        /**
+         * @brief Hand every cached block back to the shared pool
+         */
+        void flush() noexcept {
+            if (count_ != 0) {
+                (void)pool_.deallocate_batch(blocks_, count_);
+                count_ = 0;
+            }
+        }
+
+        [[nodiscard]] size_t cached() const noexcept { return count_; }
+        [[nodiscard]] const pool_cache_stats& stats() const noexcept { return stats_; }
+        void reset_stats() noexcept { stats_ = pool_cache_stats{}; }
+    };
+    
     /**
      * @brief Multi-pool memory manager
+     *
+     * With EMCORE_ENABLE_SLAB_ALLOCATOR, requests up to the largest slab class
+     * go to the slab allocator in the arena's slabs region first; the fixed
+     * pools back it up when a class runs out of pages.
      */
     class memory_manager {
     private:
         memory_pool<config::small_block_size, config::small_pool_count> small_pool_;
         memory_pool<config::medium_block_size, config::medium_pool_count> medium_pool_;
         memory_pool<config::large_block_size, config::large_pool_count> large_pool_;
+#if EMCORE_ENABLE_SLAB_ALLOCATOR
+        memory::default_slab_allocator slab_{runtime::slabs_region(), memory::kLayout.slabs.size};
+#endif
         
     public:
         memory_manager() noexcept = default;
@@ -214,6 +452,14 @@ namespace emCore {
          * @return Pointer to allocated memory or nullptr
          */
         void* allocate(size_t size) noexcept {
+#if EMCORE_ENABLE_SLAB_ALLOCATOR
+            if (size <= memory::default_slab_allocator::max_block) {
+                void* block = slab_.allocate(size);
+                if (block != nullptr) {
+                    return block;
+                }
+            }
+#endif
             if (size <= config::small_block_size) {
                 return small_pool_.allocate(size);
             } else if (size <= config::medium_block_size) {
@@ -234,6 +480,11 @@ namespace emCore {
                 return false;
             }
             
+#if EMCORE_ENABLE_SLAB_ALLOCATOR
+            if (slab_.owns(ptr)) {
+                return slab_.deallocate(ptr);
+            }
+#endif
             // Try each pool
             return small_pool_.deallocate(ptr) ||
                    medium_pool_.deallocate(ptr) ||
@@ -252,6 +503,10 @@ namespace emCore {
             size_t large_free;
         };
         
+#if EMCORE_ENABLE_SLAB_ALLOCATOR
+        [[nodiscard]] const memory::default_slab_allocator& get_slab() const noexcept { return slab_; }
+#endif
+        
         memory_stats get_stats() const noexcept {
             return {
                 small_pool_.get_allocated_count(),
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../core/types.hpp"
+
+#include <etl/algorithm.h>
+
+namespace emCore::memory {
+
+/**
+ * @brief Bump-pointer arena for temporaries that live for one task invocation
+ *
+ * allocate() is an align-up and an add; nothing is freed individually. The
+ * owner calls reset() when the invocation ends, which drops everything at once
+ * and returns the peak usage of that invocation. mark()/rewind() release a
+ * nested scope early. Not thread-safe: each slot belongs to one execution
+ * context (a cooperative worker or a native task).
+ */
+class scratch_arena {
+public:
+    using marker = size_t;
+
+    scratch_arena() noexcept = default;
+    scratch_arena(void* region, size_t bytes) noexcept { attach(region, bytes); }
+    scratch_arena(const scratch_arena&) = delete;
+    scratch_arena& operator=(const scratch_arena&) = delete;
+    scratch_arena(scratch_arena&&) = delete;
+    scratch_arena& operator=(scratch_arena&&) = delete;
+
+    // Adopt backing storage; drops any current allocations
+    void attach(void* region, size_t bytes) noexcept {
+        base_ = static_cast<u8*>(region);
+        capacity_ = (region != nullptr) ? bytes : 0U;
+        used_ = 0;
+        peak_ = 0;
+    }
+
+    /**
+     * @brief Bump-allocate size bytes aligned to align (a power of two)
+     * @return nullptr when the arena cannot hold the request
+     */
+    void* allocate(size_t size, size_t align = alignof(std::max_align_t)) noexcept {
+        const uintptr_t start = reinterpret_cast<uintptr_t>(base_) + used_;
+        const uintptr_t aligned = (start + (align - 1U)) & ~static_cast<uintptr_t>(align - 1U);
+        const size_t offset = static_cast<size_t>(aligned - reinterpret_cast<uintptr_t>(base_));
+        if (base_ == nullptr || size > capacity_ || offset > capacity_ - size) {
+            ++failures_;
+            return nullptr;
+        }
+        used_ = offset + size;
+        peak_ = etl::max(peak_, used_);
+        return base_ + offset;
+    }
+
+    // Uninitialized storage for count objects of T
+    template <typename T>
+    T* allocate_array(size_t count) noexcept {
+        if (count > capacity_ / sizeof(T)) {
+            ++failures_;
+            return nullptr;
+        }
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    [[nodiscard]] marker mark() const noexcept { return used_; }
+    void rewind(marker m) noexcept {
+        if (m < used_) { used_ = m; }
+    }
+
+    // Drop every allocation; returns the peak usage since the previous reset
+    size_t reset() noexcept {
+        const size_t peak = peak_;
+        high_water_ = etl::max(high_water_, peak);
+        used_ = 0;
+        peak_ = 0;
+        return peak;
+    }
+
+    [[nodiscard]] size_t used() const noexcept { return used_; }
+    [[nodiscard]] size_t capacity() const noexcept { return capacity_; }
+    [[nodiscard]] size_t remaining() const noexcept { return capacity_ - used_; }
+    // Largest reset() peak seen so far, across all invocations served by this slot
+    [[nodiscard]] size_t high_water() const noexcept { return etl::max(high_water_, peak_); }
+    [[nodiscard]] u32 failures() const noexcept { return failures_; }
+
+private:
+    u8* base_{nullptr};
+    size_t capacity_{0};
+    size_t used_{0};
+    size_t peak_{0};
+    size_t high_water_{0};
+    u32 failures_{0};
+};
+
+}  // namespace emCore::memory
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <cstddef>
+
+#include "../core/types.hpp"
+#include "../core/config.hpp"
+#include "../os/sync.hpp"
+#include "../utils/helpers.hpp"
+
+#include <etl/algorithm.h>
+#include <etl/array.h>
+
+namespace emCore::memory {
+
+/**
+ * @brief Size-class slab allocator over a caller-provided region
+ *
+ * Classes are powers of two from 2^MinShift up to 2^(MinShift + Classes - 1)
+ * bytes. The region is cut into PageBytes pages which are handed to a class
+ * the first time that class runs dry and then carved into its blocks, so only
+ * the classes actually used consume memory. The class of a request is one
+ * highest_set_bit() (clz) away, and the owner of a pointer is its page index,
+ * offset >> log2(PageBytes): no pool probing on allocate or free.
+ *
+ * An allocated bit per min_block granule lets deallocate() refuse double
+ * frees. Pages stay with their class once assigned. Thread-safe when
+ * EMCORE_POOLS_THREAD_SAFE is set, like memory_pool.
+ */
+template <size_t MinShift, size_t Classes, size_t PageBytes, size_t MaxPages>
+class slab_allocator {
+    static_assert(MinShift >= 3, "slab blocks must hold a free-list link");
+    static_assert(Classes >= 1 && Classes < 0xFF, "slab_allocator supports 1..254 classes");
+    static_assert((PageBytes & (PageBytes - 1U)) == 0, "PageBytes must be a power of two");
+    static_assert(PageBytes >= (size_t{1} << (MinShift + Classes - 1U)), "a page must hold the largest class");
+    static_assert(MaxPages >= 1, "MaxPages must be >= 1");
+
+public:
+    static constexpr size_t min_block = size_t{1} << MinShift;
+    static constexpr size_t max_block = size_t{1} << (MinShift + Classes - 1U);
+    static constexpr u8 no_class = 0xFF;
+
+    struct class_stats {
+        size_t block_size;
+        u16 pages;
+        u32 allocated;   // blocks currently handed out
+        u32 failures;    // requests refused because no page was left
+    };
+
+    slab_allocator(void* region, size_t bytes) noexcept
+        : base_(static_cast<u8*>(region))
+        , pages_((region != nullptr) ? etl::min(bytes >> page_shift, MaxPages) : 0U) {
+        page_class_.fill(no_class);
+        free_.fill(nullptr);
+    }
+    slab_allocator(const slab_allocator&) = delete;
+    slab_allocator& operator=(const slab_allocator&) = delete;
+    slab_allocator(slab_allocator&&) = delete;
+    slab_allocator& operator=(slab_allocator&&) = delete;
+
+    /**
+     * @brief Class index serving `size` bytes; >= Classes when it is too large
+     */
+    static constexpr size_t class_of(size_t size) noexcept {
+        if (size <= min_block) {
+            return 0;
+        }
+        return static_cast<size_t>(utils::highest_set_bit(static_cast<u32>(size - 1U))) + 1U - MinShift;
+    }
+    static constexpr size_t class_size(size_t cls) noexcept { return size_t{1} << (MinShift + cls); }
+
+    /**
+     * @brief Allocate a block of at least size bytes; nullptr when size > max_block or out of pages
+     */
+    void* allocate(size_t size) noexcept {
+        const size_t cls = class_of(size);
+        if (cls >= Classes || size == 0U) {
+            return nullptr;
+        }
+        lock_scope guard(cs_);
+        if (free_[cls] == nullptr && !grow(cls)) {
+            ++stats_[cls].failures;
+            return nullptr;
+        }
+        free_block* block = free_[cls];
+        free_[cls] = block->next;
+        mark(block, true);
+        ++stats_[cls].allocated;
+        return block;
+    }
+
+    /**
+     * @brief Return a block; false for pointers this allocator did not hand out and double frees
+     */
+    bool deallocate(void* ptr) noexcept {
+        const size_t cls = class_of_ptr(ptr);
+        if (cls == no_class) {
+            return false;
+        }
+        lock_scope guard(cs_);
+        if (!mark(ptr, false)) {
+            return false;  // Double free
+        }
+        auto* block = static_cast<free_block*>(ptr);
+        block->next = free_[cls];
+        free_[cls] = block;
+        --stats_[cls].allocated;
+        return true;
+    }
+
+    /**
+     * @brief Usable size of an allocated block (0 if not owned)
+     */
+    [[nodiscard]] size_t block_size(const void* ptr) const noexcept {
+        const size_t cls = class_of_ptr(ptr);
+        return (cls == no_class) ? 0U : class_size(cls);
+    }
+
+    [[nodiscard]] bool owns(const void* ptr) const noexcept {
+        const u8* p = static_cast<const u8*>(ptr);
+        return p != nullptr && p >= base_ && p < base_ + (pages_ << page_shift);
+    }
+
+    [[nodiscard]] class_stats stats(size_t cls) const noexcept {
+        return (cls < Classes) ? stats_[cls] : class_stats{};
+    }
+    [[nodiscard]] size_t page_count() const noexcept { return pages_; }
+    [[nodiscard]] size_t free_pages() const noexcept { return pages_ - next_page_; }
+    static constexpr size_t page_bytes() noexcept { return PageBytes; }
+    static constexpr size_t class_count() noexcept { return Classes; }
+
+private:
+    static constexpr u8 page_shift = utils::highest_set_bit(static_cast<u32>(PageBytes));
+
+    struct free_block {
+        free_block* next;
+    };
+
+    struct lock_scope {
+        os::critical_section& c;
+        explicit lock_scope(os::critical_section& c_) noexcept : c(c_) { if (config::pools_thread_safe) { c.enter(); } }
+        ~lock_scope() { if (config::pools_thread_safe) { c.exit(); } }
+        lock_scope(const lock_scope&) = delete;
+        lock_scope& operator=(const lock_scope&) = delete;
+    };
+
+    // Owning class of a block pointer in O(1); no_class for foreign or misaligned pointers
+    [[nodiscard]] size_t class_of_ptr(const void* ptr) const noexcept {
+        if (!owns(ptr)) {
+            return no_class;
+        }
+        const size_t offset = static_cast<size_t>(static_cast<const u8*>(ptr) - base_);
+        const u8 cls = page_class_[offset >> page_shift];
+        if (cls == no_class || (offset & (class_size(cls) - 1U)) != 0U) {
+            return no_class;
+        }
+        return cls;
+    }
+
+    // Set or clear the allocated bit of a block (one bit per min_block granule); false if it already had that state
+    bool mark(const void* ptr, bool allocated) noexcept {
+        const size_t bit = static_cast<size_t>(static_cast<const u8*>(ptr) - base_) >> MinShift;
+        u32& word = allocated_[bit >> 5U];
+        const u32 mask = u32{1} << (bit & 31U);
+        if (((word & mask) != 0U) == allocated) {
+            return false;
+        }
+        word ^= mask;
+        return true;
+    }
+
+    // Give the next unused page to cls and thread its blocks onto the free list
+    bool grow(size_t cls) noexcept {
+        if (next_page_ >= pages_) {
+            return false;
+        }
+        const size_t page = next_page_++;
+        page_class_[page] = static_cast<u8>(cls);
+        ++stats_[cls].pages;
+        const size_t size = class_size(cls);
+        u8* const first = base_ + (page << page_shift);
+        for (size_t off = PageBytes; off >= size; off -= size) {
+            auto* block = reinterpret_cast<free_block*>(first + off - size);
+            block->next = free_[cls];
+            free_[cls] = block;
+        }
+        return true;
+    }
+
+    static constexpr etl::array<class_stats, Classes> initial_stats() noexcept {
+        etl::array<class_stats, Classes> out{};
+        for (size_t c = 0; c < Classes; ++c) { out[c] = class_stats{class_size(c), 0, 0, 0}; }
+        return out;
+    }
+
+    u8* base_;
+    size_t pages_;
+    size_t next_page_{0};
+    etl::array<u8, MaxPages> page_class_{};
+    etl::array<free_block*, Classes> free_{};
+    etl::array<u32, ((MaxPages * (PageBytes >> MinShift)) + 31U) / 32U> allocated_{};
+    etl::array<class_stats, Classes> stats_{initial_stats()};
+    os::critical_section cs_;
+};
+
+/**
+ * @brief Slab allocator shaped by the EMCORE_SLAB_ALLOC_* knobs
+ */
+using default_slab_allocator = slab_allocator<config::slab_alloc_min_shift, config::slab_alloc_classes,
+                                              config::slab_alloc_page_bytes,
+                                              (config::slab_alloc_bytes / config::slab_alloc_page_bytes) + 1U>;
+
+}  // namespace emCore::memory
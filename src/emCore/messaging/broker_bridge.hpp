@@ -0,0 +1,242 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+
+#include "../core/types.hpp"
+#include "../core/config.hpp"
+#include "message_types.hpp"
+#include "message_broker.hpp"
+
+#include <etl/array.h>
+
+namespace emCore::messaging {
+
+/*
+ * Broker bridge: cross-node pub/sub over a packet link (UART, CAN, ...).
+ *
+ * The bridge owns a task id on a local message_broker and subscribes it to the
+ * bridged topics. flush() drains that mailbox and packs the messages into as
+ * few frames as possible, each at most MaxBatch payload bytes (use the link's
+ * PACKET_MAX_PAYLOAD), and queues them on the TX pipeline under one opcode.
+ * The peer registers a dispatcher handler for that opcode that calls
+ * on_packet(), which republishes every message on its own broker in order.
+ *
+ * Messages the bridge republished carry its task id as sender and are never
+ * forwarded back, so both nodes may bridge the same topic.
+ *
+ * Batch payload (little endian):
+ *   u16 batch sequence, u8 record count, then per record
+ *   u16 topic, u16 message sequence, u8 priority, u8 flags, u16 size, size bytes
+ * Batches are numbered per link; the receiver drops stale or repeated ones and
+ * counts the gap when some were lost (the frame checksum rejects corrupt ones).
+ *
+ * flush() runs in one task and on_packet() in the RX context; neither is
+ * reentrant with itself.
+ */
+template <typename BrokerT, typename TxT, size_t MaxBatch = config::protocol_packet_size>
+class broker_bridge {
+public:
+    using message_type = typename BrokerT::message_type;
+    static constexpr size_t batch_header_size = 3;
+    static constexpr size_t record_header_size = 8;
+    static constexpr size_t max_message_payload = sizeof(message_type::payload);
+    static_assert(MaxBatch > batch_header_size + record_header_size && MaxBatch <= 0xFFFF,
+                  "MaxBatch must hold a batch header and a record header and fit a 16-bit length");
+
+    broker_bridge(BrokerT& broker, TxT& tx, task_id_t bridge_task_id, u8 opcode) noexcept
+        : broker_(broker), tx_(tx), self_(bridge_task_id), opcode_(opcode) {}
+    broker_bridge(const broker_bridge&) = delete;
+    broker_bridge& operator=(const broker_bridge&) = delete;
+    broker_bridge(broker_bridge&&) = delete;
+    broker_bridge& operator=(broker_bridge&&) = delete;
+    ~broker_bridge() = default;
+
+    // Forward topic_id to the peer; the bridge task must be registered with the broker
+    result<void, error_code> bridge_topic(u16 topic_id) noexcept {
+        return broker_.subscribe(topic_id_t(topic_id), self_);
+    }
+
+    /*
+     * Move up to max_messages from the bridge mailbox into frames; the last
+     * partial batch is sent too. When the TX ring is full the batch is kept
+     * and the rest stays in the mailbox for the next call. Returns the number
+     * of messages taken from the mailbox.
+     */
+    size_t flush(size_t max_messages = static_cast<size_t>(-1)) noexcept {
+        size_t taken = 0;
+        while (taken < max_messages && (carry_len_ == 0U || emit())) {
+            if (carry_len_ != 0U) {
+                append(carry_.data(), carry_len_);
+                carry_len_ = 0;
+            }
+            auto res = broker_.drain_with(self_, [this](const message_type& msg) noexcept { take(msg); }, 1U);
+            if (!res.is_ok() || res.value() == 0U) {
+                break;
+            }
+            ++taken;
+        }
+        if (carry_len_ == 0U && records_ != 0U) {
+            (void)emit();
+        }
+        return taken;
+    }
+
+    // Dispatcher entry for the bridge opcode (PacketT = protocol::packet<N>)
+    template <typename PacketT>
+    void on_packet(const PacketT& pkt) noexcept {
+        if (pkt.opcode != opcode_) {
+            return;
+        }
+        const u8* data = pkt.data.data();
+        const size_t len = pkt.length;
+        if (len < batch_header_size || !well_formed(data, len)) {
+            ++stats_.malformed;
+            return;
+        }
+        const u16 seq = get16(data);
+        if (synced_) {
+            const auto ahead = static_cast<i16>(static_cast<u16>(seq - expected_));
+            if (ahead < 0) {
+                ++stats_.stale_batches;
+                return;
+            }
+            stats_.lost_batches += static_cast<u32>(ahead);
+        }
+        synced_ = true;
+        expected_ = static_cast<u16>(seq + 1U);
+        ++stats_.batches_received;
+
+        const u8 count = data[2];
+        size_t pos = batch_header_size;
+        for (u8 i = 0; i < count; ++i) {
+            const u16 size = get16(data + pos + 6);
+            message_type msg{};
+            msg.header.sequence_number = get16(data + pos + 2);
+            msg.header.priority = data[pos + 4];
+            msg.header.flags = data[pos + 5];
+            msg.header.receiver_id = 0xFFFF;
+            msg.header.payload_size = size;
+            if (size != 0U) {
+                std::memcpy(msg.payload, data + pos + record_header_size, size);
+            }
+            auto res = broker_.publish(get16(data + pos), msg, self_);
+            if (res.is_ok()) {
+                ++stats_.republished;
+            } else {
+                ++stats_.not_delivered;
+            }
+            pos += record_header_size + size;
+        }
+    }
+
+    struct bridge_stats {
+        u32 forwarded{0};         // messages packed into frames
+        u32 frames{0};            // batches queued on the TX pipeline
+        u32 tx_full{0};           // emit attempts refused by the TX pipeline
+        u32 oversize{0};          // messages larger than one batch, dropped
+        u32 batches_received{0};
+        u32 republished{0};
+        u32 not_delivered{0};     // no local subscriber or mailbox full
+        u32 stale_batches{0};     // older or repeated batch sequence
+        u32 lost_batches{0};      // sequence gaps
+        u32 malformed{0};
+    };
+    [[nodiscard]] const bridge_stats& stats() const noexcept { return stats_; }
+    [[nodiscard]] task_id_t task_id() const noexcept { return self_; }
+    [[nodiscard]] u8 opcode() const noexcept { return opcode_; }
+
+private:
+    static void put16(u8* ptr, u16 value) noexcept {
+        ptr[0] = static_cast<u8>(value & 0xFFU);
+        ptr[1] = static_cast<u8>(value >> 8U);
+    }
+    static u16 get16(const u8* ptr) noexcept { return static_cast<u16>(ptr[0] | (static_cast<u16>(ptr[1]) << 8U)); }
+
+    static size_t encode_record(const message_type& msg, u8* out) noexcept {
+        const u16 size = msg.header.payload_size;
+        put16(out, msg.header.type);
+        put16(out + 2, msg.header.sequence_number);
+        out[4] = msg.header.priority;
+        out[5] = msg.header.flags;
+        put16(out + 6, size);
+        if (size != 0U) {
+            std::memcpy(out + record_header_size, msg.payload, size);
+        }
+        return record_header_size + size;
+    }
+
+    // Visitor for one mailbox message: into the open batch, or into carry_ when it is full
+    void take(const message_type& msg) noexcept {
+        if (msg.header.sender_id == self_.value()) {
+            return;  // republished from the peer
+        }
+        const size_t bytes = record_header_size + msg.header.payload_size;
+        if (msg.header.payload_size > max_message_payload || bytes > MaxBatch - batch_header_size) {
+            ++stats_.oversize;
+            return;
+        }
+        if (bytes <= MaxBatch - used_ && records_ < 0xFFU) {
+            used_ += encode_record(msg, batch_.data() + used_);
+            ++records_;
+        } else {
+            carry_len_ = encode_record(msg, carry_.data());
+        }
+        ++stats_.forwarded;
+    }
+
+    void append(const u8* record, size_t len) noexcept {
+        std::memcpy(batch_.data() + used_, record, len);
+        used_ += len;
+        ++records_;
+    }
+
+    // Queue the open batch; true when it went out (or was empty)
+    bool emit() noexcept {
+        if (records_ == 0U) {
+            return true;
+        }
+        put16(batch_.data(), tx_seq_);
+        batch_[2] = static_cast<u8>(records_);
+        if (!tx_.submit_payload(opcode_, batch_.data(), used_)) {
+            ++stats_.tx_full;
+            return false;
+        }
+        ++tx_seq_;
+        ++stats_.frames;
+        used_ = batch_header_size;
+        records_ = 0;
+        return true;
+    }
+
+    bool well_formed(const u8* data, size_t len) const noexcept {
+        size_t pos = batch_header_size;
+        for (u8 i = 0; i < data[2]; ++i) {
+            if (len - pos < record_header_size) {
+                return false;
+            }
+            const u16 size = get16(data + pos + 6);
+            if (size > max_message_payload || len - pos - record_header_size < size) {
+                return false;
+            }
+            pos += record_header_size + size;
+        }
+        return pos == len;
+    }
+
+    BrokerT& broker_;
+    TxT& tx_;
+    task_id_t self_;
+    u8 opcode_;
+    etl::array<u8, MaxBatch> batch_{};
+    etl::array<u8, MaxBatch - batch_header_size> carry_{};
+    size_t used_{batch_header_size};
+    size_t carry_len_{0};
+    size_t records_{0};
+    u16 tx_seq_{0};
+    u16 expected_{0};
+    bool synced_{false};
+    bridge_stats stats_{};
+};
+
+}  // namespace emCore::messaging
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <cstddef>
+
+#include "../core/types.hpp"
+#include "../core/config.hpp"
+#include "../os/tasks.hpp"
+
+#include <etl/array.h>
+#include <etl/atomic.h>
+
+namespace emCore::messaging {
+
+enum class drop_reason : u8 {
+    depth_limit = 0,     // subscriber mailbox full (or its topic queue full)
+    slot_exhausted = 1,  // no envelope / pool slot for the message
+    unknown_topic = 2    // topic not registered or without subscribers
+};
+inline constexpr size_t drop_reason_count = 3;
+
+struct topic_metrics {
+    u16 topic_id{0xFFFF};
+    u16 subscribers{0};
+    u32 published{0};   // publish calls that reached the topic
+    u32 delivered{0};   // copies queued to subscribers (delivered / published = fan-out)
+    u32 dropped{0};     // copies refused, any reason
+};
+
+struct mailbox_metrics {
+    task_id_t task_id{invalid_task_id};
+    u16 depth{0};
+    u16 depth_high_water{0};
+    u32 received{0};
+    u32 dropped{0};     // sends this mailbox refused
+    u32 evicted{0};     // queued messages displaced by drop-oldest
+    u32 notifies{0};    // owner wake-ups issued
+};
+
+template <size_t MaxTopics, size_t MaxMailboxes>
+struct broker_metrics_snapshot {
+    timestamp_t timestamp_us{0};
+    u32 sent{0};
+    u32 received{0};
+    etl::array<u32, drop_reason_count> dropped{};
+    etl::array<topic_metrics, MaxTopics> topics{};
+    size_t topic_count{0};
+    etl::array<mailbox_metrics, MaxMailboxes> mailboxes{};
+    size_t mailbox_count{0};
+    bool consistent{true};  // false if a writer kept a core's counters busy for every retry
+
+    [[nodiscard]] u32 dropped_total() const noexcept {
+        u32 n = 0;
+        for (const u32 d : dropped) { n += d; }
+        return n;
+    }
+};
+
+/**
+ * @brief Broker counters split per core, each block guarded by a multi-writer seqlock
+ *
+ * Writers touch only the block of the core they run on: relaxed atomic adds,
+ * bracketed by a sync word whose low half counts writers inside the block and
+ * whose high half is bumped by every writer leaving it. A reader accepts a
+ * block when no writer was inside and the word did not move while it copied
+ * the counters, so a snapshot never mixes half of a publish with its
+ * neighbours, and publishers never wait for readers.
+ */
+template <size_t MaxTopics, size_t MaxMailboxes>
+class broker_metrics {
+    // One core's counters; the copy read by collect() mirrors the atomics
+    struct core_counters {
+        struct counters {
+            u32 sent;
+            u32 received;
+            etl::array<u32, drop_reason_count> dropped;
+            etl::array<u32, MaxTopics> topic_published;
+            etl::array<u32, MaxTopics> topic_delivered;
+            etl::array<u32, MaxTopics> topic_dropped;
+            etl::array<u32, MaxMailboxes> mailbox_dropped;
+        };
+
+        etl::atomic<u32> sync{0};
+        etl::atomic<u32> sent{0};
+        etl::atomic<u32> received{0};
+        etl::array<etl::atomic<u32>, drop_reason_count> dropped{};
+        etl::array<etl::atomic<u32>, MaxTopics> topic_published{};
+        etl::array<etl::atomic<u32>, MaxTopics> topic_delivered{};
+        etl::array<etl::atomic<u32>, MaxTopics> topic_dropped{};
+        etl::array<etl::atomic<u32>, MaxMailboxes> mailbox_dropped{};
+
+        template <size_t N>
+        static void copy_all(const etl::array<etl::atomic<u32>, N>& from, etl::array<u32, N>& to) noexcept {
+            for (size_t i = 0; i < N; ++i) { to[i] = from[i].load(etl::memory_order_acquire); }
+        }
+
+        // Copy the block; false if every attempt overlapped a writer (the last copy is kept)
+        bool read(counters& out, size_t attempts) const noexcept {
+            for (size_t i = 0; i < attempts; ++i) {
+                const u32 before = sync.load(etl::memory_order_acquire);
+                out.sent = sent.load(etl::memory_order_acquire);
+                out.received = received.load(etl::memory_order_acquire);
+                copy_all(dropped, out.dropped);
+                copy_all(topic_published, out.topic_published);
+                copy_all(topic_delivered, out.topic_delivered);
+                copy_all(topic_dropped, out.topic_dropped);
+                copy_all(mailbox_dropped, out.mailbox_dropped);
+                if ((before & 0xFFFFU) == 0U && sync.load(etl::memory_order_acquire) == before) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    /*
+     * Blocks are padded to a whole number of cache lines rather than
+     * over-aligned, so the broker keeps the arena's 8-byte alignment.
+     */
+    static constexpr size_t core_block_pad =
+        (config::cache_line_bytes - (sizeof(core_counters) % config::cache_line_bytes)) % config::cache_line_bytes;
+
+    template <size_t Pad, bool = (Pad == 0U)>
+    struct padded_block : core_counters {
+        u8 pad[Pad];
+    };
+    template <size_t Pad>
+    struct padded_block<Pad, true> : core_counters {};
+
+    using core_block = padded_block<core_block_pad>;
+    static_assert(sizeof(core_block) % config::cache_line_bytes == 0, "core_block must fill whole cache lines");
+
+public:
+    using snapshot_t = broker_metrics_snapshot<MaxTopics, MaxMailboxes>;
+    static constexpr size_t read_retries = 8;
+
+    /* RAII write section on the calling core's block */
+    class writer {
+    public:
+        explicit writer(broker_metrics& owner) noexcept : block_(owner.local()) {
+            block_.sync.fetch_add(1U, etl::memory_order_acq_rel);
+        }
+        ~writer() noexcept { block_.sync.fetch_add(0xFFFFU, etl::memory_order_release); }  // -1 writer, +1 generation
+        writer(const writer&) = delete;
+        writer& operator=(const writer&) = delete;
+        writer(writer&&) = delete;
+        writer& operator=(writer&&) = delete;
+
+        void published(size_t topic) noexcept { bump(block_.topic_published, topic); }
+        void delivered(size_t topic, u32 n = 1U) noexcept {
+            block_.sent.fetch_add(n, etl::memory_order_relaxed);
+            bump(block_.topic_delivered, topic, n);
+        }
+        void dropped(drop_reason why, size_t topic, size_t mailbox, u32 n = 1U) noexcept {
+            if (n == 0U) { return; }
+            block_.dropped[static_cast<size_t>(why)].fetch_add(n, etl::memory_order_relaxed);
+            bump(block_.topic_dropped, topic, n);
+            bump(block_.mailbox_dropped, mailbox, n);
+        }
+        void received(u32 n = 1U) noexcept { block_.received.fetch_add(n, etl::memory_order_relaxed); }
+
+    private:
+        template <size_t N>
+        static void bump(etl::array<etl::atomic<u32>, N>& counters, size_t i, u32 n = 1U) noexcept {
+            if (i < N) { counters[i].fetch_add(n, etl::memory_order_relaxed); }
+        }
+
+        core_block& block_;
+    };
+
+    broker_metrics() noexcept = default;
+    broker_metrics(const broker_metrics&) = delete;
+    broker_metrics& operator=(const broker_metrics&) = delete;
+    broker_metrics(broker_metrics&&) = delete;
+    broker_metrics& operator=(broker_metrics&&) = delete;
+
+    [[nodiscard]] writer write() noexcept { return writer(*this); }
+
+    /* Depth seen right after a send; keeps the per-mailbox maximum */
+    void observe_depth(size_t mailbox, u16 depth) noexcept {
+        if (mailbox >= MaxMailboxes) { return; }
+        u32 peak = depth_high_water_[mailbox].load(etl::memory_order_relaxed);
+        while (depth > peak && !depth_high_water_[mailbox].compare_exchange_weak(peak, depth, etl::memory_order_relaxed)) {}
+    }
+    [[nodiscard]] u16 depth_high_water(size_t mailbox) const noexcept {
+        return (mailbox < MaxMailboxes) ? static_cast<u16>(depth_high_water_[mailbox].load(etl::memory_order_relaxed)) : 0U;
+    }
+
+    /*
+     * Sum the per-core blocks into out (global, topic and mailbox drop counters).
+     * The broker fills in ids, depths and the per-mailbox fields it owns.
+     */
+    void collect(snapshot_t& out) const noexcept {
+        out.consistent = true;
+        for (const core_block& block : blocks_) {
+            typename core_counters::counters copy{};
+            if (!block.read(copy, read_retries)) {
+                out.consistent = false;
+            }
+            out.sent += copy.sent;
+            out.received += copy.received;
+            for (size_t r = 0; r < drop_reason_count; ++r) { out.dropped[r] += copy.dropped[r]; }
+            for (size_t t = 0; t < MaxTopics; ++t) {
+                out.topics[t].published += copy.topic_published[t];
+                out.topics[t].delivered += copy.topic_delivered[t];
+                out.topics[t].dropped += copy.topic_dropped[t];
+            }
+            for (size_t m = 0; m < MaxMailboxes; ++m) { out.mailboxes[m].dropped += copy.mailbox_dropped[m]; }
+        }
+        for (size_t m = 0; m < MaxMailboxes; ++m) { out.mailboxes[m].depth_high_water = depth_high_water(m); }
+    }
+
+    /* Unsynchronised totals (each one exact, not mutually consistent) */
+    [[nodiscard]] u32 total_sent() const noexcept { return sum(&core_counters::sent); }
+    [[nodiscard]] u32 total_received() const noexcept { return sum(&core_counters::received); }
+    [[nodiscard]] u32 total_dropped() const noexcept {
+        u32 n = 0;
+        for (const core_block& block : blocks_) {
+            for (const auto& d : block.dropped) { n += d.load(etl::memory_order_relaxed); }
+        }
+        return n;
+    }
+
+private:
+    core_block& local() noexcept { return blocks_[os::current_core() % config::max_cpu_cores]; }
+
+    u32 sum(etl::atomic<u32> core_counters::*field) const noexcept {
+        u32 n = 0;
+        for (const core_block& block : blocks_) { n += (block.*field).load(etl::memory_order_relaxed); }
+        return n;
+    }
+
+    etl::array<core_block, config::max_cpu_cores> blocks_{};
+    etl::array<etl::atomic<u32>, MaxMailboxes> depth_high_water_{};
+};
+
+}  // namespace emCore::messaging
@@ -7,38 +7,62 @@
 #include "message_types.hpp"
 #include "message_broker.hpp" // for Ibroker
 
+#include <etl/array.h>
 #include <etl/map.h>
 
 namespace emCore::messaging {
 
 // Distributed state machine: proposal -> majority ACK -> commit
 // Uses small_message for coordination payloads.
+//
+// Up to MaxOutstanding proposals are in flight at once; they commit strictly in
+// proposal order, so a later proposal that reaches quorum first waits for the
+// earlier ones. Every commit carries the version of the state it produces (the
+// initial state is version 0). Proposals and commits travel as a byte-granular
+// delta against a committed state, identified by its version, whenever that is
+// shorter than the full StateT; a peer that no longer holds the base version
+// drops the delta, and every KeyframeInterval-th commit is sent in full so it
+// resynchronises. The delta mask covers 16 bytes, so a larger StateT always
+// travels in full.
 template <typename StateT,
           u16 ProposeTopicId, u16 AckTopicId, u16 CommitTopicId,
           size_t MaxPeers,
-          size_t MaxOutstanding = 4>
+          size_t MaxOutstanding = 4,
+          size_t KeyframeInterval = 8>
 class distributed_state {
 public:
     static_assert(sizeof(StateT) <= small_payload_size - 6, "StateT too large for small_message payload");
 
     distributed_state(broker_uptr<small_message>& broker, task_id_t self_task_id, const StateT& initial) noexcept
-        : broker_(*broker), self_task_id_(self_task_id), state_(initial) {}
+        : broker_(*broker), self_task_id_(self_task_id), state_(initial) { remember_(initial, 0); }
 
     // New: allow constructing with a non-owning broker reference (no unique_ptr required)
     distributed_state(Ibroker<small_message>& broker, task_id_t self_task_id, const StateT& initial) noexcept
-        : broker_(broker), self_task_id_(self_task_id), state_(initial) {}
+        : broker_(broker), self_task_id_(self_task_id), state_(initial) { remember_(initial, 0); }
 
     // Start a new proposal; returns sequence (>0) or 0 if queue full
     u16 propose(const StateT& new_state) noexcept {
         if (pending_.size() >= pending_.capacity()) { return 0; }
         const u16 seq = static_cast<u16>(local_seq_++);
-        pending_info info{}; info.state = new_state; info.acks = 1; (void)pending_.insert(typename pending_map::value_type(seq, info));
+        if (seq == 0) { return propose(new_state); }  // 0 is the "queue full" sentinel
+        pending_info info{}; info.state = new_state; info.acks = 1; info.quorum = false;
+        (void)pending_.insert(typename pending_map::value_type(seq, info));
+        if (pending_.size() == 1U) { commit_cursor_ = seq; }
         small_message msg{}; msg.header.type = ProposeTopicId; msg.header.sender_id = self_task_id_.value(); msg.header.receiver_id = 0xFFFF; msg.header.sequence_number = seq;
-        msg.header.payload_size = encode_proposal_(&msg.payload[0], seq, self_task_id_.value(), new_state); msg.header.timestamp = os::time_us();
+        msg.header.payload_size = encode_proposal_(&msg.payload[0], seq, self_task_id_.value(), version_, new_state); msg.header.timestamp = os::time_us();
         (void)broker_.publish(ProposeTopicId, msg, self_task_id_);
         return seq;
     }
 
+    // Give up on a proposal that cannot reach quorum; later ones may then commit
+    bool abort(u16 seq) noexcept {
+        auto iter = pending_.find(seq);
+        if (iter == pending_.end()) { return false; }
+        pending_.erase(iter);
+        commit_ready_();
+        return true;
+    }
+
     // Process incoming messages for coordination. Guard decides acceptance.
     template <typename GuardFn>
     void process_message(const small_message& msg, const GuardFn& guard) noexcept {
@@ -47,30 +71,96 @@ public:
         else if (msg.header.type == CommitTopicId) { on_commit_(msg); }
     }
 
+    [[nodiscard]] size_t outstanding() const noexcept { return pending_.size(); }
+
+    // Delta messages dropped because their base state was not in the local history
+    [[nodiscard]] u32 base_misses() const noexcept { return base_misses_; }
+
     [[nodiscard]] StateT current() const noexcept { return state_; }
+    // Version of current(): the number of commits that led to it
+    [[nodiscard]] u16 version() const noexcept { return version_; }
 
 private:
-    struct pending_info { StateT state; u16 acks; };
+    struct pending_info { StateT state; u16 acks; bool quorum; };
     using pending_map = etl::map<u16, pending_info, MaxOutstanding>;
 
-    // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-    static u16 encode_proposal_(u8* dst, u16 seq, u16 from, const StateT& state_obj) noexcept {
-        u8* ptr = dst; *ptr++ = static_cast<u8>(seq & 0xFF); *ptr++ = static_cast<u8>((seq >> 8) & 0xFF);
-        *ptr++ = static_cast<u8>(from & 0xFF); *ptr++ = static_cast<u8>((from >> 8) & 0xFF);
+    static constexpr size_t full_proposal_size = 4 + sizeof(StateT);
+    static constexpr size_t full_commit_size = 4 + sizeof(StateT);
+    static constexpr bool delta_capable = sizeof(StateT) <= 16;
+    // Shortest accepted payloads: an empty delta (base version + mask) or the full state, whichever is smaller
+    static constexpr size_t min_proposal_size = (delta_capable && 8 < full_proposal_size) ? 8 : full_proposal_size;
+    static constexpr size_t min_commit_size = (delta_capable && 8 < full_commit_size) ? 8 : full_commit_size;
+    static constexpr size_t history_depth = MaxOutstanding + 1;
+
+    static void put16_(u8*& ptr, u16 value) noexcept { *ptr++ = static_cast<u8>(value & 0xFF); *ptr++ = static_cast<u8>((value >> 8) & 0xFF); }
+    static u16 get16_(const u8* ptr) noexcept { return static_cast<u16>(ptr[0] | (static_cast<u16>(ptr[1]) << 8)); }
+
+    static size_t changed_bytes_(const StateT& base, const StateT& next) noexcept {
+        const u8* bptr = reinterpret_cast<const u8*>(&base); const u8* nptr = reinterpret_cast<const u8*>(&next);
+        size_t count = 0;
+        for (size_t i = 0; i < sizeof(StateT); ++i) { if (bptr[i] != nptr[i]) { ++count; } }
+        return count;
+    }
+
+    // Delta body: base version, changed-byte mask, changed bytes in order
+    static u8* encode_delta_(u8* ptr, u16 base_version, const StateT& base, const StateT& next) noexcept {
+        const u8* bptr = reinterpret_cast<const u8*>(&base); const u8* nptr = reinterpret_cast<const u8*>(&next);
+        put16_(ptr, base_version);
+        u8* mask_ptr = ptr; ptr += 2;
+        u16 mask = 0;
+        for (size_t i = 0; i < sizeof(StateT); ++i) {
+            if (bptr[i] != nptr[i]) { mask = static_cast<u16>(mask | (1U << i)); *ptr++ = nptr[i]; }
+        }
+        put16_(mask_ptr, mask);
+        return ptr;
+    }
+
+    // Rebuilds the target state from a delta body; false when the base is unknown
+    bool decode_delta_(const u8* body, size_t len, StateT& out_state) noexcept {
+        if (len < 4) { return false; }
+        const StateT* base = find_base_(get16_(body));
+        if (base == nullptr) { ++base_misses_; return false; }
+        const u16 mask = get16_(body + 2);
+        const u8* src = body + 4; const u8* end = body + len;
+        out_state = *base;
+        u8* dst_ptr = reinterpret_cast<u8*>(&out_state);
+        for (size_t i = 0; i < sizeof(StateT); ++i) {
+            if ((mask & (1U << i)) == 0U) { continue; }
+            if (src == end) { return false; }
+            dst_ptr[i] = *src++;
+        }
+        return true;
+    }
+
+    static void copy_state_(u8*& ptr, const StateT& state_obj) noexcept {
         const u8* sptr = reinterpret_cast<const u8*>(&state_obj);
         for (size_t i = 0; i < sizeof(StateT); ++i) { *ptr++ = *sptr++; }
+    }
+
+    static void read_state_(const u8* src, StateT& out_state) noexcept {
+        u8* dst_ptr = reinterpret_cast<u8*>(&out_state);
+        for (size_t i = 0; i < sizeof(StateT); ++i) { dst_ptr[i] = src[i]; }
+    }
+
+    // A delta needs its base in the history; otherwise the state goes in full
+    // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+    u16 encode_proposal_(u8* dst, u16 seq, u16 from, u16 base_version, const StateT& state_obj) const noexcept {
+        u8* ptr = dst; put16_(ptr, seq); put16_(ptr, from);
+        const StateT* base = delta_capable ? find_base_(base_version) : nullptr;
+        if (base != nullptr && 8 + changed_bytes_(*base, state_obj) < full_proposal_size) { ptr = encode_delta_(ptr, base_version, *base, state_obj); }
+        else { copy_state_(ptr, state_obj); }
         return static_cast<u16>(ptr - dst);
     }
 
     // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-    static bool decode_proposal_(const small_message& msg, u16& seq, u16& from, StateT& out_state) noexcept {
-        if (msg.header.payload_size < (sizeof(StateT) + 4)) { return false; }
+    bool decode_proposal_(const small_message& msg, u16& seq, u16& from, StateT& out_state) noexcept {
+        if (msg.header.payload_size < min_proposal_size || msg.header.payload_size > full_proposal_size) { return false; }
         const u8* payload_ptr = &msg.payload[0];
-        seq = static_cast<u16>(payload_ptr[0] | (static_cast<u16>(payload_ptr[1]) << 8));
-        from = static_cast<u16>(payload_ptr[2] | (static_cast<u16>(payload_ptr[3]) << 8));
-        u8* dst_ptr = reinterpret_cast<u8*>(&out_state);
-        for (size_t i = 0; i < sizeof(StateT); ++i) { dst_ptr[i] = payload_ptr[4 + i]; }
-        return true;
+        seq = get16_(payload_ptr);
+        from = get16_(payload_ptr + 2);
+        if (msg.header.payload_size == full_proposal_size) { read_state_(payload_ptr + 4, out_state); return true; }
+        if (!delta_capable) { return false; }
+        return decode_delta_(payload_ptr + 4, msg.header.payload_size - 4U, out_state);
     }
 
     // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
@@ -88,25 +178,32 @@ private:
         from = static_cast<u16>(payload_ptr[2] | (static_cast<u16>(payload_ptr[3]) << 8)); accept = (payload_ptr[4] != 0); return true;
     }
 
-    static u16 encode_commit_(u8* dst, u16 seq, const StateT& state_obj) noexcept {
-        u8* ptr = dst; *ptr++ = static_cast<u8>(seq & 0xFF); *ptr++ = static_cast<u8>((seq >> 8) & 0xFF);
-        const u8* sptr = reinterpret_cast<const u8*>(&state_obj); for (size_t i = 0; i < sizeof(StateT); ++i) { *ptr++ = *sptr++; }
+    // Commit body: proposal seq, version of the committed state, then the state or a delta
+    // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+    u16 encode_commit_(u8* dst, u16 seq, u16 version, const StateT& state_obj, bool keyframe) const noexcept {
+        u8* ptr = dst; put16_(ptr, seq); put16_(ptr, version);
+        const u16 base_version = static_cast<u16>(version - 1U);
+        const StateT* base = (delta_capable && !keyframe) ? find_base_(base_version) : nullptr;
+        if (base != nullptr && 8 + changed_bytes_(*base, state_obj) < full_commit_size) { ptr = encode_delta_(ptr, base_version, *base, state_obj); }
+        else { copy_state_(ptr, state_obj); }
         return static_cast<u16>(ptr - dst);
     }
 
-    static bool decode_commit_(const small_message& msg, u16& seq, StateT& out_state) noexcept {
-        if (msg.header.payload_size < (sizeof(StateT) + 2)) { return false; }
+    bool decode_commit_(const small_message& msg, u16& seq, u16& version, StateT& out_state) noexcept {
+        if (msg.header.payload_size < min_commit_size || msg.header.payload_size > full_commit_size) { return false; }
         const u8* payload_ptr = &msg.payload[0];
-        seq = static_cast<u16>(payload_ptr[0] | (static_cast<u16>(payload_ptr[1]) << 8));
-        u8* dst_ptr = reinterpret_cast<u8*>(&out_state); for (size_t i = 0; i < sizeof(StateT); ++i) { dst_ptr[i] = payload_ptr[2 + i]; }
-        return true;
+        seq = get16_(payload_ptr);
+        version = get16_(payload_ptr + 2);
+        if (msg.header.payload_size == full_commit_size) { read_state_(payload_ptr + 4, out_state); return true; }
+        if (!delta_capable) { return false; }
+        return decode_delta_(payload_ptr + 4, msg.header.payload_size - 4U, out_state);
     }
 
     template <typename GuardFn>
     void on_propose_(const small_message& msg, const GuardFn& guard) noexcept {
         u16 seq = 0; u16 from = 0; StateT proposed{};
+        if (get16_(&msg.payload[2]) == self_task_id_.value()) { return; }
         if (!decode_proposal_(msg, seq, from, proposed)) { return; }
-        if (from == self_task_id_.value()) { return; }
         const bool accept = guard(state_, proposed);
         if (accept) {
             small_message ack{}; ack.header.type = AckTopicId; ack.header.sender_id = self_task_id_.value(); ack.header.receiver_id = from; ack.header.sequence_number = seq;
@@ -122,24 +219,66 @@ private:
         auto iter = pending_.find(seq);
         if (iter == pending_.end()) { return; }
         pending_info& info = iter->second; ++info.acks; const u16 majority = static_cast<u16>((MaxPeers / 2) + 1);
-        if (info.acks >= majority) {
-            state_ = info.state;
-            small_message commit{}; commit.header.type = CommitTopicId; commit.header.sender_id = self_task_id_.value(); commit.header.receiver_id = 0xFFFF; commit.header.sequence_number = seq;
-            commit.header.payload_size = encode_commit_(&commit.payload[0], seq, state_); commit.header.timestamp = os::time_us();
+        if (!info.quorum && info.acks >= majority) {
+            info.quorum = true;
+            commit_ready_();
+        }
+    }
+
+    // Commit the contiguous run of quorate proposals starting at the oldest one
+    void commit_ready_() noexcept {
+        while (!pending_.empty()) {
+            auto iter = pending_.find(commit_cursor_);
+            if (iter == pending_.end()) { ++commit_cursor_; continue; }  // aborted
+            if (!iter->second.quorum) { return; }
+            state_ = iter->second.state;
+            version_ = static_cast<u16>(version_ + 1U);
+            remember_(state_, version_);
+            const bool keyframe = (KeyframeInterval == 0U) || ((++commits_since_keyframe_ % KeyframeInterval) == 0U);
+            small_message commit{}; commit.header.type = CommitTopicId; commit.header.sender_id = self_task_id_.value(); commit.header.receiver_id = 0xFFFF; commit.header.sequence_number = commit_cursor_;
+            commit.header.payload_size = encode_commit_(&commit.payload[0], commit_cursor_, version_, state_, keyframe); commit.header.timestamp = os::time_us();
             (void)broker_.publish(CommitTopicId, commit, self_task_id_);
             pending_.erase(iter);
+            ++commit_cursor_;
         }
     }
 
     void on_commit_(const small_message& msg) noexcept {
-        u16 seq = 0; (void)seq; StateT committed{}; if (!decode_commit_(msg, seq, committed)) { return; } state_ = committed;
+        if (msg.header.sender_id == self_task_id_.value()) { return; }
+        u16 seq = 0; (void)seq; u16 version = 0; StateT committed{};
+        if (!decode_commit_(msg, seq, version, committed)) { return; }
+        state_ = committed; version_ = version; remember_(committed, version);
+    }
+
+    // Recent committed states keyed by version, so deltas against a slightly older base still decode
+    void remember_(const StateT& state_obj, u16 version) noexcept {
+        history_[history_head_] = state_obj;
+        history_version_[history_head_] = version;
+        history_head_ = (history_head_ + 1) % history_depth;
+        if (history_count_ < history_depth) { ++history_count_; }
+    }
+
+    const StateT* find_base_(u16 version) const noexcept {
+        for (size_t n = 0; n < history_count_; ++n) {
+            const size_t slot = (history_head_ + history_depth - 1 - n) % history_depth;  // newest first
+            if (history_version_[slot] == version) { return &history_[slot]; }
+        }
+        return nullptr;
     }
 
     Ibroker<small_message>& broker_;
     task_id_t self_task_id_;
     StateT state_;
     pending_map pending_{};
+    etl::array<StateT, history_depth> history_{};
+    etl::array<u16, history_depth> history_version_{};
+    size_t history_head_{0};
+    size_t history_count_{0};
     u32 local_seq_{1};
+    u16 commit_cursor_{1};
+    u32 commits_since_keyframe_{0};
+    u32 base_misses_{0};
+    u16 version_{0};
 };
 
 } // namespace emCore::messaging
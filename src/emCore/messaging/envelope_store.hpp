@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+#include "../core/types.hpp"
+
+#include <etl/array.h>
+#include <etl/atomic.h>
+
+namespace emCore::messaging {
+
+/**
+ * @brief Fixed pool of reference-counted message envelopes addressed by u16 slot
+ *
+ * Backs the shared-store mailbox policy: a published message is copied into one
+ * slot and every mailbox that queues it holds a reference by index, so storage
+ * is sized for the messages in flight rather than per mailbox. The free list is
+ * a tagged Treiber stack ({tag:16, index:16}, same scheme as
+ * lockfree_zero_copy_pool) and refcounts are atomic, so acquire/retain/release
+ * are safe from any task or ISR without a lock.
+ */
+template <typename MessageType, size_t Capacity>
+class envelope_store {
+public:
+    static_assert(Capacity >= 1 && Capacity < 0xFFFF, "envelope_store supports 1..65534 slots");
+    static constexpr u16 npos = 0xFFFF;
+
+    envelope_store() noexcept {
+        for (size_t i = 0; i < Capacity; ++i) {
+            slots_[i].refs.store(0U, etl::memory_order_relaxed);
+            slots_[i].next.store((i + 1U < Capacity) ? static_cast<u32>(i + 1U) : empty_index, etl::memory_order_relaxed);
+        }
+        free_head_.store(0U, etl::memory_order_release);
+    }
+    ~envelope_store() noexcept {
+        for (size_t i = 0; i < Capacity; ++i) {
+            if (slots_[i].refs.load(etl::memory_order_relaxed) != 0U) { at(static_cast<u16>(i)).~MessageType(); }
+        }
+    }
+    envelope_store(const envelope_store&) = delete;
+    envelope_store& operator=(const envelope_store&) = delete;
+    envelope_store(envelope_store&&) = delete;
+    envelope_store& operator=(envelope_store&&) = delete;
+
+    // Copy msg into a free slot holding one reference; npos when the store is exhausted
+    u16 acquire(const MessageType& msg) noexcept {
+        const u32 idx = pop_free();
+        if (idx == empty_index) {
+            exhausted_.fetch_add(1U, etl::memory_order_relaxed);
+            return npos;
+        }
+        ::new (static_cast<void*>(slots_[idx].bytes)) MessageType(msg);
+        slots_[idx].refs.store(1U, etl::memory_order_release);
+        const u32 used = in_use_.fetch_add(1U, etl::memory_order_relaxed) + 1U;
+        u32 peak = high_water_.load(etl::memory_order_relaxed);
+        while (used > peak && !high_water_.compare_exchange_weak(peak, used, etl::memory_order_relaxed)) {}
+        return static_cast<u16>(idx);
+    }
+
+    void retain(u16 idx) noexcept { slots_[idx].refs.fetch_add(1U, etl::memory_order_relaxed); }
+
+    // Drop one reference; the last one destroys the envelope and frees the slot
+    void release(u16 idx) noexcept {
+        if (slots_[idx].refs.fetch_sub(1U, etl::memory_order_acq_rel) == 1U) {
+            at(idx).~MessageType();
+            in_use_.fetch_sub(1U, etl::memory_order_relaxed);
+            push_free(idx);
+        }
+    }
+
+    MessageType& at(u16 idx) noexcept { return *std::launder(reinterpret_cast<MessageType*>(slots_[idx].bytes)); }
+    const MessageType& at(u16 idx) const noexcept {
+        return *std::launder(reinterpret_cast<const MessageType*>(slots_[idx].bytes));
+    }
+
+    static constexpr size_t capacity() noexcept { return Capacity; }
+    [[nodiscard]] size_t in_use() const noexcept { return in_use_.load(etl::memory_order_relaxed); }
+    [[nodiscard]] size_t available() const noexcept { return Capacity - in_use(); }
+    [[nodiscard]] size_t high_water() const noexcept { return high_water_.load(etl::memory_order_relaxed); }
+    [[nodiscard]] u32 exhausted_count() const noexcept { return exhausted_.load(etl::memory_order_relaxed); }
+
+private:
+    static constexpr u32 index_mask = 0xFFFFU;
+    static constexpr u32 empty_index = 0xFFFFU;
+
+    struct slot {
+        alignas(MessageType) unsigned char bytes[sizeof(MessageType)];
+        etl::atomic<u32> refs;
+        etl::atomic<u32> next;
+    };
+
+    static constexpr u32 next_tag(u32 head) noexcept { return (head & ~index_mask) + 0x10000U; }
+
+    u32 pop_free() noexcept {
+        u32 head = free_head_.load(etl::memory_order_acquire);
+        for (;;) {
+            const u32 idx = head & index_mask;
+            if (idx == empty_index) { return empty_index; }
+            const u32 next = slots_[idx].next.load(etl::memory_order_relaxed);
+            const u32 replacement = next_tag(head) | (next & index_mask);
+            if (free_head_.compare_exchange_weak(head, replacement, etl::memory_order_acq_rel, etl::memory_order_acquire)) {
+                return idx;
+            }
+        }
+    }
+
+    void push_free(u32 idx) noexcept {
+        u32 head = free_head_.load(etl::memory_order_relaxed);
+        for (;;) {
+            slots_[idx].next.store(head & index_mask, etl::memory_order_relaxed);
+            const u32 replacement = next_tag(head) | idx;
+            if (free_head_.compare_exchange_weak(head, replacement, etl::memory_order_release, etl::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+
+    etl::array<slot, Capacity> slots_;
+    etl::atomic<u32> free_head_{empty_index};
+    etl::atomic<u32> in_use_{0};
+    etl::atomic<u32> high_water_{0};
+    etl::atomic<u32> exhausted_{0};
+};
+
+}  // namespace emCore::messaging
@@ -8,6 +8,7 @@
 #include "message_types.hpp"
 
 #include <etl/array.h>
+#include <etl/span.h>
 
 namespace emCore::messaging {
 
@@ -47,21 +48,106 @@ public:
 
     template <typename Fn>
     void replay_from(u64 from_index, Fn&& func) const noexcept {
-        cs_.enter(); size_t count = size_; size_t pos = head_;
-        while (count--) { if (indices_[pos] >= from_index) { break; } pos = (pos + 1) % Capacity; }
-        size_t remaining = count + 1;
+        cs_.enter();
+        const u64 first = (from_index > oldest_index()) ? from_index : oldest_index();
+        size_t remaining = (first < next_index_) ? static_cast<size_t>(next_index_ - first) : 0U;
+        size_t pos = slot_of(first);
         while (remaining--) { const EventT& evt = buffer_[pos]; const u64 idx = indices_[pos]; cs_.exit(); std::forward<Fn>(func)(idx, evt); cs_.enter(); pos = (pos + 1) % Capacity; }
         cs_.exit();
     }
 
-    [[nodiscard]] stats get_stats() const noexcept { cs_.enter(); stats sts{appended_, dropped_, 0, size_, Capacity}; cs_.exit(); return sts; }
+    // Independent tailing cursor with O(1) seek; counts events lost to DropOldest
+    class reader {
+    public:
+        explicit reader(const event_log& log) noexcept : log_(log) {
+            log_.cs_.enter(); next_ = log_.oldest_index(); ++log_.readers_; log_.cs_.exit();
+        }
+        ~reader() { log_.cs_.enter(); --log_.readers_; log_.cs_.exit(); }
+        reader(const reader&) = delete;
+        reader& operator=(const reader&) = delete;
+        reader(reader&&) = delete;
+        reader& operator=(reader&&) = delete;
+
+        // Position at index (clamped to the retained window)
+        void seek(u64 index) noexcept {
+            log_.cs_.enter();
+            const u64 oldest = log_.oldest_index();
+            next_ = (index < oldest) ? oldest : ((index > log_.next_index_) ? log_.next_index_ : index);
+            log_.cs_.exit();
+        }
+        void seek_oldest() noexcept { seek(0); }
+        void seek_latest() noexcept { seek(~static_cast<u64>(0)); }
+
+        // Copy up to out.size() events starting at the cursor; first_index receives the index of out[0]
+        size_t read_next(etl::span<EventT> out, u64* first_index = nullptr) noexcept {
+            log_.cs_.enter();
+            catch_up();
+            if (first_index != nullptr) { *first_index = next_; }
+            size_t count = 0;
+            size_t pos = log_.slot_of(next_);
+            while (count < out.size() && next_ < log_.next_index_) {
+                out[count++] = log_.buffer_[pos];
+                pos = (pos + 1) % Capacity;
+                ++next_;
+            }
+            log_.cs_.exit();
+            return count;
+        }
+
+        bool read_next(EventT& out, u64* index = nullptr) noexcept {
+            return read_next(etl::span<EventT>(&out, 1), index) == 1U;
+        }
+
+        // Events appended but not yet read (overwritten ones excluded)
+        [[nodiscard]] u64 lag() const noexcept {
+            log_.cs_.enter();
+            const u64 oldest = log_.oldest_index();
+            const u64 from = (next_ < oldest) ? oldest : next_;
+            const u64 pending = (from < log_.next_index_) ? (log_.next_index_ - from) : 0U;
+            log_.cs_.exit();
+            return pending;
+        }
+
+        // Events this cursor never saw because DropOldest overwrote them
+        [[nodiscard]] u64 overwritten() const noexcept {
+            log_.cs_.enter();
+            const u64 oldest = log_.oldest_index();
+            const u64 missed = overwritten_ + ((next_ < oldest) ? (oldest - next_) : 0U);
+            log_.cs_.exit();
+            return missed;
+        }
+
+        [[nodiscard]] u64 position() const noexcept { return next_; }
+
+    private:
+        void catch_up() noexcept {
+            const u64 oldest = log_.oldest_index();
+            if (next_ < oldest) { overwritten_ += oldest - next_; next_ = oldest; }
+            if (next_ > log_.next_index_) { next_ = log_.next_index_; }  // log was reset
+        }
+
+        const event_log& log_;
+        u64 next_{1};
+        u64 overwritten_{0};
+    };
+
+    [[nodiscard]] u64 oldest_index() const noexcept { return next_index_ - size_; }
+    [[nodiscard]] u64 next_index() const noexcept { return next_index_; }
+
+    [[nodiscard]] stats get_stats() const noexcept { cs_.enter(); stats sts{appended_, dropped_, readers_, size_, Capacity}; cs_.exit(); return sts; }
 
 private:
+    // Indices are contiguous from oldest_index(), so the slot follows from the head (caller holds cs_)
+    size_t slot_of(u64 index) const noexcept {
+        return (head_ + static_cast<size_t>(index - oldest_index())) % Capacity;
+    }
+
     mutable os::critical_section cs_;
     etl::array<EventT, Capacity> buffer_{};
     etl::array<u64, Capacity> indices_{};
     size_t head_{0}; size_t tail_{0}; size_t size_{0};
     u64 next_index_{1}; u64 appended_{0}; u32 dropped_{0};
+    mutable u32 readers_{0};
 };
 
 } // namespace emCore::messaging
@@ -0,0 +1,364 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+
+#include "../core/types.hpp"
+#include "../error/result.hpp"
+#include "../utils/helpers.hpp"
+#include "event_log.hpp"
+
+#include <etl/array.h>
+#include <etl/span.h>
+#include <etl/type_traits.h>
+
+#if defined(EMCORE_PLATFORM_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace emCore::messaging {
+
+/**
+ * @brief On-media header at the start of every persisted segment (one page)
+ *
+ * Records follow the header back to back; record i has log index
+ * first_index + i. crc covers the record bytes, so a torn page write is
+ * rejected on replay.
+ */
+struct segment_header {
+    static constexpr u32 magic_value = 0x45564C47U;  // "EVLG"
+
+    u32 magic;
+    u32 sequence;
+    u64 first_index;
+    u16 record_count;
+    u16 record_size;
+    u8 crc;
+    u8 reserved[3];
+};
+static_assert(sizeof(segment_header) == 24, "segment_header layout must stay fixed on media");
+
+/*
+ * Segment backends expose whole pages (erase units) of a memory-mapped medium:
+ *   size_t page_size() const; size_t page_count() const;
+ *   bool erase_page(size_t page);
+ *   bool program_page(size_t page, const u8* data, size_t length);
+ *   const u8* map_page(size_t page) const;   // readable in place
+ */
+
+/* RAM-backed pages (host tests, retained RAM, or a staging area for another medium) */
+template <size_t PageSize, size_t PageCount>
+class ram_segment_backend {
+public:
+    ram_segment_backend() noexcept { pages_.fill(0xFF); }
+
+    [[nodiscard]] size_t page_size() const noexcept { return PageSize; }
+    [[nodiscard]] size_t page_count() const noexcept { return PageCount; }
+
+    bool erase_page(size_t page) noexcept {
+        if (page >= PageCount) { return false; }
+        std::memset(&pages_[page * PageSize], 0xFF, PageSize);
+        return true;
+    }
+    bool program_page(size_t page, const u8* data, size_t length) noexcept {
+        if (page >= PageCount || length > PageSize) { return false; }
+        std::memcpy(&pages_[page * PageSize], data, length);
+        return true;
+    }
+    [[nodiscard]] const u8* map_page(size_t page) const noexcept {
+        return (page < PageCount) ? &pages_[page * PageSize] : nullptr;
+    }
+
+private:
+    alignas(8) etl::array<u8, PageSize * PageCount> pages_{};
+};
+
+/*
+ * Memory-mapped flash region (ESP32 partition, STM32 internal flash). The
+ * integrator binds the erase/program routines and the mapped base address, e.g.
+ *   ESP32: esp_partition_mmap() for base, esp_partition_erase_range()/esp_partition_write()
+ *   STM32: flash bank address for base, HAL_FLASHEx_Erase()/HAL_FLASH_Program() loops
+ * Offsets passed to the callbacks are relative to the start of the region.
+ */
+class mapped_flash_backend {
+public:
+    using erase_fn = bool (*)(size_t offset, size_t length);
+    using program_fn = bool (*)(size_t offset, const u8* data, size_t length);
+
+    mapped_flash_backend(const u8* base, size_t page_size, size_t page_count,
+                         erase_fn erase, program_fn program) noexcept
+        : base_(base), page_size_(page_size), page_count_(page_count), erase_(erase), program_(program) {}
+
+    [[nodiscard]] size_t page_size() const noexcept { return page_size_; }
+    [[nodiscard]] size_t page_count() const noexcept { return page_count_; }
+
+    bool erase_page(size_t page) noexcept {
+        return page < page_count_ && erase_ != nullptr && erase_(page * page_size_, page_size_);
+    }
+    bool program_page(size_t page, const u8* data, size_t length) noexcept {
+        return page < page_count_ && length <= page_size_ && program_ != nullptr && program_(page * page_size_, data, length);
+    }
+    [[nodiscard]] const u8* map_page(size_t page) const noexcept {
+        return (base_ != nullptr && page < page_count_) ? base_ + page * page_size_ : nullptr;
+    }
+
+private:
+    const u8* base_;
+    size_t page_size_;
+    size_t page_count_;
+    erase_fn erase_;
+    program_fn program_;
+};
+
+#if defined(EMCORE_PLATFORM_POSIX)
+/* File-backed pages via a shared mmap; the file is created and sized on open() */
+class mmap_file_backend {
+public:
+    mmap_file_backend(size_t page_size, size_t page_count) noexcept
+        : page_size_(page_size), page_count_(page_count) {}
+    ~mmap_file_backend() { close(); }
+    mmap_file_backend(const mmap_file_backend&) = delete;
+    mmap_file_backend& operator=(const mmap_file_backend&) = delete;
+    mmap_file_backend(mmap_file_backend&&) = delete;
+    mmap_file_backend& operator=(mmap_file_backend&&) = delete;
+
+    result<void, error_code> open(const char* path) noexcept {
+        close();
+        const size_t bytes = page_size_ * page_count_;
+        fd_ = ::open(path, O_RDWR | O_CREAT, 0644);
+        if (fd_ < 0) { return result<void, error_code>(error_code::hardware_error); }
+        const off_t existing = ::lseek(fd_, 0, SEEK_END);
+        if (existing < static_cast<off_t>(bytes)) {
+            // Fresh or short file: pad with erased (0xFF) pages
+            if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) { close(); return result<void, error_code>(error_code::hardware_error); }
+        }
+        void* map = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (map == MAP_FAILED) { close(); return result<void, error_code>(error_code::hardware_error); }
+        base_ = static_cast<u8*>(map);
+        if (existing < static_cast<off_t>(bytes)) {
+            const size_t first_new = static_cast<size_t>(existing < 0 ? 0 : existing);
+            std::memset(base_ + first_new, 0xFF, bytes - first_new);
+        }
+        return ok();
+    }
+
+    void close() noexcept {
+        if (base_ != nullptr) { (void)::munmap(base_, page_size_ * page_count_); base_ = nullptr; }
+        if (fd_ >= 0) { (void)::close(fd_); fd_ = -1; }
+    }
+
+    [[nodiscard]] size_t page_size() const noexcept { return page_size_; }
+    [[nodiscard]] size_t page_count() const noexcept { return page_count_; }
+
+    bool erase_page(size_t page) noexcept {
+        if (base_ == nullptr || page >= page_count_) { return false; }
+        std::memset(base_ + page * page_size_, 0xFF, page_size_);
+        return true;
+    }
+    bool program_page(size_t page, const u8* data, size_t length) noexcept {
+        if (base_ == nullptr || page >= page_count_ || length > page_size_) { return false; }
+        u8* dst = base_ + page * page_size_;
+        std::memcpy(dst, data, length);
+        return ::msync(dst, page_size_, MS_ASYNC) == 0;
+    }
+    [[nodiscard]] const u8* map_page(size_t page) const noexcept {
+        return (base_ != nullptr && page < page_count_) ? base_ + page * page_size_ : nullptr;
+    }
+
+private:
+    size_t page_size_;
+    size_t page_count_;
+    int fd_{-1};
+    u8* base_{nullptr};
+};
+#endif
+
+/**
+ * @brief Append-only segment writer that streams log records to a paged medium
+ *
+ * Records are staged in one PageSize RAM buffer and written as a whole
+ * segment (header + records) when the page fills, when the index sequence
+ * breaks, or on flush(). Pages are used as a ring; the oldest segment is
+ * erased when the writer wraps. replay() walks segments oldest-first and
+ * hands out references straight into the mapped medium.
+ *
+ * @tparam EventT Trivially copyable record type (alignment <= 8)
+ * @tparam BackendT Segment backend (see above)
+ * @tparam PageSize Staging/segment size; must not exceed the backend page size
+ */
+template <typename EventT, typename BackendT, size_t PageSize>
+class event_segment_writer {
+public:
+    static_assert(etl::is_trivially_copyable<EventT>::value, "persisted events must be trivially copyable");
+    static_assert(alignof(EventT) <= 8, "persisted events must not need more than 8-byte alignment");
+    static constexpr size_t records_per_segment = (PageSize - sizeof(segment_header)) / sizeof(EventT);
+    static_assert(records_per_segment >= 1, "PageSize too small for one record");
+
+    struct stats {
+        u32 segments_written;
+        u32 records_written;
+        u32 write_errors;
+        u32 sequence;
+    };
+
+    explicit event_segment_writer(BackendT& backend) noexcept : backend_(backend) {}
+
+    /* Find the newest valid segment so appends resume after it */
+    result<void, error_code> mount() noexcept {
+        if (backend_.page_size() < PageSize || backend_.page_count() == 0) {
+            return result<void, error_code>(error_code::invalid_parameter);
+        }
+        bool found = false;
+        for (size_t page = 0; page < backend_.page_count(); ++page) {
+            const segment_header* hdr = valid_segment(page);
+            if (hdr != nullptr && (!found || static_cast<i32>(hdr->sequence - sequence_) > 0)) {
+                found = true;
+                sequence_ = hdr->sequence;
+                next_page_ = (page + 1) % backend_.page_count();
+            }
+        }
+        staged_ = 0;
+        mounted_ = true;
+        return ok();
+    }
+
+    /* Stage one record; a gap in indices closes the current segment first */
+    result<void, error_code> append(u64 index, const EventT& evt) noexcept {
+        if (!mounted_) {
+            return result<void, error_code>(error_code::not_initialized);
+        }
+        if (staged_ != 0 && index != staged_first_ + staged_) {
+            auto flushed = flush();
+            if (!flushed.is_ok()) { return flushed; }
+        }
+        if (staged_ == 0) {
+            staged_first_ = index;
+        }
+        std::memcpy(&staging_[sizeof(segment_header) + staged_ * sizeof(EventT)], &evt, sizeof(EventT));
+        ++staged_;
+        if (staged_ == records_per_segment) {
+            return flush();
+        }
+        return ok();
+    }
+
+    /* Pull everything new from a RAM log cursor into segments */
+    template <typename ReaderT>
+    result<size_t, error_code> drain(ReaderT& reader) noexcept {
+        etl::array<EventT, 8> chunk{};
+        size_t total = 0;
+        for (;;) {
+            u64 first = 0;
+            const size_t n = reader.read_next(etl::span<EventT>(chunk.data(), chunk.size()), &first);
+            for (size_t i = 0; i < n; ++i) {
+                auto appended = append(first + i, chunk[i]);
+                if (!appended.is_ok()) { return result<size_t, error_code>(appended.error()); }
+            }
+            total += n;
+            if (n < chunk.size()) { break; }
+        }
+        return result<size_t, error_code>(total);
+    }
+
+    /* Write the staged records as one segment (no-op when empty) */
+    result<void, error_code> flush() noexcept {
+        if (staged_ == 0) {
+            return ok();
+        }
+        segment_header hdr{};
+        hdr.magic = segment_header::magic_value;
+        hdr.sequence = sequence_ + 1U;
+        hdr.first_index = staged_first_;
+        hdr.record_count = static_cast<u16>(staged_);
+        hdr.record_size = static_cast<u16>(sizeof(EventT));
+        hdr.crc = utils::crc8::calculate(&staging_[sizeof(segment_header)], staged_ * sizeof(EventT));
+        std::memcpy(staging_.data(), &hdr, sizeof(hdr));
+        const size_t length = sizeof(segment_header) + staged_ * sizeof(EventT);
+        if (!backend_.erase_page(next_page_) || !backend_.program_page(next_page_, staging_.data(), length)) {
+            ++write_errors_;
+            return result<void, error_code>(error_code::hardware_error);
+        }
+        sequence_ = hdr.sequence;
+        next_page_ = (next_page_ + 1) % backend_.page_count();
+        ++segments_written_;
+        records_written_ += static_cast<u32>(staged_);
+        staged_ = 0;
+        return ok();
+    }
+
+    /* Visit persisted records oldest-first: fn(u64 index, const EventT& evt), read in place */
+    template <typename Fn>
+    size_t replay(Fn&& fn) const noexcept {
+        return replay_from(0, etl::forward<Fn>(fn));
+    }
+
+    template <typename Fn>
+    size_t replay_from(u64 from_index, Fn&& fn) const noexcept {
+        const size_t pages = backend_.page_count();
+        // Oldest segment = valid page with the lowest sequence relative to the newest
+        size_t start = pages;
+        u32 oldest_seq = 0;
+        for (size_t page = 0; page < pages; ++page) {
+            const segment_header* hdr = valid_segment(page);
+            if (hdr != nullptr && (start == pages || static_cast<i32>(hdr->sequence - oldest_seq) < 0)) {
+                start = page;
+                oldest_seq = hdr->sequence;
+            }
+        }
+        if (start == pages) {
+            return 0;
+        }
+        size_t visited = 0;
+        u32 expected = oldest_seq;
+        for (size_t step = 0; step < pages; ++step) {
+            const size_t page = (start + step) % pages;
+            const segment_header* hdr = valid_segment(page);
+            if (hdr == nullptr || hdr->sequence != expected) {
+                break;
+            }
+            const auto* records = reinterpret_cast<const EventT*>(backend_.map_page(page) + sizeof(segment_header));
+            for (u16 i = 0; i < hdr->record_count; ++i) {
+                const u64 index = hdr->first_index + i;
+                if (index >= from_index) {
+                    fn(index, records[i]);
+                    ++visited;
+                }
+            }
+            ++expected;
+        }
+        return visited;
+    }
+
+    [[nodiscard]] size_t staged() const noexcept { return staged_; }
+    [[nodiscard]] stats get_stats() const noexcept {
+        return stats{segments_written_, records_written_, write_errors_, sequence_};
+    }
+
+private:
+    const segment_header* valid_segment(size_t page) const noexcept {
+        const u8* base = backend_.map_page(page);
+        if (base == nullptr) { return nullptr; }
+        const auto* hdr = reinterpret_cast<const segment_header*>(base);
+        if (hdr->magic != segment_header::magic_value || hdr->record_size != sizeof(EventT) ||
+            hdr->record_count == 0 || hdr->record_count > records_per_segment) {
+            return nullptr;
+        }
+        const u8 crc = utils::crc8::calculate(base + sizeof(segment_header), hdr->record_count * sizeof(EventT));
+        return (crc == hdr->crc) ? hdr : nullptr;
+    }
+
+    BackendT& backend_;
+    alignas(8) etl::array<u8, PageSize> staging_{};
+    size_t staged_{0};
+    u64 staged_first_{0};
+    size_t next_page_{0};
+    u32 sequence_{0};
+    bool mounted_{false};
+    u32 segments_written_{0};
+    u32 records_written_{0};
+    u32 write_errors_{0};
+};
+
+}  // namespace emCore::messaging
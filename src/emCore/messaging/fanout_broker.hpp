@@ -0,0 +1,274 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+
+#include "../core/types.hpp"
+#include "../core/config.hpp"
+#include "../error/result.hpp"
+#include "message_broker.hpp"
+#include "zero_copy.hpp"
+
+#include <etl/span.h>
+#include <etl/vector.h>
+
+namespace emCore::messaging {
+
+/**
+ * @brief Ibroker front-end that switches hot topics to shared-payload fan-out
+ *
+ * Wraps an inline broker (full MessageType copied per mailbox) and a zero-copy
+ * broker (header + refcounted zc_handle per mailbox). A topic takes the shared
+ * path when its zero-copy subscriber count reaches min_subscribers, or when the
+ * envelope payload capacity is at least min_payload bytes; the payload is then
+ * copied once into the pool and every subscriber receives a handle to the same
+ * block. The lane is chosen on the first publish that finds a subscriber and is
+ * kept for the topic, so later subscriptions never reorder its stream. Messages
+ * that do not fit a pool block, or arrive while the pool is exhausted, fall
+ * back to the inline path and may overtake queued shared ones.
+ *
+ * Use receive_with() to read shared payloads in place; receive()/try_receive()
+ * materialise a MessageType for Ibroker compatibility.
+ */
+template <typename MessageType, typename PoolT, size_t MaxTasks = config::max_tasks>
+class fanout_broker : public Ibroker<MessageType> {
+public:
+    using inline_broker_t = message_broker<MessageType, MaxTasks>;
+    using shared_message_t = zc_message_envelope<PoolT>;
+    using shared_broker_t = message_broker<shared_message_t, MaxTasks>;
+
+    static constexpr size_t payload_capacity = sizeof(MessageType{}.payload);
+
+    fanout_broker(inline_broker_t& inline_broker, shared_broker_t& shared_broker, PoolT& pool,
+                  size_t min_subscribers = config::default_fanout_min_subscribers,
+                  size_t min_payload = config::default_fanout_min_payload) noexcept
+        : inline_(inline_broker)
+        , shared_(shared_broker)
+        , pool_(pool)
+        , min_subscribers_(min_subscribers)
+        , min_payload_(min_payload) {}
+
+    /* Register on both lanes so either can deliver to the task */
+    result<void, error_code> register_task(task_id_t task_id, os::task_handle_t handle = nullptr) noexcept {
+        auto inline_result = inline_.register_task(task_id, handle);
+        if (!inline_result.is_ok()) {
+            return inline_result;
+        }
+        return shared_.register_task(task_id, handle);
+    }
+
+    result<void, error_code> subscribe(topic_id_t topic_id, task_id_t subscriber_task_id) noexcept override {
+        auto inline_result = inline_.subscribe(topic_id, subscriber_task_id);
+        if (!inline_result.is_ok()) {
+            return inline_result;
+        }
+        return shared_.subscribe(topic_id, subscriber_task_id);
+    }
+
+    result<void, error_code> publish(u16 topic_id, MessageType& msg, task_id_t from_task_id) noexcept override {
+        if (!use_shared(topic_id, msg)) {
+            return inline_.publish(topic_id, msg, from_task_id);
+        }
+        const u16 size = effective_size(msg);
+        shared_message_t shared{};
+        shared.handle = pool_.allocate(size);
+        if (!shared.handle.valid()) {
+            shared_fallbacks_++;
+            return inline_.publish(topic_id, msg, from_task_id);
+        }
+        std::memcpy(shared.handle.data(), msg.payload, size);
+        shared.header = msg.header;
+        shared.header.payload_size = size;
+        auto publish_result = shared_.publish(topic_id, shared, from_task_id);
+        msg.header = shared.header;  // report the stamped sender/timestamp/sequence back
+        if (publish_result.is_ok()) {
+            shared_published_++;
+        }
+        return publish_result;
+    }
+
+    result<MessageType, error_code> receive(task_id_t task_id, timeout_ms_t timeout) noexcept override {
+        auto immediate = try_receive(task_id);
+        if (immediate.is_ok()) {
+            return immediate;
+        }
+        // Both lanes notify the same task handle, so one wait covers either
+        u32 notification = 0;
+        if (os::wait_notification(timeout.value, &notification) && ((notification & 0x01) != 0)) {
+            return try_receive(task_id);
+        }
+        return result<MessageType, error_code>(error_code::timeout);
+    }
+
+    result<MessageType, error_code> try_receive(task_id_t task_id) noexcept override {
+        MessageType out{};
+        bool found = false;
+        auto shared_result = shared_.drain_with(task_id, [&out, &found](const shared_message_t& shared) {
+            materialise(shared, out);
+            found = true;
+        }, 1);
+        (void)shared_result;
+        if (found) {
+            return result<MessageType, error_code>(out);
+        }
+        return inline_.try_receive(task_id);
+    }
+
+    result<size_t, error_code> publish_batch(u16 topic_id, etl::span<MessageType> msgs, task_id_t from_task_id) noexcept override {
+        if (msgs.empty() || !use_shared(topic_id, msgs[0])) {
+            return inline_.publish_batch(topic_id, msgs, from_task_id);
+        }
+        size_t published = 0;
+        for (MessageType& msg : msgs) {
+            if (publish(topic_id, msg, from_task_id).is_ok()) {
+                ++published;
+            }
+        }
+        return (published != 0U) ? result<size_t, error_code>(published)
+                                 : result<size_t, error_code>(error_code::out_of_memory);
+    }
+
+    result<size_t, error_code> receive_batch(task_id_t task_id, etl::span<MessageType> out, size_t max_count, timeout_ms_t timeout) noexcept override {
+        const size_t limit = (max_count < out.size()) ? max_count : out.size();
+        if (limit == 0U) {
+            return result<size_t, error_code>(error_code::invalid_parameter);
+        }
+        size_t count = 0;
+        auto shared_result = shared_.drain_with(task_id, [&out, &count](const shared_message_t& shared) {
+            materialise(shared, out[count]);
+            ++count;
+        }, limit);
+        if (!shared_result.is_ok()) {
+            return shared_result;
+        }
+        if (count < limit) {
+            auto inline_result = inline_.receive_batch(task_id, etl::span<MessageType>(out.data() + count, limit - count),
+                                                       limit - count, (count == 0U) ? timeout : timeout_ms_t{0});
+            if (inline_result.is_ok()) {
+                count += inline_result.value();
+            }
+        }
+        return (count != 0U) ? result<size_t, error_code>(count)
+                             : result<size_t, error_code>(error_code::timeout);
+    }
+
+    /*
+     * In-place receive across both lanes: fn(const message_header&, const u8* payload, u16 size).
+     * Shared payloads are read straight from the pool block.
+     */
+    template <typename Fn>
+    result<size_t, error_code> drain_with(task_id_t task_id, Fn&& fn, size_t max_count) noexcept {
+        size_t count = 0;
+        auto shared_result = shared_.drain_with(task_id, [&fn](const shared_message_t& shared) {
+            fn(shared.header, shared.payload_data(), shared.payload_size());
+        }, max_count);
+        if (!shared_result.is_ok()) {
+            return shared_result;
+        }
+        count = shared_result.value();
+        if (count < max_count) {
+            auto inline_result = inline_.drain_with(task_id, [&fn](const MessageType& msg) {
+                fn(msg.header, msg.payload, msg.header.payload_size);
+            }, max_count - count);
+            if (inline_result.is_ok()) {
+                count += inline_result.value();
+            }
+        }
+        return result<size_t, error_code>(count);
+    }
+
+    template <typename Fn>
+    result<void, error_code> receive_with(task_id_t task_id, timeout_ms_t timeout, Fn&& fn) noexcept {
+        auto drained = drain_with(task_id, fn, 1);
+        if (!drained.is_ok()) {
+            return result<void, error_code>(drained.error());
+        }
+        if (drained.value() != 0U) {
+            return ok();
+        }
+        u32 notification = 0;
+        if (os::wait_notification(timeout.value, &notification) && ((notification & 0x01) != 0)) {
+            drained = drain_with(task_id, fn, 1);
+            if (drained.is_ok() && drained.value() != 0U) {
+                return ok();
+            }
+        }
+        return result<void, error_code>(error_code::timeout);
+    }
+
+    /* Thresholds can be retuned at runtime (both inclusive); every topic re-picks its lane on its next publish */
+    void set_thresholds(size_t min_subscribers, size_t min_payload) noexcept {
+        cs_.enter();
+        min_subscribers_ = min_subscribers;
+        min_payload_ = min_payload;
+        lanes_.clear();
+        cs_.exit();
+    }
+
+    [[nodiscard]] u32 shared_published() const noexcept { return shared_published_; }
+    [[nodiscard]] u32 shared_fallbacks() const noexcept { return shared_fallbacks_; }
+
+private:
+    // Lane picked for a topic on its first publish with a subscriber
+    struct topic_lane {
+        u16 topic_id;
+        bool shared;
+    };
+
+    static u16 effective_size(const MessageType& msg) noexcept {
+        const size_t size = (msg.header.payload_size != 0U && msg.header.payload_size <= payload_capacity)
+                            ? msg.header.payload_size
+                            : payload_capacity;
+        return static_cast<u16>(size);
+    }
+
+    bool use_shared(u16 topic_id, const MessageType& msg) noexcept {
+        if (effective_size(msg) > PoolT::block_capacity()) {
+            return false;
+        }
+        cs_.enter();
+        bool shared = false;
+        const topic_lane* lane = find_lane(topic_id);
+        if (lane != nullptr) {
+            shared = lane->shared;
+        } else {
+            const size_t subscribers = shared_.subscriber_count(topic_id);
+            shared = subscribers != 0U && (subscribers >= min_subscribers_ || payload_capacity >= min_payload_);
+            if (subscribers != 0U && !lanes_.full()) {
+                lanes_.push_back(topic_lane{topic_id, shared});
+            }
+        }
+        cs_.exit();
+        return shared;
+    }
+
+    const topic_lane* find_lane(u16 topic_id) const noexcept {
+        for (const topic_lane& lane : lanes_) {
+            if (lane.topic_id == topic_id) {
+                return &lane;
+            }
+        }
+        return nullptr;
+    }
+
+    static void materialise(const shared_message_t& shared, MessageType& out) noexcept {
+        out.header = shared.header;
+        const size_t size = (shared.payload_size() <= payload_capacity) ? shared.payload_size() : payload_capacity;
+        if (size != 0U) {
+            std::memcpy(out.payload, shared.payload_data(), size);
+        }
+        out.header.payload_size = static_cast<u16>(size);
+    }
+
+    inline_broker_t& inline_;
+    shared_broker_t& shared_;
+    PoolT& pool_;
+    size_t min_subscribers_;
+    size_t min_payload_;
+    os::critical_section cs_;
+    etl::vector<topic_lane, config::default_max_topics> lanes_;
+    u32 shared_published_{0};
+    u32 shared_fallbacks_{0};
+};
+
+}  // namespace emCore::messaging
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <cstddef>
+
+#include "../core/types.hpp"
+
+#include <etl/atomic.h>
+#include <etl/type_traits.h>
+#include <etl/utility.h>
+
+namespace emCore::messaging {
+
+/* Round up to the next power of two (rings index with a mask) */
+constexpr size_t ring_pow2_ceil(size_t value) noexcept {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1U;
+    }
+    return result;
+}
+
+/**
+ * @brief Wait-free single-producer / single-consumer ring
+ *
+ * Producer owns tail_, consumer owns head_. No interrupt masking, so push()
+ * may be called from an ISR while the owning task is inside front()/pop().
+ */
+template <typename T, size_t Capacity>
+class spsc_ring {
+    static_assert(Capacity >= 1 && (Capacity & (Capacity - 1)) == 0, "spsc_ring capacity must be a power of two");
+    static constexpr u32 mask = static_cast<u32>(Capacity - 1);
+
+    T slots_[Capacity]{};
+    etl::atomic<u32> head_{0};
+    etl::atomic<u32> tail_{0};
+
+public:
+    spsc_ring() noexcept = default;
+    ~spsc_ring() = default;
+    spsc_ring(const spsc_ring&) = delete;
+    spsc_ring& operator=(const spsc_ring&) = delete;
+    spsc_ring(spsc_ring&&) = delete;
+    spsc_ring& operator=(spsc_ring&&) = delete;
+
+    /* Producer side */
+    bool try_push(const T& value) noexcept {
+        const u32 tail = tail_.load(etl::memory_order_relaxed);
+        if ((tail - head_.load(etl::memory_order_acquire)) >= Capacity) {
+            return false;
+        }
+        slots_[tail & mask] = value;
+        tail_.store(tail + 1U, etl::memory_order_release);
+        return true;
+    }
+
+    /* Consumer side: peek at the oldest element without removing it */
+    const T* front() const noexcept {
+        const u32 head = head_.load(etl::memory_order_relaxed);
+        if (head == tail_.load(etl::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &slots_[head & mask];
+    }
+
+    /* Consumer side: release the slot returned by front() */
+    void pop() noexcept {
+        const u32 head = head_.load(etl::memory_order_relaxed);
+        if constexpr (!etl::is_trivially_copyable<T>::value) {
+            slots_[head & mask] = T{};  // drop refcounted members (e.g. zc_handle)
+        }
+        head_.store(head + 1U, etl::memory_order_release);
+    }
+
+    bool try_pop(T& out) noexcept {
+        const T* slot = front();
+        if (slot == nullptr) {
+            return false;
+        }
+        out = etl::move(slots_[head_.load(etl::memory_order_relaxed) & mask]);
+        pop();
+        return true;
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        return static_cast<size_t>(tail_.load(etl::memory_order_acquire) - head_.load(etl::memory_order_acquire));
+    }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return Capacity; }
+};
+
+/**
+ * @brief Lock-free multi-producer / single-consumer bounded ring
+ *
+ * Per-slot sequence numbers (Vyukov bounded queue): producers reserve a slot
+ * with one CAS on enqueue_pos_ and publish it with a release store of the
+ * slot sequence. Requires a native 32-bit CAS (Xtensa, ARMv7-M and up).
+ */
+template <typename T, size_t Capacity>
+class mpsc_ring {
+    static_assert(Capacity >= 1 && (Capacity & (Capacity - 1)) == 0, "mpsc_ring capacity must be a power of two");
+    static constexpr u32 mask = static_cast<u32>(Capacity - 1);
+
+    struct cell {
+        etl::atomic<u32> sequence{0};
+        T value{};
+    };
+
+    cell cells_[Capacity];
+    etl::atomic<u32> enqueue_pos_{0};
+    etl::atomic<u32> dequeue_pos_{0};  // written by the consumer only
+
+public:
+    mpsc_ring() noexcept {
+        for (size_t i = 0; i < Capacity; ++i) {
+            cells_[i].sequence.store(static_cast<u32>(i), etl::memory_order_relaxed);
+        }
+    }
+    ~mpsc_ring() = default;
+    mpsc_ring(const mpsc_ring&) = delete;
+    mpsc_ring& operator=(const mpsc_ring&) = delete;
+    mpsc_ring(mpsc_ring&&) = delete;
+    mpsc_ring& operator=(mpsc_ring&&) = delete;
+
+    /* Producer side (any context) */
+    bool try_push(const T& value) noexcept {
+        u32 pos = enqueue_pos_.load(etl::memory_order_relaxed);
+        cell* target = nullptr;
+        for (;;) {
+            target = &cells_[pos & mask];
+            const u32 seq = target->sequence.load(etl::memory_order_acquire);
+            const i32 diff = static_cast<i32>(seq - pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1U, etl::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // full
+            } else {
+                pos = enqueue_pos_.load(etl::memory_order_relaxed);
+            }
+        }
+        target->value = value;
+        target->sequence.store(pos + 1U, etl::memory_order_release);
+        return true;
+    }
+
+    /* Consumer side: peek at the oldest published element */
+    const T* front() const noexcept {
+        const u32 pos = dequeue_pos_.load(etl::memory_order_relaxed);
+        const cell& head = cells_[pos & mask];
+        if (head.sequence.load(etl::memory_order_acquire) != pos + 1U) {
+            return nullptr;
+        }
+        return &head.value;
+    }
+
+    /* Consumer side: release the slot returned by front() */
+    void pop() noexcept {
+        const u32 pos = dequeue_pos_.load(etl::memory_order_relaxed);
+        cell& head = cells_[pos & mask];
+        if constexpr (!etl::is_trivially_copyable<T>::value) {
+            head.value = T{};
+        }
+        head.sequence.store(pos + static_cast<u32>(Capacity), etl::memory_order_release);
+        dequeue_pos_.store(pos + 1U, etl::memory_order_relaxed);
+    }
+
+    bool try_pop(T& out) noexcept {
+        if (front() == nullptr) {
+            return false;
+        }
+        out = etl::move(cells_[dequeue_pos_.load(etl::memory_order_relaxed) & mask].value);
+        pop();
+        return true;
+    }
+
+    /* Approximate while producers are active; exact from the consumer when idle */
+    [[nodiscard]] size_t size() const noexcept {
+        const u32 enq = enqueue_pos_.load(etl::memory_order_acquire);
+        const u32 deq = dequeue_pos_.load(etl::memory_order_acquire);
+        return static_cast<size_t>(enq - deq);
+    }
+    [[nodiscard]] bool empty() const noexcept { return front() == nullptr; }
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return Capacity; }
+};
+
+}  // namespace emCore::messaging
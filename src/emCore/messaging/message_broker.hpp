@@ -8,7 +8,13 @@
 #include "../os/time.hpp"
 #include "../os/sync.hpp"
 #include "../os/tasks.hpp"
+#include "../os/wake.hpp"
+#include "../utils/helpers.hpp"
 #include "message_types.hpp"
+#include "lockfree_ring.hpp"
+#include "envelope_store.hpp"
+#include "broker_metrics.hpp"
+#include "../diagnostics/trace_stream.hpp"
 
 #include <etl/circular_buffer.h>
 #include <etl/vector.h>
@@ -16,6 +22,9 @@
 #include <etl/pool.h>
 #include <etl/array.h>
 #include <etl/memory.h>
+#include <etl/atomic.h>
+#include <etl/type_traits.h>
+#include <etl/span.h>
 
 #include "../memory/pool.hpp"
 #include <utility>
@@ -43,13 +52,30 @@ public:
     virtual result<void, error_code> publish(u16 topic_id, MessageType& msg, task_id_t from_task_id) noexcept = 0;
     virtual result<MessageType, error_code> receive(task_id_t task_id, timeout_ms_t timeout) noexcept = 0;
     virtual result<MessageType, error_code> try_receive(task_id_t task_id) noexcept = 0;
+
+    // Burst APIs: one topic lookup, one lock and at most one notification per mailbox.
+    // Both return the number of messages moved (publish: total mailbox deliveries).
+    virtual result<size_t, error_code> publish_batch(u16 topic_id, etl::span<MessageType> msgs, task_id_t from_task_id) noexcept = 0;
+    virtual result<size_t, error_code> receive_batch(task_id_t task_id, etl::span<MessageType> out, size_t max_count, timeout_ms_t timeout) noexcept = 0;
+};
+
+/* Mailbox synchronisation policy (EMCORE_MSG_MAILBOX_POLICY selects the default) */
+enum class mailbox_policy : u8 {
+    locked = 0,  // os::critical_section around per-topic sub-queues
+    spsc = 1,    // lock-free, exactly one producer per mailbox (task or ISR)
+    mpsc = 2,    // lock-free, any number of producers
+    shared_store = 3  // locked u16 index queues into one envelope store per broker
 };
 
+/* Mailbox depth crossed its high watermark (above == true) or fell back to its low one */
+using watermark_callback_t = void (*)(task_id_t task_id, u16 depth, bool above) noexcept;
+
 /**
  * @brief Professional message broker with pub/sub
  * Clean implementation that actually works
  */
-template<typename MessageType = medium_message, size_t MaxTasks = config::max_tasks>
+template<typename MessageType = medium_message, size_t MaxTasks = config::max_tasks,
+         mailbox_policy Policy = static_cast<mailbox_policy>(config::default_mailbox_policy)>
 class message_broker : public Ibroker<MessageType> {
 private:
     static constexpr size_t queue_capacity = config::default_mailbox_queue_capacity;
@@ -71,10 +97,26 @@ private:
         u32 received_count{0};
         bool overflow_drop_oldest{true};
         bool notify_on_empty_only{true};
+        // Flow control: watermarks (0 = off) and whether a producer is waiting on credit
+        u16 high_watermark{0};
+        u16 low_watermark{0};
+        etl::atomic<bool> above_high{false};
+        etl::atomic<bool> credit_starved{false};
+        mutable etl::atomic<u32> wakeups{0};  // owner notifications issued (broker metrics)
+
+        // O(1) occupancy: running count plus per-priority non-empty bitmaps (bit == topic slot)
+        u16 message_count{0};
+        u32 high_mask{0};
+        u32 normal_mask{0};
+        u8 last_topic_slot{0};
+        // Queues whose front slot is on loan to a receive_with() handler; never evicted
+        u32 pinned_high{0};
+        u32 pinned_normal{0};
 
         // Compile-time per-topic capacities
         static constexpr size_t topic_slots = config::default_max_topic_queues_per_mailbox;
         static_assert(topic_slots >= 1, "EMCORE_MSG_TOPIC_QUEUES_PER_MAILBOX must be >= 1");
+        static_assert(topic_slots <= 32, "EMCORE_MSG_TOPIC_QUEUES_PER_MAILBOX must be <= 32 (bitmap width)");
         static_assert(config::default_topic_high_ratio_den != 0, "default_topic_high_ratio_den must not be zero");
         static_assert(topic_slots <= queue_capacity,
                       "Per-mailbox topic queues must be <= total mailbox queue capacity");
@@ -118,6 +160,8 @@ private:
             , received_count(0)
             , overflow_drop_oldest(other.overflow_drop_oldest)
             , notify_on_empty_only(other.notify_on_empty_only)
+            , high_watermark(other.high_watermark)
+            , low_watermark(other.low_watermark)
             , topic_queues() {}
 
         task_mailbox& operator=(const task_mailbox& other) {
@@ -130,30 +174,46 @@ private:
                 received_count = 0;
                 overflow_drop_oldest = other.overflow_drop_oldest;
                 notify_on_empty_only = other.notify_on_empty_only;
+                high_watermark = other.high_watermark;
+                low_watermark = other.low_watermark;
+                message_count = 0;
+                high_mask = 0;
+                normal_mask = 0;
+                last_topic_slot = 0;
+                pinned_high = 0;
+                pinned_normal = 0;
                 topic_queues.clear();
             }
             return *this;
         }
 
-        size_t total_size() const noexcept {
-            size_t total = 0;
-            for (const auto& topic_queue : topic_queues) {
-                total += topic_queue.high_queue.size();
-                total += topic_queue.normal_queue.size();
-            }
-            return total;
-        }
+        size_t total_size() const noexcept { return message_count; }
 
-        bool is_empty_unlocked() const noexcept {
-            for (const auto& topic_queue : topic_queues) {
-                if (!topic_queue.high_queue.empty() || !topic_queue.normal_queue.empty()) {
-                    return false;
-                }
+        /* Unlocked snapshot for flow control; a stale value only delays a decision */
+        u16 depth() const noexcept { return message_count; }
+        u16 credits() const noexcept { return (message_count < depth_limit) ? static_cast<u16>(depth_limit - message_count) : 0U; }
+
+        /* Credits for one topic: also bounded by the free slots of the queue push_unlocked() targets */
+        u16 credits(u16 topic_id, bool urgent) const noexcept {
+            const u16 total = credits();
+            const int idx = find_topic_index(topic_id);
+            size_t room = 0;
+            if (idx >= 0) {
+                const topic_queue_entry& entry = topic_queues[static_cast<size_t>(idx)];
+                room = urgent ? entry.high_queue.available() : entry.normal_queue.available();
+            } else if (!topic_queues.full()) {
+                room = urgent ? high_capacity : normal_capacity;
             }
-            return true;
+            return (room < total) ? static_cast<u16>(room) : total;
         }
 
+        bool is_empty_unlocked() const noexcept { return message_count == 0U; }
+
         int find_topic_index(u16 topic_id) const noexcept {
+            // Bursts usually repeat the previous topic; check it before scanning
+            if (last_topic_slot < topic_queues.size() && topic_queues[last_topic_slot].topic_id == topic_id) {
+                return static_cast<int>(last_topic_slot);
+            }
             for (size_t i = 0; i < topic_queues.size(); ++i) {
                 if (topic_queues[i].topic_id == topic_id) {
                     return static_cast<int>(i);
@@ -165,6 +225,7 @@ private:
         topic_queue_entry* get_or_create_topic(u16 topic_id) noexcept {
             int idx = find_topic_index(topic_id);
             if (idx >= 0) {
+                last_topic_slot = static_cast<u8>(idx);
                 return &topic_queues[static_cast<size_t>(idx)];
             }
             if (topic_queues.full()) {
@@ -174,35 +235,50 @@ private:
             topic_queues.emplace_back();
             topic_queue_entry& back = topic_queues.back();
             back.topic_id = topic_id;
+            last_topic_slot = static_cast<u8>(topic_queues.size() - 1U);
             return &back;
         }
 
+        /* Queue bookkeeping: keep message_count and the bitmaps in step with the buffers */
+        void push_high(size_t slot, const MessageType& msg) noexcept {
+            topic_queues[slot].high_queue.push(msg);
+            high_mask |= (1UL << slot);
+            ++message_count;
+        }
+        void push_normal(size_t slot, const MessageType& msg) noexcept {
+            topic_queues[slot].normal_queue.push(msg);
+            normal_mask |= (1UL << slot);
+            ++message_count;
+        }
+        void pop_high(size_t slot) noexcept {
+            topic_queues[slot].high_queue.pop();
+            if (topic_queues[slot].high_queue.empty()) { high_mask &= ~(1UL << slot); }
+            --message_count;
+        }
+        void pop_normal(size_t slot) noexcept {
+            topic_queues[slot].normal_queue.pop();
+            if (topic_queues[slot].normal_queue.empty()) { normal_mask &= ~(1UL << slot); }
+            --message_count;
+        }
+
         // Drop one message to make room (prefer normal across topics)
         bool drop_one_any() noexcept {
-            // Prefer dropping from normal queues
-            for (auto& topic_queue : topic_queues) {
-                if (!topic_queue.normal_queue.empty()) { topic_queue.normal_queue.pop(); return true; }
-            }
-            // Then drop from high queues
-            for (auto& topic_queue : topic_queues) {
-                if (!topic_queue.high_queue.empty()) { topic_queue.high_queue.pop(); return true; }
-            }
+            const u32 normal_free = normal_mask & ~pinned_normal;
+            if (normal_free != 0U) { pop_normal(utils::lowest_set_bit(normal_free)); return true; }
+            const u32 high_free = high_mask & ~pinned_high;
+            if (high_free != 0U) { pop_high(utils::lowest_set_bit(high_free)); return true; }
             return false;
         }
 
-        /* Thread-safe send with per-topic routing and notify-on-empty */
-        result<void, error_code> send(const MessageType& msg) noexcept {
+        /* Route one message into its per-topic queue; caller holds critical_section */
+        bool push_unlocked(const MessageType& msg) noexcept {
             const bool is_urgent = (static_cast<message_flags>(msg.header.flags) & message_flags::urgent) == message_flags::urgent
                                    || (msg.header.priority >= static_cast<u8>(message_priority::high));
-            critical_section.enter();
-
-            bool was_empty = is_empty_unlocked();
             const bool depth_reached = (total_size() >= depth_limit);
 
             topic_queue_entry* topic_queue = get_or_create_topic(msg.header.type);
             if (topic_queue == nullptr) {
-                critical_section.exit();
-                return result<void, error_code>(error_code::out_of_memory);
+                return false;
             }
 
             bool target_full = is_urgent ? topic_queue->high_queue.full() : topic_queue->normal_queue.full();
@@ -212,102 +288,616 @@ private:
                     dropped_overflow++;
                     // fallthrough to push
                 } else {
-                    critical_section.exit();
-                    return result<void, error_code>(error_code::out_of_memory);
+                    return false;
                 }
             }
 
+            const size_t slot = static_cast<size_t>(topic_queue - topic_queues.data());
             if (is_urgent) {
                 if (!topic_queue->high_queue.full()) {
-                    topic_queue->high_queue.push(msg);
+                    push_high(slot, msg);
                 } else if (!topic_queue->normal_queue.full()) {
-                    topic_queue->normal_queue.push(msg);
+                    push_normal(slot, msg);
                 } else {
-                    critical_section.exit();
-                    return result<void, error_code>(error_code::out_of_memory);
+                    return false;
                 }
             } else {
                 if (!topic_queue->normal_queue.full()) {
-                    topic_queue->normal_queue.push(msg);
+                    push_normal(slot, msg);
                 } else if (!topic_queue->high_queue.full()) {
-                    topic_queue->high_queue.push(msg);
+                    push_high(slot, msg);
                 } else {
-                    critical_section.exit();
-                    return result<void, error_code>(error_code::out_of_memory);
+                    return false;
                 }
             }
+            return true;
+        }
 
-            bool should_notify = notify_on_empty_only ? was_empty : true;
-            critical_section.exit();
+        /* Pop the next message (high across topics, then normal); caller holds critical_section */
+        bool pop_unlocked(MessageType& out) noexcept {
+            if (high_mask != 0U) {
+                const size_t slot = utils::lowest_set_bit(high_mask);
+                out = topic_queues[slot].high_queue.front();
+                pop_high(slot);
+                received_count++;
+                return true;
+            }
+            if (normal_mask != 0U) {
+                const size_t slot = utils::lowest_set_bit(normal_mask);
+                out = topic_queues[slot].normal_queue.front();
+                pop_normal(slot);
+                received_count++;
+                return true;
+            }
+            return false;
+        }
 
-            if (should_notify && handle != nullptr) {
+        /* Native owners get a task notification; cooperative ones wake the scheduler */
+        void wake() const noexcept {
+            wakeups.fetch_add(1U, etl::memory_order_relaxed);
+            if (handle != nullptr) {
                 os::notify_task(handle, 0x01);
+            } else {
+                os::wake_cooperative(task_id);
+            }
+        }
+
+        /* Thread-safe send with per-topic routing and notify-on-empty */
+        result<void, error_code> send(const MessageType& msg) noexcept {
+            critical_section.enter();
+            const bool was_empty = is_empty_unlocked();
+            const bool pushed = push_unlocked(msg);
+            critical_section.exit();
+
+            if (!pushed) {
+                return result<void, error_code>(error_code::out_of_memory);
+            }
+            const bool should_notify = notify_on_empty_only ? was_empty : true;
+            if (should_notify) {
+                wake();
             }
             return ok();
         }
 
+        /* Burst send: one lock, one notification; returns messages accepted */
+        size_t send_batch(etl::span<const MessageType> msgs) noexcept {
+            critical_section.enter();
+            const bool was_empty = is_empty_unlocked();
+            size_t accepted = 0;
+            for (const MessageType& msg : msgs) {
+                if (push_unlocked(msg)) {
+                    ++accepted;
+                }
+            }
+            critical_section.exit();
+
+            const bool should_notify = notify_on_empty_only ? was_empty : true;
+            if (accepted != 0U && should_notify) {
+                wake();
+            }
+            return accepted;
+        }
+
         /* Thread-safe receive: drain high across topics, then normal */
         result<MessageType, error_code> receive() noexcept {
+            MessageType msg{};
+            critical_section.enter();
+            const bool popped = pop_unlocked(msg);
+            const bool now_empty = is_empty_unlocked();
+            critical_section.exit();
+            if (!popped) {
+                return result<MessageType, error_code>(error_code::not_found);
+            }
+            if (now_empty) { os::clear_notification(); }
+            return result<MessageType, error_code>(msg);
+        }
+
+        /*
+         * In-place receive: hand fn a reference to the queued envelope and pop it
+         * afterwards. The slot is pinned so producers cannot evict it while fn runs
+         * outside the critical section. Owner task only.
+         */
+        template <typename Fn>
+        bool visit_front(Fn& fn) noexcept {
             critical_section.enter();
-            if (is_empty_unlocked()) {
+            const bool from_high = (high_mask != 0U);
+            if (!from_high && normal_mask == 0U) {
                 critical_section.exit();
+                return false;
+            }
+            const size_t slot = utils::lowest_set_bit(from_high ? high_mask : normal_mask);
+            const u32 bit = static_cast<u32>(1UL << slot);
+            const MessageType* msg = from_high ? &topic_queues[slot].high_queue.front()
+                                               : &topic_queues[slot].normal_queue.front();
+            if (from_high) { pinned_high |= bit; } else { pinned_normal |= bit; }
+            critical_section.exit();
+
+            fn(*msg);
+
+            critical_section.enter();
+            if (from_high) {
+                pinned_high &= ~bit;
+                pop_high(slot);
+            } else {
+                pinned_normal &= ~bit;
+                pop_normal(slot);
+            }
+            received_count++;
+            const bool now_empty = is_empty_unlocked();
+            critical_section.exit();
+            if (now_empty) { os::clear_notification(); }
+            return true;
+        }
+
+        /* Burst receive under one lock; returns messages written to out */
+        size_t receive_batch(etl::span<MessageType> out) noexcept {
+            size_t count = 0;
+            critical_section.enter();
+            while (count < out.size() && pop_unlocked(out[count])) {
+                ++count;
+            }
+            const bool now_empty = is_empty_unlocked();
+            critical_section.exit();
+            if (count != 0U && now_empty) { os::clear_notification(); }
+            return count;
+        }
+
+        bool empty() const noexcept { return is_empty_unlocked(); }
+    };
+
+    /*
+     * Lock-free mailbox: one high and one normal ring shared by all topics.
+     * send() never masks interrupts and is safe from ISRs; receive() must only
+     * be called by the owning task. Producers cannot evict, so a full mailbox
+     * rejects the newest message and set_overflow_policy() refuses drop_oldest.
+     * Normal messages never take the high ring. Urgent ones overflow into the
+     * normal ring and, once one has, follow it there until those drain, so
+     * each class stays FIFO.
+     */
+    template <template <typename, size_t> class Ring>
+    struct lockfree_mailbox {
+        task_id_t task_id{invalid_task_id};
+        os::task_handle_t handle{nullptr};
+        u16 depth_limit{static_cast<u16>(queue_capacity)};
+        u32 received_count{0};
+        bool overflow_drop_oldest{false};  // always false; producers cannot evict
+        bool notify_on_empty_only{true};
+        u16 high_watermark{0};
+        u16 low_watermark{0};
+        etl::atomic<bool> above_high{false};
+        etl::atomic<bool> credit_starved{false};
+        mutable etl::atomic<u32> wakeups{0};  // owner notifications issued (broker metrics)
+
+        static_assert(config::default_topic_high_ratio_den != 0, "default_topic_high_ratio_den must not be zero");
+        static constexpr size_t calc_high = (queue_capacity * config::default_topic_high_ratio_num)
+                                            / config::default_topic_high_ratio_den;
+        static constexpr size_t high_capacity = ring_pow2_ceil((calc_high >= 1) ? calc_high : 1);
+        static constexpr size_t normal_capacity = ring_pow2_ceil((queue_capacity > calc_high) ? (queue_capacity - calc_high) : 1);
+
+        Ring<MessageType, high_capacity> high_queue;
+        Ring<MessageType, normal_capacity> normal_queue;
+        // Messages reserved or queued; producers bump it before pushing
+        etl::atomic<u32> count{0};
+        // Urgent messages sitting in the normal ring
+        etl::atomic<u32> spilled{0};
+
+        static bool is_urgent(const MessageType& msg) noexcept {
+            return (static_cast<message_flags>(msg.header.flags) & message_flags::urgent) == message_flags::urgent
+                   || (msg.header.priority >= static_cast<u8>(message_priority::high));
+        }
+
+        lockfree_mailbox() = default;
+        ~lockfree_mailbox() = default;
+        // Copy configuration only; rings start empty
+        lockfree_mailbox(const lockfree_mailbox& other)
+            : task_id(other.task_id)
+            , handle(other.handle)
+            , depth_limit(other.depth_limit)
+            , received_count(0)
+            , overflow_drop_oldest(other.overflow_drop_oldest)
+            , notify_on_empty_only(other.notify_on_empty_only)
+            , high_watermark(other.high_watermark)
+            , low_watermark(other.low_watermark) {}
+
+        lockfree_mailbox& operator=(const lockfree_mailbox& other) {
+            if (this != &other) {
+                task_id = other.task_id;
+                handle = other.handle;
+                depth_limit = other.depth_limit;
+                overflow_drop_oldest = other.overflow_drop_oldest;
+                notify_on_empty_only = other.notify_on_empty_only;
+                high_watermark = other.high_watermark;
+                low_watermark = other.low_watermark;
+            }
+            return *this;
+        }
+
+        u16 depth() const noexcept { return static_cast<u16>(count.load(etl::memory_order_acquire)); }
+        u16 credits() const noexcept {
+            const u16 used = depth();
+            return (used < depth_limit) ? static_cast<u16>(depth_limit - used) : 0U;
+        }
+        u16 credits(u16 /*topic_id*/, bool /*urgent*/) const noexcept { return credits(); }
+
+        /* Reserve depth and push one message; prev receives the count before this push */
+        bool push(const MessageType& msg, u32& prev) noexcept {
+            prev = count.fetch_add(1U, etl::memory_order_acq_rel);
+            if (prev >= depth_limit) {
+                count.fetch_sub(1U, etl::memory_order_acq_rel);
+                return false;
+            }
+            bool pushed = false;
+            if (!is_urgent(msg)) {
+                pushed = normal_queue.try_push(msg);
+            } else if (spilled.load(etl::memory_order_acquire) == 0U && high_queue.try_push(msg)) {
+                pushed = true;
+            } else {
+                // Counted before the push so the consumer never pops an uncounted spill
+                spilled.fetch_add(1U, etl::memory_order_acq_rel);
+                pushed = normal_queue.try_push(msg);
+                if (!pushed) {
+                    spilled.fetch_sub(1U, etl::memory_order_acq_rel);
+                }
+            }
+            if (!pushed) {
+                count.fetch_sub(1U, etl::memory_order_acq_rel);
+            }
+            return pushed;
+        }
+
+        /* Consumer side: pop the next message, high ring first */
+        bool pop(MessageType& out) noexcept {
+            if (high_queue.try_pop(out)) {
+                return true;
+            }
+            if (!normal_queue.try_pop(out)) {
+                return false;
+            }
+            if (is_urgent(out)) {
+                spilled.fetch_sub(1U, etl::memory_order_acq_rel);
+            }
+            return true;
+        }
+
+        /* Consumer side: account for popped messages and clear the wakeup when drained */
+        void release(u32 popped) noexcept {
+            received_count += popped;
+            if (count.fetch_sub(popped, etl::memory_order_acq_rel) == popped) {
+                os::clear_notification();
+                // A producer may have raced the clear; re-arm so the wakeup is not lost
+                if (count.load(etl::memory_order_acquire) != 0U) {
+                    wake();
+                }
+            }
+        }
+
+        void wake() const noexcept {
+            wakeups.fetch_add(1U, etl::memory_order_relaxed);
+            if (handle != nullptr) {
+                os::notify_task(handle, 0x01);
+            } else {
+                os::wake_cooperative(task_id);
+            }
+        }
+
+        result<void, error_code> send(const MessageType& msg) noexcept {
+            u32 prev = 0;
+            if (!push(msg, prev)) {
+                return result<void, error_code>(error_code::out_of_memory);
+            }
+            const bool should_notify = notify_on_empty_only ? (prev == 0U) : true;
+            if (should_notify) {
+                wake();
+            }
+            return ok();
+        }
+
+        size_t send_batch(etl::span<const MessageType> msgs) noexcept {
+            size_t accepted = 0;
+            bool was_empty = false;
+            for (const MessageType& msg : msgs) {
+                u32 prev = 0;
+                if (push(msg, prev)) {
+                    was_empty = was_empty || (prev == 0U);
+                    ++accepted;
+                }
+            }
+            const bool should_notify = notify_on_empty_only ? was_empty : true;
+            if (accepted != 0U && should_notify) {
+                wake();
+            }
+            return accepted;
+        }
+
+        result<MessageType, error_code> receive() noexcept {
+            MessageType msg{};
+            if (!pop(msg)) {
                 return result<MessageType, error_code>(error_code::not_found);
             }
-            // First pass: high priority
-            for (auto& topic_queue : topic_queues) {
-                if (!topic_queue.high_queue.empty()) {
-                    MessageType msg = topic_queue.high_queue.front();
-                    topic_queue.high_queue.pop();
-                    received_count++;
-                    bool now_empty = is_empty_unlocked();
-                    critical_section.exit();
-                    if (now_empty) { os::clear_notification(); }
-                    return result<MessageType, error_code>(msg);
+            release(1U);
+            return result<MessageType, error_code>(msg);
+        }
+
+        /* In-place receive: the consumer owns the ring head, so fn reads the slot directly */
+        template <typename Fn>
+        bool visit_front(Fn& fn) noexcept {
+            const MessageType* msg = high_queue.front();
+            const bool from_high = (msg != nullptr);
+            if (!from_high) {
+                msg = normal_queue.front();
+                if (msg == nullptr) {
+                    return false;
+                }
+            }
+            fn(*msg);
+            if (from_high) {
+                high_queue.pop();
+            } else {
+                if (is_urgent(*msg)) { spilled.fetch_sub(1U, etl::memory_order_acq_rel); }
+                normal_queue.pop();
+            }
+            release(1U);
+            return true;
+        }
+
+        size_t receive_batch(etl::span<MessageType> out) noexcept {
+            size_t popped = 0;
+            while (popped < out.size() && pop(out[popped])) {
+                ++popped;
+            }
+            if (popped != 0U) {
+                release(static_cast<u32>(popped));
+            }
+            return popped;
+        }
+
+        bool empty() const noexcept { return count.load(etl::memory_order_acquire) == 0U; }
+    };
+
+    /*
+     * Shared-store mailbox: high and normal FIFOs of u16 slot indices into the
+     * broker's envelope_store. A published message occupies one store slot
+     * however many subscribers queue it (each queued index holds a reference),
+     * so RAM follows the messages in flight instead of tasks x queue_capacity.
+     * Queues are guarded by the mailbox critical section; the store is lock-free.
+     */
+    struct indexed_mailbox {
+        using store_t = envelope_store<MessageType, config::default_shared_store_capacity>;
+        static constexpr u16 npos = store_t::npos;
+
+        task_id_t task_id{invalid_task_id};
+        os::task_handle_t handle{nullptr};
+        mutable os::critical_section critical_section;
+        u16 depth_limit{static_cast<u16>(queue_capacity)};
+        u32 dropped_overflow{0};
+        u32 received_count{0};
+        bool overflow_drop_oldest{true};
+        bool notify_on_empty_only{true};
+        u16 high_watermark{0};
+        u16 low_watermark{0};
+        etl::atomic<bool> above_high{false};
+        etl::atomic<bool> credit_starved{false};
+        mutable etl::atomic<u32> wakeups{0};  // owner notifications issued (broker metrics)
+        store_t* store{nullptr};  // bound by register_task()
+
+        u16 message_count{0};
+        etl::circular_buffer<u16, queue_capacity> high_queue;
+        etl::circular_buffer<u16, queue_capacity> normal_queue;
+
+        indexed_mailbox() = default;
+        ~indexed_mailbox() noexcept { clear(); }
+        // Copy configuration only; queues start empty
+        indexed_mailbox(const indexed_mailbox& other)
+            : task_id(other.task_id)
+            , handle(other.handle)
+            , critical_section()
+            , depth_limit(other.depth_limit)
+            , overflow_drop_oldest(other.overflow_drop_oldest)
+            , notify_on_empty_only(other.notify_on_empty_only)
+            , high_watermark(other.high_watermark)
+            , low_watermark(other.low_watermark)
+            , store(other.store) {}
+
+        indexed_mailbox& operator=(const indexed_mailbox& other) {
+            if (this != &other) {
+                clear();
+                task_id = other.task_id;
+                handle = other.handle;
+                depth_limit = other.depth_limit;
+                dropped_overflow = 0;
+                received_count = 0;
+                overflow_drop_oldest = other.overflow_drop_oldest;
+                notify_on_empty_only = other.notify_on_empty_only;
+                high_watermark = other.high_watermark;
+                low_watermark = other.low_watermark;
+                store = other.store;
+            }
+            return *this;
+        }
+
+        u16 depth() const noexcept { return message_count; }
+        u16 credits() const noexcept {
+            const u16 queued = (message_count < depth_limit) ? static_cast<u16>(depth_limit - message_count) : 0U;
+            const size_t free_slots = (store != nullptr) ? store->available() : 0U;
+            return (free_slots < queued) ? static_cast<u16>(free_slots) : queued;
+        }
+        u16 credits(u16 /*topic_id*/, bool /*urgent*/) const noexcept { return credits(); }
+
+        /* Queue a reference to slot idx; caller holds critical_section */
+        bool push_unlocked(u16 idx) noexcept {
+            const MessageType& msg = store->at(idx);
+            if (message_count >= depth_limit) {
+                const bool is_persistent = (static_cast<message_flags>(msg.header.flags) & message_flags::persistent) == message_flags::persistent;
+                if (is_persistent || !overflow_drop_oldest || message_count == 0U) {
+                    return false;
+                }
+                auto& victim = normal_queue.empty() ? high_queue : normal_queue;
+                store->release(victim.front());
+                victim.pop();
+                --message_count;
+                dropped_overflow++;
+            }
+            const bool is_urgent = (static_cast<message_flags>(msg.header.flags) & message_flags::urgent) == message_flags::urgent
+                                   || (msg.header.priority >= static_cast<u8>(message_priority::high));
+            store->retain(idx);
+            (is_urgent ? high_queue : normal_queue).push(idx);
+            ++message_count;
+            return true;
+        }
+
+        /* Next index, high before normal; caller holds critical_section */
+        u16 pop_unlocked() noexcept {
+            auto& queue = high_queue.empty() ? normal_queue : high_queue;
+            if (queue.empty()) {
+                return npos;
+            }
+            const u16 idx = queue.front();
+            queue.pop();
+            --message_count;
+            return idx;
+        }
+
+        void clear() noexcept {
+            for (u16 idx = pop_unlocked(); idx != npos; idx = pop_unlocked()) {
+                store->release(idx);
+            }
+        }
+
+        void wake() const noexcept {
+            wakeups.fetch_add(1U, etl::memory_order_relaxed);
+            if (handle != nullptr) {
+                os::notify_task(handle, 0x01);
+            } else {
+                os::wake_cooperative(task_id);
+            }
+        }
+
+        /* Queue slots already in the store (publisher keeps its own reference); returns accepted */
+        size_t send_indices(etl::span<const u16> slots) noexcept {
+            critical_section.enter();
+            const bool was_empty = (message_count == 0U);
+            size_t accepted = 0;
+            for (const u16 idx : slots) {
+                if (push_unlocked(idx)) {
+                    ++accepted;
                 }
             }
-            // Second pass: normal priority
-            for (auto& topic_queue : topic_queues) {
-                if (!topic_queue.normal_queue.empty()) {
-                    MessageType msg = topic_queue.normal_queue.front();
-                    topic_queue.normal_queue.pop();
-                    received_count++;
-                    bool now_empty = is_empty_unlocked();
-                    critical_section.exit();
-                    if (now_empty) { os::clear_notification(); }
-                    return result<MessageType, error_code>(msg);
+            critical_section.exit();
+            if (accepted != 0U && (notify_on_empty_only ? was_empty : true)) {
+                wake();
+            }
+            return accepted;
+        }
+
+        result<void, error_code> send(const MessageType& msg) noexcept {
+            const u16 idx = (store != nullptr) ? store->acquire(msg) : npos;
+            if (idx == npos) {
+                return result<void, error_code>(error_code::out_of_memory);
+            }
+            const size_t accepted = send_indices(etl::span<const u16>(&idx, 1U));
+            store->release(idx);
+            return (accepted != 0U) ? ok() : result<void, error_code>(error_code::out_of_memory);
+        }
+
+        size_t send_batch(etl::span<const MessageType> msgs) noexcept {
+            size_t accepted = 0;
+            for (const MessageType& msg : msgs) {
+                if (send(msg).is_ok()) {
+                    ++accepted;
                 }
             }
+            return accepted;
+        }
+
+        result<MessageType, error_code> receive() noexcept {
+            critical_section.enter();
+            const u16 idx = pop_unlocked();
+            const bool now_empty = (message_count == 0U);
+            critical_section.exit();
+            if (idx == npos) {
+                return result<MessageType, error_code>(error_code::not_found);
+            }
+            received_count++;
+            result<MessageType, error_code> out(store->at(idx));
+            store->release(idx);
+            if (now_empty) { os::clear_notification(); }
+            return out;
+        }
+
+        /* In-place receive: the index is dequeued first, so our reference keeps the slot alive */
+        template <typename Fn>
+        bool visit_front(Fn& fn) noexcept {
+            critical_section.enter();
+            const u16 idx = pop_unlocked();
+            const bool now_empty = (message_count == 0U);
             critical_section.exit();
-            return result<MessageType, error_code>(error_code::not_found);
+            if (idx == npos) {
+                return false;
+            }
+            fn(static_cast<const MessageType&>(store->at(idx)));
+            store->release(idx);
+            received_count++;
+            if (now_empty) { os::clear_notification(); }
+            return true;
         }
 
-        bool empty() const noexcept { return is_empty_unlocked(); }
+        size_t receive_batch(etl::span<MessageType> out) noexcept {
+            size_t count = 0;
+            critical_section.enter();
+            for (u16 idx = npos; count < out.size() && (idx = pop_unlocked()) != npos; ++count) {
+                out[count] = store->at(idx);
+                store->release(idx);
+            }
+            const bool now_empty = (message_count == 0U);
+            critical_section.exit();
+            received_count += static_cast<u32>(count);
+            if (count != 0U && now_empty) { os::clear_notification(); }
+            return count;
+        }
+
+        bool empty() const noexcept { return message_count == 0U; }
     };
+
+    static constexpr bool shared_store = (Policy == mailbox_policy::shared_store);
+    using mailbox_t = typename etl::conditional<Policy == mailbox_policy::locked, task_mailbox,
+        typename etl::conditional<Policy == mailbox_policy::spsc, lockfree_mailbox<spsc_ring>,
+        typename etl::conditional<Policy == mailbox_policy::mpsc, lockfree_mailbox<mpsc_ring>,
+                                  indexed_mailbox>::type>::type>::type;
+    struct no_store {};
+    using store_t = typename etl::conditional<shared_store, typename indexed_mailbox::store_t, no_store>::type;
     
     /* Topic subscription */
     struct topic_subscription {
         u16 topic_id{0xFFFF};
         // Soft capacity limit for subscribers (<= max_subscribers_per_topic)
         u16 capacity_limit{static_cast<u16>(max_subscribers_per_topic)};
+        // Metrics slot: creation order, stable while topics_ stays sorted by id
+        u16 stats_slot{0};
         etl::vector<task_id_t, max_subscribers_per_topic> subscriber_ids;
         
         topic_subscription() = default;
-        explicit topic_subscription(u16 topic_identifier) : topic_id(topic_identifier) {}
+        topic_subscription(u16 topic_identifier, u16 slot) : topic_id(topic_identifier), stats_slot(slot) {}
     };
     
-    /* Storage */
-    etl::vector<task_mailbox, MaxTasks> mailboxes_;
+    /* Storage (store_ before mailboxes_: queued indices are released on destruction) */
+    store_t store_;
+    etl::vector<mailbox_t, MaxTasks> mailboxes_;
     etl::vector<topic_subscription, max_topics> topics_;
     
-    /* Statistics */
-    u32 sent_count_{0};
-    u32 received_count_{0};
-    u32 dropped_count_{0};
+    /* Statistics (per-core, seqlock-read; see broker_metrics.hpp) */
+    using metrics_t = broker_metrics<max_topics, MaxTasks>;
+    metrics_t metrics_;
     u16 sequence_{0};
     bool notify_on_empty_only_{true};
+
+    /* Credit flow control */
+    static constexpr u32 credit_notification = 0x02;
+    watermark_callback_t watermark_callback_{nullptr};
+    os::critical_section waiters_cs_;
+    etl::vector<os::task_handle_t, config::default_credit_waiters> credit_waiters_;
     
     /* Find mailbox by task ID - O(1) lookup */
-    task_mailbox* find_mailbox(task_id_t task_id) noexcept {
+    mailbox_t* find_mailbox(task_id_t task_id) noexcept {
         // Direct indexing since task_id maps to mailbox index
         const size_t idx = static_cast<size_t>(task_id.value());
         if (idx >= mailboxes_.size()) {
@@ -317,6 +907,157 @@ private:
         return (mailbox.task_id == task_id) ? &mailbox : nullptr;
     }
     
+    /* Fewest credits across the topic's subscribers; marks exhausted mailboxes as starved */
+    u16 min_credits(const topic_subscription& topic, bool urgent, bool mark_starved) noexcept {
+        u16 least = 0xFFFF;
+        for (task_id_t subscriber_id : topic.subscriber_ids) {
+            mailbox_t* mailbox = find_mailbox(subscriber_id);
+            if (mailbox == nullptr) {
+                continue;
+            }
+            const u16 credits = mailbox->credits(topic.topic_id, urgent);
+            if (credits == 0U && mark_starved) {
+                mailbox->credit_starved.store(true, etl::memory_order_release);
+            }
+            least = (credits < least) ? credits : least;
+        }
+        return least;
+    }
+
+    void after_send(mailbox_t& mailbox) noexcept {
+        metrics_.observe_depth(mailbox.task_id.value(), mailbox.depth());
+        if (mailbox.high_watermark == 0U || mailbox.above_high.load(etl::memory_order_relaxed)) {
+            return;
+        }
+        const u16 depth = mailbox.depth();
+        if (depth >= mailbox.high_watermark && !mailbox.above_high.exchange(true, etl::memory_order_acq_rel)
+            && watermark_callback_ != nullptr) {
+            watermark_callback_(mailbox.task_id, depth, true);
+        }
+    }
+
+    /* Consumer side: report the low watermark and release producers blocked on credit */
+    void after_consume(mailbox_t& mailbox) noexcept {
+        if (mailbox.above_high.load(etl::memory_order_relaxed)) {
+            const u16 depth = mailbox.depth();
+            if (depth <= mailbox.low_watermark && mailbox.above_high.exchange(false, etl::memory_order_acq_rel)
+                && watermark_callback_ != nullptr) {
+                watermark_callback_(mailbox.task_id, depth, false);
+            }
+        }
+        if (mailbox.credit_starved.load(etl::memory_order_acquire) && mailbox.credits() != 0U
+            && mailbox.credit_starved.exchange(false, etl::memory_order_acq_rel)) {
+            waiters_cs_.enter();
+            for (os::task_handle_t waiter : credit_waiters_) {
+                os::notify_task(waiter, credit_notification);
+            }
+            waiters_cs_.exit();
+        }
+    }
+
+    bool add_credit_waiter(os::task_handle_t handle) noexcept {
+        waiters_cs_.enter();
+        const bool added = !credit_waiters_.full();
+        if (added) {
+            credit_waiters_.push_back(handle);
+        }
+        waiters_cs_.exit();
+        return added;
+    }
+
+    void remove_credit_waiter(os::task_handle_t handle) noexcept {
+        waiters_cs_.enter();
+        for (size_t i = 0; i < credit_waiters_.size(); ++i) {
+            if (credit_waiters_[i] == handle) {
+                credit_waiters_[i] = credit_waiters_.back();
+                credit_waiters_.pop_back();
+                break;
+            }
+        }
+        waiters_cs_.exit();
+    }
+
+    /* Visitor handed to visit_front(): fn itself, or fn behind a msg_receive trace point */
+    template <typename Fn>
+    static decltype(auto) traced_visitor(Fn& fn) noexcept {
+#if EMCORE_ENABLE_TRACE
+        return [&fn](const MessageType& msg) noexcept {
+            EMCORE_TRACE_MSG(msg_receive, msg.header);
+            fn(msg);
+        };
+#else
+        return (fn);
+#endif
+    }
+
+    /* Shared store: one slot per message, referenced from every subscriber's queue */
+    result<void, error_code> publish_shared(const topic_subscription& topic, const MessageType& msg) noexcept {
+        auto stats = metrics_.write();
+        stats.published(topic.stats_slot);
+        const u16 idx = store_.acquire(msg);
+        if (idx == store_t::npos) {
+            for (task_id_t subscriber_id : topic.subscriber_ids) {
+                stats.dropped(drop_reason::slot_exhausted, topic.stats_slot, subscriber_id.value());
+            }
+            return result<void, error_code>(error_code::out_of_memory);
+        }
+        bool sent_any = false;
+        for (task_id_t subscriber_id : topic.subscriber_ids) {
+            mailbox_t* mailbox = find_mailbox(subscriber_id);
+            if (mailbox != nullptr) {
+                if (mailbox->send_indices(etl::span<const u16>(&idx, 1U)) != 0U) {
+                    stats.delivered(topic.stats_slot);
+                    sent_any = true;
+                    after_send(*mailbox);
+                } else {
+                    stats.dropped(drop_reason::depth_limit, topic.stats_slot, subscriber_id.value());
+                }
+            }
+        }
+        store_.release(idx);
+        return sent_any ? ok() : result<void, error_code>(error_code::out_of_memory);
+    }
+
+    /* Shared-store burst: stage up to 16 slots, then one lock and notify per subscriber */
+    result<size_t, error_code> publish_batch_shared(const topic_subscription& topic, etl::span<MessageType> msgs) noexcept {
+        static constexpr size_t chunk = 16;
+        size_t delivered = 0;
+        auto stats = metrics_.write();
+        for (size_t i = 0; i < msgs.size(); ++i) { stats.published(topic.stats_slot); }
+        for (size_t base = 0; base < msgs.size(); base += chunk) {
+            etl::array<u16, chunk> staged{};
+            size_t n = 0;
+            for (size_t i = base; i < msgs.size() && i < base + chunk; ++i) {
+                const u16 idx = store_.acquire(msgs[i]);
+                if (idx != store_t::npos) {
+                    staged[n++] = idx;
+                }
+            }
+            const etl::span<const u16> burst(staged.data(), n);
+            for (task_id_t subscriber_id : topic.subscriber_ids) {
+                mailbox_t* mailbox = find_mailbox(subscriber_id);
+                if (mailbox != nullptr) {
+                    const size_t accepted = (n != 0U) ? mailbox->send_indices(burst) : 0U;
+                    if (accepted != 0U) {
+                        after_send(*mailbox);
+                    }
+                    const size_t offered = (msgs.size() - base < chunk) ? (msgs.size() - base) : chunk;
+                    stats.delivered(topic.stats_slot, static_cast<u32>(accepted));
+                    stats.dropped(drop_reason::slot_exhausted, topic.stats_slot, subscriber_id.value(),
+                                  static_cast<u32>(offered - n));
+                    stats.dropped(drop_reason::depth_limit, topic.stats_slot, subscriber_id.value(),
+                                  static_cast<u32>(n - accepted));
+                    delivered += accepted;
+                }
+            }
+            for (size_t i = 0; i < n; ++i) {
+                store_.release(staged[i]);
+            }
+        }
+        return (delivered != 0U) ? result<size_t, error_code>(delivered)
+                                 : result<size_t, error_code>(error_code::out_of_memory);
+    }
+
     /* Find topic - O(log n) using binary search on sorted vector */
     topic_subscription* find_topic(u16 topic_id) noexcept {
         // Binary search since topics are kept sorted by topic_id
@@ -337,7 +1078,7 @@ public:
     /* Configure per-mailbox depth limit (soft cap <= queue_capacity) */
     // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
     result<void, error_code> set_mailbox_depth(task_id_t task_id, size_t depth) noexcept {
-        task_mailbox* mailbox = find_mailbox(task_id);
+        mailbox_t* mailbox = find_mailbox(task_id);
         if (mailbox == nullptr) {
             return result<void, error_code>(error_code::not_found);
         }
@@ -379,15 +1120,23 @@ public:
         // Register mailbox at index == task_id
         mailboxes_[idx].task_id = task_id;
         mailboxes_[idx].handle = handle;
+        if constexpr (shared_store) {
+            mailboxes_[idx].store = &store_;
+        }
         return ok();
     }
 
-    /* Configure per-mailbox overflow policy */
+    /* Configure per-mailbox overflow policy; lock-free mailboxes only support rejecting new messages */
     result<void, error_code> set_overflow_policy(task_id_t task_id, bool drop_oldest) noexcept {
-        task_mailbox* mailbox = find_mailbox(task_id);
+        mailbox_t* mailbox = find_mailbox(task_id);
         if (mailbox == nullptr) {
             return result<void, error_code>(error_code::not_found);
         }
+        if constexpr (Policy == mailbox_policy::spsc || Policy == mailbox_policy::mpsc) {
+            if (drop_oldest) {
+                return result<void, error_code>(error_code::invalid_parameter);
+            }
+        }
         mailbox->overflow_drop_oldest = drop_oldest;
         return ok();
     }
@@ -416,7 +1165,7 @@ public:
                 [](u16 topic_identifier, const topic_subscription& topic) {
                     return topic_identifier < topic.topic_id;
                 });
-            topic = &(*topics_.insert(insert_pos, topic_subscription(topic_id.value)));
+            topic = &(*topics_.insert(insert_pos, topic_subscription(topic_id.value, static_cast<u16>(topics_.size()))));
         }
         
         /* Add subscriber */
@@ -449,31 +1198,128 @@ public:
         
         topic_subscription* topic = find_topic(topic_id);
         if (topic == nullptr || topic->subscriber_ids.empty()) {
+            metrics_.write().dropped(drop_reason::unknown_topic, max_topics, MaxTasks);
             return result<void, error_code>(error_code::not_found);
         }
+        EMCORE_TRACE_MSG(msg_publish, msg.header);
+        
+        if constexpr (shared_store) {
+            return publish_shared(*topic, msg);
+        }
         
         /* Send to all subscribers */
+        auto stats = metrics_.write();
+        stats.published(topic->stats_slot);
         bool sent_any = false;
         for (task_id_t subscriber_id : topic->subscriber_ids) {
-            task_mailbox* mailbox = find_mailbox(subscriber_id);
+            mailbox_t* mailbox = find_mailbox(subscriber_id);
             if (mailbox != nullptr) {
                 auto send_result = mailbox->send(msg);
                 if (send_result.is_ok()) {
-                    sent_count_++;
+                    stats.delivered(topic->stats_slot);
                     sent_any = true;
+                    after_send(*mailbox);
                 } else {
-                    dropped_count_++;
+                    stats.dropped(drop_reason::depth_limit, topic->stats_slot, subscriber_id.value());
                 }
             }
         }
         
         return sent_any ? ok() : result<void, error_code>(error_code::out_of_memory);
     }
+
+    /*
+     * Credit-gated publish: waits (task context only) until every subscriber of
+     * the topic has a free slot (under depth_limit and, for locked mailboxes, in
+     * that topic's queues), then publishes. Consumers wake blocked producers as
+     * they drain. Returns timeout if credit did not free up in time; a zero
+     * timeout only checks once.
+     */
+    result<void, error_code> publish_when_ready(u16 topic_id, MessageType& msg, task_id_t from_task_id,
+                                                timeout_ms_t timeout) noexcept {
+        topic_subscription* topic = find_topic(topic_id);
+        if (topic == nullptr || topic->subscriber_ids.empty()) {
+            return result<void, error_code>(error_code::not_found);
+        }
+        const bool urgent = (static_cast<message_flags>(msg.header.flags) & message_flags::urgent) == message_flags::urgent
+                            || (msg.header.priority >= static_cast<u8>(message_priority::high));
+        const timestamp_t deadline = os::time_us() + (static_cast<timestamp_t>(timeout.value) * 1000U);
+        const os::task_handle_t self = os::current_task();
+        // Our own mailbox wakeup (bit 0x01) is held back and re-posted on return;
+        // posting it while we still wait would make every later wait return at once
+        bool mailbox_woken = false;
+        result<void, error_code> res(error_code::timeout);
+        for (;;) {
+            if (min_credits(*topic, urgent, false) != 0U) {
+                res = publish(topic_id, msg, from_task_id);
+                break;
+            }
+            const timestamp_t now = os::time_us();
+            if (now >= deadline || self == nullptr) {
+                break;
+            }
+            // Register before re-checking so a consumer draining in between still wakes us
+            const bool registered = add_credit_waiter(self);
+            if (min_credits(*topic, urgent, true) == 0U) {
+                const u32 wait_ms = static_cast<u32>((deadline - now + 999U) / 1000U);
+                u32 bits = 0;
+                if (registered) {
+                    (void)os::wait_notification(wait_ms, &bits);
+                } else {
+                    os::yield();  // waiter table full: poll
+                }
+                mailbox_woken = mailbox_woken || ((bits & 0x01) != 0U);
+            }
+            if (registered) {
+                remove_credit_waiter(self);
+            }
+        }
+        if (mailbox_woken) {
+            os::notify_task(self, 0x01);
+        }
+        return res;
+    }
+
+    /* Free slots left under the mailbox depth_limit (any topic) */
+    [[nodiscard]] size_t credits(task_id_t task_id) noexcept {
+        mailbox_t* mailbox = find_mailbox(task_id);
+        return (mailbox != nullptr) ? mailbox->credits() : 0U;
+    }
+
+    /* Smallest credit across a topic's subscribers (0 when the topic is unknown) */
+    [[nodiscard]] size_t topic_credits(u16 topic_id, bool urgent = false) noexcept {
+        topic_subscription* topic = find_topic(topic_id);
+        if (topic == nullptr || topic->subscriber_ids.empty()) {
+            return 0U;
+        }
+        return min_credits(*topic, urgent, false);
+    }
+
+    /*
+     * Per-mailbox watermarks: callback fires once when depth reaches high and
+     * once more when it drains back to low (high == 0 disables).
+     */
+    // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+    result<void, error_code> set_watermarks(task_id_t task_id, u16 high, u16 low) noexcept {
+        mailbox_t* mailbox = find_mailbox(task_id);
+        if (mailbox == nullptr) {
+            return result<void, error_code>(error_code::not_found);
+        }
+        if (high != 0U && low >= high) {
+            return result<void, error_code>(error_code::invalid_parameter);
+        }
+        mailbox->high_watermark = high;
+        mailbox->low_watermark = low;
+        mailbox->above_high.store(false, etl::memory_order_relaxed);
+        return ok();
+    }
+
+    void set_watermark_callback(watermark_callback_t callback) noexcept { watermark_callback_ = callback; }
     
     /* Receive message (blocking) */
     result<MessageType, error_code> receive(task_id_t task_id, timeout_ms_t timeout) noexcept override {
         u32 timeout_ms = timeout.value;
-        task_mailbox* mailbox = find_mailbox(task_id);
+        mailbox_t* mailbox = find_mailbox(task_id);
         if (mailbox == nullptr) {
             return result<MessageType, error_code>(error_code::not_found);
         }
@@ -481,7 +1327,9 @@ public:
         /* Try immediate receive */
         auto receive_result = mailbox->receive();
         if (receive_result.is_ok()) {
-            received_count_++;
+            metrics_.write().received();
+            after_consume(*mailbox);
+            EMCORE_TRACE_MSG(msg_receive, receive_result.value().header);
             return receive_result;
         }
         
@@ -490,7 +1338,9 @@ public:
         if (os::wait_notification(timeout_ms, &notification) && ((notification & 0x01) != 0)) {
             receive_result = mailbox->receive();
             if (receive_result.is_ok()) {
-                received_count_++;
+                metrics_.write().received();
+                after_consume(*mailbox);
+                EMCORE_TRACE_MSG(msg_receive, receive_result.value().header);
                 return receive_result;
             }
         }
@@ -500,32 +1350,162 @@ public:
     
     /* Try receive (non-blocking) */
     result<MessageType, error_code> try_receive(task_id_t task_id) noexcept override {
-        task_mailbox* mailbox = find_mailbox(task_id);
+        mailbox_t* mailbox = find_mailbox(task_id);
         if (mailbox == nullptr) {
             return result<MessageType, error_code>(error_code::not_found);
         }
         
         auto receive_result = mailbox->receive();
         if (receive_result.is_ok()) {
-            received_count_++;
+            metrics_.write().received();
+            after_consume(*mailbox);
+            EMCORE_TRACE_MSG(msg_receive, receive_result.value().header);
             return receive_result;
         }
         
         return result<MessageType, error_code>(error_code::not_found);
     }
+
+    /*
+     * Visitor receive: fn(const MessageType&) sees the envelope in its mailbox slot,
+     * which is popped after fn returns. Copy inside fn only if the data must outlive it.
+     */
+    template <typename Fn>
+    result<void, error_code> receive_with(task_id_t task_id, timeout_ms_t timeout, Fn&& fn) noexcept {
+        mailbox_t* mailbox = find_mailbox(task_id);
+        if (mailbox == nullptr) {
+            return result<void, error_code>(error_code::not_found);
+        }
+        auto&& visit = traced_visitor(fn);
+        if (mailbox->visit_front(visit)) {
+            metrics_.write().received();
+            after_consume(*mailbox);
+            return ok();
+        }
+        u32 notification = 0;
+        if (os::wait_notification(timeout.value, &notification) && ((notification & 0x01) != 0)) {
+            if (mailbox->visit_front(visit)) {
+                metrics_.write().received();
+                after_consume(*mailbox);
+                return ok();
+            }
+        }
+        return result<void, error_code>(error_code::timeout);
+    }
+
+    /* Non-blocking visitor drain of up to max_count messages; returns how many fn saw */
+    template <typename Fn>
+    result<size_t, error_code> drain_with(task_id_t task_id, Fn&& fn, size_t max_count) noexcept {
+        mailbox_t* mailbox = find_mailbox(task_id);
+        if (mailbox == nullptr) {
+            return result<size_t, error_code>(error_code::not_found);
+        }
+        auto&& visit = traced_visitor(fn);
+        size_t count = 0;
+        while (count < max_count && mailbox->visit_front(visit)) {
+            ++count;
+        }
+        metrics_.write().received(static_cast<u32>(count));
+        if (count != 0U) {
+            after_consume(*mailbox);
+        }
+        return result<size_t, error_code>(count);
+    }
+
+    /* Publish a burst to one topic: topic resolved once, one lock + notify per subscriber */
+    result<size_t, error_code> publish_batch(u16 topic_id, etl::span<MessageType> msgs, task_id_t from_task_id) noexcept override {
+        if (msgs.empty()) {
+            return result<size_t, error_code>(static_cast<size_t>(0));
+        }
+        const timestamp_t now = os::time_us();
+        for (MessageType& msg : msgs) {
+            msg.header.sender_id = from_task_id.value();
+            if (msg.header.timestamp == 0) {
+                msg.header.timestamp = now;
+            }
+            if (msg.header.sequence_number == 0) {
+                msg.header.sequence_number = sequence_++;
+            }
+            msg.header.type = topic_id;
+        }
+
+        topic_subscription* topic = find_topic(topic_id);
+        if (topic == nullptr || topic->subscriber_ids.empty()) {
+            metrics_.write().dropped(drop_reason::unknown_topic, max_topics, MaxTasks, static_cast<u32>(msgs.size()));
+            return result<size_t, error_code>(error_code::not_found);
+        }
+#if EMCORE_ENABLE_TRACE
+        for (const MessageType& msg : msgs) { EMCORE_TRACE_MSG(msg_publish, msg.header); }
+#endif
+
+        if constexpr (shared_store) {
+            return publish_batch_shared(*topic, msgs);
+        }
+
+        size_t delivered = 0;
+        const etl::span<const MessageType> burst(msgs.data(), msgs.size());
+        auto stats = metrics_.write();
+        for (size_t i = 0; i < msgs.size(); ++i) { stats.published(topic->stats_slot); }
+        for (task_id_t subscriber_id : topic->subscriber_ids) {
+            mailbox_t* mailbox = find_mailbox(subscriber_id);
+            if (mailbox != nullptr) {
+                const size_t accepted = mailbox->send_batch(burst);
+                if (accepted != 0U) {
+                    after_send(*mailbox);
+                }
+                stats.delivered(topic->stats_slot, static_cast<u32>(accepted));
+                stats.dropped(drop_reason::depth_limit, topic->stats_slot, subscriber_id.value(),
+                              static_cast<u32>(msgs.size() - accepted));
+                delivered += accepted;
+            }
+        }
+        return (delivered != 0U) ? result<size_t, error_code>(delivered)
+                                 : result<size_t, error_code>(error_code::out_of_memory);
+    }
+
+    /* Receive up to max_count messages under one lock; waits once if the mailbox is empty */
+    result<size_t, error_code> receive_batch(task_id_t task_id, etl::span<MessageType> out, size_t max_count, timeout_ms_t timeout) noexcept override {
+        mailbox_t* mailbox = find_mailbox(task_id);
+        if (mailbox == nullptr) {
+            return result<size_t, error_code>(error_code::not_found);
+        }
+        const size_t limit = (max_count < out.size()) ? max_count : out.size();
+        if (limit == 0U) {
+            return result<size_t, error_code>(error_code::invalid_parameter);
+        }
+        const etl::span<MessageType> window(out.data(), limit);
+
+        size_t count = mailbox->receive_batch(window);
+        if (count == 0U) {
+            u32 notification = 0;
+            if (os::wait_notification(timeout.value, &notification) && ((notification & 0x01) != 0)) {
+                count = mailbox->receive_batch(window);
+            }
+        }
+        if (count == 0U) {
+            return result<size_t, error_code>(error_code::timeout);
+        }
+        metrics_.write().received(static_cast<u32>(count));
+        after_consume(*mailbox);
+#if EMCORE_ENABLE_TRACE
+        for (size_t i = 0; i < count; ++i) { EMCORE_TRACE_MSG(msg_receive, window[i].header); }
+#endif
+        return result<size_t, error_code>(count);
+    }
     
     /* Broadcast to all tasks */
     result<void, error_code> broadcast(const MessageType& msg) noexcept {
         /* Send to all subscribers */
         bool sent_any = false;
+        auto stats = metrics_.write();
         for (auto& mailbox : mailboxes_) {
             if (mailbox.task_id != invalid_task_id) {
                 auto send_result = mailbox.send(msg);
                 if (send_result.is_ok()) {
-                    sent_count_++;
+                    stats.delivered(max_topics);
                     sent_any = true;
                 } else {
-                    dropped_count_++;
+                    stats.dropped(drop_reason::depth_limit, max_topics, mailbox.task_id.value());
                 }
             }
         }
@@ -533,10 +1513,56 @@ public:
     }
     
     /* Statistics */
-    [[nodiscard]] u32 total_sent() const noexcept { return sent_count_; }
-    [[nodiscard]] u32 total_received() const noexcept { return received_count_; }
-    [[nodiscard]] u32 total_dropped() const noexcept { return dropped_count_; }
+    [[nodiscard]] u32 total_sent() const noexcept { return metrics_.total_sent(); }
+    [[nodiscard]] u32 total_received() const noexcept { return metrics_.total_received(); }
+    [[nodiscard]] u32 total_dropped() const noexcept { return metrics_.total_dropped(); }
+
+    using metrics_snapshot_t = typename metrics_t::snapshot_t;
+
+    /*
+     * Consistent copy of every counter: global, per topic (indexed by creation
+     * order, topic_count entries) and per mailbox (indexed by task id). Never
+     * blocks publishers; poll it from a monitoring task and diff successive
+     * snapshots for rates.
+     */
+    void metrics_snapshot(metrics_snapshot_t& out) const noexcept {
+        out = metrics_snapshot_t{};
+        out.timestamp_us = os::time_us();
+        metrics_.collect(out);
+        out.topic_count = topics_.size();
+        for (const topic_subscription& topic : topics_) {
+            topic_metrics& t = out.topics[topic.stats_slot];
+            t.topic_id = topic.topic_id;
+            t.subscribers = static_cast<u16>(topic.subscriber_ids.size());
+        }
+        out.mailbox_count = mailboxes_.size();
+        for (size_t i = 0; i < mailboxes_.size(); ++i) {
+            const mailbox_t& mailbox = mailboxes_[i];
+            mailbox_metrics& m = out.mailboxes[i];
+            m.task_id = mailbox.task_id;
+            m.depth = mailbox.depth();
+            m.received = mailbox.received_count;
+            m.notifies = mailbox.wakeups.load(etl::memory_order_relaxed);
+            if constexpr (Policy != mailbox_policy::spsc && Policy != mailbox_policy::mpsc) {
+                m.evicted = mailbox.dropped_overflow;
+            }
+        }
+    }
     [[nodiscard]] size_t mailbox_count() const noexcept { return mailboxes_.size(); }
+    /* Shared-store policy: envelopes in flight, peak, and publishes refused for lack of a slot */
+    [[nodiscard]] size_t store_in_use() const noexcept {
+        if constexpr (shared_store) { return store_.in_use(); } else { return 0U; }
+    }
+    [[nodiscard]] size_t store_high_water() const noexcept {
+        if constexpr (shared_store) { return store_.high_water(); } else { return 0U; }
+    }
+    [[nodiscard]] u32 store_exhausted() const noexcept {
+        if constexpr (shared_store) { return store_.exhausted_count(); } else { return 0U; }
+    }
+    [[nodiscard]] size_t subscriber_count(u16 topic_id) const noexcept {
+        const topic_subscription* topic = const_cast<message_broker*>(this)->find_topic(topic_id);
+        return (topic != nullptr) ? topic->subscriber_ids.size() : 0U;
+    }
 
     /* Configure per-topic subscriber capacity (soft cap) */
     // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
@@ -551,7 +1577,7 @@ public:
                 [](u16 topic_identifier, const topic_subscription& topic) {
                     return topic_identifier < topic.topic_id;
                 });
-            topic = &(*topics_.insert(insert_pos, topic_subscription(topic_id)));
+            topic = &(*topics_.insert(insert_pos, topic_subscription(topic_id, static_cast<u16>(topics_.size()))));
         }
         size_t clamped = max_subs > max_subscribers_per_topic ? max_subscribers_per_topic : max_subs;
         topic->capacity_limit = static_cast<u16>(clamped);
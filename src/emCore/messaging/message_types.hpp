@@ -94,6 +94,19 @@ struct message_ack {
     u8 error_code;
 };
 
+/*
+ * Windowed acknowledgment: every sequence in [first_sequence, last_sequence] was
+ * received, and bit i of selective_mask reports last_sequence + 1 + i.
+ * Told apart from message_ack by payload size.
+ */
+struct message_ack_range {
+    u16 first_sequence;
+    u16 last_sequence;   /* Highest contiguous sequence */
+    u16 sender_id;       /* Publisher being acknowledged */
+    u16 reserved;
+    u32 selective_mask;
+};
+
 }  // namespace emCore::messaging
 
 
@@ -8,11 +8,16 @@
 #include "message_types.hpp"
 #include "message_broker.hpp" // for Ibroker
 #include "../error/result.hpp"
+#include "../error/error_handler.hpp"
+#include <etl/array.h>
 #include <etl/map.h>
 
 namespace emCore::messaging {
 
-// QoS Publisher: ACK-based delivery with retransmission and ordering support
+// QoS Publisher: ACK-based delivery with retransmission and ordering support.
+// Pending entries sit in a min-heap keyed by retransmit deadline, so a pump only
+// touches expired entries; the wait after each send follows retry_policy::get_delay
+// and an entry is dropped once max_retries transmissions went unacknowledged.
 template <typename MsgType,
           size_t PendingLimit = config::default_qos_pending_limit>
 class qos_publisher {
@@ -24,6 +29,21 @@ public:
     qos_publisher(Ibroker<MsgType>& broker, task_id_t from_task_id, u16 ack_topic_id) noexcept
         : broker_(broker), from_task_id_(from_task_id), ack_topic_id_(ack_topic_id) {}
 
+    // Default policy: first wait is the ACK timeout (rounded up to whole ms), doubling up to the backoff ceiling
+    static error::retry_policy default_retry_policy() noexcept {
+        error::retry_policy policy{};
+        policy.max_retries = config::default_qos_max_attempts;
+        policy.initial_delay_ms = static_cast<duration_t>((config::default_ack_timeout_us + 999U) / 1000U);
+        policy.max_delay_ms = config::default_qos_max_backoff_ms;
+        policy.exponential_backoff = true;
+        policy.backoff_multiplier = 2.0F;
+        return policy;
+    }
+
+    // Applies to deadlines computed after the call; entries already waiting keep theirs
+    void set_retry_policy(const error::retry_policy& policy) noexcept { policy_ = policy; }
+    [[nodiscard]] const error::retry_policy& get_retry_policy() const noexcept { return policy_; }
+
     result<void, error_code> publish(u16 topic_id, MsgType& msg) noexcept {
         msg.header.flags = static_cast<u8>(static_cast<message_flags>(msg.header.flags) | message_flags::requires_ack);
         if (msg.header.timestamp == 0) { msg.header.timestamp = os::time_us(); }
@@ -36,60 +56,184 @@ public:
         pending_entry new_entry{};
         new_entry.msg = msg; // copy; zero-copy envelopes bump refcount
         new_entry.last_send = msg.header.timestamp;
+        new_entry.deadline = deadline_after_(new_entry.last_send, 0);
         new_entry.attempts = 1;
         auto insert_result = pending_.insert(typename pending_map::value_type(msg.header.sequence_number, new_entry));
         if (!insert_result.second) {
             return result<void, error_code>(error_code::out_of_memory);
         }
+        heap_push_(&insert_result.first->second);
         return broker_.publish(topic_id, msg, from_task_id_);
     }
 
-    void pump_retransmit() noexcept {
+    // Retransmits every entry whose deadline has passed; returns how many were resent
+    size_t pump_retransmit() noexcept {
         const timestamp_t now = os::time_us();
-        for (auto iter = pending_.begin(); iter != pending_.end(); ++iter) {
-            pending_entry& entry_ref = iter->second;
-            if ((now - entry_ref.last_send) >= static_cast<timestamp_t>(config::default_ack_timeout_us)) {
-                entry_ref.last_send = now;
-                ++entry_ref.attempts;
-                (void)broker_.publish(entry_ref.msg.header.type, entry_ref.msg, from_task_id_);
+        size_t resent = 0;
+        while (heap_size_ != 0U && heap_[0]->deadline <= now) {
+            pending_entry& entry_ref = *heap_[0];
+            if (entry_ref.attempts >= policy_.max_retries) {
+                // Attempt budget spent: stop retrying and free the slot
+                const u16 seq = entry_ref.msg.header.sequence_number;
+                heap_remove_(0);
+                pending_.erase(seq);
+                ++expired_;
+                continue;
             }
+            entry_ref.last_send = now;
+            entry_ref.deadline = deadline_after_(now, static_cast<u8>(entry_ref.attempts > 0xFF ? 0xFF : entry_ref.attempts));
+            ++entry_ref.attempts;
+            heap_sift_down_(0);
+            (void)broker_.publish(entry_ref.msg.header.type, entry_ref.msg, from_task_id_);
+            ++resent;
         }
+        return resent;
     }
 
     void on_ack(const message_ack& ack) noexcept {
         auto iter = pending_.find(ack.sequence_number);
-        if (iter != pending_.end()) { pending_.erase(iter); }
-        (void)ack;
+        if (iter != pending_.end()) {
+            heap_remove_(iter->second.heap_pos);
+            pending_.erase(iter);
+        }
     }
 
     [[nodiscard]] size_t pending_count() const noexcept { return pending_.size(); }
 
+    // Earliest retransmit deadline (0 when nothing is pending), for sleeping until the next pump
+    [[nodiscard]] timestamp_t next_deadline() const noexcept { return (heap_size_ != 0U) ? heap_[0]->deadline : 0; }
+
+    // Entries dropped after exhausting their attempt budget
+    [[nodiscard]] u32 expired_count() const noexcept { return expired_; }
+
+    // Releases [first_sequence, last_sequence] plus every entry flagged in the selective mask
+    void on_ack_range(const message_ack_range& ack) noexcept {
+        if (ack.sender_id != from_task_id_.value()) { return; }
+        const u16 span = static_cast<u16>(ack.last_sequence - ack.first_sequence);
+        if (span < 0x8000U) {
+            if (ack.first_sequence <= ack.last_sequence) {
+                release_between_(pending_.lower_bound(ack.first_sequence), pending_.upper_bound(ack.last_sequence));
+            } else {
+                // Sequence wrapped inside the range
+                release_between_(pending_.lower_bound(ack.first_sequence), pending_.end());
+                release_between_(pending_.begin(), pending_.upper_bound(ack.last_sequence));
+            }
+        }
+        for (u32 mask = ack.selective_mask, bit = 0; mask != 0U; mask >>= 1U, ++bit) {
+            if ((mask & 1U) == 0U) { continue; }
+            auto iter = pending_.find(static_cast<u16>(ack.last_sequence + 1U + bit));
+            if (iter != pending_.end()) {
+                heap_remove_(iter->second.heap_pos);
+                pending_.erase(iter);
+            }
+        }
+    }
+
     bool try_handle_ack_message(const small_message& msg) noexcept {
         if (msg.header.type != ack_topic_id_) { return false; }
+        if (msg.header.payload_size == sizeof(message_ack_range)) {
+            message_ack_range range{};
+            copy_payload_(msg, reinterpret_cast<u8*>(&range), sizeof(range));
+            on_ack_range(range);
+            return true;
+        }
         if (msg.header.payload_size != sizeof(message_ack)) { return false; }
         message_ack ack{};
-        const u8* src_ptr = &msg.payload[0];
-        u8* dst_ptr = reinterpret_cast<u8*>(&ack);
-        for (size_t i = 0; i < sizeof(message_ack); ++i) { *dst_ptr++ = *src_ptr++; }
+        copy_payload_(msg, reinterpret_cast<u8*>(&ack), sizeof(ack));
         on_ack(ack);
         return true;
     }
 
 private:
-    struct pending_entry { MsgType msg; timestamp_t last_send; u16 attempts; };
+    struct pending_entry { MsgType msg; timestamp_t last_send; timestamp_t deadline; u16 attempts; u16 heap_pos; };
     using pending_map = etl::map<u16, pending_entry, PendingLimit>;
     u16 next_seq_() noexcept { return static_cast<u16>(local_seq_++); }
 
+    static void copy_payload_(const small_message& msg, u8* dst_ptr, size_t size) noexcept {
+        const u8* src_ptr = &msg.payload[0];
+        for (size_t i = 0; i < size && i < sizeof(msg.payload); ++i) { *dst_ptr++ = *src_ptr++; }
+    }
+
+    template <typename Iter>
+    void release_between_(Iter first, Iter last) noexcept {
+        while (first != last) {
+            heap_remove_(first->second.heap_pos);
+            first = pending_.erase(first);
+        }
+    }
+
+    // A zero delay (sub-ms policy) still waits 1 ms, so it never reads as an immediate resend
+    timestamp_t deadline_after_(timestamp_t sent, u8 attempt) const noexcept {
+        const duration_t delay_ms = policy_.get_delay(attempt);
+        return sent + (static_cast<timestamp_t>((delay_ms == 0U) ? 1U : delay_ms) * 1000U);
+    }
+
+    // Binary min-heap over map nodes (etl::map nodes do not move while alive)
+    void heap_place_(size_t pos, pending_entry* entry) noexcept {
+        heap_[pos] = entry;
+        entry->heap_pos = static_cast<u16>(pos);
+    }
+
+    void heap_push_(pending_entry* entry) noexcept {
+        heap_place_(heap_size_, entry);
+        heap_sift_up_(heap_size_++);
+    }
+
+    void heap_sift_up_(size_t pos) noexcept {
+        pending_entry* entry = heap_[pos];
+        while (pos > 0) {
+            const size_t parent = (pos - 1) / 2;
+            if (heap_[parent]->deadline <= entry->deadline) { break; }
+            heap_place_(pos, heap_[parent]);
+            pos = parent;
+        }
+        heap_place_(pos, entry);
+    }
+
+    void heap_sift_down_(size_t pos) noexcept {
+        pending_entry* entry = heap_[pos];
+        for (;;) {
+            size_t child = (2 * pos) + 1;
+            if (child >= heap_size_) { break; }
+            if (child + 1 < heap_size_ && heap_[child + 1]->deadline < heap_[child]->deadline) { ++child; }
+            if (entry->deadline <= heap_[child]->deadline) { break; }
+            heap_place_(pos, heap_[child]);
+            pos = child;
+        }
+        heap_place_(pos, entry);
+    }
+
+    void heap_remove_(size_t pos) noexcept {
+        if (pos >= heap_size_) { return; }
+        --heap_size_;
+        if (pos == heap_size_) { return; }
+        pending_entry* moved = heap_[heap_size_];
+        heap_place_(pos, moved);
+        heap_sift_up_(pos);
+        heap_sift_down_(moved->heap_pos);
+    }
+
     Ibroker<MsgType>& broker_;
     task_id_t from_task_id_;
     u16 ack_topic_id_;
     pending_map pending_{};
+    etl::array<pending_entry*, PendingLimit> heap_{};
+    size_t heap_size_{0};
+    error::retry_policy policy_{default_retry_policy()};
+    u32 expired_{0};
     u32 local_seq_{1};
 };
 
+// ACK strategy for qos_subscriber
+enum class ack_mode : u8 {
+    immediate,   // one message_ack per received message
+    cumulative   // one message_ack_range per window, flushed on count or age
+};
+
 // QoS Subscriber: sends ACKs and enforces per-(sender,topic) monotonic ordering
 template <typename MsgType,
-          size_t TrackLimit = 32>
+          size_t TrackLimit = 32,
+          size_t AckSenders = 4>
 class qos_subscriber {
 public:
     qos_subscriber(broker_uptr<MsgType>& broker, task_id_t self_task_id, u16 ack_topic_id) noexcept
@@ -99,29 +243,107 @@ public:
     qos_subscriber(Ibroker<MsgType>& broker, task_id_t self_task_id, u16 ack_topic_id) noexcept
         : broker_(broker), self_task_id_(self_task_id), ack_topic_id_(ack_topic_id) {}
 
+    /*
+     * Cumulative mode folds ACKs into one message_ack_range per sender, published
+     * once batch messages are covered or the oldest unacknowledged one is
+     * delay_us old. Keep delay_us well below the publisher's retransmit timeout.
+     */
+    void set_ack_mode(ack_mode mode, u16 batch = config::default_qos_ack_batch,
+                      u32 delay_us = config::default_qos_ack_delay_us) noexcept {
+        if (mode_ == ack_mode::cumulative && mode != ack_mode::cumulative) { flush_acks(); }
+        mode_ = mode;
+        ack_batch_ = (batch == 0U) ? 1U : batch;
+        ack_delay_us_ = delay_us;
+    }
+
+    [[nodiscard]] ack_mode get_ack_mode() const noexcept { return mode_; }
+
+    // Publishes every held ACK window regardless of thresholds
+    void flush_acks() noexcept { flush_windows_(true); }
+
     result<MsgType, error_code> receive(timeout_ms_t timeout) noexcept {
         auto res = broker_.receive(self_task_id_, timeout);
-        if (!res.is_ok()) { return res; }
+        if (!res.is_ok()) { flush_windows_(false); return res; }
         MsgType msg = res.value();
 
         const u32 key = (static_cast<u32>(msg.header.sender_id) << 16) | static_cast<u32>(msg.header.type);
         auto iter = last_seq_.find(key);
         const u16 seq = msg.header.sequence_number;
         if (iter != last_seq_.end()) {
-            if (seq == iter->second) { send_ack_(seq, msg.header.sender_id, true); return result<MsgType, error_code>(error_code::not_found); }
-            if (static_cast<i32>(seq) - static_cast<i32>(iter->second) <= 0) { send_ack_(seq, msg.header.sender_id, true); return result<MsgType, error_code>(error_code::not_found); }
+            if (seq == iter->second) { ack_(seq, msg.header.sender_id); return result<MsgType, error_code>(error_code::not_found); }
+            if (static_cast<i32>(seq) - static_cast<i32>(iter->second) <= 0) { ack_(seq, msg.header.sender_id); return result<MsgType, error_code>(error_code::not_found); }
             iter->second = seq;
         } else {
             if (last_seq_.size() < last_seq_.capacity()) { last_seq_.insert(typename seq_map::value_type(key, seq)); }
         }
 
-        if (has_flag(static_cast<message_flags>(msg.header.flags), message_flags::requires_ack)) { send_ack_(seq, msg.header.sender_id, true); }
+        if (has_flag(static_cast<message_flags>(msg.header.flags), message_flags::requires_ack)) { ack_(seq, msg.header.sender_id); }
+        flush_windows_(false);
         return result<MsgType, error_code>(msg);
     }
 
 private:
     using seq_map = etl::map<u32, u16, TrackLimit>;
 
+    // Received run [first, last] plus a 32-sequence bitmap above last
+    struct ack_window { u16 first; u16 last; u32 mask; u16 unflushed; timestamp_t oldest; };
+    using window_map = etl::map<u16, ack_window, AckSenders>;
+    static constexpr i32 window_bits = 32;
+
+    void ack_(u16 seq, u16 to_sender) noexcept {
+        if (mode_ != ack_mode::cumulative) { send_ack_(seq, to_sender, true); return; }
+        auto iter = windows_.find(to_sender);
+        if (iter == windows_.end()) {
+            if (windows_.full()) { send_ack_(seq, to_sender, true); return; }
+            iter = windows_.insert(typename window_map::value_type(to_sender, ack_window{seq, seq, 0, 0, 0})).first;
+        } else {
+            ack_window& window = iter->second;
+            const i32 ahead = static_cast<i16>(static_cast<u16>(seq - window.last));
+            if (ahead > 0 && ahead <= window_bits) {
+                window.mask |= (1UL << static_cast<u32>(ahead - 1));
+                while ((window.mask & 1U) != 0U) { ++window.last; window.mask >>= 1U; }
+            } else if (ahead > 0 || static_cast<i16>(static_cast<u16>(seq - window.first)) < 0) {
+                // Outside what the window can express: report it and restart at seq
+                send_window_(to_sender, window);
+                window = ack_window{seq, seq, 0, 0, 0};
+            }
+            // else: duplicate inside the run, re-reported with the next flush
+        }
+        ack_window& window = iter->second;
+        if (window.unflushed == 0U) { window.oldest = os::time_us(); }
+        if (++window.unflushed >= ack_batch_) { send_window_(to_sender, window); }
+    }
+
+    void flush_windows_(bool force) noexcept {
+        if (mode_ != ack_mode::cumulative || windows_.empty()) { return; }
+        const timestamp_t now = os::time_us();
+        for (auto iter = windows_.begin(); iter != windows_.end(); ++iter) {
+            ack_window& window = iter->second;
+            if (window.unflushed != 0U && (force || (now - window.oldest) >= ack_delay_us_)) {
+                send_window_(iter->first, window);
+            }
+        }
+    }
+
+    void send_window_(u16 to_sender, ack_window& window) noexcept {
+        if (window.unflushed == 0U) { return; }
+        message_ack_range ack{window.first, window.last, to_sender, 0, window.mask};
+        small_message ack_msg{};
+        ack_msg.header.type = ack_topic_id_;
+        ack_msg.header.sender_id = self_task_id_.value();
+        ack_msg.header.receiver_id = to_sender;
+        ack_msg.header.payload_size = sizeof(ack);
+        ack_msg.header.timestamp = os::time_us();
+        if (sizeof(ack) <= sizeof(ack_msg.payload)) {
+            const u8* src = reinterpret_cast<const u8*>(&ack);
+            for (size_t i = 0; i < sizeof(ack); ++i) { ack_msg.payload[i] = src[i]; }
+            (void)broker_.publish(ack_msg.header.type, ack_msg, self_task_id_);
+        }
+        // Reported sequences stay in the bitmap; the run restarts at last
+        window.first = window.last;
+        window.unflushed = 0;
+    }
+
     void send_ack_(u16 seq, u16 to_sender, bool success) noexcept {
         message_ack ack{seq, to_sender, success, 0};
         small_message ack_msg{};
@@ -141,6 +363,10 @@ private:
     task_id_t self_task_id_;
     u16 ack_topic_id_;
     seq_map last_seq_{};
+    window_map windows_{};
+    ack_mode mode_{ack_mode::immediate};
+    u16 ack_batch_{config::default_qos_ack_batch};
+    u32 ack_delay_us_{config::default_qos_ack_delay_us};
 };
 
 } // namespace emCore::messaging
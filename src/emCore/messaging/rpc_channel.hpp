@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstddef>
+
+#include "../core/types.hpp"
+#include "../error/result.hpp"
+#include "../os/sync.hpp"
+#include "../os/wake.hpp"
+
+#include <etl/atomic.h>
+#include <etl/type_traits.h>
+
+namespace emCore::messaging {
+
+/**
+ * @brief Typed request/reply rendezvous between one client and one server task
+ *
+ * call() lends the server a pointer to the caller's request and to the
+ * caller's reply storage, then blocks; serve() runs the handler on them in
+ * place and releases the caller. Nothing is copied or routed through a broker,
+ * and each direction costs one semaphore give (plus a cooperative wake-up of
+ * the server task, when one is named, so a tickless taskmaster picks it up).
+ *
+ * The handler writes straight into the caller's storage, so once the server
+ * has accepted a request the caller waits for its reply regardless of the
+ * timeout; the timeout only bounds the wait for the server to accept it.
+ */
+template <typename Request, typename Reply>
+class rpc_channel {
+public:
+    using request_type = Request;
+    using reply_type = Reply;
+
+    rpc_channel() noexcept = default;
+    rpc_channel(const rpc_channel&) = delete;
+    rpc_channel& operator=(const rpc_channel&) = delete;
+    rpc_channel(rpc_channel&&) = delete;
+    rpc_channel& operator=(rpc_channel&&) = delete;
+    ~rpc_channel() noexcept {
+        if (request_sem_ != nullptr) { os::delete_semaphore(request_sem_); }
+        if (reply_sem_ != nullptr) { os::delete_semaphore(reply_sem_); }
+    }
+
+    /* server_task is woken through os::wake_cooperative(); invalid_task_id for native servers */
+    result<void, error_code> initialize(task_id_t server_task = invalid_task_id) noexcept {
+        if (request_sem_ != nullptr) {
+            return result<void, error_code>(error_code::already_exists);
+        }
+        request_sem_ = os::create_binary_semaphore();
+        reply_sem_ = os::create_binary_semaphore();
+        if (request_sem_ == nullptr || reply_sem_ == nullptr) {
+            return result<void, error_code>(error_code::out_of_memory);
+        }
+        server_ = server_task;
+        return ok();
+    }
+
+    /*
+     * Client side: block until the server has written `out`. Returns the
+     * handler's status, timeout when the server did not accept the request in
+     * time, or already_exists when another call is in flight.
+     */
+    result<void, error_code> call(const Request& request, Reply& out,
+                                  timeout_ms_t timeout = timeout_ms_t::infinite()) noexcept {
+        if (request_sem_ == nullptr) {
+            return result<void, error_code>(error_code::not_initialized);
+        }
+        u8 expected = idle;
+        if (!state_.compare_exchange_strong(expected, claimed, etl::memory_order_acquire)) {
+            return result<void, error_code>(error_code::already_exists);
+        }
+        request_ = &request;
+        reply_ = &out;
+        status_ = error_code::success;
+        state_.store(pending, etl::memory_order_release);
+        (void)os::semaphore_give(request_sem_);
+        if (server_ != invalid_task_id) {
+            os::wake_cooperative(server_);
+        }
+
+        if (!os::semaphore_take(reply_sem_, to_us(timeout))) {
+            // Withdraw the request unless the server already holds our storage
+            expected = pending;
+            if (state_.compare_exchange_strong(expected, idle, etl::memory_order_acq_rel)) {
+                timeouts_.fetch_add(1U, etl::memory_order_relaxed);
+                return result<void, error_code>(error_code::timeout);
+            }
+            (void)os::semaphore_take(reply_sem_, wait_forever);
+        }
+        const error_code status = status_;
+        state_.store(idle, etl::memory_order_release);
+        if (status != error_code::success) {
+            return result<void, error_code>(status);
+        }
+        return ok();
+    }
+
+    /*
+     * Server side: wait up to `timeout` for a request and answer it with
+     * fn(const Request&, Reply&), which returns void or result<void, error_code>.
+     * timeout_ms_t(0) polls, for cooperative servers. Returns true if a request
+     * was served.
+     */
+    template <typename Fn>
+    bool serve(Fn&& fn, timeout_ms_t timeout = timeout_ms_t(0)) noexcept {
+        if (request_sem_ == nullptr) {
+            return false;
+        }
+        u8 expected = pending;
+        if (!state_.compare_exchange_strong(expected, serving, etl::memory_order_acquire)) {
+            // Nothing pending yet (or a withdrawn request left the semaphore given)
+            if (!os::semaphore_take(request_sem_, to_us(timeout))) {
+                return false;
+            }
+            expected = pending;
+            if (!state_.compare_exchange_strong(expected, serving, etl::memory_order_acquire)) {
+                return false;
+            }
+        }
+        using ret_t = decltype(fn(*request_, *reply_));
+        if constexpr (etl::is_void<ret_t>::value) {
+            fn(*request_, *reply_);
+            status_ = error_code::success;
+        } else {
+            const auto r = fn(*request_, *reply_);
+            status_ = r.is_ok() ? error_code::success : r.error();
+        }
+        served_.fetch_add(1U, etl::memory_order_relaxed);
+        state_.store(replied, etl::memory_order_release);
+        (void)os::semaphore_give(reply_sem_);
+        return true;
+    }
+
+    // A request is waiting to be served (cheap; for cooperative servers)
+    [[nodiscard]] bool pending_request() const noexcept {
+        return state_.load(etl::memory_order_acquire) == pending;
+    }
+    [[nodiscard]] u32 served_count() const noexcept { return served_.load(etl::memory_order_relaxed); }
+    [[nodiscard]] u32 timeout_count() const noexcept { return timeouts_.load(etl::memory_order_relaxed); }
+
+private:
+    enum : u8 { idle = 0, claimed = 1, pending = 2, serving = 3, replied = 4 };
+
+    static constexpr duration_t wait_forever = static_cast<duration_t>(0xFFFFFFFFU);
+
+    static duration_t to_us(timeout_ms_t timeout) noexcept {
+        if (timeout == timeout_ms_t::infinite()) { return wait_forever; }
+        const u64 us = static_cast<u64>(timeout.value) * 1000U;
+        return (us >= wait_forever) ? static_cast<duration_t>(wait_forever - 1U) : static_cast<duration_t>(us);
+    }
+
+    etl::atomic<u8> state_{idle};
+    const Request* request_{nullptr};
+    Reply* reply_{nullptr};
+    error_code status_{error_code::success};
+    task_id_t server_{invalid_task_id};
+    os::semaphore_handle_t request_sem_{nullptr};
+    os::semaphore_handle_t reply_sem_{nullptr};
+    etl::atomic<u32> served_{0};
+    etl::atomic<u32> timeouts_{0};
+};
+
+}  // namespace emCore::messaging
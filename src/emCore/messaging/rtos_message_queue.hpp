@@ -3,11 +3,14 @@
 #include "../core/types.hpp"
 #include "../os/sync.hpp"
 #include "../os/time.hpp"
+#include "../os/tasks.hpp"
 #include "../error/result.hpp"
 
-#include <etl/circular_buffer.h>
+#include "../utils/helpers.hpp"
+
 #include <etl/array.h>
 #include <etl/algorithm.h>
+#include <etl/span.h>
 #include <cstddef>
 
 
@@ -56,13 +59,32 @@ struct message_wrapper {
 
 /**
  * @brief RTOS-optimized message queue
+ *
+ * With config.priority_queue set, messages go to one FIFO lane per priority
+ * (priorities >= PriorityLanes - 1 share the top lane). Lanes are index-linked
+ * lists over one shared slot array, and a ready bitmap picks the highest
+ * non-empty lane, so send and receive are O(1) at any depth.
  */
-template<typename MessageType, size_t QueueSize = 32>
+template<typename MessageType, size_t QueueSize = 32, size_t PriorityLanes = 8>
 class rtos_message_queue {
 private:
     using message_wrapper_t = message_wrapper<MessageType>;
-    
-    etl::circular_buffer<message_wrapper_t, QueueSize> queue_;
+
+    static_assert(QueueSize >= 1 && QueueSize < 0xFFFF, "rtos_message_queue QueueSize must be in [1, 65534]");
+    static_assert(PriorityLanes >= 1 && PriorityLanes <= 32, "rtos_message_queue supports 1..32 priority lanes");
+    static constexpr u16 end_of_lane = 0xFFFF;
+
+    struct lane {
+        u16 head{end_of_lane};
+        u16 tail{end_of_lane};
+    };
+
+    etl::array<message_wrapper_t, QueueSize> slots_{};
+    etl::array<u16, QueueSize> next_{};
+    etl::array<lane, PriorityLanes> lanes_{};
+    u16 free_head_{0};
+    u32 ready_mask_{0};
+    size_t count_{0};
     rtos_queue_config config_;
     
     // RTOS synchronization (platform-agnostic)
@@ -81,6 +103,7 @@ public:
         : config_(config),
           send_semaphore_(os::create_binary_semaphore()),
           receive_semaphore_(os::create_binary_semaphore()) {
+        reset_slots();
     }
     
     // Rule of Five: Delete copy/move operations for RTOS resources
@@ -105,28 +128,18 @@ public:
         
         critical_section_.enter();
         
-        if (queue_.full()) {
+        if (count_ == QueueSize) {
             critical_section_.exit();
             messages_dropped_++;
             return result<void, error_code>(error_code::out_of_memory);
         }
         
-        message_wrapper_t wrapper(message, priority);
-        
-        if (config_.priority_queue) {
-            // Insert based on priority (higher priority first)
-            auto iter = queue_.begin();
-            while (iter != queue_.end() && iter->priority >= priority) {
-                ++iter;
-            }
-            queue_.insert(iter, wrapper);
-        } else {
-            // FIFO insertion
-            queue_.push_back(wrapper);
-        }
+        // FIFO mode uses lane 0 only; priority mode keeps FIFO order within a lane
+        const size_t lane_index = config_.priority_queue ? etl::min(static_cast<size_t>(priority), PriorityLanes - 1) : 0U;
+        push_unlocked(message_wrapper_t(message, priority), lane_index);
         
         messages_sent_++;
-        peak_queue_size_ = etl::max(peak_queue_size_, static_cast<u32>(queue_.size()));
+        peak_queue_size_ = etl::max(peak_queue_size_, static_cast<u32>(count_));
         
         // Signal waiting receivers (platform-agnostic)
         os::semaphore_give(receive_semaphore_);
@@ -136,52 +149,52 @@ public:
         return ok();
     }
     
+    /* Timeout value for receive()/receive_many() that never expires */
+    static constexpr duration_t wait_forever = static_cast<duration_t>(0xFFFFFFFFU);
+
     /**
-     * @brief Non-blocking receive with timeout (RTOS-safe)
+     * @brief Receive with optional timeout (RTOS-safe); not_found when nothing arrived
      */
     result<message_wrapper_t, error_code> receive_nonblocking(duration_t timeout_us = 0) noexcept {
         message_wrapper_t msg_wrapper;
-        
-        // Quick check without blocking
-        critical_section_.enter();
-        
-        if (!queue_.empty()) {
-            msg_wrapper = queue_.front();
-            queue_.pop();
-            messages_received_++;
-            critical_section_.exit();
+        if (wait_and_take(timeout_us, [this, &msg_wrapper]() { return pop_unlocked(msg_wrapper); })) {
             return result<message_wrapper_t, error_code>(msg_wrapper);
         }
-        
-        critical_section_.exit();
-        
-        // If no message and timeout requested, wait
-        if (timeout_us > 0) {
-            if (os::semaphore_take(receive_semaphore_, timeout_us)) {
-                // Try again after semaphore signal
-                critical_section_.enter();
-                if (!queue_.empty()) {
-                    msg_wrapper = queue_.front();
-                    queue_.pop();
-                    messages_received_++;
-                    critical_section_.exit();
-                    return result<message_wrapper_t, error_code>(msg_wrapper);
-                }
-                critical_section_.exit();
-            } else {
-                // Fallback: busy wait for systems without semaphore support
-                timestamp_t start = os::time_us();
-                while ((os::time_us() - start) < timeout_us) {
-                    auto retry_result = receive_nonblocking(0); // Try again
-                    if (retry_result.is_ok()) {
-                        return retry_result;
-                    }
-                    os::delay_ms(1); // Small delay
-                }
+        return result<message_wrapper_t, error_code>(error_code::not_found);
+    }
+
+    /**
+     * @brief Blocking receive: sleeps on the receive semaphore until a message
+     *        arrives or timeout_us elapses (wait_forever = no deadline)
+     */
+    result<message_wrapper_t, error_code> receive(duration_t timeout_us = wait_forever) noexcept {
+        message_wrapper_t msg_wrapper;
+        if (wait_and_take(timeout_us, [this, &msg_wrapper]() { return pop_unlocked(msg_wrapper); })) {
+            return result<message_wrapper_t, error_code>(msg_wrapper);
+        }
+        return result<message_wrapper_t, error_code>(error_code::timeout);
+    }
+
+    /**
+     * @brief Wait like receive(), then drain up to out.size() messages in one
+     *        critical section
+     * @return Number of messages written to out
+     */
+    result<size_t, error_code> receive_many(etl::span<message_wrapper_t> out, duration_t timeout_us = wait_forever) noexcept {
+        if (out.empty()) {
+            return result<size_t, error_code>(error_code::invalid_parameter);
+        }
+        size_t count = 0;
+        const bool got = wait_and_take(timeout_us, [this, &out, &count]() {
+            while (count < out.size() && pop_unlocked(out[count])) {
+                ++count;
             }
+            return count != 0U;
+        });
+        if (!got) {
+            return result<size_t, error_code>(error_code::timeout);
         }
-        
-        return result<message_wrapper_t, error_code>(error_code::not_found);
+        return result<size_t, error_code>(count);
     }
     
     /**
@@ -189,7 +202,7 @@ public:
      */
     bool empty() const noexcept {
         critical_section_.enter();
-        bool is_empty = queue_.empty();
+        bool is_empty = (count_ == 0);
         critical_section_.exit();
         return is_empty;
     }
@@ -199,7 +212,7 @@ public:
      */
     size_t size() const noexcept {
         critical_section_.enter();
-        size_t current_size = queue_.size();
+        size_t current_size = count_;
         critical_section_.exit();
         return current_size;
     }
@@ -238,9 +251,98 @@ public:
      */
     void clear() noexcept {
         critical_section_.enter();
-        queue_.clear();
+        reset_slots();
         critical_section_.exit();
     }
+
+private:
+    /*
+     * Run take() under the lock until it succeeds or the deadline passes. The
+     * binary semaphore latches a give that lands between a failed take() and the
+     * wait, so no wakeup is lost; a stale give only costs one extra loop. Backends
+     * without semaphores (bare-metal generic) fall back to yielding.
+     */
+    template <typename TakeFn>
+    bool wait_and_take(duration_t timeout_us, TakeFn&& take) noexcept {
+        const bool forever = (timeout_us == wait_forever);
+        const timestamp_t start = os::time_us();
+        for (;;) {
+            critical_section_.enter();
+            const size_t before = count_;
+            const bool got = take();
+            if (got) {
+                messages_received_ += static_cast<u32>(before - count_);
+            }
+            const bool more = (count_ != 0U);
+            critical_section_.exit();
+            if (got) {
+                if (more) {
+                    os::semaphore_give(receive_semaphore_);  // pass the wakeup on to another receiver
+                }
+                return true;
+            }
+            const timestamp_t elapsed = os::time_us() - start;
+            if (!forever && elapsed >= timeout_us) {
+                return false;
+            }
+            const duration_t remaining = forever ? wait_forever : static_cast<duration_t>(timeout_us - elapsed);
+            if (receive_semaphore_ != nullptr) {
+                (void)os::semaphore_take(receive_semaphore_, remaining);
+            } else {
+                os::yield();
+            }
+        }
+    }
+
+    void reset_slots() noexcept {
+        for (size_t i = 0; i < QueueSize; ++i) {
+            next_[i] = (i + 1 < QueueSize) ? static_cast<u16>(i + 1) : end_of_lane;
+            slots_[i] = message_wrapper_t{};
+        }
+        for (lane& l : lanes_) {
+            l = lane{};
+        }
+        free_head_ = 0;
+        ready_mask_ = 0;
+        count_ = 0;
+    }
+
+    /* Caller holds critical_section_ and has checked count_ < QueueSize */
+    void push_unlocked(const message_wrapper_t& wrapper, size_t lane_index) noexcept {
+        const u16 slot = free_head_;
+        free_head_ = next_[slot];
+        slots_[slot] = wrapper;
+        next_[slot] = end_of_lane;
+        lane& l = lanes_[lane_index];
+        if (l.tail == end_of_lane) {
+            l.head = slot;
+        } else {
+            next_[l.tail] = slot;
+        }
+        l.tail = slot;
+        ready_mask_ |= (1U << lane_index);
+        ++count_;
+    }
+
+    /* Caller holds critical_section_; takes the oldest message of the highest ready lane */
+    bool pop_unlocked(message_wrapper_t& out) noexcept {
+        if (ready_mask_ == 0U) {
+            return false;
+        }
+        const u8 lane_index = utils::highest_set_bit(ready_mask_);
+        lane& l = lanes_[lane_index];
+        const u16 slot = l.head;
+        out = slots_[slot];
+        l.head = next_[slot];
+        if (l.head == end_of_lane) {
+            l.tail = end_of_lane;
+            ready_mask_ &= ~(1U << lane_index);
+        }
+        next_[slot] = free_head_;
+        free_head_ = slot;
+        --count_;
+        return true;
+    }
 };
 
 /**
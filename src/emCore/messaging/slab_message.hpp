@@ -0,0 +1,218 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+
+#include "../core/types.hpp"
+#include "../core/config.hpp"
+#include "../error/result.hpp"
+#include "../os/sync.hpp"
+#include "message_broker.hpp"
+#include "zero_copy.hpp"
+
+namespace emCore::messaging {
+
+/**
+ * @brief Refcounted payload pool with three size classes (small/medium/large)
+ *
+ * A drop-in PoolT for zc_handle / zc_message_envelope: allocate(size) picks the
+ * smallest class that fits and spills into the next class up when exhausted.
+ * Handle indices carry the class in the top two bits, so a queue slot only has
+ * to hold the header plus {pool*, index, size} regardless of payload length.
+ */
+template <size_t SmallCount, size_t MediumCount, size_t LargeCount,
+          size_t SmallSize = config::slab_small_size,
+          size_t MediumSize = config::slab_medium_size,
+          size_t LargeSize = config::slab_large_size>
+class size_class_pool {
+    static_assert(SmallSize < MediumSize && MediumSize < LargeSize, "size classes must be strictly increasing");
+    static_assert(SmallCount < 0x3FFF && MediumCount < 0x3FFF && LargeCount < 0x3FFF,
+                  "size_class_pool supports at most 16382 blocks per class");
+
+    static constexpr u16 class_shift = 14;
+    static constexpr u16 block_mask = 0x3FFF;
+    static constexpr u16 end_of_list = 0x3FFF;
+
+    template <size_t BlockSize, size_t BlockCount>
+    struct size_class {
+        struct node {
+            alignas(4) u8 payload[BlockSize];
+            u16 size;
+            u16 refs;
+            u16 next;
+        };
+        etl::array<node, (BlockCount > 0 ? BlockCount : 1)> nodes{};
+        u16 free_head{end_of_list};
+        u16 in_use{0};
+
+        void initialize() noexcept {
+            in_use = 0;
+            free_head = (BlockCount > 0) ? 0 : end_of_list;
+            for (size_t i = 0; i < BlockCount; ++i) {
+                nodes[i].size = 0;
+                nodes[i].refs = 0;
+                nodes[i].next = (i == BlockCount - 1) ? end_of_list : static_cast<u16>(i + 1);
+            }
+        }
+
+        /* Caller holds the pool lock */
+        u16 take(u16 size) noexcept {
+            if (free_head == end_of_list) {
+                return end_of_list;
+            }
+            const u16 idx = free_head;
+            free_head = nodes[idx].next;
+            nodes[idx].size = size;
+            nodes[idx].refs = 0;  // handle constructor takes the first reference
+            nodes[idx].next = end_of_list;
+            ++in_use;
+            return idx;
+        }
+
+        bool retain(u16 idx) noexcept {
+            if (idx < BlockCount && nodes[idx].refs != 0xFFFF) { ++nodes[idx].refs; return true; }
+            return false;
+        }
+
+        void drop(u16 idx) noexcept {
+            if (idx < BlockCount && nodes[idx].refs > 0 && --nodes[idx].refs == 0) {
+                nodes[idx].next = free_head;
+                free_head = idx;
+                --in_use;
+            }
+        }
+    };
+
+public:
+    using handle_t = zc_handle<size_class_pool>;
+
+    size_class_pool() noexcept { initialize(); }
+
+    void initialize() noexcept {
+        small_.initialize();
+        medium_.initialize();
+        large_.initialize();
+    }
+
+    handle_t allocate(u16 size) noexcept {
+        if (size > LargeSize) {
+            return handle_t();
+        }
+        u16 index = 0xFFFF;
+        cs_.enter();
+        if (size <= SmallSize) {
+            index = tag(0, small_.take(size));
+        }
+        if (index == 0xFFFF && size <= MediumSize) {
+            index = tag(1, medium_.take(size));
+        }
+        if (index == 0xFFFF) {
+            index = tag(2, large_.take(size));
+        }
+        cs_.exit();
+        if (index == 0xFFFF) {
+            return handle_t();
+        }
+        return handle_t(this, index, size);
+    }
+
+    bool add_ref(u16 index) noexcept {
+        cs_.enter();
+        bool taken = false;
+        switch (index >> class_shift) {
+            case 0: taken = small_.retain(index & block_mask); break;
+            case 1: taken = medium_.retain(index & block_mask); break;
+            case 2: taken = large_.retain(index & block_mask); break;
+            default: break;
+        }
+        cs_.exit();
+        return taken;
+    }
+
+    void release(u16 index) noexcept {
+        cs_.enter();
+        switch (index >> class_shift) {
+            case 0: small_.drop(index & block_mask); break;
+            case 1: medium_.drop(index & block_mask); break;
+            case 2: large_.drop(index & block_mask); break;
+            default: break;
+        }
+        cs_.exit();
+    }
+
+    u8* data(u16 index) noexcept {
+        const u16 idx = index & block_mask;
+        switch (index >> class_shift) {
+            case 0: return (idx < SmallCount) ? small_.nodes[idx].payload : nullptr;
+            case 1: return (idx < MediumCount) ? medium_.nodes[idx].payload : nullptr;
+            case 2: return (idx < LargeCount) ? large_.nodes[idx].payload : nullptr;
+            default: return nullptr;
+        }
+    }
+    const u8* data(u16 index) const noexcept { return const_cast<size_class_pool*>(this)->data(index); }
+
+    u16 block_size(u16 index) const noexcept {
+        const u16 idx = index & block_mask;
+        switch (index >> class_shift) {
+            case 0: return (idx < SmallCount) ? small_.nodes[idx].size : 0;
+            case 1: return (idx < MediumCount) ? medium_.nodes[idx].size : 0;
+            case 2: return (idx < LargeCount) ? large_.nodes[idx].size : 0;
+            default: return 0;
+        }
+    }
+
+    [[nodiscard]] size_t capacity() const noexcept { return SmallCount + MediumCount + LargeCount; }
+    [[nodiscard]] static constexpr size_t block_capacity() noexcept { return LargeSize; }
+
+    /* Blocks currently handed out per class (0 = small, 1 = medium, 2 = large) */
+    [[nodiscard]] size_t in_use(u8 size_class_index) const noexcept {
+        switch (size_class_index) {
+            case 0: return small_.in_use;
+            case 1: return medium_.in_use;
+            case 2: return large_.in_use;
+            default: return 0;
+        }
+    }
+
+    /* Payload bytes reserved by the three classes */
+    static constexpr size_t storage_bytes() noexcept {
+        return SmallSize * SmallCount + MediumSize * MediumCount + LargeSize * LargeCount;
+    }
+
+private:
+    static constexpr u16 tag(u16 size_class_index, u16 idx) noexcept {
+        return (idx == end_of_list) ? 0xFFFF : static_cast<u16>((size_class_index << class_shift) | idx);
+    }
+
+    os::critical_section cs_;
+    size_class<SmallSize, SmallCount> small_;
+    size_class<MediumSize, MediumCount> medium_;
+    size_class<LargeSize, LargeCount> large_;
+};
+
+/* Default slab pool and envelope sized via config */
+using slab_pool = size_class_pool<config::slab_small_count, config::slab_medium_count, config::slab_large_count>;
+using slab_message = zc_message_envelope<slab_pool>;
+
+/*
+ * Copy a payload into the slab and publish the envelope through any broker
+ * carrying slab envelopes. Returns out_of_memory when every fitting class is
+ * exhausted; the header's payload_size is set from size.
+ */
+template <typename BrokerT, typename PoolT>
+result<void, error_code> publish_slab(BrokerT& broker, PoolT& pool, u16 topic_id, const u8* data, u16 size,
+                                      task_id_t from_task_id, message_header header = {}) noexcept {
+    zc_message_envelope<PoolT> msg{};
+    msg.handle = pool.allocate(size);
+    if (!msg.handle.valid()) {
+        return result<void, error_code>(error_code::out_of_memory);
+    }
+    if (size != 0U && data != nullptr) {
+        std::memcpy(msg.handle.data(), data, size);
+    }
+    msg.header = header;
+    msg.header.payload_size = size;
+    return broker.publish(topic_id, msg, from_task_id);
+}
+
+}  // namespace emCore::messaging
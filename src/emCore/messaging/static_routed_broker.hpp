@@ -0,0 +1,322 @@
+#pragma once
+
+#include <cstddef>
+
+#include "../core/types.hpp"
+#include "../core/config.hpp"
+#include "../error/result.hpp"
+#include "../os/time.hpp"
+#include "../os/sync.hpp"
+#include "../os/tasks.hpp"
+#include "../utils/helpers.hpp"
+#include "message_types.hpp"
+#include "message_broker.hpp"
+
+#include <etl/array.h>
+#include <etl/circular_buffer.h>
+#include <etl/span.h>
+
+namespace emCore::messaging {
+
+/* One delivery target of a route: dense mailbox index + pre-assigned topic slot */
+struct route_target {
+    u8 mailbox;
+    u8 slot;
+    u16 depth;  // soft cap for this (topic, mailbox) queue; 0 = slot capacity
+};
+
+/*
+ * Routes is a generated table type (see scripts/generate_tasks.py) providing:
+ *   static constexpr size_t topic_count, mailbox_count, slots_per_mailbox, slot_capacity, task_count;
+ *   static constexpr u16 topic_ids[topic_count];
+ *   static constexpr u8 target_offset[topic_count + 1];   // targets[offset[i] .. offset[i+1])
+ *   static constexpr route_target targets[];
+ *   static constexpr u8 mailbox_of_task[task_count];       // 0xFF = task has no mailbox
+ *   static constexpr int index_of(u16 topic_id) noexcept;  // -1 when unknown
+ */
+
+/**
+ * @brief Broker over a build-time routing table
+ *
+ * Publishing resolves topic -> targets with Routes::index_of (a generated switch)
+ * and then walks a contiguous constexpr target range; every target names its
+ * mailbox and queue slot directly, so there is no subscribe-time bookkeeping,
+ * no sorted topic vector and no per-mailbox topic search.
+ */
+template <typename MessageType, typename Routes>
+class static_routed_broker : public Ibroker<MessageType> {
+    static constexpr size_t slot_total = Routes::slot_capacity;
+    static_assert(Routes::slots_per_mailbox >= 1 && Routes::slots_per_mailbox <= 32,
+                  "Routes::slots_per_mailbox must be in [1, 32] (bitmap width)");
+    static_assert(slot_total >= 2, "Routes::slot_capacity must be >= 2 (high + normal)");
+    static constexpr size_t calc_high = (slot_total * config::default_topic_high_ratio_num)
+                                        / config::default_topic_high_ratio_den;
+    // Both lanes keep at least one entry whatever the high ratio
+    static constexpr size_t high_capacity = (calc_high < 1) ? 1 : ((calc_high >= slot_total) ? slot_total - 1U : calc_high);
+    static constexpr size_t normal_capacity = slot_total - high_capacity;
+    static constexpr u8 no_mailbox = 0xFF;
+
+    struct slot_queue {
+        etl::circular_buffer<MessageType, high_capacity> high_queue;
+        etl::circular_buffer<MessageType, normal_capacity> normal_queue;
+    };
+
+    struct routed_mailbox {
+        os::task_handle_t handle{nullptr};
+        mutable os::critical_section critical_section;
+        etl::array<slot_queue, Routes::slots_per_mailbox> slots;
+        u32 high_mask{0};
+        u32 normal_mask{0};
+        u16 message_count{0};
+        bool notify_on_empty_only{true};
+
+        /* Caller holds critical_section */
+        bool push_unlocked(const route_target& target, const MessageType& msg) noexcept {
+            slot_queue& queue = slots[target.slot];
+            const size_t depth = (target.depth != 0U) ? target.depth : slot_total;
+            if ((queue.high_queue.size() + queue.normal_queue.size()) >= depth) {
+                return false;
+            }
+            const bool is_urgent = (static_cast<message_flags>(msg.header.flags) & message_flags::urgent) == message_flags::urgent
+                                   || (msg.header.priority >= static_cast<u8>(message_priority::high));
+            const u32 bit = static_cast<u32>(1UL << target.slot);
+            // Preferred lane first, the other lane as overflow
+            const bool use_high = is_urgent ? !queue.high_queue.full() : queue.normal_queue.full();
+            if (use_high && !queue.high_queue.full()) {
+                queue.high_queue.push(msg);
+                high_mask |= bit;
+            } else if (!queue.normal_queue.full()) {
+                queue.normal_queue.push(msg);
+                normal_mask |= bit;
+            } else {
+                return false;
+            }
+            ++message_count;
+            return true;
+        }
+
+        /* Caller holds critical_section */
+        bool pop_unlocked(MessageType& out) noexcept {
+            if (high_mask != 0U) {
+                const u8 slot = utils::lowest_set_bit(high_mask);
+                out = slots[slot].high_queue.front();
+                slots[slot].high_queue.pop();
+                if (slots[slot].high_queue.empty()) { high_mask &= ~(1UL << slot); }
+            } else if (normal_mask != 0U) {
+                const u8 slot = utils::lowest_set_bit(normal_mask);
+                out = slots[slot].normal_queue.front();
+                slots[slot].normal_queue.pop();
+                if (slots[slot].normal_queue.empty()) { normal_mask &= ~(1UL << slot); }
+            } else {
+                return false;
+            }
+            --message_count;
+            return true;
+        }
+
+        void notify(bool was_empty) const noexcept {
+            const bool should_notify = notify_on_empty_only ? was_empty : true;
+            if (should_notify && handle != nullptr) {
+                os::notify_task(handle, 0x01);
+            }
+        }
+    };
+
+    etl::array<routed_mailbox, Routes::mailbox_count> mailboxes_;
+    u32 sent_count_{0};
+    u32 received_count_{0};
+    u32 dropped_count_{0};
+    u16 sequence_{0};
+
+    routed_mailbox* mailbox_for_task(task_id_t task_id) noexcept {
+        const size_t idx = static_cast<size_t>(task_id.value());
+        if (idx >= Routes::task_count || Routes::mailbox_of_task[idx] == no_mailbox) {
+            return nullptr;
+        }
+        return &mailboxes_[Routes::mailbox_of_task[idx]];
+    }
+
+    void stamp(u16 topic_id, MessageType& msg, task_id_t from_task_id, timestamp_t now) noexcept {
+        msg.header.sender_id = from_task_id.value();
+        if (msg.header.timestamp == 0) {
+            msg.header.timestamp = now;
+        }
+        if (msg.header.sequence_number == 0) {
+            msg.header.sequence_number = sequence_++;
+        }
+        msg.header.type = topic_id;
+    }
+
+public:
+    static_routed_broker() noexcept = default;
+
+    /* Bind a task's notification handle; mailbox placement itself is fixed by Routes */
+    result<void, error_code> register_task(task_id_t task_id, os::task_handle_t handle = nullptr) noexcept {
+        routed_mailbox* mailbox = mailbox_for_task(task_id);
+        if (mailbox == nullptr) {
+            return result<void, error_code>(error_code::not_found);
+        }
+        mailbox->handle = handle;
+        return ok();
+    }
+
+    /* Topology is fixed at build time: succeeds only for routes present in the table */
+    result<void, error_code> subscribe(topic_id_t topic_id, task_id_t subscriber_task_id) noexcept override {
+        const int route = Routes::index_of(topic_id.value);
+        const size_t idx = static_cast<size_t>(subscriber_task_id.value());
+        if (route < 0 || idx >= Routes::task_count) {
+            return result<void, error_code>(error_code::not_found);
+        }
+        const u8 mailbox = Routes::mailbox_of_task[idx];
+        for (size_t i = Routes::target_offset[route]; i < Routes::target_offset[route + 1]; ++i) {
+            if (Routes::targets[i].mailbox == mailbox) {
+                return ok();
+            }
+        }
+        return result<void, error_code>(error_code::invalid_parameter);
+    }
+
+    /* Publish by route index (position of the topic in Routes::topic_ids) */
+    result<void, error_code> publish_route(size_t route, MessageType& msg, task_id_t from_task_id) noexcept {
+        if (route >= Routes::topic_count) {
+            return result<void, error_code>(error_code::not_found);
+        }
+        stamp(Routes::topic_ids[route], msg, from_task_id, os::time_us());
+        bool sent_any = false;
+        for (size_t i = Routes::target_offset[route]; i < Routes::target_offset[route + 1]; ++i) {
+            const route_target& target = Routes::targets[i];
+            routed_mailbox& mailbox = mailboxes_[target.mailbox];
+            mailbox.critical_section.enter();
+            const bool was_empty = (mailbox.message_count == 0U);
+            const bool pushed = mailbox.push_unlocked(target, msg);
+            mailbox.critical_section.exit();
+            if (pushed) {
+                sent_count_++;
+                sent_any = true;
+                mailbox.notify(was_empty);
+            } else {
+                dropped_count_++;
+            }
+        }
+        return sent_any ? ok() : result<void, error_code>(error_code::out_of_memory);
+    }
+
+    result<void, error_code> publish(u16 topic_id, MessageType& msg, task_id_t from_task_id) noexcept override {
+        const int route = Routes::index_of(topic_id);
+        if (route < 0) {
+            return result<void, error_code>(error_code::not_found);
+        }
+        return publish_route(static_cast<size_t>(route), msg, from_task_id);
+    }
+
+    result<MessageType, error_code> try_receive(task_id_t task_id) noexcept override {
+        routed_mailbox* mailbox = mailbox_for_task(task_id);
+        if (mailbox == nullptr) {
+            return result<MessageType, error_code>(error_code::not_found);
+        }
+        MessageType msg{};
+        mailbox->critical_section.enter();
+        const bool popped = mailbox->pop_unlocked(msg);
+        const bool now_empty = (mailbox->message_count == 0U);
+        mailbox->critical_section.exit();
+        if (!popped) {
+            return result<MessageType, error_code>(error_code::not_found);
+        }
+        if (now_empty) { os::clear_notification(); }
+        received_count_++;
+        return result<MessageType, error_code>(msg);
+    }
+
+    result<MessageType, error_code> receive(task_id_t task_id, timeout_ms_t timeout) noexcept override {
+        auto receive_result = try_receive(task_id);
+        if (receive_result.is_ok() || receive_result.error() != error_code::not_found || mailbox_for_task(task_id) == nullptr) {
+            return receive_result;
+        }
+        u32 notification = 0;
+        if (os::wait_notification(timeout.value, &notification) && ((notification & 0x01) != 0)) {
+            receive_result = try_receive(task_id);
+            if (receive_result.is_ok()) {
+                return receive_result;
+            }
+        }
+        return result<MessageType, error_code>(error_code::timeout);
+    }
+
+    result<size_t, error_code> publish_batch(u16 topic_id, etl::span<MessageType> msgs, task_id_t from_task_id) noexcept override {
+        const int route = Routes::index_of(topic_id);
+        if (route < 0) {
+            return result<size_t, error_code>(error_code::not_found);
+        }
+        const timestamp_t now = os::time_us();
+        for (MessageType& msg : msgs) {
+            stamp(topic_id, msg, from_task_id, now);
+        }
+        size_t delivered = 0;
+        for (size_t i = Routes::target_offset[route]; i < Routes::target_offset[route + 1]; ++i) {
+            const route_target& target = Routes::targets[i];
+            routed_mailbox& mailbox = mailboxes_[target.mailbox];
+            size_t accepted = 0;
+            mailbox.critical_section.enter();
+            const bool was_empty = (mailbox.message_count == 0U);
+            for (const MessageType& msg : msgs) {
+                if (mailbox.push_unlocked(target, msg)) {
+                    ++accepted;
+                }
+            }
+            mailbox.critical_section.exit();
+            if (accepted != 0U) {
+                mailbox.notify(was_empty);
+            }
+            sent_count_ += static_cast<u32>(accepted);
+            dropped_count_ += static_cast<u32>(msgs.size() - accepted);
+            delivered += accepted;
+        }
+        return (delivered != 0U) ? result<size_t, error_code>(delivered)
+                                 : result<size_t, error_code>(error_code::out_of_memory);
+    }
+
+    result<size_t, error_code> receive_batch(task_id_t task_id, etl::span<MessageType> out, size_t max_count, timeout_ms_t timeout) noexcept override {
+        routed_mailbox* mailbox = mailbox_for_task(task_id);
+        if (mailbox == nullptr) {
+            return result<size_t, error_code>(error_code::not_found);
+        }
+        const size_t limit = (max_count < out.size()) ? max_count : out.size();
+        auto drain = [&]() noexcept {
+            size_t count = 0;
+            mailbox->critical_section.enter();
+            while (count < limit && mailbox->pop_unlocked(out[count])) {
+                ++count;
+            }
+            const bool now_empty = (mailbox->message_count == 0U);
+            mailbox->critical_section.exit();
+            if (count != 0U && now_empty) { os::clear_notification(); }
+            return count;
+        };
+        size_t count = drain();
+        if (count == 0U && limit != 0U) {
+            u32 notification = 0;
+            if (os::wait_notification(timeout.value, &notification) && ((notification & 0x01) != 0)) {
+                count = drain();
+            }
+        }
+        if (count == 0U) {
+            return result<size_t, error_code>(error_code::timeout);
+        }
+        received_count_ += static_cast<u32>(count);
+        return result<size_t, error_code>(count);
+    }
+
+    /* Configure global notify policy for all mailboxes */
+    void set_notify_on_empty_only(bool enabled) noexcept {
+        for (auto& mailbox : mailboxes_) {
+            mailbox.notify_on_empty_only = enabled;
+        }
+    }
+
+    [[nodiscard]] u32 total_sent() const noexcept { return sent_count_; }
+    [[nodiscard]] u32 total_received() const noexcept { return received_count_; }
+    [[nodiscard]] u32 total_dropped() const noexcept { return dropped_count_; }
+    [[nodiscard]] static constexpr size_t mailbox_count() noexcept { return Routes::mailbox_count; }
+};
+
+}  // namespace emCore::messaging
@@ -3,6 +3,8 @@
 #include "message_types.hpp"
 #include "../os/sync.hpp"
 #include <etl/array.h>
+#include <etl/atomic.h>
+#include <etl/utility.h>
 #include <cstddef>
 // ---- Consolidated Zero-Copy Messaging Support ----
 namespace emCore::messaging {
@@ -53,11 +55,51 @@ namespace emCore::messaging {
         [[nodiscard]] u8* data() noexcept { return valid() ? pool_->data(index_) : nullptr; }
         [[nodiscard]] const u8* data() const noexcept { return valid() ? pool_->data(index_) : nullptr; }
         [[nodiscard]] u16 size() const noexcept { return size_; }
+
+        // Chained handles (allocate_chain) span several blocks; data() is the first segment only
+        [[nodiscard]] bool chained() const noexcept { return valid() && pool_->next_block(index_) != 0xFFFF; }
+
+        // Visit each segment in order: fn(u8* data, u16 length)
+        template <typename Fn>
+        void for_each_segment(Fn&& fn) const noexcept {
+            if (!valid()) { return; }
+            for (u16 idx = index_; idx != 0xFFFF; idx = pool_->next_block(idx)) {
+                fn(pool_->data(idx), pool_->block_size(idx));
+            }
+        }
+
+        // Gather the payload into dst; returns bytes copied (bounded by capacity)
+        u16 copy_to(u8* dst, u16 capacity) const noexcept {
+            u16 copied = 0;
+            for_each_segment([&](const u8* seg, u16 len) {
+                const u16 n = (len < static_cast<u16>(capacity - copied)) ? len : static_cast<u16>(capacity - copied);
+                for (u16 i = 0; i < n; ++i) { dst[copied + i] = seg[i]; }
+                copied = static_cast<u16>(copied + n);
+            });
+            return copied;
+        }
+
+        // Scatter src across the segments; returns bytes written (bounded by size())
+        u16 copy_from(const u8* src, u16 length) noexcept {
+            u16 written = 0;
+            for_each_segment([&](u8* seg, u16 len) {
+                const u16 n = (len < static_cast<u16>(length - written)) ? len : static_cast<u16>(length - written);
+                for (u16 i = 0; i < n; ++i) { seg[i] = src[written + i]; }
+                written = static_cast<u16>(written + n);
+            });
+            return written;
+        }
     
     private:
         friend pool_type; // Only pool can construct raw handle safely
+        struct adopt_ref_t {};
         zc_handle(pool_type* pool, u16 index, u16 size) noexcept : pool_(pool), index_(index), size_(size) { add_ref_(); }
-        void add_ref_() noexcept { if (pool_ && index_ != 0xFFFF) { pool_->add_ref(index_); } }
+        // Takes over a reference the pool already set (no add_ref round-trip)
+        zc_handle(pool_type* pool, u16 index, u16 size, adopt_ref_t) noexcept : pool_(pool), index_(index), size_(size) {}
+        // A block the pool refuses to reference (already freed) leaves this handle empty
+        void add_ref_() noexcept {
+            if (pool_ && index_ != 0xFFFF && !pool_->add_ref(index_)) { pool_ = nullptr; index_ = 0xFFFF; size_ = 0; }
+        }
         void release_() noexcept { if (pool_ && index_ != 0xFFFF) { pool_->release(index_); } }
     
         pool_type* pool_;
@@ -105,30 +147,102 @@ namespace emCore::messaging {
             cs_.exit();
             return handle_t(this, idx, size);
         }
+
+        // Scatter-gather allocation: ceil(size / BlockSize) blocks linked through node::next.
+        // Segment lengths are BlockSize except the tail; all-or-nothing.
+        handle_t allocate_chain(u16 size) noexcept {
+            if (size <= BlockSize) { return allocate(size); }
+            const size_t blocks = (static_cast<size_t>(size) + BlockSize - 1) / BlockSize;
+            cs_.enter();
+            size_t available = 0;
+            for (u16 idx = free_head_; idx != 0xFFFF && available < blocks; idx = nodes_[idx].next) { ++available; }
+            if (available < blocks) { cs_.exit(); return handle_t(); }
+            const u16 head = free_head_;
+            u16 idx = head;
+            size_t remaining = size;
+            for (size_t i = 0; i < blocks; ++i) {
+                nodes_[idx].size = static_cast<u16>((remaining < BlockSize) ? remaining : BlockSize);
+                nodes_[idx].refs = 0;
+                nodes_[idx].in_use = true;
+                remaining -= nodes_[idx].size;
+                const u16 next = nodes_[idx].next;
+                if (i + 1 == blocks) {
+                    free_head_ = next;
+                    nodes_[idx].next = 0xFFFF;
+                }
+                idx = next;
+            }
+            cs_.exit();
+            return handle_t(this, head, size);
+        }
     
-        void add_ref(u16 index) noexcept {
+        // False when the block is free (a stale handle) or the count is saturated
+        bool add_ref(u16 index) noexcept {
             cs_.enter();
-            if (index < BlockCount && nodes_[index].in_use && nodes_[index].refs != 0xFFFF) { ++nodes_[index].refs; }
+            const bool taken = index < BlockCount && nodes_[index].in_use && nodes_[index].refs != 0xFFFF;
+            if (taken) { ++nodes_[index].refs; }
             cs_.exit();
+            return taken;
         }
     
         void release(u16 index) noexcept {
             cs_.enter();
             if (index < BlockCount && nodes_[index].in_use && nodes_[index].refs > 0) {
                 if (--nodes_[index].refs == 0) {
-                    nodes_[index].in_use = false;
-                    nodes_[index].next = free_head_;
-                    free_head_ = index;
+                    // Refcount lives on the head block; free the whole chain
+                    for (u16 idx = index; idx != 0xFFFF;) {
+                        const u16 next = nodes_[idx].next;
+                        nodes_[idx].in_use = false;
+                        nodes_[idx].next = free_head_;
+                        free_head_ = idx;
+                        idx = next;
+                    }
                 }
             }
             cs_.exit();
         }
     
+        // Batch hand-off for zc_alloc_cache: take up to count free blocks under one lock
+        size_t reserve_blocks(u16* out, size_t count) noexcept {
+            cs_.enter();
+            size_t taken = 0;
+            while (taken < count && free_head_ != 0xFFFF) {
+                out[taken++] = free_head_;
+                free_head_ = nodes_[free_head_].next;
+            }
+            cs_.exit();
+            return taken;
+        }
+
+        void unreserve_blocks(const u16* blocks, size_t count) noexcept {
+            cs_.enter();
+            for (size_t i = 0; i < count; ++i) {
+                if (blocks[i] < BlockCount && !nodes_[blocks[i]].in_use) {
+                    nodes_[blocks[i]].next = free_head_;
+                    free_head_ = blocks[i];
+                }
+            }
+            cs_.exit();
+        }
+
+        // Turn a reserved block into a handle without taking the lock (caller owns the block)
+        handle_t adopt(u16 index, u16 size) noexcept {
+            if (index >= BlockCount || size > BlockSize) { return handle_t(); }
+            nodes_[index].size = size;
+            nodes_[index].next = 0xFFFF;
+            nodes_[index].refs = 1;
+            nodes_[index].in_use = true;
+            return handle_t(this, index, size, typename handle_t::adopt_ref_t{});
+        }
+
         u8* data(u16 index) noexcept { return (index < BlockCount) ? nodes_[index].payload : nullptr; }
         const u8* data(u16 index) const noexcept { return (index < BlockCount) ? nodes_[index].payload : nullptr; }
         u16 block_size(u16 index) const noexcept { return (index < BlockCount) ? nodes_[index].size : 0; }
+        // Next segment of an allocated chain (0xFFFF at the tail); links are fixed while referenced
+        u16 next_block(u16 index) const noexcept { return (index < BlockCount && nodes_[index].in_use) ? nodes_[index].next : 0xFFFF; }
     
         [[nodiscard]] size_t capacity() const noexcept { return BlockCount; }
+        [[nodiscard]] static constexpr size_t block_capacity() noexcept { return BlockSize; }
     
     private:
         os::critical_section cs_;
@@ -136,6 +250,229 @@ namespace emCore::messaging {
         u16 free_head_{0xFFFF};
     };
     
+    // Lock-free zero-copy pool: atomic refcounts and a tagged Treiber free list.
+    // The free-list head packs {tag:16, index:16} into one word so a node that is
+    // popped and pushed back between a load and the CAS (ABA) fails the exchange.
+    // Same interface as zero_copy_pool; usable from both cores and from ISRs.
+    template <size_t BlockSize, size_t BlockCount>
+    class lockfree_zero_copy_pool {
+    public:
+        static_assert(BlockCount < 0xFFFF, "lockfree_zero_copy_pool supports at most 65534 blocks");
+
+        struct node {
+            alignas(4) u8 payload[BlockSize];
+            u16 size;
+            etl::atomic<u32> refs;
+            etl::atomic<u32> next;
+        };
+
+        using handle_t = zc_handle<lockfree_zero_copy_pool<BlockSize, BlockCount>>;
+
+        lockfree_zero_copy_pool() noexcept { initialize(); }
+
+        // Not thread-safe: call before the pool is shared
+        void initialize() noexcept {
+            for (size_t i = 0; i < BlockCount; ++i) {
+                nodes_[i].size = 0;
+                nodes_[i].refs.store(0, etl::memory_order_relaxed);
+                nodes_[i].next.store((i == BlockCount - 1) ? empty_index : static_cast<u32>(i + 1), etl::memory_order_relaxed);
+            }
+            free_head_.store(BlockCount == 0 ? empty_index : 0U, etl::memory_order_release);
+        }
+
+        handle_t allocate(u16 size) noexcept {
+            if (size > BlockSize) { return handle_t(); }
+            const u32 idx = pop_free();
+            if (idx == empty_index) { return handle_t(); }
+            nodes_[idx].size = size;
+            // The handle adopts this first reference; add_ref() refuses blocks at zero
+            nodes_[idx].refs.store(1U, etl::memory_order_relaxed);
+            nodes_[idx].next.store(empty_index, etl::memory_order_relaxed);
+            return handle_t(this, static_cast<u16>(idx), size, typename handle_t::adopt_ref_t{});
+        }
+
+        // Scatter-gather allocation, see zero_copy_pool::allocate_chain. Blocks are popped
+        // one at a time; a partial chain is returned to the free list on exhaustion.
+        handle_t allocate_chain(u16 size) noexcept {
+            if (size <= BlockSize) { return allocate(size); }
+            const size_t blocks = (static_cast<size_t>(size) + BlockSize - 1) / BlockSize;
+            u32 head = empty_index;
+            u32 tail = empty_index;
+            size_t remaining = size;
+            for (size_t i = 0; i < blocks; ++i) {
+                const u32 idx = pop_free();
+                if (idx == empty_index) {
+                    for (u32 cur = head; cur != empty_index;) {
+                        const u32 next = nodes_[cur].next.load(etl::memory_order_relaxed);
+                        push_free(static_cast<u16>(cur));
+                        cur = next;
+                    }
+                    return handle_t();
+                }
+                nodes_[idx].size = static_cast<u16>((remaining < BlockSize) ? remaining : BlockSize);
+                nodes_[idx].refs.store(0, etl::memory_order_relaxed);
+                nodes_[idx].next.store(empty_index, etl::memory_order_relaxed);
+                remaining -= nodes_[idx].size;
+                if (head == empty_index) { head = idx; } else { nodes_[tail].next.store(idx, etl::memory_order_relaxed); }
+                tail = idx;
+            }
+            nodes_[head].refs.store(1U, etl::memory_order_relaxed);
+            return handle_t(this, static_cast<u16>(head), size, typename handle_t::adopt_ref_t{});
+        }
+
+        // Refuses a block whose count already reached zero: it is back on the free list,
+        // and a stale handle must not resurrect it (the locked pool's in_use guard)
+        bool add_ref(u16 index) noexcept {
+            if (index >= BlockCount) { return false; }
+            u32 refs = nodes_[index].refs.load(etl::memory_order_relaxed);
+            do {
+                if (refs == 0U) { return false; }
+            } while (!nodes_[index].refs.compare_exchange_weak(refs, refs + 1U, etl::memory_order_relaxed, etl::memory_order_relaxed));
+            return true;
+        }
+
+        void release(u16 index) noexcept {
+            if (index >= BlockCount) { return; }
+            u32 refs = nodes_[index].refs.load(etl::memory_order_relaxed);
+            do {
+                if (refs == 0U) { return; }  // double release: ignore like the locked pool
+            } while (!nodes_[index].refs.compare_exchange_weak(refs, refs - 1U, etl::memory_order_acq_rel, etl::memory_order_relaxed));
+            if (refs == 1U) {
+                // Refcount lives on the head block; free the whole chain
+                for (u32 cur = index; cur != empty_index;) {
+                    const u32 next = nodes_[cur].next.load(etl::memory_order_relaxed);
+                    push_free(static_cast<u16>(cur));
+                    cur = next;
+                }
+            }
+        }
+
+        size_t reserve_blocks(u16* out, size_t count) noexcept {
+            size_t taken = 0;
+            while (taken < count) {
+                const u32 idx = pop_free();
+                if (idx == empty_index) { break; }
+                out[taken++] = static_cast<u16>(idx);
+            }
+            return taken;
+        }
+
+        void unreserve_blocks(const u16* blocks, size_t count) noexcept {
+            for (size_t i = 0; i < count; ++i) {
+                if (blocks[i] < BlockCount) { push_free(blocks[i]); }
+            }
+        }
+
+        handle_t adopt(u16 index, u16 size) noexcept {
+            if (index >= BlockCount || size > BlockSize) { return handle_t(); }
+            nodes_[index].size = size;
+            nodes_[index].next.store(empty_index, etl::memory_order_relaxed);
+            nodes_[index].refs.store(1U, etl::memory_order_release);
+            return handle_t(this, index, size, typename handle_t::adopt_ref_t{});
+        }
+
+        u8* data(u16 index) noexcept { return (index < BlockCount) ? nodes_[index].payload : nullptr; }
+        const u8* data(u16 index) const noexcept { return (index < BlockCount) ? nodes_[index].payload : nullptr; }
+        u16 block_size(u16 index) const noexcept { return (index < BlockCount) ? nodes_[index].size : 0; }
+        // Next segment of an allocated chain (0xFFFF at the tail); only valid while referenced
+        u16 next_block(u16 index) const noexcept {
+            return (index < BlockCount) ? static_cast<u16>(nodes_[index].next.load(etl::memory_order_relaxed)) : 0xFFFF;
+        }
+
+        [[nodiscard]] size_t capacity() const noexcept { return BlockCount; }
+        [[nodiscard]] static constexpr size_t block_capacity() noexcept { return BlockSize; }
+
+    private:
+        static constexpr u32 index_mask = 0xFFFFU;
+        static constexpr u32 empty_index = 0xFFFFU;
+
+        static constexpr u32 next_tag(u32 head) noexcept { return (head & ~index_mask) + 0x10000U; }
+
+        u32 pop_free() noexcept {
+            u32 head = free_head_.load(etl::memory_order_acquire);
+            for (;;) {
+                const u32 idx = head & index_mask;
+                if (idx == empty_index) { return empty_index; }
+                const u32 next = nodes_[idx].next.load(etl::memory_order_relaxed);
+                const u32 replacement = next_tag(head) | (next & index_mask);
+                if (free_head_.compare_exchange_weak(head, replacement, etl::memory_order_acq_rel, etl::memory_order_acquire)) {
+                    return idx;
+                }
+            }
+        }
+
+        void push_free(u16 index) noexcept {
+            u32 head = free_head_.load(etl::memory_order_relaxed);
+            for (;;) {
+                nodes_[index].next.store(head & index_mask, etl::memory_order_relaxed);
+                const u32 replacement = next_tag(head) | index;
+                if (free_head_.compare_exchange_weak(head, replacement, etl::memory_order_release, etl::memory_order_relaxed)) {
+                    return;
+                }
+            }
+        }
+
+        node nodes_[BlockCount];
+        etl::atomic<u32> free_head_{empty_index};
+    };
+
+    // Allocation-side cache counters (hit = no shared free-list access)
+    struct zc_cache_stats {
+        u32 hits;
+        u32 misses;
+        u32 refills;
+    };
+
+    // Per-task (or per-core) allocation cache in front of a zero-copy pool.
+    // Keeps up to CacheSize reserved block indices; an empty cache refills all of
+    // them with one reserve_blocks() call. Blocks return to the shared pool when
+    // their last handle is released (usually on the consumer side), so only the
+    // producer's allocate path is served locally. Not locked: one instance per owner.
+    template <typename PoolT, size_t CacheSize = 8>
+    class zc_alloc_cache {
+    public:
+        static_assert(CacheSize >= 1, "zc_alloc_cache needs room for at least one block");
+        using handle_t = typename PoolT::handle_t;
+
+        explicit zc_alloc_cache(PoolT& pool) noexcept : pool_(pool) {}
+        ~zc_alloc_cache() { flush(); }
+        zc_alloc_cache(const zc_alloc_cache&) = delete;
+        zc_alloc_cache& operator=(const zc_alloc_cache&) = delete;
+        zc_alloc_cache(zc_alloc_cache&&) = delete;
+        zc_alloc_cache& operator=(zc_alloc_cache&&) = delete;
+
+        handle_t allocate(u16 size) noexcept {
+            if (size > PoolT::block_capacity()) { return handle_t(); }
+            if (count_ == 0) {
+                ++stats_.misses;
+                count_ = pool_.reserve_blocks(indices_, CacheSize);
+                if (count_ == 0) { return handle_t(); }
+                ++stats_.refills;
+            } else {
+                ++stats_.hits;
+            }
+            return pool_.adopt(indices_[--count_], size);
+        }
+
+        // Return the reserved but unused blocks to the shared pool
+        void flush() noexcept {
+            if (count_ != 0) {
+                pool_.unreserve_blocks(indices_, count_);
+                count_ = 0;
+            }
+        }
+
+        [[nodiscard]] size_t cached() const noexcept { return count_; }
+        [[nodiscard]] const zc_cache_stats& stats() const noexcept { return stats_; }
+        void reset_stats() noexcept { stats_ = zc_cache_stats{}; }
+
+    private:
+        PoolT& pool_;
+        u16 indices_[CacheSize]{};
+        size_t count_{0};
+        zc_cache_stats stats_{};
+    };
+
     // Zero-copy message envelope with header and handle to pool memory.
     template <typename PoolT>
     struct zc_message_envelope {
@@ -145,6 +482,10 @@ namespace emCore::messaging {
         [[nodiscard]] u8* payload_data() noexcept { return handle.valid() ? handle.data() : nullptr; }
         [[nodiscard]] const u8* payload_data() const noexcept { return handle.valid() ? handle.data() : nullptr; }
         [[nodiscard]] u16 payload_size() const noexcept { return handle.valid() ? handle.size() : 0; }
+        // Chained payloads: payload_data() covers the first segment only, use for_each_segment()
+        [[nodiscard]] bool is_chained() const noexcept { return handle.chained(); }
+        template <typename Fn>
+        void for_each_segment(Fn&& fn) const noexcept { handle.for_each_segment(etl::forward<Fn>(fn)); }
     
         [[nodiscard]] bool has_flag(message_flags flag) const noexcept {
             return (static_cast<message_flags>(header.flags) & flag) == flag;
@@ -42,6 +42,11 @@ inline bool notify_task(task_handle_t handle, u32 value = 0x01) noexcept { retur
 inline bool wait_notification(u32 timeout_ms, u32* out_value) noexcept { return platform::wait_notification(timeout_ms, out_value); }
 inline void clear_notification() noexcept { platform::clear_notification(); }
 inline task_handle_t current_task() noexcept { return platform::get_current_task_handle(); }
+// Move a live native task to core_id; false where the kernel cannot re-pin
+inline bool set_task_affinity(task_handle_t handle, int core_id) noexcept { return platform::set_task_affinity(handle, core_id); }
+inline u8 cpu_core_count() noexcept { return platform::cpu_core_count(); }
+inline u8 current_core() noexcept { return platform::current_core_id(); }
+inline bool in_isr() noexcept { return platform::in_isr(); }
 inline void yield() noexcept { platform::task_yield(); }
 inline size_t stack_high_water_mark() noexcept { return platform::get_stack_high_water_mark(); }
 
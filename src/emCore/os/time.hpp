@@ -8,6 +8,14 @@ namespace emCore::os {
 inline timestamp_t time_us() noexcept { return platform::get_system_time_us(); }
 inline timestamp_t time_ms() noexcept { return platform::get_system_time(); }
 
+/* Free-running cycle counter (wraps; subtract as u32) and its rate */
+inline u32 cycles() noexcept { return platform::get_cycle_count(); }
+inline u32 cycle_hz() noexcept { return platform::get_cycle_frequency_hz(); }
+inline u32 cycles_to_us(u32 elapsed_cycles) noexcept {
+    const u32 hz = cycle_hz();
+    return (hz != 0U) ? static_cast<u32>((static_cast<u64>(elapsed_cycles) * 1000000ULL) / hz) : 0U;
+}
+
 inline void delay_ms(duration_t milliseconds) noexcept { platform::delay_ms(milliseconds); }
 inline void delay_us(u32 microseconds) noexcept { platform::delay_us(microseconds); }
 
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "../core/types.hpp"
+
+namespace emCore::os {
+
+/*
+ * Cooperative wake hook. Producers (message broker, event bus) call
+ * wake_cooperative() after queuing work for a task without a native handle, so a
+ * tickless cooperative scheduler sleeping in idle re-evaluates its queues.
+ * Install once before producers start; the hook must be ISR-safe.
+ */
+using cooperative_wake_t = void (*)(task_id_t task) noexcept;
+
+namespace detail {
+inline cooperative_wake_t cooperative_wake_hook{nullptr};
+}
+
+inline void set_cooperative_wake(cooperative_wake_t hook) noexcept { detail::cooperative_wake_hook = hook; }
+
+// task = invalid_task_id when the work is not addressed to one task
+inline void wake_cooperative(task_id_t task = invalid_task_id) noexcept {
+    const cooperative_wake_t hook = detail::cooperative_wake_hook;
+    if (hook != nullptr) { hook(task); }
+}
+
+} // namespace emCore::os
@@ -0,0 +1,128 @@
+#pragma once
+
+// Deferred logging backend (EMCORE_DEFERRED_LOG): platform::log()/logf() store
+// the format pointer and raw u32 arguments in a lock-free ring; formatting
+// happens later in log_flush() (a low-priority task) or on the host from the
+// binary stream produced by log_drain_into() (scripts/decode_deferred_log.py
+// resolves format addresses against the firmware ELF).
+//
+// The ring keeps pointers, not text: format strings and log() messages must
+// have static storage (string literals). Text built in a local buffer goes
+// through platform::log_now().
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include "../core/types.hpp"
+#include "../messaging/lockfree_ring.hpp"
+
+#include <etl/array.h>
+#include <etl/atomic.h>
+
+namespace emCore::platform {
+
+struct log_record {
+    const char* fmt{nullptr};  // format string, or the message itself when argc == 0
+    u32 timestamp_us{0};
+    u8 argc{0};
+    etl::array<u32, 5> args{};
+};
+
+/**
+ * @brief MPSC ring of unformatted log records
+ *
+ * push() is one CAS plus a few stores, safe from tasks, ISRs and other cores;
+ * a full ring drops the record and counts it. One context drains.
+ */
+template <size_t Records>
+class deferred_log_ring {
+public:
+    static constexpr size_t max_record_bytes = 9U + (5U * 4U);  // fmt, timestamp, argc, args
+
+    deferred_log_ring() noexcept = default;
+    deferred_log_ring(const deferred_log_ring&) = delete;
+    deferred_log_ring& operator=(const deferred_log_ring&) = delete;
+    deferred_log_ring(deferred_log_ring&&) = delete;
+    deferred_log_ring& operator=(deferred_log_ring&&) = delete;
+    ~deferred_log_ring() = default;
+
+    void push(const log_record& rec) noexcept {
+        if (!ring_.try_push(rec)) {
+            dropped_.fetch_add(1U, etl::memory_order_relaxed);
+        }
+    }
+
+    /*
+     * Format up to max_records with snprintf and hand each line to sink(const char*).
+     * A gap left by dropped records is reported as its own line first.
+     */
+    template <typename Sink>
+    size_t flush(Sink&& sink, size_t max_records = static_cast<size_t>(-1)) noexcept {
+        report_drops(sink);
+        char line[256];
+        size_t n = 0;
+        log_record rec;
+        while (n < max_records && ring_.try_pop(rec)) {
+            if (rec.argc == 0U) {
+                sink(rec.fmt);
+            } else {
+                std::snprintf(line, sizeof(line), rec.fmt, rec.args[0], rec.args[1], rec.args[2], rec.args[3], rec.args[4]); /* NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg,cppcoreguidelines-pro-bounds-array-to-pointer-decay) */
+                sink(static_cast<const char*>(line));
+            }
+            ++n;
+        }
+        return n;
+    }
+
+    /*
+     * Move whole records into buf for host-side formatting; returns bytes written.
+     * Wire (little endian): u32 format address, u32 timestamp_us, u8 argc, argc x u32.
+     * Same shape as packet_tx_pipeline::submit_with(), so a log link can be fed from the TX path.
+     */
+    size_t drain_into(u8* buf, size_t cap) noexcept {
+        size_t written = 0;
+        for (const log_record* rec = ring_.front(); rec != nullptr; rec = ring_.front()) {
+            const size_t bytes = 9U + (static_cast<size_t>(rec->argc) * 4U);
+            if (cap - written < bytes) {
+                break;
+            }
+            u8* out = buf + written;
+            put_u32(out, static_cast<u32>(reinterpret_cast<uintptr_t>(rec->fmt)));
+            put_u32(out + 4, rec->timestamp_us);
+            out[8] = rec->argc;
+            for (u8 i = 0; i < rec->argc; ++i) { put_u32(out + 9 + (i * 4U), rec->args[i]); }
+            ring_.pop();
+            written += bytes;
+        }
+        return written;
+    }
+
+    [[nodiscard]] size_t pending() const noexcept { return ring_.size(); }
+    [[nodiscard]] u32 dropped() const noexcept { return dropped_.load(etl::memory_order_relaxed); }
+
+private:
+    static void put_u32(u8* p, u32 v) noexcept {
+        p[0] = static_cast<u8>(v);
+        p[1] = static_cast<u8>(v >> 8U);
+        p[2] = static_cast<u8>(v >> 16U);
+        p[3] = static_cast<u8>(v >> 24U);
+    }
+
+    template <typename Sink>
+    void report_drops(Sink& sink) noexcept {
+        const u32 total = dropped_.load(etl::memory_order_relaxed);
+        if (total != reported_drops_) {
+            char line[48];
+            std::snprintf(line, sizeof(line), "[log] %u records dropped", static_cast<unsigned>(total - reported_drops_)); /* NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg,cppcoreguidelines-pro-bounds-array-to-pointer-decay) */
+            reported_drops_ = total;
+            sink(static_cast<const char*>(line));
+        }
+    }
+
+    messaging::mpsc_ring<log_record, Records> ring_{};
+    etl::atomic<u32> dropped_{0};
+    u32 reported_drops_{0};
+};
+
+}  // namespace emCore::platform
@@ -37,6 +37,22 @@ inline timestamp_t get_system_time_us() noexcept {
 }
 inline timestamp_t get_system_time() noexcept { return get_system_time_us() / 1000ULL; }
 
+/* CCOUNT on ESP32 cores; elsewhere micros() stands in at 1 MHz */
+inline u32 get_cycle_count() noexcept {
+#if defined(ESP32) || defined(ESP_PLATFORM)
+    return static_cast<u32>(ESP.getCycleCount());
+#else
+    return static_cast<u32>(micros());
+#endif
+}
+inline u32 get_cycle_frequency_hz() noexcept {
+#if defined(ESP32) || defined(ESP_PLATFORM)
+    return static_cast<u32>(getCpuFrequencyMhz()) * 1000000U;
+#else
+    return 1000000U;
+#endif
+}
+
 inline void delay_ms(duration_t ms) noexcept {
 #if defined(ESP32) || defined(ESP_PLATFORM)
     TickType_t ticks = ms / portTICK_PERIOD_MS;
@@ -128,9 +144,49 @@ inline task_handle_t get_current_task_handle() noexcept {
 #endif
 }
 
+inline bool set_task_affinity(task_handle_t h, int core_id) noexcept {
+#if (defined(ESP32) || defined(ESP_PLATFORM)) && defined(CONFIG_FREERTOS_SMP) && (configUSE_CORE_AFFINITY == 1)
+    if (!h || core_id < 0 || core_id >= portNUM_PROCESSORS) return false;
+    vTaskCoreAffinitySet(static_cast<TaskHandle_t>(h), static_cast<UBaseType_t>(1U << core_id));
+    return true;
+#else
+    (void)h; (void)core_id; return false;
+#endif
+}
+inline u8 cpu_core_count() noexcept {
+#if defined(ESP32) || defined(ESP_PLATFORM)
+    return static_cast<u8>(portNUM_PROCESSORS);
+#else
+    return 1;
+#endif
+}
+inline u8 current_core_id() noexcept {
+#if defined(ESP32) || defined(ESP_PLATFORM)
+    return static_cast<u8>(xPortGetCoreID());
+#else
+    return 0;
+#endif
+}
+inline bool in_isr() noexcept {
+#if defined(ESP32) || defined(ESP_PLATFORM)
+    return xPortInIsrContext() != 0;
+#else
+    return false;  // AVR cores expose no handler-mode flag
+#endif
+}
+
 inline bool notify_task(task_handle_t h, u32 value) noexcept {
 #if defined(ESP32) || defined(ESP_PLATFORM)
-    if (!h) return false; xTaskNotify(static_cast<TaskHandle_t>(h), value, eSetBits); return true;
+    if (!h) return false;
+    if (xPortInIsrContext()) {
+        BaseType_t hpw = pdFALSE;
+        xTaskNotifyFromISR(static_cast<TaskHandle_t>(h), value, eSetBits, &hpw);
+        if (hpw == pdTRUE) {
+            portYIELD_FROM_ISR();
+        }
+        return true;
+    }
+    xTaskNotify(static_cast<TaskHandle_t>(h), value, eSetBits); return true;
 #else
     (void)h; (void)value; return false;
 #endif
@@ -182,7 +238,9 @@ inline bool semaphore_give(semaphore_handle_t h) noexcept {
 }
 inline bool semaphore_take(semaphore_handle_t h, duration_t timeout_us) noexcept {
 #if defined(ESP32) || defined(ESP_PLATFORM)
-    if (!h) return false; TickType_t t = pdMS_TO_TICKS(timeout_us / 1000); return xSemaphoreTake(static_cast<SemaphoreHandle_t>(h), t) == pdTRUE;
+    if (!h) return false;
+    const TickType_t t = (timeout_us == static_cast<duration_t>(0xFFFFFFFFU)) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_us / 1000U + ((timeout_us % 1000U) != 0U ? 1U : 0U));
+    return xSemaphoreTake(static_cast<SemaphoreHandle_t>(h), t) == pdTRUE;
 #else
     (void)h; (void)timeout_us; return false;
 #endif
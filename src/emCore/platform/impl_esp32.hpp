@@ -12,6 +12,14 @@
 #include <freertos/portmacro.h>
 #include <esp_timer.h>
 #include <rom/ets_sys.h>
+#if __has_include(<esp_cpu.h>)
+#include <esp_cpu.h>
+#else
+#include <xtensa/hal.h>
+#endif
+#if __has_include(<driver/uart.h>)
+#include <driver/uart.h>
+#endif
 
 namespace emCore::platform::impl_esp32 {
 
@@ -24,6 +32,16 @@ struct critical_section {
 inline timestamp_t get_system_time_us() noexcept { return static_cast<timestamp_t>(esp_timer_get_time()); }
 inline timestamp_t get_system_time() noexcept { return get_system_time_us() / 1000ULL; }
 
+/* Xtensa/RISC-V CCOUNT of the calling core; wraps every 2^32 CPU clocks */
+inline u32 get_cycle_count() noexcept {
+#if __has_include(<esp_cpu.h>)
+    return static_cast<u32>(esp_cpu_get_cycle_count());
+#else
+    return static_cast<u32>(xthal_get_ccount());
+#endif
+}
+inline u32 get_cycle_frequency_hz() noexcept { return static_cast<u32>(ets_get_cpu_frequency()) * 1000000U; }
+
 inline void delay_ms(duration_t ms) noexcept {
     TickType_t ticks = pdMS_TO_TICKS(ms);
     vTaskDelay(ticks > 0 ? ticks : 1);
@@ -67,8 +85,30 @@ inline bool suspend_native_task(task_handle_t h) noexcept { if (!h) return false
 inline bool resume_native_task(task_handle_t h) noexcept { if (!h) return false; vTaskResume(static_cast<TaskHandle_t>(h)); return true; }
 inline task_handle_t get_current_task_handle() noexcept { return xTaskGetCurrentTaskHandle(); }
 
+// Re-pinning a live task needs the SMP kernel; classic ESP-IDF FreeRTOS pins only at creation
+inline bool set_task_affinity(task_handle_t h, int core_id) noexcept {
+#if defined(CONFIG_FREERTOS_SMP) && (configUSE_CORE_AFFINITY == 1)
+    if (!h || core_id < 0 || core_id >= portNUM_PROCESSORS) return false;
+    vTaskCoreAffinitySet(static_cast<TaskHandle_t>(h), static_cast<UBaseType_t>(1U << core_id));
+    return true;
+#else
+    (void)h; (void)core_id; return false;
+#endif
+}
+inline u8 cpu_core_count() noexcept { return static_cast<u8>(portNUM_PROCESSORS); }
+inline u8 current_core_id() noexcept { return static_cast<u8>(xPortGetCoreID()); }
+inline bool in_isr() noexcept { return xPortInIsrContext() != 0; }
+
 inline bool notify_task(task_handle_t h, u32 value) noexcept {
     if (!h) return false;
+    if (xPortInIsrContext()) {
+        BaseType_t hpw = pdFALSE;
+        xTaskNotifyFromISR(static_cast<TaskHandle_t>(h), value, eSetBits, &hpw);
+        if (hpw == pdTRUE) {
+            portYIELD_FROM_ISR();
+        }
+        return true;
+    }
     xTaskNotify(static_cast<TaskHandle_t>(h), value, eSetBits);
     return true;
 }
@@ -98,10 +138,37 @@ inline bool semaphore_give(semaphore_handle_t h) noexcept {
 }
 inline bool semaphore_take(semaphore_handle_t h, duration_t timeout_us) noexcept {
     if (!h) { return false; }
-    TickType_t t = pdMS_TO_TICKS(timeout_us / 1000);
+    // Round up so sub-millisecond waits still block for a tick; all-ones waits forever
+    const TickType_t t = (timeout_us == static_cast<duration_t>(0xFFFFFFFFU))
+                         ? portMAX_DELAY
+                         : pdMS_TO_TICKS(timeout_us / 1000U + ((timeout_us % 1000U) != 0U ? 1U : 0U));
     return xSemaphoreTake(static_cast<SemaphoreHandle_t>(h), t) == pdTRUE;
 }
 
+/*
+ * ESP-IDF UART DMA lands in the driver's own ring, so there is no user-visible
+ * circular target. Instead, drain it straight into dma_byte_ring::write_span()
+ * from the UART_DATA / rx-timeout (idle-line) event and commit() what arrived:
+ * one bulk copy per event instead of one per byte.
+ */
+#if __has_include(<driver/uart.h>)
+inline size_t uart_rx_into(int port, u8* dst, size_t capacity) noexcept {
+    if (dst == nullptr || capacity == 0U) { return 0; }
+    size_t buffered = 0;
+    if (uart_get_buffered_data_len(static_cast<uart_port_t>(port), &buffered) != ESP_OK || buffered == 0U) { return 0; }
+    const size_t want = (buffered < capacity) ? buffered : capacity;
+    const int got = uart_read_bytes(static_cast<uart_port_t>(port), dst, static_cast<uint32_t>(want), 0);
+    return (got > 0) ? static_cast<size_t>(got) : 0U;
+}
+
+// Copy a span into the driver's TX ring (its DMA drains it). The bytes are free
+// once this returns, so a packet_tx_pipeline hook calls on_tx_complete() right away.
+inline bool uart_tx_from(int port, const u8* data, size_t len) noexcept {
+    if (data == nullptr || len == 0U) { return false; }
+    return uart_write_bytes(static_cast<uart_port_t>(port), data, len) == static_cast<int>(len);
+}
+#endif
+
 inline constexpr platform_info get_platform_info() noexcept { return {"ESP32", 240000000U, true}; }
 
 } // namespace emCore::platform::impl_esp32
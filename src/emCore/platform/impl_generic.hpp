@@ -15,6 +15,9 @@ inline timestamp_t get_system_time_us() noexcept {
 }
 inline timestamp_t get_system_time() noexcept { return get_system_time_us() / 1000; }
 
+inline u32 get_cycle_count() noexcept { return static_cast<u32>(get_system_time_us()); }
+inline u32 get_cycle_frequency_hz() noexcept { return 1000000U; }
+
 inline void delay_ms(duration_t ms) noexcept {
     const timestamp_t start = get_system_time();
     while ((get_system_time() - start) < ms) {}
@@ -38,6 +41,10 @@ inline bool delete_native_task(task_handle_t) noexcept { return false; }
 inline bool suspend_native_task(task_handle_t) noexcept { return false; }
 inline bool resume_native_task(task_handle_t) noexcept { return false; }
 inline task_handle_t get_current_task_handle() noexcept { return nullptr; }
+inline bool set_task_affinity(task_handle_t, int) noexcept { return false; }
+inline u8 cpu_core_count() noexcept { return 1; }
+inline u8 current_core_id() noexcept { return 0; }
+inline bool in_isr() noexcept { return false; }
 
 inline bool notify_task(task_handle_t, u32) noexcept { return false; }
 inline bool wait_notification(u32, u32*) noexcept { return false; }
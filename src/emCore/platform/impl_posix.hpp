@@ -2,10 +2,17 @@
 
 #include "platform_base.hpp"
 
+#include <errno.h>
+#include <limits.h>
 #include <pthread.h>
+#include <sched.h>
 #include <time.h>
 #include <unistd.h>
 #include <cstdio>
+#include <cstring>
+#include <new>
+
+#include <etl/atomic.h>
 
 namespace emCore::platform::impl_posix {
 
@@ -22,34 +29,549 @@ inline timestamp_t get_system_time_us() noexcept {
 }
 inline timestamp_t get_system_time() noexcept { return get_system_time_us() / 1000ULL; }
 
-inline void delay_ms(duration_t ms) noexcept { usleep(static_cast<useconds_t>(ms * 1000ULL)); }
-inline void delay_us(u32 us) noexcept { usleep(static_cast<useconds_t>(us)); }
+/* Cycle counter: CLOCK_MONOTONIC nanoseconds, wrapping (portable; rdtsc needs per-host calibration) */
+inline u32 get_cycle_count() noexcept {
+    timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<u32>((static_cast<u64>(ts.tv_sec) * 1000000000ULL) + static_cast<u64>(ts.tv_nsec));
+}
+inline u32 get_cycle_frequency_hz() noexcept { return 1000000000U; }
 
 /* logging provided centrally by platform.hpp */
 
 inline void system_reset() noexcept { _exit(1); }
-inline void task_yield() noexcept { sched_yield(); }
-inline size_t get_stack_high_water_mark() noexcept { return 0; }
 
 using task_handle_t = platform::task_handle_t;
 using task_function_t = platform::task_function_t;
 using task_create_params = platform::task_create_params;
 
-inline bool create_native_task(const task_create_params&) noexcept { return false; }
-inline bool delete_native_task(task_handle_t) noexcept { return false; }
-inline bool suspend_native_task(task_handle_t) noexcept { return false; }
-inline bool resume_native_task(task_handle_t) noexcept { return false; }
-inline task_handle_t get_current_task_handle() noexcept { return nullptr; }
+/* Mutex + condition variable pair waiting on CLOCK_MONOTONIC where available */
+struct wait_point {
+    pthread_mutex_t mtx = PTHREAD_MUTEX_INITIALIZER;
+    pthread_cond_t cv;
+
+    wait_point() noexcept {
+        pthread_condattr_t attr;
+        (void)pthread_condattr_init(&attr);
+#if defined(__linux__)
+        (void)pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+#endif
+        (void)pthread_cond_init(&cv, &attr);
+        (void)pthread_condattr_destroy(&attr);
+    }
+    ~wait_point() {
+        (void)pthread_cond_destroy(&cv);
+        (void)pthread_mutex_destroy(&mtx);
+    }
+    wait_point(const wait_point&) = delete;
+    wait_point& operator=(const wait_point&) = delete;
+
+    /* Absolute deadline for pthread_cond_timedwait, timeout in microseconds */
+    static timespec deadline_after_us(u64 timeout_us) noexcept {
+        timespec ts{};
+#if defined(__linux__)
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+        clock_gettime(CLOCK_REALTIME, &ts);
+#endif
+        ts.tv_sec += static_cast<time_t>(timeout_us / 1000000ULL);
+        ts.tv_nsec += static_cast<long>((timeout_us % 1000000ULL) * 1000ULL);
+        if (ts.tv_nsec >= 1000000000L) {
+            ts.tv_sec += 1;
+            ts.tv_nsec -= 1000000000L;
+        }
+        return ts;
+    }
+
+    /* Wait with mtx held until ready() holds or the timeout expires; infinite when forever */
+    template <typename Ready>
+    bool wait_until(Ready&& ready, u64 timeout_us, bool forever) noexcept {
+        if (ready()) { return true; }
+        if (!forever && timeout_us == 0U) { return false; }
+        const timespec deadline = deadline_after_us(timeout_us);
+        while (!ready()) {
+            const int rc = forever ? pthread_cond_wait(&cv, &mtx) : pthread_cond_timedwait(&cv, &mtx, &deadline);
+            if (rc != 0 && rc != EINTR) {
+                return ready();
+            }
+        }
+        return true;
+    }
+};
+
+/*
+ * Per-thread notification word (FreeRTOS task-notification semantics):
+ * notify_task() ORs bits in and wakes the waiter, wait_notification() returns
+ * and clears all bits. The handle of a thread is the address of its slot.
+ */
+struct notification_slot {
+    wait_point wp;
+    u32 value{0};
+    bool pending{false};
+};
+
+/*
+ * Native tasks on pthreads, from a fixed table (no heap). The handle of a
+ * native task is the address of its table entry's notification slot, so
+ * notify_task() works the same for native and foreign threads.
+ *
+ * Priorities use FreeRTOS numbering (0 = idle, higher = more urgent) and map
+ * linearly onto the EMCORE_POSIX_SCHED_POLICY range; without permission for a
+ * real-time policy (EPERM) the thread runs under the default policy.
+ *
+ * A thread cannot be stopped from outside without unwinding frames that are
+ * noexcept, so suspend and delete are honoured at the task's suspension
+ * points (delay_ms, delay_us, task_yield, wait_notification) and at once when
+ * a task suspends or deletes itself. A deleted thread leaves its entry and
+ * parks for good instead of returning into user code.
+ */
+#ifndef EMCORE_POSIX_MAX_NATIVE_TASKS
+#define EMCORE_POSIX_MAX_NATIVE_TASKS 16
+#endif
+#ifndef EMCORE_POSIX_SCHED_POLICY
+#define EMCORE_POSIX_SCHED_POLICY SCHED_FIFO  // SCHED_RR, or SCHED_OTHER to keep the default policy
+#endif
+#ifndef EMCORE_POSIX_PRIORITY_LEVELS
+#define EMCORE_POSIX_PRIORITY_LEVELS 25  // configMAX_PRIORITIES of the FreeRTOS configs the task tables target
+#endif
+#ifndef EMCORE_POSIX_MIN_STACK_BYTES
+#define EMCORE_POSIX_MIN_STACK_BYTES 65536  // stack sizes tuned for MCUs are too small for libc on a host
+#endif
+
+static_assert(EMCORE_POSIX_PRIORITY_LEVELS >= 2, "EMCORE_POSIX_PRIORITY_LEVELS must be at least 2");
+
+struct native_thread {
+    notification_slot slot;  // must stay first: the handle is &slot
+    wait_point gate;         // parks the thread while suspended
+    task_function_t function{nullptr};
+    void* parameters{nullptr};
+    pthread_t thread{};
+    etl::atomic<bool> suspended{false};
+    etl::atomic<bool> deleted{false};
+    bool in_use{false};
+    bool running{false};  // pthread exists (thread is valid)
+    char name[16]{};
+    u32 stack_request{0};
+    const u32* stack_lo{nullptr};  // painted region [stack_lo, stack_entry)
+    const u8* stack_entry{nullptr};
+};
+
+inline constexpr u32 native_stack_paint = 0xA5A5A5A5U;
+
+/* Never destroyed: detached threads may still wait on their entry while the process exits */
+inline native_thread* native_thread_table() noexcept {
+    alignas(native_thread) static unsigned char storage[sizeof(native_thread) * EMCORE_POSIX_MAX_NATIVE_TASKS];
+    static native_thread* const table = []() noexcept {
+        auto* first = reinterpret_cast<native_thread*>(storage);
+        for (size_t i = 0; i < EMCORE_POSIX_MAX_NATIVE_TASKS; ++i) { (void)new (first + i) native_thread(); }
+        return first;
+    }();
+    return table;
+}
+
+inline pthread_mutex_t& native_thread_table_lock() noexcept {
+    static pthread_mutex_t mtx = PTHREAD_MUTEX_INITIALIZER;
+    return mtx;
+}
+
+inline native_thread*& current_native_thread() noexcept {
+    thread_local native_thread* self = nullptr;
+    return self;
+}
+
+inline native_thread* find_native_thread(task_handle_t h) noexcept {
+    native_thread* table = native_thread_table();
+    for (size_t i = 0; h != nullptr && i < EMCORE_POSIX_MAX_NATIVE_TASKS; ++i) {
+        if (static_cast<void*>(&table[i].slot) == h && table[i].in_use) {
+            return &table[i];
+        }
+    }
+    return nullptr;
+}
+
+inline notification_slot& current_notification_slot() noexcept {
+    native_thread* self = current_native_thread();
+    if (self != nullptr) {
+        return self->slot;
+    }
+    thread_local notification_slot slot;
+    return slot;
+}
+
+inline void release_native_thread(native_thread& t) noexcept {
+    (void)pthread_mutex_lock(&native_thread_table_lock());
+    t.in_use = false;
+    t.running = false;
+    (void)pthread_mutex_unlock(&native_thread_table_lock());
+}
+
+/* Deleted thread: give the entry back and sleep until the process ends */
+[[noreturn]] inline void retire_native_thread(native_thread& t) noexcept {
+    current_native_thread() = nullptr;
+    release_native_thread(t);
+    for (;;) {
+        (void)pause();
+    }
+}
+
+/* Suspension point: park while suspended, retire when deleted */
+inline void native_checkpoint() noexcept {
+    native_thread* self = current_native_thread();
+    if (self == nullptr || (!self->suspended.load(etl::memory_order_acquire) &&
+                            !self->deleted.load(etl::memory_order_acquire))) {
+        return;
+    }
+    (void)pthread_mutex_lock(&self->gate.mtx);
+    (void)self->gate.wait_until([self]() {
+        return !self->suspended.load(etl::memory_order_acquire) || self->deleted.load(etl::memory_order_acquire);
+    }, 0U, true);
+    (void)pthread_mutex_unlock(&self->gate.mtx);
+    if (self->deleted.load(etl::memory_order_acquire)) {
+        retire_native_thread(*self);
+    }
+}
+
+/* Fill the unused stack below the entry frame so the high-water mark can be measured */
+inline void paint_native_stack(native_thread& t) noexcept {
+#if defined(__linux__)
+    pthread_attr_t attr;
+    if (pthread_getattr_np(pthread_self(), &attr) != 0) {
+        return;
+    }
+    void* base = nullptr;
+    size_t size = 0;
+    const int rc = pthread_attr_getstack(&attr, &base, &size);
+    (void)pthread_attr_destroy(&attr);
+    if (rc != 0 || base == nullptr) {
+        return;
+    }
+    auto* entry = static_cast<u8*>(__builtin_frame_address(0));
+    auto* lo = static_cast<u32*>(base);
+    auto* end = reinterpret_cast<u32*>((reinterpret_cast<uintptr_t>(entry) - 512U) & ~uintptr_t{3});  // keep clear of live frames
+    for (u32* p = lo; p < end; ++p) { *p = native_stack_paint; }
+    t.stack_lo = lo;
+    t.stack_entry = entry;
+#else
+    (void)t;
+#endif
+}
+
+inline void* native_thread_entry(void* arg) noexcept {
+    auto* t = static_cast<native_thread*>(arg);
+    current_native_thread() = t;
+#if defined(__linux__)
+    (void)pthread_setname_np(pthread_self(), t->name);
+#endif
+    paint_native_stack(*t);
+    native_checkpoint();  // start_suspended
+    t->function(t->parameters);
+    current_native_thread() = nullptr;
+    release_native_thread(*t);
+    return nullptr;
+}
+
+inline int native_sched_priority(u32 priority) noexcept {
+    const int lo = sched_get_priority_min(EMCORE_POSIX_SCHED_POLICY);
+    const int hi = sched_get_priority_max(EMCORE_POSIX_SCHED_POLICY);
+    constexpr u32 top = EMCORE_POSIX_PRIORITY_LEVELS - 1U;
+    const u32 level = (priority > top) ? top : priority;
+    return lo + static_cast<int>((static_cast<u32>(hi - lo) * level) / top);
+}
+
+inline bool create_native_task(const task_create_params& p) noexcept {
+    if (!p.function) return false;
+    native_thread* table = native_thread_table();
+    native_thread* t = nullptr;
+    (void)pthread_mutex_lock(&native_thread_table_lock());
+    for (size_t i = 0; i < EMCORE_POSIX_MAX_NATIVE_TASKS; ++i) {
+        if (!table[i].in_use) {
+            t = &table[i];
+            t->in_use = true;
+            break;
+        }
+    }
+    (void)pthread_mutex_unlock(&native_thread_table_lock());
+    if (t == nullptr) return false;
+
+    t->function = p.function;
+    t->parameters = p.parameters;
+    t->suspended.store(p.start_suspended, etl::memory_order_release);
+    t->deleted.store(false, etl::memory_order_release);
+    t->stack_request = p.stack_size;
+    t->stack_lo = nullptr;
+    t->stack_entry = nullptr;
+    (void)std::strncpy(t->name, (p.name != nullptr) ? p.name : "emcore", sizeof(t->name) - 1U);
+    t->name[sizeof(t->name) - 1U] = '\0';
+    (void)pthread_mutex_lock(&t->slot.wp.mtx);
+    t->slot.value = 0;
+    t->slot.pending = false;
+    (void)pthread_mutex_unlock(&t->slot.wp.mtx);
+    if (p.handle) *p.handle = &t->slot;
+
+    pthread_attr_t attr;
+    (void)pthread_attr_init(&attr);
+    (void)pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    const long page = sysconf(_SC_PAGESIZE);
+    size_t stack = (p.stack_size > EMCORE_POSIX_MIN_STACK_BYTES) ? p.stack_size : EMCORE_POSIX_MIN_STACK_BYTES;
+    if (stack < static_cast<size_t>(PTHREAD_STACK_MIN)) stack = static_cast<size_t>(PTHREAD_STACK_MIN);
+    if (page > 0) stack = (stack + static_cast<size_t>(page) - 1U) & ~(static_cast<size_t>(page) - 1U);
+    (void)pthread_attr_setstacksize(&attr, stack);
+#if defined(__linux__)
+    if (p.pin_to_core && p.core_id >= 0 && p.core_id < CPU_SETSIZE) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(p.core_id, &cpus);
+        (void)pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+    }
+#endif
+    const bool realtime = (EMCORE_POSIX_SCHED_POLICY != SCHED_OTHER);
+    if (realtime) {
+        sched_param param{};
+        param.sched_priority = native_sched_priority(p.priority);
+        (void)pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        (void)pthread_attr_setschedpolicy(&attr, EMCORE_POSIX_SCHED_POLICY);
+        (void)pthread_attr_setschedparam(&attr, &param);
+    }
+    int rc = pthread_create(&t->thread, &attr, &native_thread_entry, t);
+    if (rc == EPERM && realtime) {
+        static etl::atomic<bool> warned{false};
+        if (!warned.exchange(true)) {
+            (void)std::fputs("emCore: no permission for real-time scheduling, native tasks use the default policy\n", stderr);
+        }
+        (void)pthread_attr_setinheritsched(&attr, PTHREAD_INHERIT_SCHED);
+        rc = pthread_create(&t->thread, &attr, &native_thread_entry, t);
+    }
+    (void)pthread_attr_destroy(&attr);
+    if (rc != 0) {
+        if (p.handle) *p.handle = nullptr;
+        release_native_thread(*t);
+        return false;
+    }
+    (void)pthread_mutex_lock(&native_thread_table_lock());
+    t->running = t->in_use;  // the thread may already have finished
+    (void)pthread_mutex_unlock(&native_thread_table_lock());
+    return true;
+}
+
+/* Wake a thread blocked in wait_notification() or parked, so it reaches its checkpoint */
+inline void kick_native_thread(native_thread& t) noexcept {
+    (void)pthread_mutex_lock(&t.slot.wp.mtx);
+    (void)pthread_mutex_unlock(&t.slot.wp.mtx);
+    (void)pthread_cond_broadcast(&t.slot.wp.cv);
+    (void)pthread_mutex_lock(&t.gate.mtx);
+    (void)pthread_mutex_unlock(&t.gate.mtx);
+    (void)pthread_cond_broadcast(&t.gate.cv);
+}
+
+inline bool delete_native_task(task_handle_t h) noexcept {
+    native_thread* t = find_native_thread(h);
+    if (t == nullptr) return false;
+    t->deleted.store(true, etl::memory_order_release);
+    if (t == current_native_thread()) {
+        retire_native_thread(*t);
+    }
+    kick_native_thread(*t);
+    return true;
+}
+
+inline bool suspend_native_task(task_handle_t h) noexcept {
+    native_thread* t = find_native_thread(h);
+    if (t == nullptr) return false;
+    t->suspended.store(true, etl::memory_order_release);
+    if (t == current_native_thread()) {
+        native_checkpoint();
+    }
+    return true;
+}
+
+inline bool resume_native_task(task_handle_t h) noexcept {
+    native_thread* t = find_native_thread(h);
+    if (t == nullptr) return false;
+    (void)pthread_mutex_lock(&t->gate.mtx);
+    t->suspended.store(false, etl::memory_order_release);
+    (void)pthread_mutex_unlock(&t->gate.mtx);
+    (void)pthread_cond_broadcast(&t->gate.cv);
+    return true;
+}
+
+inline task_handle_t get_current_task_handle() noexcept { return &current_notification_slot(); }
+
+inline bool set_task_affinity(task_handle_t h, int core_id) noexcept {
+#if defined(__linux__)
+    if (core_id >= CPU_SETSIZE) return false;
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    if (core_id < 0) {
+        for (long c = 0, n = sysconf(_SC_NPROCESSORS_CONF); c < n && c < CPU_SETSIZE; ++c) { CPU_SET(c, &cpus); }
+    } else {
+        CPU_SET(core_id, &cpus);
+    }
+    (void)pthread_mutex_lock(&native_thread_table_lock());
+    native_thread* t = find_native_thread(h);
+    const bool ok = (t != nullptr) && t->running &&
+                    pthread_setaffinity_np(t->thread, sizeof(cpus), &cpus) == 0;
+    (void)pthread_mutex_unlock(&native_thread_table_lock());
+    return ok;
+#else
+    (void)h;
+    (void)core_id;
+    return false;
+#endif
+}
+
+/*
+ * Free stack bytes of the calling native task, FreeRTOS style: the deepest
+ * point ever reached is found by scanning the painted region from its low
+ * end, and usage is reported against the requested stack size (the real
+ * stack is at least EMCORE_POSIX_MIN_STACK_BYTES). 0 outside native tasks.
+ */
+inline size_t get_stack_high_water_mark() noexcept {
+    const native_thread* self = current_native_thread();
+    if (self == nullptr || self->stack_lo == nullptr) {
+        return 0;
+    }
+    const u32* p = self->stack_lo;
+    const auto* end = reinterpret_cast<const u32*>(self->stack_entry);
+    while (p < end && *p == native_stack_paint) { ++p; }
+    const size_t used = static_cast<size_t>(self->stack_entry - reinterpret_cast<const u8*>(p));
+    const size_t size = (self->stack_request != 0U) ? self->stack_request
+                                                    : static_cast<size_t>(self->stack_entry - reinterpret_cast<const u8*>(self->stack_lo));
+    return (used < size) ? (size - used) : 1U;  // 1: at or past the requested size
+}
+
+inline void delay_ms(duration_t ms) noexcept {
+    usleep(static_cast<useconds_t>(ms * 1000ULL));
+    native_checkpoint();
+}
+inline void delay_us(u32 us) noexcept {
+    usleep(static_cast<useconds_t>(us));
+    native_checkpoint();
+}
+inline void task_yield() noexcept {
+    sched_yield();
+    native_checkpoint();
+}
+
+inline u8 cpu_core_count() noexcept {
+    const long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n < 1) ? 1U : ((n > 255) ? 255U : static_cast<u8>(n));
+}
+inline u8 current_core_id() noexcept {
+#if defined(__linux__)
+    const int cpu = sched_getcpu();
+    return (cpu < 0) ? 0U : static_cast<u8>(cpu);
+#else
+    return 0;
+#endif
+}
+inline bool in_isr() noexcept { return false; }  // signal handlers are not tracked
+
+inline bool notify_task(task_handle_t h, u32 value) noexcept {
+    if (!h) return false;
+    auto* slot = static_cast<notification_slot*>(h);
+    (void)pthread_mutex_lock(&slot->wp.mtx);
+    slot->value |= value;
+    slot->pending = true;
+    (void)pthread_mutex_unlock(&slot->wp.mtx);
+    (void)pthread_cond_signal(&slot->wp.cv);
+    return true;
+}
+
+inline bool wait_notification(u32 timeout_ms, u32* out) noexcept {
+    notification_slot& slot = current_notification_slot();
+    (void)pthread_mutex_lock(&slot.wp.mtx);
+    const native_thread* self = current_native_thread();
+    (void)slot.wp.wait_until([&slot, self]() {
+        return slot.pending || (self != nullptr && self->deleted.load(etl::memory_order_acquire));
+    }, static_cast<u64>(timeout_ms) * 1000ULL, timeout_ms == 0xFFFFFFFFU);
+    const bool notified = slot.pending;
+    if (out) { *out = notified ? slot.value : 0U; }
+    if (notified) {
+        slot.value = 0;
+        slot.pending = false;
+    }
+    (void)pthread_mutex_unlock(&slot.wp.mtx);
+    native_checkpoint();
+    return notified;
+}
+
+inline void clear_notification() noexcept {
+    notification_slot& slot = current_notification_slot();
+    (void)pthread_mutex_lock(&slot.wp.mtx);
+    slot.value = 0;
+    slot.pending = false;
+    (void)pthread_mutex_unlock(&slot.wp.mtx);
+}
+
+/* Binary semaphores from a fixed table (no heap); handle is the table entry */
+#ifndef EMCORE_POSIX_MAX_SEMAPHORES
+#define EMCORE_POSIX_MAX_SEMAPHORES 32
+#endif
+
+struct binary_semaphore {
+    wait_point wp;
+    bool available{false};
+    bool in_use{false};
+};
 
-inline bool notify_task(task_handle_t, u32) noexcept { return false; }
-inline bool wait_notification(u32, u32*) noexcept { return false; }
-inline void clear_notification() noexcept {}
+inline binary_semaphore* semaphore_table() noexcept {
+    static binary_semaphore table[EMCORE_POSIX_MAX_SEMAPHORES];
+    return table;
+}
+
+inline pthread_mutex_t& semaphore_table_lock() noexcept {
+    static pthread_mutex_t mtx = PTHREAD_MUTEX_INITIALIZER;
+    return mtx;
+}
 
 using semaphore_handle_t = void*;
-inline semaphore_handle_t create_binary_semaphore() noexcept { return nullptr; }
-inline void delete_semaphore(semaphore_handle_t) noexcept {}
-inline bool semaphore_give(semaphore_handle_t) noexcept { return false; }
-inline bool semaphore_take(semaphore_handle_t, duration_t) noexcept { return false; }
+inline semaphore_handle_t create_binary_semaphore() noexcept {
+    binary_semaphore* table = semaphore_table();
+    semaphore_handle_t handle = nullptr;
+    (void)pthread_mutex_lock(&semaphore_table_lock());
+    for (size_t i = 0; i < EMCORE_POSIX_MAX_SEMAPHORES; ++i) {
+        if (!table[i].in_use) {
+            table[i].in_use = true;
+            table[i].available = false;  // binary semaphores start empty, as on FreeRTOS
+            handle = &table[i];
+            break;
+        }
+    }
+    (void)pthread_mutex_unlock(&semaphore_table_lock());
+    return handle;
+}
+
+inline void delete_semaphore(semaphore_handle_t h) noexcept {
+    if (!h) return;
+    auto* sem = static_cast<binary_semaphore*>(h);
+    (void)pthread_mutex_lock(&semaphore_table_lock());
+    sem->in_use = false;
+    (void)pthread_mutex_unlock(&semaphore_table_lock());
+}
+
+inline bool semaphore_give(semaphore_handle_t h) noexcept {
+    if (!h) return false;
+    auto* sem = static_cast<binary_semaphore*>(h);
+    (void)pthread_mutex_lock(&sem->wp.mtx);
+    const bool given = !sem->available;
+    sem->available = true;
+    (void)pthread_mutex_unlock(&sem->wp.mtx);
+    (void)pthread_cond_signal(&sem->wp.cv);
+    return given;
+}
+
+inline bool semaphore_take(semaphore_handle_t h, duration_t timeout_us) noexcept {
+    if (!h) return false;
+    auto* sem = static_cast<binary_semaphore*>(h);
+    (void)pthread_mutex_lock(&sem->wp.mtx);
+    const bool taken = sem->wp.wait_until([sem]() { return sem->available; },
+                                          static_cast<u64>(timeout_us), timeout_us == static_cast<duration_t>(-1));
+    if (taken) {
+        sem->available = false;
+    }
+    (void)pthread_mutex_unlock(&sem->wp.mtx);
+    return taken;
+}
 
 inline constexpr platform_info get_platform_info() noexcept { return {"POSIX", 1000000000U, false}; }
 
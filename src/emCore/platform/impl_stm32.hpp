@@ -18,7 +18,8 @@ struct critical_section {
     void exit() const noexcept { __enable_irq(); }
 };
 
-inline timestamp_t get_system_time_us() noexcept {
+/* DWT CYCCNT, enabled on first use; wraps every 2^32 core clocks */
+inline u32 get_cycle_count() noexcept {
     static bool dwt_initialized = false;
     if (!dwt_initialized) {
         CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
@@ -26,7 +27,12 @@ inline timestamp_t get_system_time_us() noexcept {
         DWT->CYCCNT = 0;
         dwt_initialized = true;
     }
-    const uint32_t cycles = DWT->CYCCNT;
+    return static_cast<u32>(DWT->CYCCNT);
+}
+inline u32 get_cycle_frequency_hz() noexcept { return static_cast<u32>(SystemCoreClock); }
+
+inline timestamp_t get_system_time_us() noexcept {
+    const uint32_t cycles = get_cycle_count();
     return static_cast<timestamp_t>((static_cast<uint64_t>(cycles) * 1000000ULL) / SystemCoreClock);
 }
 inline timestamp_t get_system_time() noexcept { return get_system_time_us() / 1000ULL; }
@@ -66,6 +72,10 @@ inline bool delete_native_task(task_handle_t h) noexcept { if (!h) return false;
 inline bool suspend_native_task(task_handle_t h) noexcept { if (!h) return false; osThreadSuspend(reinterpret_cast<osThreadId_t>(h)); return true; }
 inline bool resume_native_task(task_handle_t h) noexcept { if (!h) return false; osThreadResume(reinterpret_cast<osThreadId_t>(h)); return true; }
 inline task_handle_t get_current_task_handle() noexcept { return reinterpret_cast<task_handle_t>(osThreadGetId()); }
+inline bool set_task_affinity(task_handle_t, int) noexcept { return false; }
+inline u8 cpu_core_count() noexcept { return 1; }
+inline u8 current_core_id() noexcept { return 0; }
+inline bool in_isr() noexcept { return __get_IPSR() != 0U; }  // handler mode
 
 inline bool notify_task(task_handle_t h, u32 value) noexcept {
     if (!h) return false; return osThreadFlagsSet(reinterpret_cast<osThreadId_t>(h), value) != 0U;
@@ -82,12 +92,66 @@ inline semaphore_handle_t create_binary_semaphore() noexcept { return osSemaphor
 inline void delete_semaphore(semaphore_handle_t sem) noexcept { if (sem) { osSemaphoreDelete(sem); } }
 inline bool semaphore_give(semaphore_handle_t sem) noexcept { return sem && (osSemaphoreRelease(sem) == osOK); }
 inline bool semaphore_take(semaphore_handle_t sem, duration_t timeout_us) noexcept {
-    const uint32_t ms = static_cast<uint32_t>(timeout_us / 1000U);
+    if (timeout_us == static_cast<duration_t>(0xFFFFFFFFU)) {
+        return sem && (osSemaphoreAcquire(sem, osWaitForever) == osOK);
+    }
+    // Round up to whole ms without overflowing near the u32 limit
+    const uint32_t ms = static_cast<uint32_t>(timeout_us / 1000U + ((timeout_us % 1000U) != 0U ? 1U : 0U));
     // Convert ms to ticks for CMSIS v2 if needed
-    const uint32_t ticks = (ms * osKernelGetTickFreq()) / 1000U;
+    const uint32_t ticks = static_cast<uint32_t>((static_cast<u64>(ms) * osKernelGetTickFreq()) / 1000U);
     return sem && (osSemaphoreAcquire(sem, ticks ? ticks : 1U) == osOK);
 }
 
+/*
+ * Circular DMA UART receive into a caller buffer (e.g. dma_byte_ring::dma_buffer()).
+ * The RX DMA stream must be configured in circular mode. HAL then reports the
+ * write offset through HAL_UARTEx_RxEventCallback(huart, size) on half-transfer,
+ * transfer-complete and idle-line; forward size to dma_byte_ring::on_dma_event().
+ */
+#if defined(HAL_UART_MODULE_ENABLED) && defined(HAL_DMA_MODULE_ENABLED)
+inline bool uart_dma_rx_start(void* uart, u8* buffer, size_t size) noexcept {
+    auto* huart = static_cast<UART_HandleTypeDef*>(uart);
+    if (huart == nullptr || buffer == nullptr || size == 0U || size > 0xFFFFU) { return false; }
+    return HAL_UARTEx_ReceiveToIdle_DMA(huart, buffer, static_cast<uint16_t>(size)) == HAL_OK;
+}
+
+// Current DMA write offset, for polling without waiting for the next event
+inline size_t uart_dma_rx_position(void* uart, size_t size) noexcept {
+    auto* huart = static_cast<UART_HandleTypeDef*>(uart);
+    if (huart == nullptr || huart->hdmarx == nullptr) { return 0; }
+    return size - static_cast<size_t>(__HAL_DMA_GET_COUNTER(huart->hdmarx));
+}
+
+/*
+ * Start a UART DMA transmit; usable as a packet_tx_pipeline driver hook with the
+ * UART handle as ctx. Call packet_tx_pipeline::on_tx_complete() from
+ * HAL_UART_TxCpltCallback(huart).
+ */
+inline bool uart_dma_tx_start(void* uart, const u8* data, size_t size) noexcept {
+    auto* huart = static_cast<UART_HandleTypeDef*>(uart);
+    if (huart == nullptr || data == nullptr || size == 0U || size > 0xFFFFU) { return false; }
+    return HAL_UART_Transmit_DMA(huart, const_cast<u8*>(data), static_cast<uint16_t>(size)) == HAL_OK;
+}
+#endif
+
+// Cores with a data cache must drop stale lines before reading DMA-written memory
+inline void dma_rx_invalidate(const void* addr, size_t size) noexcept {
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    SCB_InvalidateDCache_by_Addr(const_cast<void*>(addr), static_cast<int32_t>(size));
+#else
+    (void)addr; (void)size;
+#endif
+}
+
+// Cores with a data cache must write dirty lines back before DMA reads the memory
+inline void dma_tx_clean(const void* addr, size_t size) noexcept {
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    SCB_CleanDCache_by_Addr(const_cast<uint32_t*>(static_cast<const uint32_t*>(addr)), static_cast<int32_t>(size));
+#else
+    (void)addr; (void)size;
+#endif
+}
+
 inline constexpr platform_info get_platform_info() noexcept { return {"STM32", static_cast<u32>(SystemCoreClock), true}; }
 
 } // namespace emCore::platform::impl_stm32
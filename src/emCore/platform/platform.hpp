@@ -56,6 +56,8 @@ using critical_section = impl::critical_section;
 
 inline timestamp_t get_system_time_us() noexcept { return impl::get_system_time_us(); }
 inline timestamp_t get_system_time() noexcept { return impl::get_system_time(); }
+inline u32 get_cycle_count() noexcept { return impl::get_cycle_count(); }
+inline u32 get_cycle_frequency_hz() noexcept { return impl::get_cycle_frequency_hz(); }
 inline void delay_ms(duration_t milliseconds) noexcept { impl::delay_ms(milliseconds); }
 inline void delay_us(u32 microseconds) noexcept { impl::delay_us(microseconds); }
 
@@ -69,6 +71,10 @@ inline bool delete_native_task(task_handle_t handle) noexcept { return impl::del
 inline bool suspend_native_task(task_handle_t handle) noexcept { return impl::suspend_native_task(handle); }
 inline bool resume_native_task(task_handle_t handle) noexcept { return impl::resume_native_task(handle); }
 inline task_handle_t get_current_task_handle() noexcept { return impl::get_current_task_handle(); }
+inline bool set_task_affinity(task_handle_t handle, int core_id) noexcept { return impl::set_task_affinity(handle, core_id); }
+inline u8 cpu_core_count() noexcept { return impl::cpu_core_count(); }
+inline u8 current_core_id() noexcept { return impl::current_core_id(); }
+inline bool in_isr() noexcept { return impl::in_isr(); }
 
 inline bool notify_task(task_handle_t handle, u32 value = 0x01) noexcept { return impl::notify_task(handle, value); }
 inline bool wait_notification(u32 timeout_ms, u32* out_value) noexcept { return impl::wait_notification(timeout_ms, out_value); }
@@ -86,6 +92,26 @@ constexpr platform_info get_platform_info() noexcept { return impl::get_platform
 #ifndef EMCORE_ENABLE_LOGGING
 #define EMCORE_ENABLE_LOGGING 1 /* NOLINT(cppcoreguidelines-macro-usage) */
 #endif
+// 1 = log()/logf() only queue the format pointer and arguments; log_flush() or
+// log_drain_into() does the formatting (see deferred_log.hpp)
+#ifndef EMCORE_DEFERRED_LOG
+#define EMCORE_DEFERRED_LOG 0 /* NOLINT(cppcoreguidelines-macro-usage) */
+#endif
+#ifndef EMCORE_DEFERRED_LOG_RECORDS
+#define EMCORE_DEFERRED_LOG_RECORDS 64 /* NOLINT(cppcoreguidelines-macro-usage) */
+#endif
+// Records the taskmaster formats per idle pass in deferred mode (0 = leave draining to the application)
+#ifndef EMCORE_DEFERRED_LOG_IDLE_FLUSH
+#define EMCORE_DEFERRED_LOG_IDLE_FLUSH 8 /* NOLINT(cppcoreguidelines-macro-usage) */
+#endif
+
+} // namespace emCore::platform
+
+#if EMCORE_DEFERRED_LOG
+#include "deferred_log.hpp"
+#endif
+
+namespace emCore::platform {
 
 namespace detail {
 inline void log_sink(const char* msg) noexcept {
@@ -101,9 +127,30 @@ inline void log_sink(const char* msg) noexcept {
     (void)msg;
 #endif
 }
+
+#if EMCORE_DEFERRED_LOG
+inline deferred_log_ring<EMCORE_DEFERRED_LOG_RECORDS>& deferred_log() noexcept {
+    static deferred_log_ring<EMCORE_DEFERRED_LOG_RECORDS> ring;
+    return ring;
+}
+#endif
+
+// Common path of every logf overload
+inline void log_args(const char* fmt, u8 argc, u32 arg1, u32 arg2 = 0, u32 arg3 = 0, u32 arg4 = 0, u32 arg5 = 0) noexcept {
+#if !EMCORE_ENABLE_LOGGING
+    (void)fmt; (void)argc; (void)arg1; (void)arg2; (void)arg3; (void)arg4; (void)arg5;
+#elif EMCORE_DEFERRED_LOG
+    deferred_log().push(log_record{fmt, static_cast<u32>(get_system_time_us()), argc, {arg1, arg2, arg3, arg4, arg5}});
+#else
+    (void)argc;
+    char buffer[256]; std::snprintf(buffer, sizeof(buffer), fmt, arg1, arg2, arg3, arg4, arg5); /* NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg,cppcoreguidelines-pro-bounds-array-to-pointer-decay) */
+    log_sink(buffer);
+#endif
+}
 } // namespace detail
 
-inline void log(const char* message) noexcept {
+// Emit immediately, whatever the logging mode (for text in transient buffers)
+inline void log_now(const char* message) noexcept {
 #if EMCORE_ENABLE_LOGGING
     detail::log_sink(message);
 #else
@@ -111,17 +158,41 @@ inline void log(const char* message) noexcept {
 #endif
 }
 
-inline void logf(const char* fmt, u32 arg1) noexcept {
-#if EMCORE_ENABLE_LOGGING
-    char buffer[256]; std::snprintf(buffer, sizeof(buffer), fmt, arg1); /* NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg,cppcoreguidelines-pro-bounds-array-to-pointer-decay) */ log(buffer);
+// In deferred mode message must be a string literal (only the pointer is queued)
+inline void log(const char* message) noexcept {
+#if EMCORE_ENABLE_LOGGING && EMCORE_DEFERRED_LOG
+    detail::deferred_log().push(log_record{message, static_cast<u32>(get_system_time_us()), 0U, {}});
+#else
+    log_now(message);
+#endif
+}
+
+inline void logf(const char* fmt, u32 arg1) noexcept { detail::log_args(fmt, 1U, arg1); }
+inline void logf(const char* fmt, u32 arg1, u32 arg2) noexcept { detail::log_args(fmt, 2U, arg1, arg2); }
+inline void logf(const char* fmt, u32 arg1, u32 arg2, u32 arg3) noexcept { detail::log_args(fmt, 3U, arg1, arg2, arg3); }
+inline void logf(const char* fmt, u32 arg1, u32 arg2, u32 arg3, u32 arg4) noexcept { detail::log_args(fmt, 4U, arg1, arg2, arg3, arg4); }
+inline void logf(const char* fmt, u32 arg1, u32 arg2, u32 arg3, u32 arg4, u32 arg5) noexcept { detail::log_args(fmt, 5U, arg1, arg2, arg3, arg4, arg5); }
+
+/*
+ * Deferred mode drain side (a no-op otherwise): log_flush() formats up to
+ * max_records on the calling context, log_drain_into() exports them raw.
+ */
+inline size_t log_flush(size_t max_records = static_cast<size_t>(-1)) noexcept {
+#if EMCORE_ENABLE_LOGGING && EMCORE_DEFERRED_LOG
+    return detail::deferred_log().flush(detail::log_sink, max_records);
+#else
+    (void)max_records;
+    return 0;
+#endif
+}
+inline size_t log_drain_into(u8* buf, size_t cap) noexcept {
+#if EMCORE_ENABLE_LOGGING && EMCORE_DEFERRED_LOG
+    return detail::deferred_log().drain_into(buf, cap);
 #else
-    (void)fmt; (void)arg1;
+    (void)buf; (void)cap;
+    return 0;
 #endif
 }
-inline void logf(const char* fmt, u32 arg1, u32 arg2) noexcept { char buffer[256]; std::snprintf(buffer, sizeof(buffer), fmt, arg1, arg2); /* NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg,cppcoreguidelines-pro-bounds-array-to-pointer-decay) */ log(buffer); }
-inline void logf(const char* fmt, u32 arg1, u32 arg2, u32 arg3) noexcept { char buffer[256]; std::snprintf(buffer, sizeof(buffer), fmt, arg1, arg2, arg3); /* NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg,cppcoreguidelines-pro-bounds-array-to-pointer-decay) */ log(buffer); }
-inline void logf(const char* fmt, u32 arg1, u32 arg2, u32 arg3, u32 arg4) noexcept { char buffer[256]; std::snprintf(buffer, sizeof(buffer), fmt, arg1, arg2, arg3, arg4); /* NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg,cppcoreguidelines-pro-bounds-array-to-pointer-decay) */ log(buffer); }
-inline void logf(const char* fmt, u32 arg1, u32 arg2, u32 arg3, u32 arg4, u32 arg5) noexcept { char buffer[256]; std::snprintf(buffer, sizeof(buffer), fmt, arg1, arg2, arg3, arg4, arg5); /* NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg,cppcoreguidelines-pro-bounds-array-to-pointer-decay) */ log(buffer); }
 
 } // namespace emCore::platform
 
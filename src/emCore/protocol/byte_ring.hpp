@@ -6,7 +6,10 @@
 // - ETL only dependency (for array)
 
 #include <etl/array.h>
+#include <etl/atomic.h>
+#include <etl/span.h>
 #include <emCore/core/types.hpp>
+#include <cstring>
 
 namespace emCore::protocol {
 
@@ -78,4 +81,129 @@ private:
     size_t tail_{0};
 };
 
+/*
+ * Lock-free SPSC byte ring for ISR -> task (or DMA -> task) streams.
+ * Capacity must be a power of two; indices are free-running u32 counters
+ * masked on access, so all Capacity bytes are usable. The producer owns
+ * head_, the consumer owns tail_; acquire/release on the opposite index
+ * orders the data copies.
+ *
+ * Zero-copy access: write_span() exposes the contiguous free region at the
+ * write position and commit(n) publishes n bytes of it; read_span() exposes
+ * the contiguous readable region and consume(n) releases it. Either span may
+ * be shorter than the total free/readable count when it reaches the end of
+ * the storage; call again after commit/consume for the wrapped part.
+ */
+template <size_t Capacity>
+class spsc_byte_ring {
+public:
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "spsc_byte_ring capacity must be a power of two");
+    static_assert(Capacity <= 0x80000000UL, "spsc_byte_ring capacity must fit the u32 index space");
+
+    constexpr spsc_byte_ring() = default;
+    spsc_byte_ring(const spsc_byte_ring&) = delete;
+    spsc_byte_ring& operator=(const spsc_byte_ring&) = delete;
+    spsc_byte_ring(spsc_byte_ring&&) = delete;
+    spsc_byte_ring& operator=(spsc_byte_ring&&) = delete;
+
+    // Reset indices; neither side may be active
+    inline void reset() noexcept {
+        head_.store(0, etl::memory_order_relaxed);
+        tail_.store(0, etl::memory_order_relaxed);
+    }
+
+    /* Producer side */
+    inline bool push(u8 b) noexcept {
+        const u32 head = head_.load(etl::memory_order_relaxed);
+        if ((head - tail_.load(etl::memory_order_acquire)) >= Capacity) { return false; }
+        buf_[head & mask] = b;
+        head_.store(head + 1U, etl::memory_order_release);
+        return true;
+    }
+
+    // Push many bytes (at most two memcpy); returns number stored
+    inline size_t push_n(const u8* data, size_t len) noexcept {
+        const u32 head = head_.load(etl::memory_order_relaxed);
+        const size_t space = Capacity - static_cast<size_t>(head - tail_.load(etl::memory_order_acquire));
+        const size_t count = (len < space) ? len : space;
+        copy_in(head, data, count);
+        head_.store(head + static_cast<u32>(count), etl::memory_order_release);
+        return count;
+    }
+
+    inline etl::span<u8> write_span() noexcept {
+        const u32 head = head_.load(etl::memory_order_relaxed);
+        const size_t space = Capacity - static_cast<size_t>(head - tail_.load(etl::memory_order_acquire));
+        const size_t offset = head & mask;
+        const size_t run = ((Capacity - offset) < space) ? (Capacity - offset) : space;
+        return etl::span<u8>(&buf_[offset], run);
+    }
+
+    // Publish n bytes written through write_span(); n must not exceed its size
+    inline void commit(size_t n) noexcept {
+        head_.store(head_.load(etl::memory_order_relaxed) + static_cast<u32>(n), etl::memory_order_release);
+    }
+
+    /* Consumer side */
+    inline bool pop(u8& out) noexcept {
+        const u32 tail = tail_.load(etl::memory_order_relaxed);
+        if (tail == head_.load(etl::memory_order_acquire)) { return false; }
+        out = buf_[tail & mask];
+        tail_.store(tail + 1U, etl::memory_order_release);
+        return true;
+    }
+
+    // Pop up to max bytes into dst (at most two memcpy); returns count popped
+    inline size_t pop_n(u8* dst, size_t max) noexcept {
+        const u32 tail = tail_.load(etl::memory_order_relaxed);
+        const size_t avail = static_cast<size_t>(head_.load(etl::memory_order_acquire) - tail);
+        const size_t count = (max < avail) ? max : avail;
+        copy_out(tail, dst, count);
+        tail_.store(tail + static_cast<u32>(count), etl::memory_order_release);
+        return count;
+    }
+
+    inline etl::span<const u8> read_span() const noexcept {
+        const u32 tail = tail_.load(etl::memory_order_relaxed);
+        const size_t avail = static_cast<size_t>(head_.load(etl::memory_order_acquire) - tail);
+        const size_t offset = tail & mask;
+        const size_t run = ((Capacity - offset) < avail) ? (Capacity - offset) : avail;
+        return etl::span<const u8>(&buf_[offset], run);
+    }
+
+    // Release n bytes seen through read_span(); n must not exceed its size
+    inline void consume(size_t n) noexcept {
+        tail_.store(tail_.load(etl::memory_order_relaxed) + static_cast<u32>(n), etl::memory_order_release);
+    }
+
+    // State (snapshots; exact only from the owning side)
+    inline size_t size() const noexcept {
+        return static_cast<size_t>(head_.load(etl::memory_order_acquire) - tail_.load(etl::memory_order_acquire));
+    }
+    inline bool empty() const noexcept { return size() == 0U; }
+    inline bool full() const noexcept { return size() >= Capacity; }
+    static constexpr size_t capacity() noexcept { return Capacity; }
+
+private:
+    static constexpr u32 mask = static_cast<u32>(Capacity - 1);
+
+    inline void copy_in(u32 index, const u8* src, size_t count) noexcept {
+        const size_t offset = index & mask;
+        const size_t first = ((Capacity - offset) < count) ? (Capacity - offset) : count;
+        std::memcpy(&buf_[offset], src, first);
+        std::memcpy(&buf_[0], src + first, count - first);
+    }
+
+    inline void copy_out(u32 index, u8* dst, size_t count) const noexcept {
+        const size_t offset = index & mask;
+        const size_t first = ((Capacity - offset) < count) ? (Capacity - offset) : count;
+        std::memcpy(dst, &buf_[offset], first);
+        std::memcpy(dst + first, &buf_[0], count - first);
+    }
+
+    etl::array<u8, Capacity> buf_{};
+    etl::atomic<u32> head_{0};   // producer
+    etl::atomic<u32> tail_{0};   // consumer
+};
+
 } // namespace emCore::protocol
@@ -4,6 +4,7 @@
 // - Fixed-capacity table for opcode -> handler
 // - Replace-on-register semantics; supports deregistration
 // - Minimal API suitable for ISR/task use (no locks)
+// - indexed_command_dispatcher / const_command_dispatcher: O(1) dense opcode tables
 
 #include <emCore/core/types.hpp>
 #include <etl/array.h>
@@ -115,4 +116,141 @@ private:
     handler_t unknown_{nullptr};
 };
 
+// Dense opcode-indexed dispatcher: one handler slot per opcode in [0, OpcodeSpace)
+// - Same API as command_dispatcher; dispatch() is a single indexed call
+// - constexpr-constructible from a generated table (see generate_command_table.py)
+// - CountHits: per-opcode dispatch counters for finding hot commands
+template <size_t OpcodeSpace, typename PacketT, bool CountHits = false>
+class indexed_command_dispatcher {
+    static_assert(OpcodeSpace >= 1 && OpcodeSpace <= 256, "OpcodeSpace must be in [1, 256]");
+
+public:
+    using handler_t = command_handler_t<PacketT>;
+    using table_t = etl::array<handler_t, OpcodeSpace>;
+    using reg_result = typename command_dispatcher<OpcodeSpace, PacketT>::reg_result;
+
+    static constexpr size_t capacity() noexcept { return OpcodeSpace; }
+
+    constexpr indexed_command_dispatcher() noexcept = default;
+    constexpr explicit indexed_command_dispatcher(const table_t& table, handler_t unknown = nullptr) noexcept
+        : table_(table), unknown_(unknown) {}
+
+    // Replace the whole table (e.g. with a generated constexpr table)
+    void load(const table_t& table, handler_t unknown = nullptr) noexcept {
+        table_ = table;
+        unknown_ = unknown;
+    }
+
+    bool register_handler(u8 opcode, handler_t fn) noexcept {
+        return try_register_handler(opcode, fn) != reg_result::full;
+    }
+
+    // Opcodes outside the table report full, like an exhausted command_dispatcher
+    reg_result try_register_handler(u8 opcode, handler_t fn) noexcept {
+        if (opcode >= OpcodeSpace) { return reg_result::full; }
+        const bool replaced = (table_[opcode] != nullptr);
+        table_[opcode] = fn;
+        return replaced ? reg_result::ok_replaced : reg_result::ok_new;
+    }
+
+    bool deregister_handler(u8 opcode) noexcept {
+        if (opcode >= OpcodeSpace || table_[opcode] == nullptr) { return false; }
+        table_[opcode] = nullptr;
+        return true;
+    }
+
+    [[nodiscard]] bool has_handler(u8 opcode) const noexcept {
+        return opcode < OpcodeSpace && table_[opcode] != nullptr;
+    }
+
+    handler_t get_handler(u8 opcode) const noexcept {
+        return (opcode < OpcodeSpace) ? table_[opcode] : nullptr;
+    }
+
+    void set_unknown_handler(handler_t fn) noexcept { unknown_ = fn; }
+
+    void clear() noexcept {
+        table_.fill(nullptr);
+        unknown_ = nullptr;
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        size_t n = 0;
+        for (size_t i = 0; i < OpcodeSpace; ++i) { n += (table_[i] != nullptr) ? 1U : 0U; }
+        return n;
+    }
+
+    void dispatch(const PacketT& pkt) const noexcept {
+        const handler_t fn = (pkt.opcode < OpcodeSpace) ? table_[pkt.opcode] : nullptr;
+        if constexpr (CountHits) {
+            ++hits_[(fn != nullptr) ? pkt.opcode : OpcodeSpace];
+        }
+        if (fn != nullptr) { fn(pkt); return; }
+        if (unknown_) { unknown_(pkt); }
+    }
+
+    // Dispatch count for an opcode (always 0 unless CountHits)
+    [[nodiscard]] u32 hits(u8 opcode) const noexcept {
+        if constexpr (CountHits) { return (opcode < OpcodeSpace) ? hits_[opcode] : 0U; }
+        else { (void)opcode; return 0U; }
+    }
+    // Packets with no registered handler (routed to the unknown handler, if any)
+    [[nodiscard]] u32 unknown_hits() const noexcept {
+        if constexpr (CountHits) { return hits_[OpcodeSpace]; }
+        else { return 0U; }
+    }
+    void reset_hits() noexcept {
+        if constexpr (CountHits) { hits_.fill(0U); }
+    }
+
+private:
+    table_t table_{};
+    handler_t unknown_{nullptr};
+    mutable etl::array<u32, CountHits ? OpcodeSpace + 1 : 1> hits_{};
+};
+
+// Registration-free dispatcher over a constexpr handler table kept in flash.
+// Table must be a namespace-scope constexpr etl::array<command_handler_t<PacketT>, OpcodeSpace>;
+// nullptr slots fall through to Unknown.
+template <typename PacketT, size_t OpcodeSpace,
+          const etl::array<command_handler_t<PacketT>, OpcodeSpace>& Table,
+          command_handler_t<PacketT> Unknown = nullptr, bool CountHits = false>
+class const_command_dispatcher {
+public:
+    using handler_t = command_handler_t<PacketT>;
+
+    static constexpr size_t capacity() noexcept { return OpcodeSpace; }
+
+    [[nodiscard]] static constexpr bool has_handler(u8 opcode) noexcept {
+        return opcode < OpcodeSpace && Table[opcode] != nullptr;
+    }
+    static constexpr handler_t get_handler(u8 opcode) noexcept {
+        return (opcode < OpcodeSpace) ? Table[opcode] : nullptr;
+    }
+
+    static void dispatch(const PacketT& pkt) noexcept {
+        const handler_t fn = get_handler(pkt.opcode);
+        if constexpr (CountHits) {
+            ++hits_[(fn != nullptr) ? pkt.opcode : OpcodeSpace];
+        }
+        if (fn != nullptr) { fn(pkt); return; }
+        if constexpr (Unknown != nullptr) { Unknown(pkt); }
+    }
+
+    [[nodiscard]] static u32 hits(u8 opcode) noexcept {
+        if constexpr (CountHits) { return (opcode < OpcodeSpace) ? hits_[opcode] : 0U; }
+        else { (void)opcode; return 0U; }
+    }
+    [[nodiscard]] static u32 unknown_hits() noexcept {
+        if constexpr (CountHits) { return hits_[OpcodeSpace]; }
+        else { return 0U; }
+    }
+    static void reset_hits() noexcept {
+        if constexpr (CountHits) { hits_.fill(0U); }
+    }
+
+private:
+    static inline etl::array<u32, CountHits ? OpcodeSpace + 1 : 1> hits_{};
+};
+
 } // namespace emCore::protocol
@@ -9,6 +9,7 @@
 #include <emCore/protocol/command_dispatcher.hpp>
 #include <etl/array.h>
 #include <cstddef>
+#include <cstring>
 
 // Forward declare packet template
 namespace emCore::protocol {
@@ -65,7 +66,7 @@ public:
     
     // Set field definitions for a specific opcode
     bool set_field_layout(u8 opcode, const field_def* fields, size_t field_count) noexcept {
-        if (field_count > MaxFields) {
+        if (field_count > MaxFields || opcode >= OpcodeSpace) {
             return false;
         }
         
@@ -79,7 +80,7 @@ public:
     // Decode packet data into structured format
     template<size_t MaxPayload>
     bool decode_fields(const packet<MaxPayload>& pkt, void* target_struct) noexcept {
-        if (layouts_[pkt.opcode].field_count == 0) {
+        if (pkt.opcode >= OpcodeSpace || layouts_[pkt.opcode].field_count == 0) {
             return false; // No layout defined for this opcode
         }
         
@@ -122,8 +123,10 @@ private:
                 if (offset + 1 >= data_len) {
                     return false;
                 }
-                *reinterpret_cast<u16*>(field_ptr) = 
-                    (static_cast<u16>(data[offset]) << 8) | data[offset + 1];
+                {
+                    const u16 value16 = static_cast<u16>((static_cast<u16>(data[offset]) << 8) | data[offset + 1]);
+                    std::memcpy(field_ptr, &value16, sizeof(value16));
+                }
                 offset += 2;
                 break;
                 
@@ -131,11 +134,13 @@ private:
                 if (offset + 3 >= data_len) {
                     return false;
                 }
-                *reinterpret_cast<u32*>(field_ptr) = 
-                    (static_cast<u32>(data[offset]) << 24) |
-                    (static_cast<u32>(data[offset + 1]) << 16) |
-                    (static_cast<u32>(data[offset + 2]) << 8) |
-                    data[offset + 3];
+                {
+                    const u32 value32 = (static_cast<u32>(data[offset]) << 24) |
+                                        (static_cast<u32>(data[offset + 1]) << 16) |
+                                        (static_cast<u32>(data[offset + 2]) << 8) |
+                                        data[offset + 3];
+                    std::memcpy(field_ptr, &value32, sizeof(value32));
+                }
                 offset += 4;
                 break;
                 
@@ -144,9 +149,13 @@ private:
                     return false;
                 }
                 // Store pointer to array start
-                *reinterpret_cast<const u8**>(field_ptr) = &data[offset];
-                // Store length in next field (assumed to be size_t)
-                *reinterpret_cast<size_t*>(field_ptr + sizeof(const u8*)) = data_len - offset;
+                {
+                    const u8* array_start = &data[offset];
+                    std::memcpy(field_ptr, &array_start, sizeof(array_start));
+                    // Store length in next field (assumed to be size_t)
+                    const size_t array_len = data_len - offset;
+                    std::memcpy(field_ptr + sizeof(const u8*), &array_len, sizeof(array_len));
+                }
                 offset = data_len; // Consume rest of packet
                 break;
         }
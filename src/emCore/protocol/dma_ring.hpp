@@ -0,0 +1,158 @@
+#pragma once
+
+// DMA-fed byte ring: the ring storage is the DMA target buffer itself
+// - Peripheral writes bytes in circular mode; no CPU per byte on receive
+// - HT / TC / idle-line interrupts only publish the new write position
+// - Consumer side matches spsc_byte_ring, so packet_pipeline parses in place
+
+#include <etl/array.h>
+#include <etl/atomic.h>
+#include <etl/span.h>
+#include <emCore/core/types.hpp>
+#include <cstring>
+
+namespace emCore::protocol {
+
+/*
+ * Hand dma_buffer()/capacity() to the peripheral's circular DMA, then call
+ * on_dma_event(pos) from the half-transfer, transfer-complete and idle-line
+ * interrupts with the DMA write offset (0..Capacity). With the STM32 HAL,
+ * HAL_UARTEx_RxEventCallback(huart, size) delivers that offset as size; see
+ * impl_stm32::uart_dma_rx_start(). Drivers that copy into the ring instead
+ * (ESP-IDF UART) use write_span()/commit().
+ *
+ * Events must arrive at least twice per lap (HT + TC guarantee this). If the
+ * producer laps the consumer the unread bytes are lost; the consumer skips to
+ * the write position and overruns() counts the event. On cores with a data
+ * cache use BufferAlign = 32 and invalidate with impl_stm32::dma_rx_invalidate().
+ */
+template <size_t Capacity, size_t BufferAlign = 8>
+class dma_byte_ring {
+public:
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "dma_byte_ring capacity must be a power of two");
+    static_assert(Capacity <= 0x10000UL, "dma_byte_ring capacity must fit a 16-bit DMA counter");
+
+    constexpr dma_byte_ring() = default;
+    dma_byte_ring(const dma_byte_ring&) = delete;
+    dma_byte_ring& operator=(const dma_byte_ring&) = delete;
+    dma_byte_ring(dma_byte_ring&&) = delete;
+    dma_byte_ring& operator=(dma_byte_ring&&) = delete;
+
+    // Restart at offset 0 (call with DMA stopped, before re-arming it)
+    inline void reset() noexcept {
+        head_.store(0, etl::memory_order_relaxed);
+        tail_.store(0, etl::memory_order_relaxed);
+        dma_pos_ = 0;
+    }
+
+    /* DMA target */
+    inline u8* dma_buffer() noexcept { return buf_.data(); }
+    static constexpr size_t capacity() noexcept { return Capacity; }
+
+    /* Producer side (ISR): DMA has written up to offset pos */
+    inline void on_dma_event(size_t pos) noexcept {
+        const u32 offset = static_cast<u32>(pos) & mask;
+        const u32 delta = (offset - dma_pos_) & mask;
+        dma_pos_ = offset;
+        if (delta != 0U) {
+            head_.store(head_.load(etl::memory_order_relaxed) + delta, etl::memory_order_release);
+        }
+    }
+
+    /* Producer side for copy-based drivers: free region at the write position */
+    inline etl::span<u8> write_span() noexcept {
+        const u32 head = head_.load(etl::memory_order_relaxed);
+        const size_t used = static_cast<size_t>(head - tail_.load(etl::memory_order_acquire));
+        const size_t space = (used < Capacity) ? (Capacity - used) : 0U;
+        const size_t offset = head & mask;
+        const size_t run = ((Capacity - offset) < space) ? (Capacity - offset) : space;
+        return etl::span<u8>(&buf_[offset], run);
+    }
+
+    // Advance by n directly: a full-capacity write is a whole lap, which on_dma_event() would read as no progress
+    inline void commit(size_t n) noexcept {
+        if (n == 0U) { return; }
+        dma_pos_ = (dma_pos_ + static_cast<u32>(n)) & mask;
+        head_.store(head_.load(etl::memory_order_relaxed) + static_cast<u32>(n), etl::memory_order_release);
+    }
+
+    // Copy-in producer (loopback, tests, non-DMA fallback); never mix with a running DMA
+    inline size_t push_n(const u8* data, size_t len) noexcept {
+        size_t stored = 0;
+        while (stored < len) {
+            const auto span = write_span();
+            if (span.empty()) { break; }
+            const size_t run = (span.size() < (len - stored)) ? span.size() : (len - stored);
+            std::memcpy(span.data(), data + stored, run);
+            commit(run);
+            stored += run;
+        }
+        return stored;
+    }
+
+    inline bool push(u8 b) noexcept { return push_n(&b, 1) == 1U; }
+
+    /* Consumer side */
+    inline etl::span<const u8> read_span() noexcept {
+        const u32 tail = resync();
+        const size_t avail = static_cast<size_t>(head_.load(etl::memory_order_acquire) - tail);
+        const size_t offset = tail & mask;
+        const size_t run = ((Capacity - offset) < avail) ? (Capacity - offset) : avail;
+        return etl::span<const u8>(&buf_[offset], run);
+    }
+
+    inline void consume(size_t n) noexcept {
+        tail_.store(tail_.load(etl::memory_order_relaxed) + static_cast<u32>(n), etl::memory_order_release);
+    }
+
+    inline bool pop(u8& out) noexcept {
+        const u32 tail = resync();
+        if (tail == head_.load(etl::memory_order_acquire)) { return false; }
+        out = buf_[tail & mask];
+        tail_.store(tail + 1U, etl::memory_order_release);
+        return true;
+    }
+
+    inline size_t pop_n(u8* dst, size_t max) noexcept {
+        size_t count = 0;
+        while (count < max) {
+            const auto span = read_span();
+            if (span.empty()) { break; }
+            const size_t run = (span.size() < (max - count)) ? span.size() : (max - count);
+            std::memcpy(dst + count, span.data(), run);
+            consume(run);
+            count += run;
+        }
+        return count;
+    }
+
+    // State (snapshots; may exceed capacity() until the consumer resyncs after an overrun)
+    inline size_t size() const noexcept {
+        return static_cast<size_t>(head_.load(etl::memory_order_acquire) - tail_.load(etl::memory_order_acquire));
+    }
+    inline bool empty() const noexcept { return size() == 0U; }
+    [[nodiscard]] inline u32 overruns() const noexcept { return overruns_; }
+
+private:
+    static constexpr u32 mask = static_cast<u32>(Capacity - 1);
+
+    // Consumer: drop everything if the writer lapped us
+    inline u32 resync() noexcept {
+        u32 tail = tail_.load(etl::memory_order_relaxed);
+        const u32 head = head_.load(etl::memory_order_acquire);
+        if ((head - tail) > Capacity) {
+            tail = head;
+            tail_.store(tail, etl::memory_order_release);
+            ++overruns_;
+        }
+        return tail;
+    }
+
+    alignas(BufferAlign) etl::array<u8, Capacity> buf_{};
+    etl::atomic<u32> head_{0};   // bytes written by DMA (free-running)
+    etl::atomic<u32> tail_{0};   // bytes consumed (free-running)
+    u32 dma_pos_{0};             // last DMA offset seen; producer only
+    u32 overruns_{0};            // consumer only
+};
+
+} // namespace emCore::protocol
@@ -8,8 +8,11 @@
 
 #include <emCore/core/types.hpp>
 #include <etl/array.h>
+#include <etl/span.h>
 #include <cstddef>
+#include <cstring>
 #include "decoder.hpp" // reuse FieldType and field_def
+#include "fletcher16.hpp"
 
 namespace emCore::protocol {
 
@@ -25,6 +28,67 @@ enum class encode_state : u8 {
     ENCODE_COMPLETE
 };
 
+// Frame an already-encoded payload: sync, opcode, length, payload, Fletcher-16.
+// Used by the generated compile-time codecs; fails if len does not fit the length field.
+template <typename PacketConfig, typename OutputFunc>
+bool write_frame(u8 opcode, const u8* payload, size_t len, OutputFunc out) noexcept {
+    if (len > (PacketConfig::PACKET_LENGTH_16BIT ? 0xFFFFU : 0xFFU)) { return false; }
+    fletcher16_accum acc{};
+    for (size_t i = 0; i < PacketConfig::PACKET_SYNC_LEN; ++i) {
+        out(PacketConfig::PACKET_SYNC[i]);
+    }
+    out(opcode);
+    acc.add(opcode);
+    if (PacketConfig::PACKET_LENGTH_16BIT) {
+        out(static_cast<u8>(len >> 8));
+        acc.add(static_cast<u8>(len >> 8));
+    }
+    out(static_cast<u8>(len & 0xFF));
+    acc.add(static_cast<u8>(len & 0xFF));
+    if (len != 0U) {
+        acc.add(payload, len);
+        for (size_t i = 0; i < len; ++i) { out(payload[i]); }
+    }
+    const u16 checksum = acc.value();
+    out(static_cast<u8>(checksum >> 8));
+    out(static_cast<u8>(checksum & 0xFF));
+    return true;
+}
+
+// Bytes in front of the payload (sync + opcode + length) and total frame size
+template <typename PacketConfig>
+constexpr size_t frame_header_size() noexcept {
+    return PacketConfig::PACKET_SYNC_LEN + 1U + (PacketConfig::PACKET_LENGTH_16BIT ? 2U : 1U);
+}
+template <typename PacketConfig>
+constexpr size_t frame_size(size_t payload_len) noexcept {
+    return frame_header_size<PacketConfig>() + payload_len + 2U;
+}
+
+// Complete a frame whose payload already sits at buf + frame_header_size():
+// writes sync, opcode, length and the trailing checksum in place.
+// Returns the frame size, or 0 if it does not fit cap or the length field.
+template <typename PacketConfig>
+size_t finish_frame(u8 opcode, size_t payload_len, u8* buf, size_t cap) noexcept {
+    constexpr size_t header = frame_header_size<PacketConfig>();
+    if (payload_len > (PacketConfig::PACKET_LENGTH_16BIT ? 0xFFFFU : 0xFFU) ||
+        buf == nullptr || frame_size<PacketConfig>(payload_len) > cap) {
+        return 0;
+    }
+    std::memcpy(buf, PacketConfig::PACKET_SYNC, PacketConfig::PACKET_SYNC_LEN);
+    u8* p = buf + PacketConfig::PACKET_SYNC_LEN;
+    *p++ = opcode;
+    if (PacketConfig::PACKET_LENGTH_16BIT) { *p++ = static_cast<u8>(payload_len >> 8); }
+    *p = static_cast<u8>(payload_len & 0xFF);
+    // opcode, length and payload are contiguous: one bulk checksum pass
+    fletcher16_accum acc{};
+    acc.add(buf + PacketConfig::PACKET_SYNC_LEN, header - PacketConfig::PACKET_SYNC_LEN + payload_len);
+    const u16 checksum = acc.value();
+    buf[header + payload_len] = static_cast<u8>(checksum >> 8);
+    buf[header + payload_len + 1U] = static_cast<u8>(checksum & 0xFF);
+    return header + payload_len + 2U;
+}
+
 // Field encoder state machine for automatic structured data serialization
 // MaxFields defines max fields per opcode layout
 template <size_t MaxFields, size_t OpcodeSpace = 256>
@@ -38,7 +102,7 @@ public:
 
     // Register field layout for an opcode (same shape as decoder)
     bool set_field_layout(u8 opcode, const field_def* fields, size_t field_count) noexcept {
-        if (field_count > MaxFields) { return false; }
+        if (field_count > MaxFields || opcode >= OpcodeSpace) { return false; }
         auto& layout_entry = layouts_[opcode];
         layout_entry.field_count = field_count;
         for (size_t i = 0; i < field_count; ++i) {
@@ -50,6 +114,7 @@ public:
     // Synchronous encode helper using PacketConfig (must provide PACKET_SYNC, PACKET_SYNC_LEN, PACKET_LENGTH_16BIT)
     template <typename PacketConfig, typename OutputFunc>
     bool encode_command(u8 opcode, const void* source_struct, OutputFunc out) noexcept {
+        if (opcode >= OpcodeSpace) { return false; }
         const auto& layout = layouts_[opcode];
         if (layout.field_count == 0) { return false; }
 
@@ -92,7 +157,7 @@ public:
                     break;
                 }
                 case FieldType::U16: {
-                    u16 value16 = *reinterpret_cast<const u16*>(field_ptr);
+                    u16 value16 = 0; std::memcpy(&value16, field_ptr, sizeof(value16));
                     u8 high_byte = static_cast<u8>(value16 >> 8);
                     u8 low_byte = static_cast<u8>(value16 & 0xFF);
                     out(high_byte); chk_add(high_byte);
@@ -100,7 +165,7 @@ public:
                     break;
                 }
                 case FieldType::U32: {
-                    u32 value32 = *reinterpret_cast<const u32*>(field_ptr);
+                    u32 value32 = 0; std::memcpy(&value32, field_ptr, sizeof(value32));
                     u8 byte_0 = static_cast<u8>(value32 >> 24);
                     u8 byte_1 = static_cast<u8>(value32 >> 16);
                     u8 byte_2 = static_cast<u8>(value32 >> 8);
@@ -112,8 +177,8 @@ public:
                     break;
                 }
                 case FieldType::U8_ARRAY: {
-                    const u8* arr = *reinterpret_cast<const u8* const*>(field_ptr);
-                    size_t len = *reinterpret_cast<const size_t*>(field_ptr + sizeof(const u8*));
+                    const u8* arr = nullptr; std::memcpy(&arr, field_ptr, sizeof(arr));
+                    size_t len = 0; std::memcpy(&len, field_ptr + sizeof(const u8*), sizeof(len));
                     for (size_t i = 0; i < len; ++i) {
                         out(arr[i]);
                         chk_add(arr[i]);
@@ -130,8 +195,67 @@ public:
         return true;
     }
 
+    // Serialize a whole frame into buf in one pass over the layout (no per-byte
+    // callbacks). The payload is written first and the header is filled in
+    // afterwards, so the length needs no separate walk. Returns bytes written,
+    // or 0 if the opcode has no layout or the frame exceeds cap.
+    template <typename PacketConfig>
+    size_t encode_into(u8 opcode, const void* source_struct, u8* buf, size_t cap) noexcept {
+        constexpr size_t header = frame_header_size<PacketConfig>();
+        if (opcode >= OpcodeSpace || buf == nullptr || cap < frame_size<PacketConfig>(0)) { return 0; }
+        const auto& layout = layouts_[opcode];
+        if (layout.field_count == 0) { return 0; }
+
+        const u8* src = static_cast<const u8*>(source_struct);
+        u8* payload = buf + header;
+        const size_t room = cap - frame_size<PacketConfig>(0);
+        size_t len = 0;
+        for (size_t fi = 0; fi < layout.field_count; ++fi) {
+            const auto& field = layout.fields[fi];
+            const u8* field_ptr = src + field.offset;
+            switch (field.type) {
+                case FieldType::U8: {
+                    if (len + 1U > room) { return 0; }
+                    payload[len++] = *field_ptr;
+                    break;
+                }
+                case FieldType::U16: {
+                    if (len + 2U > room) { return 0; }
+                    u16 value16 = 0; std::memcpy(&value16, field_ptr, sizeof(value16));
+                    payload[len++] = static_cast<u8>(value16 >> 8);
+                    payload[len++] = static_cast<u8>(value16 & 0xFF);
+                    break;
+                }
+                case FieldType::U32: {
+                    if (len + 4U > room) { return 0; }
+                    u32 value32 = 0; std::memcpy(&value32, field_ptr, sizeof(value32));
+                    payload[len++] = static_cast<u8>(value32 >> 24);
+                    payload[len++] = static_cast<u8>(value32 >> 16);
+                    payload[len++] = static_cast<u8>(value32 >> 8);
+                    payload[len++] = static_cast<u8>(value32 & 0xFF);
+                    break;
+                }
+                case FieldType::U8_ARRAY: {
+                    const u8* arr = nullptr; std::memcpy(&arr, field_ptr, sizeof(arr));
+                    size_t arr_len = 0; std::memcpy(&arr_len, field_ptr + sizeof(const u8*), sizeof(arr_len));
+                    if (arr_len > room - len) { return 0; }
+                    if (arr_len != 0U) { std::memcpy(payload + len, arr, arr_len); }
+                    len += arr_len;
+                    break;
+                }
+            }
+        }
+        return finish_frame<PacketConfig>(opcode, len, buf, cap);
+    }
+
+    template <typename PacketConfig>
+    size_t encode_into(u8 opcode, const void* source_struct, etl::span<u8> out) noexcept {
+        return encode_into<PacketConfig>(opcode, source_struct, out.data(), out.size());
+    }
+
     // Start stateful encoding (for streaming)
     bool start_encode(u8 opcode, const void* source_struct) noexcept {
+        if (opcode >= OpcodeSpace) { return false; }
         current_opcode_ = opcode;
         source_struct_ = source_struct;
         payload_length_ = calculate_payload_length(opcode, source_struct);
@@ -219,6 +343,7 @@ private:
 
     // Compute total payload length from field layout and source struct
     u16 calculate_payload_length(u8 opcode, const void* source_struct) const noexcept {
+        if (opcode >= OpcodeSpace) { return 0; }
         const auto& layout = layouts_[opcode];
         const u8* src = static_cast<const u8*>(source_struct);
         u16 total = 0;
@@ -229,7 +354,7 @@ private:
                 case FieldType::U16: total += 2; break;
                 case FieldType::U32: total += 4; break;
                 case FieldType::U8_ARRAY: {
-                    const size_t len = *reinterpret_cast<const size_t*>(src + f.offset + sizeof(const u8*));
+                    size_t len = 0; std::memcpy(&len, src + f.offset + sizeof(const u8*), sizeof(len));
                     total += static_cast<u16>(len);
                     break;
                 }
@@ -240,6 +365,7 @@ private:
 
     // Step-wise payload emission, updates checksum sums
     bool encode_payload_step_inline(u8& out_byte) noexcept {
+        if (current_opcode_ >= OpcodeSpace) { return false; }
         const auto& layout = layouts_[current_opcode_];
         if (field_index_ >= layout.field_count) { return false; }
         const auto& field = layout.fields[field_index_];
@@ -253,7 +379,7 @@ private:
                 return true;
             }
             case FieldType::U16: {
-                const u16 value16 = *reinterpret_cast<const u16*>(field_ptr);
+                u16 value16 = 0; std::memcpy(&value16, field_ptr, sizeof(value16));
                 if (byte_index_ == 0) {
                     out_byte = static_cast<u8>(value16 >> 8);
                     byte_index_ = 1;
@@ -266,7 +392,7 @@ private:
                 return true;
             }
             case FieldType::U32: {
-                const u32 value32 = *reinterpret_cast<const u32*>(field_ptr);
+                u32 value32 = 0; std::memcpy(&value32, field_ptr, sizeof(value32));
                 switch (byte_index_) {
                     case 0: out_byte = static_cast<u8>(value32 >> 24); byte_index_ = 1; break;
                     case 1: out_byte = static_cast<u8>(value32 >> 16); byte_index_ = 2; break;
@@ -277,8 +403,8 @@ private:
                 return true;
             }
             case FieldType::U8_ARRAY: {
-                const u8* arr = *reinterpret_cast<const u8* const*>(field_ptr);
-                const size_t len = *reinterpret_cast<const size_t*>(field_ptr + sizeof(const u8*));
+                const u8* arr = nullptr; std::memcpy(&arr, field_ptr, sizeof(arr));
+                size_t len = 0; std::memcpy(&len, field_ptr + sizeof(const u8*), sizeof(len));
                 if (byte_index_ < len) {
                     out_byte = arr[byte_index_++];
                     chk_add_inline(out_byte);
@@ -0,0 +1,37 @@
+#pragma once
+
+// emCore field codec primitives for generated compile-time codecs
+// - Big-endian loads/stores as plain byte shifts (no aliasing, no alignment needs)
+// - Used by the per-opcode codecs emitted by scripts/generate_packet_config.py
+//   and scripts/generate_command_table.py; header-only, constexpr
+
+#include <emCore/core/types.hpp>
+#include <cstddef>
+
+namespace emCore::protocol::codec {
+
+constexpr u16 load_be16(const u8* p) noexcept {
+    return static_cast<u16>((static_cast<u16>(p[0]) << 8) | p[1]);
+}
+
+constexpr u32 load_be32(const u8* p) noexcept {
+    return (static_cast<u32>(p[0]) << 24) | (static_cast<u32>(p[1]) << 16) |
+           (static_cast<u32>(p[2]) << 8) | static_cast<u32>(p[3]);
+}
+
+constexpr void store_be16(u8* p, u16 v) noexcept {
+    p[0] = static_cast<u8>(v >> 8);
+    p[1] = static_cast<u8>(v);
+}
+
+constexpr void store_be32(u8* p, u32 v) noexcept {
+    p[0] = static_cast<u8>(v >> 24);
+    p[1] = static_cast<u8>(v >> 16);
+    p[2] = static_cast<u8>(v >> 8);
+    p[3] = static_cast<u8>(v);
+}
+
+// Returned by generated encode_*() when the output buffer is too small
+inline constexpr size_t encode_error = static_cast<size_t>(-1);
+
+} // namespace emCore::protocol::codec
@@ -1,18 +1,94 @@
 #pragma once
 
 #include <emCore/core/types.hpp>
+#include <emCore/core/config.hpp>
+
+#include <type_traits>
+
+#if EMCORE_PROTOCOL_SIMD_CHECKSUM && defined(__SSSE3__)
+#include <tmmintrin.h>
+#define EMCORE_FLETCHER16_SSSE3 1
+#endif
 
 namespace emCore::protocol {
 
+namespace detail {
+
+// Bytes that can be summed without reduction: starting from sums < 255, sum2
+// stays below 2^32 for up to 5802 bytes; a power of two keeps the SIMD loop even.
+inline constexpr size_t fletcher16_block = 4096;
+
+// Unreduced sums over one block (n <= fletcher16_block)
+constexpr void fletcher16_sum_scalar(u32& sum1, u32& sum2, const u8* data, size_t n) noexcept {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const u32 a = data[i];
+        const u32 b = data[i + 1];
+        const u32 c = data[i + 2];
+        const u32 d = data[i + 3];
+        sum2 += 4U * sum1 + 4U * a + 3U * b + 2U * c + d;
+        sum1 += a + b + c + d;
+    }
+    for (; i < n; ++i) {
+        sum1 += data[i];
+        sum2 += sum1;
+    }
+}
+
+#ifdef EMCORE_FLETCHER16_SSSE3
+// 16 bytes per step: sum1 via SAD, sum2 via byte weights 16..1 plus 16 * running sum1
+inline void fletcher16_sum_ssse3(u32& sum1, u32& sum2, const u8* data, size_t n) noexcept {
+    const size_t chunks = n / 16U;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(1);
+    const __m128i weights = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+    __m128i v_sum1 = zero;    // bytes summed so far (two u64 lanes)
+    __m128i v_prefix = zero;  // sum of v_sum1 before each chunk
+    __m128i v_sum2 = zero;    // weighted bytes (four i32 lanes)
+    for (size_t c = 0; c < chunks; ++c) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + c * 16U));
+        v_prefix = _mm_add_epi64(v_prefix, v_sum1);
+        v_sum1 = _mm_add_epi64(v_sum1, _mm_sad_epu8(v, zero));
+        v_sum2 = _mm_add_epi32(v_sum2, _mm_madd_epi16(_mm_maddubs_epi16(v, weights), ones));
+    }
+    const u32 bytes = static_cast<u32>(_mm_cvtsi128_si32(v_sum1) + _mm_cvtsi128_si32(_mm_srli_si128(v_sum1, 8)));
+    const u32 prefix = static_cast<u32>(_mm_cvtsi128_si32(v_prefix) + _mm_cvtsi128_si32(_mm_srli_si128(v_prefix, 8)));
+    v_sum2 = _mm_add_epi32(v_sum2, _mm_srli_si128(v_sum2, 8));
+    v_sum2 = _mm_add_epi32(v_sum2, _mm_srli_si128(v_sum2, 4));
+    sum2 += 16U * static_cast<u32>(chunks) * sum1 + 16U * prefix + static_cast<u32>(_mm_cvtsi128_si32(v_sum2));
+    sum1 += bytes;
+    fletcher16_sum_scalar(sum1, sum2, data + chunks * 16U, n - chunks * 16U);
+}
+#endif
+
+// Fold len bytes into reduced sums, reducing once per block
+constexpr void fletcher16_update(u32& sum1, u32& sum2, const u8* data, size_t len) noexcept {
+    while (len != 0U) {
+        const size_t n = (len < fletcher16_block) ? len : fletcher16_block;
+#ifdef EMCORE_FLETCHER16_SSSE3
+        if (!std::is_constant_evaluated() && n >= 32U) {
+            fletcher16_sum_ssse3(sum1, sum2, data, n);
+        } else {
+            fletcher16_sum_scalar(sum1, sum2, data, n);
+        }
+#else
+        fletcher16_sum_scalar(sum1, sum2, data, n);
+#endif
+        sum1 %= 255U;
+        sum2 %= 255U;
+        data += n;
+        len -= n;
+    }
+}
+
+} // namespace detail
+
 // Compute Fletcher-16 checksum (RFC 1146 variant for 8-bit data)
 // Returns 16-bit checksum: high byte first in typical wire format
 constexpr u16 fletcher16(const u8* data, size_t len) noexcept {
     u32 sum1 = 0;
     u32 sum2 = 0;
-    for (size_t i = 0; i < len; ++i) {
-        sum1 = (sum1 + data[i]) % 255U;
-        sum2 = (sum2 + sum1) % 255U;
-    }
+    detail::fletcher16_update(sum1, sum2, data, len);
     return static_cast<u16>((sum2 << 8) | sum1);
 }
 
@@ -22,9 +98,14 @@ struct fletcher16_accum {
     u32 sum2{0};
     inline void reset() noexcept { sum1 = 0; sum2 = 0; }
     inline void add(u8 b) noexcept {
-        sum1 = (sum1 + b) % 255U;
-        sum2 = (sum2 + sum1) % 255U;
+        // sums stay in [0, 254], so one conditional subtract replaces % 255
+        sum1 += b;
+        if (sum1 >= 255U) { sum1 -= 255U; }
+        sum2 += sum1;
+        if (sum2 >= 255U) { sum2 -= 255U; }
     }
+    // Bulk add with deferred reduction; same result as add(b) per byte
+    inline void add(const u8* data, size_t len) noexcept { detail::fletcher16_update(sum1, sum2, data, len); }
     inline u16 value() const noexcept { return static_cast<u16>((sum2 << 8) | sum1); }
 };
 
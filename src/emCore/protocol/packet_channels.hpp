@@ -0,0 +1,142 @@
+#pragma once
+
+// Multi-channel packet runtime: N (ring, parser, pipeline) sets, one shared dispatcher
+// - One channel per link (UART, USB-CDC, BLE, ...), all speaking the same command set
+// - service() visits channels round-robin under a per-channel byte budget and an
+//   overall time budget, so a flood on one link cannot starve the others
+// - Handlers learn the originating link via current_channel() and answer through reply()
+// - Header-only; no RTTI, no dynamic allocation
+
+#include <emCore/core/types.hpp>
+#include <emCore/os/time.hpp>
+#include <emCore/protocol/packet_pipeline.hpp>
+#include <etl/array.h>
+#include <new>
+
+namespace emCore::protocol {
+
+// Reply sink for a channel: queue an already-framed reply (e.g. packet_tx_pipeline::submit_frame)
+using channel_reply_t = bool (*)(void* ctx, const u8* frame, size_t len) noexcept;
+
+struct channel_service_result {
+    size_t bytes{0};
+    size_t packets{0};
+    bool budget_exhausted{false};  // time budget hit before every channel was visited
+};
+
+template <size_t Channels, typename RingT, typename ParserT, typename DispatcherT, typename PacketT,
+          size_t ChunkSize = 32>
+class packet_channels {
+public:
+    static_assert(Channels >= 1 && Channels <= 255, "Channels must be in [1, 255]");
+
+    using pipeline_t = packet_pipeline<RingT, ParserT, DispatcherT, PacketT, ChunkSize>;
+    static constexpr u8 no_channel = 0xFF;
+
+    explicit packet_channels(DispatcherT& dispatcher) noexcept : dispatcher_(dispatcher) {
+        for (size_t i = 0; i < Channels; ++i) {
+            ::new (pipeline_ptr(i)) pipeline_t(rings_[i], parsers_[i], dispatcher_);
+        }
+    }
+    ~packet_channels() noexcept {
+        for (size_t i = 0; i < Channels; ++i) { pipeline_ptr(i)->~pipeline_t(); }
+    }
+    packet_channels(const packet_channels&) = delete;
+    packet_channels& operator=(const packet_channels&) = delete;
+    packet_channels(packet_channels&&) = delete;
+    packet_channels& operator=(packet_channels&&) = delete;
+
+    static constexpr size_t size() noexcept { return Channels; }
+
+    RingT& ring(size_t ch) noexcept { return rings_[ch]; }
+    ParserT& parser(size_t ch) noexcept { return parsers_[ch]; }
+    pipeline_t& pipeline(size_t ch) noexcept { return *pipeline_ptr(ch); }
+    DispatcherT& dispatcher() noexcept { return dispatcher_; }
+
+    // Driver-side ingest for one link
+    bool feed_byte(size_t ch, u8 byte) noexcept { return (ch < Channels) && pipeline(ch).feed_byte(byte); }
+    size_t feed_bytes(size_t ch, const u8* data, size_t len) noexcept {
+        return (ch < Channels) ? pipeline(ch).feed_bytes(data, len) : 0U;
+    }
+
+    // Per-channel byte budget per pass (0 = use the default passed to service())
+    void set_budget(size_t ch, size_t bytes) noexcept {
+        if (ch < Channels) { budgets_[ch] = bytes; }
+    }
+
+    void set_reply_sink(size_t ch, channel_reply_t fn, void* ctx) noexcept {
+        if (ch < Channels) { replies_[ch] = reply_sink{fn, ctx}; }
+    }
+
+    /*
+     * One round-robin pass: each channel drains up to its byte budget. When
+     * time_budget_us is non-zero the pass stops once it is spent, and the next
+     * pass starts at the first channel that was not served.
+     */
+    channel_service_result service(size_t default_budget, u32 time_budget_us = 0) noexcept {
+        channel_service_result out{};
+        const timestamp_t start = (time_budget_us != 0U) ? os::time_us() : 0U;
+        size_t ch = next_;
+        for (size_t visited = 0; visited < Channels; ++visited) {
+            if (time_budget_us != 0U && visited != 0U &&
+                (os::time_us() - start) >= static_cast<timestamp_t>(time_budget_us)) {
+                out.budget_exhausted = true;
+                break;
+            }
+            const size_t budget = (budgets_[ch] != 0U) ? budgets_[ch] : default_budget;
+            size_t packets = 0;
+            current_ = static_cast<u8>(ch);
+            const size_t bytes = pipeline(ch).process_bytes(budget, packets);
+            current_ = no_channel;
+            stats_[ch].bytes += static_cast<u32>(bytes);
+            stats_[ch].packets += static_cast<u32>(packets);
+            if (bytes >= budget && budget != 0U) { ++stats_[ch].throttled; }
+            out.bytes += bytes;
+            out.packets += packets;
+            ch = (ch + 1U) % Channels;
+        }
+        next_ = ch;
+        return out;
+    }
+
+    // Channel whose packet is being dispatched (no_channel outside service())
+    [[nodiscard]] u8 current_channel() const noexcept { return current_; }
+
+    // Answer on the originating channel from inside a handler
+    bool reply(const u8* frame, size_t len) noexcept { return reply_on(current_, frame, len); }
+    bool reply_on(size_t ch, const u8* frame, size_t len) noexcept {
+        if (ch >= Channels || replies_[ch].fn == nullptr) { return false; }
+        return replies_[ch].fn(replies_[ch].ctx, frame, len);
+    }
+
+    struct channel_stats {
+        u32 bytes{0};
+        u32 packets{0};
+        u32 throttled{0};  // passes that ended on the byte budget with data possibly left
+    };
+    [[nodiscard]] channel_stats stats(size_t ch) const noexcept {
+        return (ch < Channels) ? stats_[ch] : channel_stats{};
+    }
+
+private:
+    struct reply_sink {
+        channel_reply_t fn{nullptr};
+        void* ctx{nullptr};
+    };
+
+    pipeline_t* pipeline_ptr(size_t ch) noexcept {
+        return std::launder(reinterpret_cast<pipeline_t*>(&pipelines_[ch * sizeof(pipeline_t)]));
+    }
+
+    DispatcherT& dispatcher_;
+    etl::array<RingT, Channels> rings_{};
+    etl::array<ParserT, Channels> parsers_{};
+    alignas(pipeline_t) u8 pipelines_[Channels * sizeof(pipeline_t)]{};
+    etl::array<size_t, Channels> budgets_{};
+    etl::array<reply_sink, Channels> replies_{};
+    etl::array<channel_stats, Channels> stats_{};
+    size_t next_{0};
+    u8 current_{no_channel};
+};
+
+} // namespace emCore::protocol
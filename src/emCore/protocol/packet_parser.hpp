@@ -12,6 +12,7 @@
 #include <emCore/protocol/fletcher16.hpp>
 #include <emCore/protocol/command_dispatcher.hpp>
 #include <cstddef>
+#include <cstring>
 
 namespace emCore::protocol {
 
@@ -23,6 +24,12 @@ enum class parser_error : u8 {
     checksum_mismatch,
 };
 
+// Outcome of packet_parser::decode_block()
+struct decode_result {
+    size_t consumed{0};   // bytes taken from the span
+    size_t packets{0};    // validated packets reported to the callback
+};
+
 // Packet receive states (table-driven)
 enum class PacketRxState : u8 {
     SYNC = 0,
@@ -54,14 +61,18 @@ struct packet {
  *  - SyncLen: number of sync bytes in header
  *  - Length16Bit: if true, uses 2-byte big-endian length; else 1 byte
  *  - SyncPattern: compile-time sync pattern array reference
+ *  - Buffers: 1, or 2 to double-buffer so acquire_packet() can hold a packet
+ *    while the next one is parsed
  */
 
 template <size_t MaxPayload,
           size_t SyncLen,
           bool Length16Bit,
-          const u8 (&SyncPattern)[SyncLen]>
+          const u8 (&SyncPattern)[SyncLen],
+          size_t Buffers = 1>
 class packet_parser {
 public:
+    static_assert(Buffers == 1 || Buffers == 2, "packet_parser supports single or double buffering");
     using packet_t = packet<MaxPayload>;
 
     packet_parser() = default;
@@ -74,9 +85,9 @@ public:
     void reset() noexcept {
         state_ = PacketRxState::SYNC;
         sync_index_ = 0;
-        pkt_.length = 0;
+        parse_buf().length = 0;
         data_index_ = 0;
-        pkt_.checksum_rx = 0;
+        parse_buf().checksum_rx = 0;
         acc_.reset();
         error_ = parser_error::none;
         packet_ready_ = false;
@@ -93,17 +104,87 @@ public:
         return (this->*table_[static_cast<u8>(state_)])(data);
     }
 
+    /*
+     * Bulk decode: same state machine as decode(), but sync hunting uses memchr
+     * and DATA runs are copied in one go. on_packet(const packet_t&) is called
+     * for each validated packet while it is still in the parser, so no copy is
+     * made and has_packet() stays false afterwards. Stops early (consumed < len)
+     * once max_packets have been reported.
+     */
+    template <typename Fn>
+    decode_result decode_block(const u8* data, size_t len, Fn&& on_packet,
+                               size_t max_packets = static_cast<size_t>(-1)) noexcept {
+        decode_result res{};
+        size_t pos = 0;
+        while (pos < len && res.packets < max_packets) {
+            if (state_ >= PacketRxState::PACKET_STATE_END) {
+                reset();
+                error_ = parser_error::boundary_error;
+                continue;
+            }
+            if (state_ == PacketRxState::SYNC && sync_index_ == 0U) {
+                const void* hit = std::memchr(data + pos, SyncPattern[0], len - pos);
+                if (hit == nullptr) { pos = len; break; }
+                pos = static_cast<size_t>(static_cast<const u8*>(hit) - data);
+            }
+            if (state_ == PacketRxState::DATA) {
+                const size_t want = static_cast<size_t>(parse_buf().length - data_index_);
+                const size_t run = (want < (len - pos)) ? want : (len - pos);
+                std::memcpy(&parse_buf().data[data_index_], data + pos, run);
+                acc_.add(data + pos, run);
+                data_index_ = static_cast<u16>(data_index_ + run);
+                pos += run;
+                if (data_index_ >= parse_buf().length) {
+                    state_ = PacketRxState::CHECKSUM;
+                    chksum_bytes_read_ = 0;
+                }
+                continue;
+            }
+            in_block_ = true;
+            const bool done = (this->*table_[static_cast<u8>(state_)])(data[pos++]);
+            in_block_ = false;
+            if (done) {
+                // Dispatched synchronously from the parse buffer; no hand-off needed
+                on_packet(static_cast<const packet_t&>(parse_buf()));
+                ++res.packets;
+            }
+        }
+        res.consumed = pos;
+        return res;
+    }
+
     // Check if a packet is ready after decode() returned true
     [[nodiscard]]  bool has_packet() const noexcept { return packet_ready_; }
 
-    // Copy out the packet and clear ready flag
+    // Copy out the packet (valid bytes only) and clear ready flag
     bool get_packet(packet_t& out) noexcept {
         if (!packet_ready_) { return false; }
-        out = pkt_;
+        const packet_t& ready = bufs_[ready_];
+        out.opcode = ready.opcode;
+        out.length = ready.length;
+        out.checksum_rx = ready.checksum_rx;
+        std::memcpy(out.data.data(), ready.data.data(), ready.length);
         packet_ready_ = false;
         return true;
     }
 
+    /*
+     * Zero-copy hand-off: borrow the ready packet in place. With Buffers == 2
+     * parsing continues into the other buffer until release_packet(); packets
+     * completing while one is still held are dropped (dropped_packets()). With
+     * Buffers == 1 the packet is only valid until the next decode call.
+     */
+    const packet_t* acquire_packet() noexcept {
+        if (!packet_ready_) { return nullptr; }
+        packet_ready_ = false;
+        held_ = (Buffers > 1);
+        return &bufs_[ready_];
+    }
+
+    void release_packet() noexcept { held_ = false; }
+
+    [[nodiscard]] u32 dropped_packets() const noexcept { return dropped_; }
+
     [[nodiscard]]  parser_error last_error() const noexcept { return error_; }
 
 private:
@@ -126,11 +207,11 @@ private:
     }
 
     bool on_opcode(u8 b) noexcept {
-        pkt_.opcode = b;
+        parse_buf().opcode = b;
         acc_.add(b);
         state_ = PacketRxState::DATA_LENGTH;
         len_bytes_read_ = 0;
-        pkt_.length = 0;
+        parse_buf().length = 0;
         return false;
     }
 
@@ -138,15 +219,15 @@ private:
         if constexpr (Length16Bit) {
             // big-endian length
             if (len_bytes_read_ == 0) {
-                pkt_.length = static_cast<u16>(b) << 8;
+                parse_buf().length = static_cast<u16>(b) << 8;
                 acc_.add(b);
                 len_bytes_read_ = 1;
             } else {
-                pkt_.length |= b;
+                parse_buf().length |= b;
                 acc_.add(b);
                 // validate length
-                if (pkt_.length > MaxPayload) { reset(); error_ = parser_error::length_overflow; return false; }
-                if (pkt_.length == 0) { // allow empty payload
+                if (parse_buf().length > MaxPayload) { reset(); error_ = parser_error::length_overflow; return false; }
+                if (parse_buf().length == 0) { // allow empty payload
                     state_ = PacketRxState::CHECKSUM;
                     chksum_bytes_read_ = 0;
                 } else {
@@ -155,10 +236,10 @@ private:
                 }
             }
         } else {
-            pkt_.length = b;
+            parse_buf().length = b;
             acc_.add(b);
-            if (pkt_.length > MaxPayload) { reset(); error_ = parser_error::length_overflow; return false; }
-            state_ = (pkt_.length == 0) ? PacketRxState::CHECKSUM : PacketRxState::DATA;
+            if (parse_buf().length > MaxPayload) { reset(); error_ = parser_error::length_overflow; return false; }
+            state_ = (parse_buf().length == 0) ? PacketRxState::CHECKSUM : PacketRxState::DATA;
             if (state_ == PacketRxState::CHECKSUM) { chksum_bytes_read_ = 0; }
             else { data_index_ = 0; }
         }
@@ -167,10 +248,10 @@ private:
 
     bool on_data(u8 b) noexcept {
         // store and accumulate
-        pkt_.data[data_index_] = b;
+        parse_buf().data[data_index_] = b;
         acc_.add(b);
         ++data_index_;
-        if (data_index_ >= pkt_.length) {
+        if (data_index_ >= parse_buf().length) {
             // move to checksum
             state_ = PacketRxState::CHECKSUM;
             chksum_bytes_read_ = 0;
@@ -181,20 +262,19 @@ private:
     bool on_checksum(u8 b) noexcept {
         // two bytes, big-endian
         if (chksum_bytes_read_ == 0) {
-            pkt_.checksum_rx = static_cast<u16>(b) << 8;
+            parse_buf().checksum_rx = static_cast<u16>(b) << 8;
             chksum_bytes_read_ = 1;
         } else {
-            pkt_.checksum_rx |= b;
+            parse_buf().checksum_rx |= b;
             // validate
             const u16 calc = acc_.value();
-            if (calc == pkt_.checksum_rx) {
-                packet_ready_ = true;
+            if (calc == parse_buf().checksum_rx) {
                 // next packet
                 state_ = PacketRxState::SYNC;
                 acc_.reset();
                 data_index_ = 0;
                 error_ = parser_error::none;
-                return true;
+                return publish_packet();
             } else {
                 reset();
                 error_ = parser_error::checksum_mismatch;
@@ -203,6 +283,18 @@ private:
         return false;
     }
 
+    // Make the parse buffer the ready one (flipping buffers when double-buffered)
+    bool publish_packet() noexcept {
+        if (in_block_) { return true; }
+        if (held_) { ++dropped_; return false; }
+        ready_ = parse_;
+        parse_ = static_cast<u8>((parse_ + 1U) % Buffers);
+        packet_ready_ = true;
+        return true;
+    }
+
+    packet_t& parse_buf() noexcept { return bufs_[parse_]; }
+
     // FSM table
     using state_fn_t = bool (packet_parser::*)(u8);
     static constexpr etl::array<state_fn_t, static_cast<size_t>(PacketRxState::PACKET_STATE_END)> table_ = {
@@ -225,9 +317,14 @@ private:
     u8 chksum_bytes_read_{0};
     u8 sync_index_{0};
 
-    // Accumulator and current packet
+    // Accumulator and packet buffers (parse_ is being filled, ready_ is handed out)
     fletcher16_accum acc_{};
-    packet_t pkt_{};
+    etl::array<packet_t, Buffers> bufs_{};
+    u8 parse_{0};
+    u8 ready_{0};
+    bool held_{false};
+    bool in_block_{false};
+    u32 dropped_{0};
 };
 
 
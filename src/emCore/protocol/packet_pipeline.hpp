@@ -6,22 +6,28 @@
 // - Header-only; no RTTI, no dynamic allocation
 
 #include <emCore/core/types.hpp>
+#include <etl/array.h>
 #include <etl/circular_buffer.h> // not used here but kept for future; current ring is custom
 #include <emCore/protocol/packet_parser.hpp>
 #include <emCore/protocol/byte_ring.hpp>
+#include <emCore/protocol/dma_ring.hpp>
 
 namespace emCore::protocol {
 
 // Generic pipeline that connects a byte ring with a packet parser and a dispatcher.
 // Template parameters:
-//  - RingT: provides push/pop/pop_n/empty
-//  - ParserT: provides decode(u8), has_packet(), get_packet(PacketT&)
+//  - RingT: provides push/pop/pop_n/empty; read_span/consume (spsc_byte_ring) are
+//    used instead of pop_n when present
+//  - ParserT: provides decode_block(data, len, fn, max_packets)
 //  - DispatcherT: provides dispatch(const PacketT&)
 //  - PacketT: packet type matching ParserT
+//  - ChunkSize: bytes moved out of the ring per decode_block() call
 
-template <typename RingT, typename ParserT, typename DispatcherT, typename PacketT>
+template <typename RingT, typename ParserT, typename DispatcherT, typename PacketT, size_t ChunkSize = 32>
 class packet_pipeline {
 public:
+    static_assert(ChunkSize > 0, "ChunkSize must be > 0");
+
     packet_pipeline(RingT& ring, ParserT& parser, DispatcherT& dispatcher) noexcept
         : ring_(ring), parser_(parser), dispatcher_(dispatcher) {}
     packet_pipeline(const packet_pipeline&) = delete;
@@ -35,21 +41,36 @@ public:
     // Feed a buffer to ring. Returns number of bytes stored.
     size_t feed_bytes(const u8* data, size_t len) noexcept { return ring_.push_n(data, len); }
 
+    // DMA ingest (dma_byte_ring): forward the DMA write offset from HT/TC/idle ISRs
+    void on_dma_event(size_t pos) noexcept { ring_.on_dma_event(pos); }
+
     // Process as many bytes as available; dispatch packets as they complete.
     // Returns number of packets dispatched.
     size_t process_available(size_t max_packets = static_cast<size_t>(-1)) noexcept {
         size_t packets = 0;
-        u8 byte = 0;
+        if constexpr (requires(RingT& ring) { ring.read_span(); ring.consume(size_t{}); }) {
+            // Ring exposes its storage: parse in place, unconsumed bytes stay queued
+            while (packets < max_packets) {
+                const auto span = ring_.read_span();
+                if (span.empty()) { break; }
+                const decode_result res = parser_.decode_block(span.data(), span.size(),
+                    [this](const PacketT& pkt) { dispatcher_.dispatch(pkt); }, max_packets - packets);
+                ring_.consume(res.consumed);
+                packets += res.packets;
+            }
+            return packets;
+        }
         while (packets < max_packets) {
-            if (!ring_.pop(byte)) { break; }
-            const bool done = parser_.decode(byte);
-            if (done && parser_.has_packet()) {
-                PacketT pkt{};
-                if (parser_.get_packet(pkt)) {
-                    dispatcher_.dispatch(pkt);
-                    ++packets;
-                }
+            if (carry_pos_ == carry_len_) {
+                carry_len_ = ring_.pop_n(carry_.data(), ChunkSize);
+                carry_pos_ = 0;
+                if (carry_len_ == 0U) { break; }
             }
+            // Bytes left over when max_packets is hit stay in carry_ for the next call
+            const decode_result res = parser_.decode_block(&carry_[carry_pos_], carry_len_ - carry_pos_,
+                [this](const PacketT& pkt) { dispatcher_.dispatch(pkt); }, max_packets - packets);
+            carry_pos_ += res.consumed;
+            packets += res.packets;
         }
         return packets;
     }
@@ -58,17 +79,20 @@ public:
     size_t process_bytes(size_t max_bytes, size_t& packets_out) noexcept {
         size_t processed = 0;
         packets_out = 0;
-        u8 byte = 0;
-        while (processed < max_bytes && ring_.pop(byte)) {
-            ++processed;
-            const bool done = parser_.decode(byte);
-            if (done && parser_.has_packet()) {
-                PacketT pkt{};
-                if (parser_.get_packet(pkt)) {
-                    dispatcher_.dispatch(pkt);
-                    ++packets_out;
-                }
+        while (processed < max_bytes) {
+            if (carry_pos_ == carry_len_) {
+                const size_t want = ((max_bytes - processed) < ChunkSize) ? (max_bytes - processed) : ChunkSize;
+                carry_len_ = ring_.pop_n(carry_.data(), want);
+                carry_pos_ = 0;
+                if (carry_len_ == 0U) { break; }
             }
+            const size_t avail = carry_len_ - carry_pos_;
+            const size_t budget = max_bytes - processed;
+            const decode_result res = parser_.decode_block(&carry_[carry_pos_], (avail < budget) ? avail : budget,
+                [this](const PacketT& pkt) { dispatcher_.dispatch(pkt); });
+            carry_pos_ += res.consumed;
+            processed += res.consumed;
+            packets_out += res.packets;
         }
         return processed;
     }
@@ -77,6 +101,9 @@ private:
     RingT& ring_;
     ParserT& parser_;
     DispatcherT& dispatcher_;
+    etl::array<u8, ChunkSize> carry_{};
+    size_t carry_len_{0};
+    size_t carry_pos_{0};
 };
 
 } // namespace emCore::protocol
@@ -7,9 +7,11 @@
 #include <emCore/protocol/packet_parser.hpp>
 #include <emCore/protocol/packet_pipeline.hpp>
 #include <emCore/protocol/byte_ring.hpp>
+#include <emCore/protocol/dma_ring.hpp>
 #include <emCore/protocol/decoder.hpp>
 #include <emCore/protocol/encoder.hpp>
 #include <emCore/protocol/command_dispatcher.hpp>
+#include <emCore/protocol/packet_channels.hpp>
 #if EMCORE_ENABLE_PROTOCOL
 #include <emCore/protocol/protocol_global.hpp>
 #endif
@@ -33,6 +35,21 @@
 #ifndef EMCORE_PROTOCOL_RING_SIZE
 #define EMCORE_PROTOCOL_RING_SIZE 512
 #endif
+#ifndef EMCORE_PROTOCOL_DMA_RX
+#define EMCORE_PROTOCOL_DMA_RX 0
+#endif
+#ifndef EMCORE_PROTOCOL_CHANNELS
+#define EMCORE_PROTOCOL_CHANNELS 1
+#endif
+#ifndef EMCORE_PROTOCOL_RUNTIME_LAYOUTS
+#define EMCORE_PROTOCOL_RUNTIME_LAYOUTS 1
+#endif
+#ifndef EMCORE_PROTOCOL_INDEXED_DISPATCH
+#define EMCORE_PROTOCOL_INDEXED_DISPATCH 0
+#endif
+#ifndef EMCORE_PROTOCOL_DISPATCH_HITS
+#define EMCORE_PROTOCOL_DISPATCH_HITS 0
+#endif
 
 namespace emCore::protocol::runtime {
 
@@ -41,11 +58,27 @@ namespace gencfg = ::emCore::protocol::gen;
 // Prefer generated types from packet_config; sizes can still be overridden by macros
 using PacketT = gencfg::PacketT;
 using ParserT = gencfg::ParserT;
+#if EMCORE_PROTOCOL_INDEXED_DISPATCH
+using DispatcherT = emCore::protocol::indexed_command_dispatcher<gencfg::OPCODE_SPACE, PacketT,
+                                                                 (EMCORE_PROTOCOL_DISPATCH_HITS != 0)>;
+#else
 using DispatcherT = emCore::protocol::command_dispatcher<EMCORE_PROTOCOL_MAX_HANDLERS, PacketT>;
+#endif
+#if EMCORE_PROTOCOL_RUNTIME_LAYOUTS
 using FieldDecoderT = emCore::protocol::field_decoder<16, gencfg::OPCODE_SPACE>; // Max 16 fields per command
 using FieldEncoderT = emCore::protocol::field_encoder<16, gencfg::OPCODE_SPACE>; // Max 16 fields per command
+#else
+// Generated constexpr codecs replace the per-opcode layout tables
+using FieldDecoderT = emCore::protocol::field_decoder<1, 1>;
+using FieldEncoderT = emCore::protocol::field_encoder<1, 1>;
+#endif
+#if EMCORE_PROTOCOL_DMA_RX
+using RingT = emCore::protocol::dma_byte_ring<EMCORE_PROTOCOL_RING_SIZE>;
+#else
 using RingT = emCore::protocol::byte_ring<EMCORE_PROTOCOL_RING_SIZE>;
+#endif
 using PipelineT = emCore::protocol::packet_pipeline<RingT, ParserT, DispatcherT, PacketT>;
+using ChannelsT = emCore::protocol::packet_channels<EMCORE_PROTOCOL_CHANNELS, RingT, ParserT, DispatcherT, PacketT>;
 
 #if EMCORE_ENABLE_PROTOCOL
 inline RingT&           get_ring()          noexcept { return ::emCore::protocol::global::global_ring(); }
@@ -54,6 +87,18 @@ inline DispatcherT&     get_dispatcher()    noexcept { return ::emCore::protocol
 inline FieldDecoderT&   get_field_decoder() noexcept { return ::emCore::protocol::global::global_field_decoder(); }
 inline FieldEncoderT&   get_field_encoder() noexcept { return ::emCore::protocol::global::global_field_encoder(); }
 inline PipelineT&       get_pipeline()      noexcept { return ::emCore::protocol::global::global_pipeline(); }
+#if EMCORE_PROTOCOL_CHANNELS > 1
+inline ChannelsT&       get_channels()      noexcept { return ::emCore::protocol::global::global_channels(); }
+#endif
+#elif EMCORE_PROTOCOL_CHANNELS > 1
+// Fallback internal statics when protocol is disabled; channel 0 is the legacy pipeline
+inline DispatcherT&     get_dispatcher()    noexcept { static DispatcherT d; return d; }
+inline ChannelsT&       get_channels()      noexcept { static ChannelsT c(get_dispatcher()); return c; }
+inline RingT&           get_ring()          noexcept { return get_channels().ring(0); }
+inline ParserT&         get_parser()        noexcept { return get_channels().parser(0); }
+inline FieldDecoderT&   get_field_decoder() noexcept { static FieldDecoderT fd; return fd; }
+inline FieldEncoderT&   get_field_encoder() noexcept { static FieldEncoderT fe; return fe; }
+inline PipelineT&       get_pipeline()      noexcept { return get_channels().pipeline(0); }
 #else
 // Fallback internal statics when protocol is disabled (no central region used)
 inline RingT&           get_ring()          noexcept { static RingT r; return r; }
@@ -73,6 +118,17 @@ inline size_t process_bytes(size_t max_bytes, size_t& packets_out) noexcept {
     return get_pipeline().process_bytes(max_bytes, packets_out);
 }
 
+#if EMCORE_PROTOCOL_CHANNELS > 1
+// Multi-link helpers: feed one channel, service all of them round-robin
+inline size_t feed_channel(size_t channel, const u8* data, size_t len) noexcept {
+    return get_channels().feed_bytes(channel, data, len);
+}
+
+inline channel_service_result service_channels(size_t bytes_per_channel, u32 time_budget_us = 0) noexcept {
+    return get_channels().service(bytes_per_channel, time_budget_us);
+}
+#endif
+
 // Driver-friendly helpers to feed data into the pipeline
 inline bool feed_byte(u8 byte) noexcept {
     return get_pipeline().feed_byte(byte);
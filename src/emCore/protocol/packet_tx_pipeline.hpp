@@ -0,0 +1,190 @@
+#pragma once
+
+// Transmit-side packet pipeline: encoder -> TX ring -> driver (DMA)
+// - Any task queues whole frames; producers are serialized by a critical section
+// - Queued frames are coalesced: each transfer hands the driver every contiguous
+//   byte in the ring, so a burst of frames goes out as one DMA transfer
+// - The driver is kicked through a start hook and reports back via on_tx_complete()
+// - Header-only; no RTTI, no dynamic allocation
+
+#include <emCore/core/types.hpp>
+#include <emCore/core/config.hpp>
+#include <emCore/os/sync.hpp>
+#include <emCore/protocol/byte_ring.hpp>
+#include <emCore/protocol/encoder.hpp>
+#include <etl/array.h>
+#include <etl/atomic.h>
+
+namespace emCore::protocol {
+
+/*
+ * Driver start hook: begin transmitting len bytes at data and return true, then
+ * call on_tx_complete() once they are gone (typically from the TX-complete ISR,
+ * e.g. HAL_UART_TxCpltCallback with impl_stm32::uart_dma_tx_start()). The bytes
+ * stay valid until then. Synchronous sinks may call on_tx_complete() before
+ * returning. Returning false leaves the data queued for the next kick().
+ */
+using tx_start_t = bool (*)(void* ctx, const u8* data, size_t len) noexcept;
+
+// Template parameters:
+//  - Capacity: TX ring bytes (power of two, spsc_byte_ring)
+//  - PacketConfig: PACKET_SYNC / PACKET_SYNC_LEN / PACKET_LENGTH_16BIT
+//  - MaxFrame: largest frame accepted; stages frames that straddle the ring wrap
+//  - MaxTransfer: cap on bytes per driver transfer (e.g. 0xFFFF for 16-bit DMA counters)
+template <size_t Capacity, typename PacketConfig,
+          size_t MaxFrame = frame_size<PacketConfig>(config::protocol_packet_size),
+          size_t MaxTransfer = Capacity>
+class packet_tx_pipeline {
+public:
+    static_assert(MaxFrame >= frame_size<PacketConfig>(0) && MaxFrame <= Capacity,
+                  "MaxFrame must hold an empty frame and fit the TX ring");
+    static_assert(MaxTransfer > 0, "MaxTransfer must be > 0");
+
+    packet_tx_pipeline() noexcept = default;
+    packet_tx_pipeline(tx_start_t start, void* ctx) noexcept : start_(start), ctx_(ctx) {}
+    packet_tx_pipeline(const packet_tx_pipeline&) = delete;
+    packet_tx_pipeline& operator=(const packet_tx_pipeline&) = delete;
+    packet_tx_pipeline(packet_tx_pipeline&&) = delete;
+    packet_tx_pipeline& operator=(packet_tx_pipeline&&) = delete;
+
+    // Install the driver hook (before the first submit)
+    void set_driver(tx_start_t start, void* ctx) noexcept {
+        start_ = start;
+        ctx_ = ctx;
+    }
+
+    /*
+     * Queue one frame produced by fn(u8* buf, size_t cap) -> size_t (0 = failed),
+     * e.g. a generated encode_<cmd>_command_into(). fn writes straight into the
+     * ring when the contiguous space allows, otherwise into a staging buffer.
+     * All-or-nothing; returns false when the frame fails to encode or does not fit.
+     */
+    template <typename Fn>
+    bool submit_with(Fn&& fn) noexcept {
+        bool queued = false;
+        producer_cs_.enter();
+        const size_t space = Capacity - ring_.size();
+        auto span = ring_.write_span();
+        if (span.size() >= MaxFrame || span.size() == space) {
+            const size_t n = fn(span.data(), span.size());
+            if (n != 0U && n <= span.size()) {
+                ring_.commit(n);
+                queued = true;
+            }
+        } else {
+            const size_t n = fn(staging_.data(), staging_.size());
+            if (n != 0U && n <= space) {
+                (void)ring_.push_n(staging_.data(), n);
+                queued = true;
+            }
+        }
+        producer_cs_.exit();
+        if (queued) {
+            frames_.fetch_add(1U, etl::memory_order_relaxed);
+            kick();
+        } else {
+            rejected_.fetch_add(1U, etl::memory_order_relaxed);
+        }
+        return queued;
+    }
+
+    // Encode through a field_encoder layout (encode_into) and queue the frame
+    template <typename EncoderT>
+    bool submit(EncoderT& encoder, u8 opcode, const void* source_struct) noexcept {
+        return submit_with([&encoder, opcode, source_struct](u8* buf, size_t cap) noexcept {
+            return encoder.template encode_into<PacketConfig>(opcode, source_struct, buf, cap);
+        });
+    }
+
+    // Frame and queue an already-encoded payload
+    bool submit_payload(u8 opcode, const u8* payload, size_t len) noexcept {
+        return submit_with([opcode, payload, len](u8* buf, size_t cap) noexcept -> size_t {
+            if (frame_size<PacketConfig>(len) > cap) { return 0; }
+            if (len != 0U) { std::memcpy(buf + frame_header_size<PacketConfig>(), payload, len); }
+            return finish_frame<PacketConfig>(opcode, len, buf, cap);
+        });
+    }
+
+    // Queue raw, already-framed bytes (all-or-nothing)
+    bool submit_frame(const u8* frame, size_t len) noexcept {
+        bool queued = false;
+        producer_cs_.enter();
+        if (len != 0U && len <= Capacity - ring_.size()) {
+            (void)ring_.push_n(frame, len);
+            queued = true;
+        }
+        producer_cs_.exit();
+        if (queued) {
+            frames_.fetch_add(1U, etl::memory_order_relaxed);
+            kick();
+        } else {
+            rejected_.fetch_add(1U, etl::memory_order_relaxed);
+        }
+        return queued;
+    }
+
+    // Start a transfer if the driver is idle and bytes are queued. Safe from any
+    // task or ISR; only one caller wins the idle -> busy transition.
+    void kick() noexcept {
+        for (;;) {
+            bool expected = false;
+            if (start_ == nullptr || !busy_.compare_exchange_strong(expected, true)) { return; }
+            auto span = ring_.read_span();
+            if (!span.empty()) {
+                const size_t len = (span.size() < MaxTransfer) ? span.size() : MaxTransfer;
+                in_flight_ = len;
+                transfers_.fetch_add(1U, etl::memory_order_relaxed);
+                if (!start_(ctx_, span.data(), len)) {
+                    in_flight_ = 0;
+                    busy_.store(false, etl::memory_order_release);
+                    start_failures_.fetch_add(1U, etl::memory_order_relaxed);
+                }
+                return;
+            }
+            busy_.store(false, etl::memory_order_release);
+            // A producer may have committed after read_span() but lost the CAS
+            if (ring_.empty()) { return; }
+        }
+    }
+
+    // Driver TX-complete notification (ISR-safe): release the sent bytes, send the rest
+    void on_tx_complete() noexcept {
+        const size_t sent = in_flight_;
+        in_flight_ = 0;
+        ring_.consume(sent);
+        bytes_sent_.fetch_add(static_cast<u32>(sent), etl::memory_order_relaxed);
+        busy_.store(false, etl::memory_order_release);
+        kick();
+    }
+
+    [[nodiscard]] bool busy() const noexcept { return busy_.load(etl::memory_order_acquire); }
+    [[nodiscard]] size_t queued_bytes() const noexcept { return ring_.size(); }
+    [[nodiscard]] size_t free_bytes() const noexcept { return Capacity - ring_.size(); }
+    [[nodiscard]] bool idle() const noexcept { return !busy() && ring_.empty(); }
+
+    // Frames queued / rejected, driver transfers started / refused, bytes completed
+    [[nodiscard]] u32 frames() const noexcept { return frames_.load(etl::memory_order_relaxed); }
+    [[nodiscard]] u32 rejected() const noexcept { return rejected_.load(etl::memory_order_relaxed); }
+    [[nodiscard]] u32 transfers() const noexcept { return transfers_.load(etl::memory_order_relaxed); }
+    [[nodiscard]] u32 start_failures() const noexcept { return start_failures_.load(etl::memory_order_relaxed); }
+    [[nodiscard]] u32 bytes_sent() const noexcept { return bytes_sent_.load(etl::memory_order_relaxed); }
+
+    static constexpr size_t capacity() noexcept { return Capacity; }
+    static constexpr size_t max_frame() noexcept { return MaxFrame; }
+
+private:
+    spsc_byte_ring<Capacity> ring_{};
+    etl::array<u8, MaxFrame> staging_{};
+    os::critical_section producer_cs_;
+    tx_start_t start_{nullptr};
+    void* ctx_{nullptr};
+    etl::atomic<bool> busy_{false};
+    size_t in_flight_{0};
+    etl::atomic<u32> frames_{0};
+    etl::atomic<u32> rejected_{0};
+    etl::atomic<u32> transfers_{0};
+    etl::atomic<u32> start_failures_{0};
+    etl::atomic<u32> bytes_sent_{0};
+};
+
+} // namespace emCore::protocol
@@ -7,9 +7,11 @@
 #include <emCore/protocol/packet_parser.hpp>
 #include <emCore/protocol/packet_pipeline.hpp>
 #include <emCore/protocol/byte_ring.hpp>
+#include <emCore/protocol/dma_ring.hpp>
 #include <emCore/protocol/decoder.hpp>
 #include <emCore/protocol/encoder.hpp>
 #include <emCore/protocol/command_dispatcher.hpp>
+#include <emCore/protocol/packet_channels.hpp>
 
 #if __has_include(<generated_packet_config.hpp>)
 #  include <generated_packet_config.hpp>
@@ -28,6 +30,21 @@
 #ifndef EMCORE_PROTOCOL_RING_SIZE
 #define EMCORE_PROTOCOL_RING_SIZE 512
 #endif
+#ifndef EMCORE_PROTOCOL_DMA_RX
+#define EMCORE_PROTOCOL_DMA_RX 0
+#endif
+#ifndef EMCORE_PROTOCOL_CHANNELS
+#define EMCORE_PROTOCOL_CHANNELS 1
+#endif
+#ifndef EMCORE_PROTOCOL_RUNTIME_LAYOUTS
+#define EMCORE_PROTOCOL_RUNTIME_LAYOUTS 1
+#endif
+#ifndef EMCORE_PROTOCOL_INDEXED_DISPATCH
+#define EMCORE_PROTOCOL_INDEXED_DISPATCH 0
+#endif
+#ifndef EMCORE_PROTOCOL_DISPATCH_HITS
+#define EMCORE_PROTOCOL_DISPATCH_HITS 0
+#endif
 
 namespace emCore::protocol::global {
 
@@ -35,12 +52,43 @@ namespace gencfg = ::emCore::protocol::gen;
 
 using PacketT = gencfg::PacketT;
 using ParserT = gencfg::ParserT;
+#if EMCORE_PROTOCOL_INDEXED_DISPATCH
+using DispatcherT = emCore::protocol::indexed_command_dispatcher<gencfg::OPCODE_SPACE, PacketT,
+                                                                 (EMCORE_PROTOCOL_DISPATCH_HITS != 0)>;
+#else
 using DispatcherT = emCore::protocol::command_dispatcher<EMCORE_PROTOCOL_MAX_HANDLERS, PacketT>;
+#endif
+#if EMCORE_PROTOCOL_RUNTIME_LAYOUTS
 using FieldDecoderT = emCore::protocol::field_decoder<16, gencfg::OPCODE_SPACE>;
 using FieldEncoderT = emCore::protocol::field_encoder<16, gencfg::OPCODE_SPACE>;
+#else
+// Generated constexpr codecs replace the per-opcode layout tables
+using FieldDecoderT = emCore::protocol::field_decoder<1, 1>;
+using FieldEncoderT = emCore::protocol::field_encoder<1, 1>;
+#endif
+#if EMCORE_PROTOCOL_DMA_RX
+using RingT = emCore::protocol::dma_byte_ring<EMCORE_PROTOCOL_RING_SIZE>;
+#else
 using RingT = emCore::protocol::byte_ring<EMCORE_PROTOCOL_RING_SIZE>;
+#endif
 using PipelineT = emCore::protocol::packet_pipeline<RingT, ParserT, DispatcherT, PacketT>;
+using ChannelsT = emCore::protocol::packet_channels<EMCORE_PROTOCOL_CHANNELS, RingT, ParserT, DispatcherT, PacketT>;
 
+#if EMCORE_PROTOCOL_CHANNELS > 1
+// Multi-link: channel 0 doubles as the legacy single ring/parser/pipeline
+struct ProtocolBlock {
+    DispatcherT dispatcher;
+    FieldDecoderT decoder;
+    FieldEncoderT encoder;
+    ChannelsT channels;
+
+    ProtocolBlock() : dispatcher(), decoder(), encoder(), channels(dispatcher) {}
+    ProtocolBlock(const ProtocolBlock&) = delete;
+    ProtocolBlock& operator=(const ProtocolBlock&) = delete;
+    ProtocolBlock(ProtocolBlock&&) = delete;
+    ProtocolBlock& operator=(ProtocolBlock&&) = delete;
+};
+#else
 struct ProtocolBlock {
     RingT ring;
     ParserT parser;
@@ -55,6 +103,7 @@ struct ProtocolBlock {
     ProtocolBlock(ProtocolBlock&&) = delete;
     ProtocolBlock& operator=(ProtocolBlock&&) = delete;
 };
+#endif
 
 #if EMCORE_ENABLE_PROTOCOL
 static_assert(::emCore::memory::kLayout.protocol.size >= sizeof(ProtocolBlock),
@@ -83,11 +132,18 @@ inline ProtocolBlock& block() noexcept {
 #endif
 }
 
+#if EMCORE_PROTOCOL_CHANNELS > 1
+inline ChannelsT&   global_channels()   noexcept { return block().channels; }
+inline RingT&       global_ring()       noexcept { return block().channels.ring(0); }
+inline ParserT&     global_parser()     noexcept { return block().channels.parser(0); }
+inline PipelineT&   global_pipeline()   noexcept { return block().channels.pipeline(0); }
+#else
 inline RingT&       global_ring()       noexcept { return block().ring; }
 inline ParserT&     global_parser()     noexcept { return block().parser; }
+inline PipelineT&   global_pipeline()   noexcept { return block().pipeline; }
+#endif
 inline DispatcherT& global_dispatcher() noexcept { return block().dispatcher; }
 inline FieldDecoderT& global_field_decoder() noexcept { return block().decoder; }
 inline FieldEncoderT& global_field_encoder() noexcept { return block().encoder; }
-inline PipelineT&   global_pipeline()   noexcept { return block().pipeline; }
 
 } // namespace emCore::protocol::global
@@ -2,6 +2,9 @@
 
 namespace emCore::runtime {
 
-alignas(8) unsigned char g_arena[emCore::memory::required_bytes];
+// Cache-line aligned so cache-aligned regions really start on a line
+alignas(EMCORE_CACHE_LINE_BYTES) unsigned char g_arena[emCore::memory::arena_bytes(emCore::memory::memory_class::internal)];
+alignas(EMCORE_CACHE_LINE_BYTES) EMCORE_FAST_RAM_ATTR unsigned char g_arena_fast[emCore::memory::arena_bytes(emCore::memory::memory_class::fast)];
+alignas(EMCORE_CACHE_LINE_BYTES) EMCORE_EXT_RAM_ATTR unsigned char g_arena_ext[emCore::memory::arena_bytes(emCore::memory::memory_class::external)];
 
 } // namespace emCore::runtime
@@ -11,20 +11,33 @@
 
 namespace emCore::runtime {
 
-// Extern storage for the central arena (defined in runtime.cpp)
-extern unsigned char g_arena[emCore::memory::required_bytes]; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+// Extern storage for the central arenas, one per memory class (defined in runtime.cpp)
+extern unsigned char g_arena[emCore::memory::arena_bytes(emCore::memory::memory_class::internal)]; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+extern unsigned char g_arena_fast[emCore::memory::arena_bytes(emCore::memory::memory_class::fast)]; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+extern unsigned char g_arena_ext[emCore::memory::arena_bytes(emCore::memory::memory_class::external)]; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
 // Sizes and regions
 constexpr std::size_t arena_size() noexcept { return emCore::memory::required_bytes; }
 constexpr emCore::memory::layout layout() noexcept { return emCore::memory::kLayout; }
 constexpr emCore::memory::budget_report budget() noexcept { return emCore::memory::report(); }
 
+// Base pointer of a region inside the arena of its memory class
+inline void* region_base(const emCore::memory::region& r) noexcept {
+    switch (r.cls) {
+        case emCore::memory::memory_class::fast:     return static_cast<void*>(&g_arena_fast[r.offset]);
+        case emCore::memory::memory_class::external: return static_cast<void*>(&g_arena_ext[r.offset]);
+        default:                                     return static_cast<void*>(&g_arena[r.offset]);
+    }
+}
+
 // Region base pointers (for placement-new of heavy singletons if desired)
-inline void* messaging_region() noexcept { return static_cast<void*>(&g_arena[emCore::memory::kLayout.messaging.offset]); }
-inline void* events_region()    noexcept { return static_cast<void*>(&g_arena[emCore::memory::kLayout.events.offset]); }
-inline void* tasks_region()     noexcept { return static_cast<void*>(&g_arena[emCore::memory::kLayout.tasks.offset]); }
-inline void* os_region()        noexcept { return static_cast<void*>(&g_arena[emCore::memory::kLayout.os.offset]); }
-inline void* protocol_region()  noexcept { return static_cast<void*>(&g_arena[emCore::memory::kLayout.protocol.offset]); }
-inline void* diagnostics_region() noexcept { return static_cast<void*>(&g_arena[emCore::memory::kLayout.diagnostics.offset]); }
+inline void* messaging_region() noexcept { return region_base(emCore::memory::kLayout.messaging); }
+inline void* events_region()    noexcept { return region_base(emCore::memory::kLayout.events); }
+inline void* tasks_region()     noexcept { return region_base(emCore::memory::kLayout.tasks); }
+inline void* os_region()        noexcept { return region_base(emCore::memory::kLayout.os); }
+inline void* protocol_region()  noexcept { return region_base(emCore::memory::kLayout.protocol); }
+inline void* diagnostics_region() noexcept { return region_base(emCore::memory::kLayout.diagnostics); }
+inline void* slabs_region()     noexcept { return region_base(emCore::memory::kLayout.slabs); }
+inline void* scratch_region()   noexcept { return region_base(emCore::memory::kLayout.scratch); }
 
 } // namespace emCore::runtime
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstddef>
+
+#include "../core/types.hpp"
+#include "../core/config.hpp"
+#include "../os/time.hpp"
+#include "rtos_scheduler.hpp"
+
+#include <etl/array.h>
+#include <etl/span.h>
+
+namespace emCore::task {
+
+struct core_placement {
+    task_id_t task_id{invalid_task_id};
+    u8 from_core{0};
+    u8 to_core{0};
+    u32 load_ppm{0};  // task's share of one core over the sample window
+};
+
+/**
+ * @brief Load-aware core placement for tasks registered with rtos_scheduler
+ *
+ * sample() measures each task's execution time since the previous sample as a
+ * share of one core. propose() keeps user-pinned tasks where they are and
+ * spreads the rest largest-first onto the least loaded core (LPT); it reports
+ * only tasks whose core changes, and nothing while the measured spread between
+ * the busiest and idlest core is under the imbalance threshold. apply() hands
+ * the moves to rtos_scheduler::place(), which re-pins live native tasks where
+ * the kernel allows.
+ */
+template <size_t MaxTasks = config::max_tasks, size_t MaxCores = config::max_cpu_cores>
+class core_balancer {
+public:
+    static constexpr u32 full_core_ppm = 1000000U;
+
+    explicit core_balancer(rtos_scheduler& scheduler, u32 imbalance_ppm = 100000U) noexcept
+        : scheduler_(scheduler), imbalance_ppm_(imbalance_ppm) {}
+
+    // Close the current window; returns false on the first call (no window yet)
+    bool sample() noexcept {
+        const timestamp_t now = os::time_us();
+        const timestamp_t window = now - last_sample_us_;
+        const bool have_window = (last_sample_us_ != 0U) && (window != 0U);
+        core_load_.fill(0U);
+        count_ = 0;
+        for (size_t i = 0; i < scheduler_.task_count() && i < MaxTasks; ++i) {
+            const task_execution_context& ctx = scheduler_.context_at(i);
+            const duration_t busy = ctx.total_execution_time_us - last_exec_us_[i];
+            last_exec_us_[i] = ctx.total_execution_time_us;
+            u32 load = 0;
+            if (have_window) {
+                const u64 ppm = (static_cast<u64>(busy) * full_core_ppm) / window;
+                load = (ppm > full_core_ppm) ? full_core_ppm : static_cast<u32>(ppm);
+            }
+            tasks_[count_++] = entry{scheduler_.task_at(i), ctx.cpu_core_id, load, ctx.pin_to_core};
+            if (ctx.cpu_core_id < MaxCores) { core_load_[ctx.cpu_core_id] += load; }
+        }
+        last_sample_us_ = now;
+        return have_window;
+    }
+
+    // Measured load of a core over the last window, ppm of one core
+    [[nodiscard]] u32 core_load_ppm(u8 core) const noexcept {
+        return (core < MaxCores) ? core_load_[core] : 0U;
+    }
+
+    /*
+     * Placement for `cores` cores from the last sample; writes up to out.size()
+     * moves and returns how many.
+     */
+    size_t propose(etl::span<core_placement> out, u8 cores) noexcept {
+        if (cores > MaxCores) { cores = static_cast<u8>(MaxCores); }
+        if (cores < 2U || count_ == 0U || spread(cores) < imbalance_ppm_) { return 0; }
+
+        etl::array<u32, MaxCores> planned{};
+        etl::array<u8, MaxTasks> order{};
+        size_t movable = 0;
+        for (size_t i = 0; i < count_; ++i) {
+            const entry& e = tasks_[i];
+            if (e.pinned && e.core < cores) {
+                planned[e.core] += e.load;
+            } else {
+                order[movable++] = static_cast<u8>(i);
+            }
+        }
+        // Largest load first (insertion sort; MaxTasks is small)
+        for (size_t i = 1; i < movable; ++i) {
+            const u8 v = order[i];
+            size_t j = i;
+            while (j > 0U && tasks_[order[j - 1U]].load < tasks_[v].load) {
+                order[j] = order[j - 1U];
+                --j;
+            }
+            order[j] = v;
+        }
+        size_t moves = 0;
+        for (size_t k = 0; k < movable; ++k) {
+            const entry& e = tasks_[order[k]];
+            u8 best = 0;
+            for (u8 c = 1; c < cores; ++c) {
+                if (planned[c] < planned[best]) { best = c; }
+            }
+            // Stay put on a tie so an already balanced task is not shuffled
+            if (e.core < cores && planned[e.core] == planned[best]) { best = e.core; }
+            planned[best] += e.load;
+            if (best != e.core && moves < out.size()) {
+                out[moves++] = core_placement{e.task_id, e.core, best, e.load};
+            }
+        }
+        return moves;
+    }
+
+    // Apply proposed moves; returns how many took effect on live tasks
+    size_t apply(etl::span<const core_placement> moves) noexcept {
+        size_t applied = 0;
+        for (const core_placement& m : moves) {
+            if (scheduler_.place(m.task_id, m.to_core)) { ++applied; }
+        }
+        return applied;
+    }
+
+private:
+    struct entry {
+        task_id_t task_id{invalid_task_id};
+        u8 core{0};
+        u32 load{0};
+        bool pinned{false};
+    };
+
+    [[nodiscard]] u32 spread(u8 cores) const noexcept {
+        u32 lo = core_load_[0];
+        u32 hi = core_load_[0];
+        for (u8 c = 1; c < cores; ++c) {
+            if (core_load_[c] < lo) { lo = core_load_[c]; }
+            if (core_load_[c] > hi) { hi = core_load_[c]; }
+        }
+        return hi - lo;
+    }
+
+    rtos_scheduler& scheduler_;
+    u32 imbalance_ppm_;
+    timestamp_t last_sample_us_{0};
+    etl::array<duration_t, MaxTasks> last_exec_us_{};
+    etl::array<entry, MaxTasks> tasks_{};
+    etl::array<u32, MaxCores> core_load_{};
+    size_t count_{0};
+};
+
+}  // namespace emCore::task
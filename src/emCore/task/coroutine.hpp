@@ -0,0 +1,410 @@
+#pragma once
+
+// Stackless C++20 coroutine tasks for the cooperative scheduler
+// - Frames come from a fixed block pool (no heap); a frame that does not fit
+//   makes the coroutine call return an empty co_task instead of allocating
+// - Awaitables: co::sleep_for/sleep_until, co::yield, co::receive (broker
+//   mailbox) and co::wait_event (event bus)
+// - Driven by coroutine_scheduler::poll(), which taskmaster calls from run()
+
+#include <cstddef>
+
+#include "../core/types.hpp"
+#include "../core/config.hpp"
+#include "../error/result.hpp"
+#include "../os/sync.hpp"
+#include "../os/time.hpp"
+#include "../utils/helpers.hpp"
+#include "../event/event_bus.hpp"
+
+#include <etl/array.h>
+#include <etl/atomic.h>
+#include <etl/utility.h>
+
+#if defined(__has_include)
+  #if __has_include(<coroutine>) && defined(__cpp_impl_coroutine)
+    #include <coroutine>
+    #define EMCORE_COROUTINES_AVAILABLE 1
+  #endif
+#endif
+#ifndef EMCORE_COROUTINES_AVAILABLE
+  #define EMCORE_COROUTINES_AVAILABLE 0
+#endif
+
+#if EMCORE_COROUTINES_AVAILABLE
+
+namespace emCore::task {
+
+/**
+ * @brief Fixed-size block pool for coroutine frames
+ *
+ * One bit per block in a free mask; allocation is a find-first-set under a
+ * critical section.
+ */
+template <size_t BlockSize, size_t Blocks>
+class coroutine_frame_pool {
+    static_assert(Blocks >= 1 && Blocks <= 32, "coroutine_frame_pool supports 1..32 frames");
+    static_assert(BlockSize % alignof(std::max_align_t) == 0, "BlockSize must keep frames max-aligned");
+
+public:
+    void* allocate(size_t bytes) noexcept {
+        if (bytes > BlockSize) {
+            oversize_.fetch_add(1U, etl::memory_order_relaxed);
+            return nullptr;
+        }
+        cs_.enter();
+        void* out = nullptr;
+        if (free_ != 0U) {
+            const u8 i = utils::lowest_set_bit(free_);
+            free_ &= ~(1U << i);
+            out = &storage_[static_cast<size_t>(i) * BlockSize];
+        }
+        cs_.exit();
+        return out;
+    }
+
+    void release(void* p) noexcept {
+        if (p == nullptr) { return; }
+        const size_t i = static_cast<size_t>(static_cast<u8*>(p) - storage_) / BlockSize;
+        cs_.enter();
+        free_ |= (1U << i);
+        cs_.exit();
+    }
+
+    [[nodiscard]] size_t available() const noexcept {
+        size_t n = 0;
+        for (u32 m = free_; m != 0U; m &= m - 1U) { ++n; }
+        return n;
+    }
+    // Frames refused because the coroutine needed more than BlockSize bytes
+    [[nodiscard]] u32 oversize() const noexcept { return oversize_.load(etl::memory_order_relaxed); }
+    static constexpr size_t block_size() noexcept { return BlockSize; }
+    static constexpr size_t capacity() noexcept { return Blocks; }
+
+private:
+    static constexpr u32 all_free = (Blocks == 32U) ? 0xFFFFFFFFU : ((1U << Blocks) - 1U);
+
+    alignas(std::max_align_t) u8 storage_[BlockSize * Blocks]{};
+    u32 free_{all_free};
+    etl::atomic<u32> oversize_{0};
+    os::critical_section cs_;
+};
+
+using coroutine_frames_t = coroutine_frame_pool<config::coroutine_frame_bytes, config::max_coroutines>;
+
+inline coroutine_frames_t& coroutine_frames() noexcept {
+    static coroutine_frames_t pool;
+    return pool;
+}
+
+/* What a suspended coroutine is waiting for; written by awaitables, read by the scheduler */
+struct coroutine_wait {
+    using probe_t = bool (*)(void* awaiter) noexcept;
+
+    static constexpr timestamp_t never = static_cast<timestamp_t>(-1);
+    static constexpr u16 no_key = 0xFFFF;
+
+    probe_t probe{nullptr};   // returns true once the awaiter can resume
+    void* awaiter{nullptr};
+    timestamp_t deadline{never};  // resume at this time even if probe() never succeeds (ms)
+    u16 key{no_key};          // task id whose wake-up re-runs probe()
+    bool poll{false};         // re-run probe() on every pass (cheap probes such as event waits)
+    bool timed_out{false};
+};
+
+/**
+ * @brief Coroutine return type for cooperative tasks
+ *
+ * Starts suspended; hand it to taskmaster::spawn() (or a coroutine_scheduler).
+ * Empty (!valid()) when no frame could be allocated.
+ */
+class co_task {
+public:
+    struct promise_type {
+        coroutine_wait wait{};
+
+        static void* operator new(size_t bytes) noexcept { return coroutine_frames().allocate(bytes); }
+        static void operator delete(void* p) noexcept { coroutine_frames().release(p); }
+        static co_task get_return_object_on_allocation_failure() noexcept { return co_task{}; }
+
+        co_task get_return_object() noexcept {
+            return co_task{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept {}
+    };
+    using handle_t = std::coroutine_handle<promise_type>;
+
+    co_task() noexcept = default;
+    explicit co_task(handle_t h) noexcept : handle_(h) {}
+    co_task(co_task&& other) noexcept : handle_(other.release()) {}
+    co_task& operator=(co_task&& other) noexcept {
+        if (this != &other) {
+            reset();
+            handle_ = other.release();
+        }
+        return *this;
+    }
+    co_task(const co_task&) = delete;
+    co_task& operator=(const co_task&) = delete;
+    ~co_task() noexcept { reset(); }
+
+    [[nodiscard]] bool valid() const noexcept { return static_cast<bool>(handle_); }
+    handle_t release() noexcept {
+        const handle_t h = handle_;
+        handle_ = handle_t{};
+        return h;
+    }
+
+private:
+    void reset() noexcept {
+        if (handle_) { handle_.destroy(); }
+        handle_ = handle_t{};
+    }
+
+    handle_t handle_{};
+};
+
+namespace co {
+
+namespace detail {
+inline void park(std::coroutine_handle<co_task::promise_type> h, const coroutine_wait& w) noexcept {
+    h.promise().wait = w;
+}
+}  // namespace detail
+
+/* Resume on the next scheduler pass */
+struct yield {
+    [[nodiscard]] bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<co_task::promise_type> h) const noexcept {
+        coroutine_wait w{};
+        w.deadline = 0;
+        detail::park(h, w);
+    }
+    void await_resume() const noexcept {}
+};
+
+/* Resume once os::time_ms() reaches `when` */
+struct sleep_until {
+    timestamp_t when;
+    [[nodiscard]] bool await_ready() const noexcept { return os::time_ms() >= when; }
+    void await_suspend(std::coroutine_handle<co_task::promise_type> h) const noexcept {
+        coroutine_wait w{};
+        w.deadline = when;
+        detail::park(h, w);
+    }
+    void await_resume() const noexcept {}
+};
+
+inline sleep_until sleep_for(duration_t ms) noexcept { return sleep_until{os::time_ms() + ms}; }
+
+/*
+ * Next message for task_id from a broker (message_broker, fanout_broker...).
+ * The probe runs when the broker's cooperative wake hook names task_id, so the
+ * mailbox should be registered with a null native handle. timeout_ms 0 waits
+ * forever; a timeout resumes with error_code::timeout.
+ */
+template <typename Broker>
+struct receive {
+    using message_t = typename Broker::message_type;
+    using result_t = result<message_t, error_code>;
+
+    Broker& broker;
+    task_id_t task_id;
+    duration_t timeout_ms{0};
+    result_t got{error_code::timeout};
+    coroutine_wait* wait{nullptr};
+
+    receive(Broker& b, task_id_t id, duration_t timeout = 0) noexcept : broker(b), task_id(id), timeout_ms(timeout) {}
+
+    static bool probe(void* self) noexcept {
+        auto* r = static_cast<receive*>(self);
+        r->got = r->broker.try_receive(r->task_id);
+        return r->got.is_ok();
+    }
+    bool await_ready() noexcept { return probe(this); }
+    void await_suspend(std::coroutine_handle<co_task::promise_type> h) noexcept {
+        coroutine_wait w{};
+        w.probe = &receive::probe;
+        w.awaiter = this;
+        w.key = task_id.value();
+        w.deadline = (timeout_ms != 0U) ? (os::time_ms() + timeout_ms) : coroutine_wait::never;
+        detail::park(h, w);
+        wait = &h.promise().wait;
+    }
+    result_t await_resume() noexcept {
+        if (wait != nullptr && wait->timed_out) { return result_t(error_code::timeout); }
+        return etl::move(got);
+    }
+};
+
+template <typename Broker>
+receive(Broker&, task_id_t, duration_t) -> receive<Broker>;
+template <typename Broker>
+receive(Broker&, task_id_t) -> receive<Broker>;
+
+/*
+ * Next event matching `filter` (category::any / code 0xFFFF are wildcards),
+ * delivered by a bus attached with coroutine_scheduler::attach().
+ */
+struct wait_event {
+    events::id filter;
+    duration_t timeout_ms{0};
+    events::Event event{};
+    bool delivered{false};
+
+    explicit wait_event(events::id f, duration_t timeout = 0) noexcept : filter(f), timeout_ms(timeout) {}
+
+    [[nodiscard]] bool matches(const events::Event& evt) const noexcept {
+        const bool cat_match = (filter.cat == events::category::any) || (filter.cat == evt.ident.cat);
+        const bool code_match = (filter.code == 0xFFFFU) || (filter.code == evt.ident.code);
+        return cat_match && code_match;
+    }
+    static bool probe(void* self) noexcept { return static_cast<wait_event*>(self)->delivered; }
+
+    [[nodiscard]] bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<co_task::promise_type> h) noexcept {
+        coroutine_wait w{};
+        w.probe = &wait_event::probe;
+        w.awaiter = this;
+        w.poll = true;
+        w.deadline = (timeout_ms != 0U) ? (os::time_ms() + timeout_ms) : coroutine_wait::never;
+        detail::park(h, w);
+    }
+    result<events::Event, error_code> await_resume() const noexcept {
+        if (!delivered) { return result<events::Event, error_code>(error_code::timeout); }
+        return result<events::Event, error_code>(event);
+    }
+};
+
+}  // namespace co
+
+/**
+ * @brief Runs spawned co_tasks; single-threaded (call poll() from one context)
+ *
+ * A coroutine is resumed when its deadline passes, when a wake-up names its
+ * key and the probe succeeds, or on every pass for polling waits. notify() is
+ * safe from any context; everything else belongs to the polling thread.
+ */
+template <size_t MaxCoroutines>
+class coroutine_scheduler {
+    static_assert(MaxCoroutines >= 1, "MaxCoroutines must be >= 1");
+
+public:
+    using handle_t = co_task::handle_t;
+
+    coroutine_scheduler() noexcept = default;
+    coroutine_scheduler(const coroutine_scheduler&) = delete;
+    coroutine_scheduler& operator=(const coroutine_scheduler&) = delete;
+    coroutine_scheduler(coroutine_scheduler&&) = delete;
+    coroutine_scheduler& operator=(coroutine_scheduler&&) = delete;
+    ~coroutine_scheduler() noexcept {
+        for (auto& h : slots_) {
+            if (h) { h.destroy(); }
+        }
+    }
+
+    // Take ownership; it first runs on the next poll()
+    result<void, error_code> spawn(co_task&& task) noexcept {
+        if (!task.valid()) { return result<void, error_code>(error_code::out_of_memory); }
+        for (auto& h : slots_) {
+            if (!h) {
+                h = task.release();
+                h.promise().wait = coroutine_wait{};
+                h.promise().wait.deadline = 0;
+                ++count_;
+                return ok();
+            }
+        }
+        return result<void, error_code>(error_code::out_of_memory);
+    }
+
+    // Wake-up for a key (task id), e.g. from the broker's cooperative wake hook
+    void notify(task_id_t key) noexcept {
+        const u16 k = key.value();
+        if (k < max_keys) {
+            keys_[k / 32U].fetch_or(1U << (k % 32U), etl::memory_order_release);
+        }
+    }
+
+    // Resume every coroutine that can make progress; returns how many ran
+    size_t poll(timestamp_t now) noexcept {
+        etl::array<u32, key_words> woken{};
+        for (size_t w = 0; w < key_words; ++w) {
+            woken[w] = keys_[w].exchange(0U, etl::memory_order_acquire);
+        }
+        size_t resumed = 0;
+        for (auto& h : slots_) {
+            if (!h) { continue; }
+            coroutine_wait& w = h.promise().wait;
+            bool run = false;
+            if (w.probe != nullptr) {
+                const bool keyed = (w.key < max_keys) && ((woken[w.key / 32U] & (1U << (w.key % 32U))) != 0U);
+                run = (w.poll || keyed) && w.probe(w.awaiter);
+            }
+            if (!run && now >= w.deadline) {
+                w.timed_out = (w.probe != nullptr);
+                run = true;
+            }
+            if (!run) { continue; }
+            h.resume();
+            ++resumed;
+            if (h.done()) {
+                h.destroy();
+                h = handle_t{};
+                --count_;
+            }
+        }
+        return resumed;
+    }
+
+    /*
+     * Earliest deadline among suspended coroutines; never when none has one.
+     * Polling waits do not count: whatever satisfies them (a broker send, an
+     * event post) also wakes a tickless scheduler.
+     */
+    [[nodiscard]] timestamp_t next_deadline() const noexcept {
+        timestamp_t next = coroutine_wait::never;
+        for (const auto& h : slots_) {
+            if (h && h.promise().wait.deadline < next) { next = h.promise().wait.deadline; }
+        }
+        return next;
+    }
+
+    // Deliver events from a bus to co::wait_event awaiters (once per bus)
+    bool attach(events::event_bus& bus) noexcept {
+        return bus.register_handler(events::id{events::category::any, 0xFFFFU},
+                                    events::handler_t::create<coroutine_scheduler, &coroutine_scheduler::on_event>(*this));
+    }
+
+    // Hand evt to every waiter whose filter matches; they resume on the next poll()
+    void on_event(const events::Event& evt) noexcept {
+        for (auto& h : slots_) {
+            if (!h) { continue; }
+            coroutine_wait& w = h.promise().wait;
+            if (w.probe != &co::wait_event::probe) { continue; }
+            auto* waiter = static_cast<co::wait_event*>(w.awaiter);
+            if (!waiter->delivered && waiter->matches(evt)) {
+                waiter->event = evt;
+                waiter->delivered = true;
+            }
+        }
+    }
+
+    [[nodiscard]] size_t count() const noexcept { return count_; }
+    static constexpr size_t capacity() noexcept { return MaxCoroutines; }
+
+private:
+    static constexpr size_t max_keys = config::max_tasks;
+    static constexpr size_t key_words = (max_keys + 31U) / 32U;
+
+    etl::array<handle_t, MaxCoroutines> slots_{};
+    etl::array<etl::atomic<u32>, key_words> keys_{};
+    size_t count_{0};
+};
+
+}  // namespace emCore::task
+
+#endif  // EMCORE_COROUTINES_AVAILABLE
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <cstddef>
+
+#include "../core/types.hpp"
+#include "../os/sync.hpp"
+#include "../utils/helpers.hpp"
+#include "ready_queue.hpp"
+
+#include <etl/array.h>
+#include <etl/atomic.h>
+
+namespace emCore::task {
+
+/**
+ * @brief Work-stealing run queues for cooperative tasks on N worker contexts
+ *
+ * Each worker owns a timer heap and two priority ready queues: `pinned` (tasks
+ * with a core affinity, never stolen) and `shared` (stealable). A worker serves
+ * its own queues first, highest priority wins and pinned wins ties; when both
+ * are empty it steals the highest-priority shared task from the other workers.
+ * A task lives in at most one queue or heap at a time, so it is never run by two
+ * workers at once. Each worker's structures sit behind its own critical section;
+ * the owner and at most one thief contend for it, and only briefly.
+ */
+template <size_t MaxTasks, size_t Levels, size_t Workers>
+class work_stealing_executor {
+    static_assert(Workers >= 1 && Workers <= 32, "work_stealing_executor supports 1..32 workers");
+
+public:
+    static constexpr u16 npos = 0xFFFF;
+    static constexpr u8 no_worker = 0xFF;
+
+    work_stealing_executor() noexcept { clear(); }
+    work_stealing_executor(const work_stealing_executor&) = delete;
+    work_stealing_executor& operator=(const work_stealing_executor&) = delete;
+    work_stealing_executor(work_stealing_executor&&) = delete;
+    work_stealing_executor& operator=(work_stealing_executor&&) = delete;
+
+    static constexpr size_t workers() noexcept { return Workers; }
+
+    // Not thread-safe; call before the workers start
+    void clear() noexcept {
+        for (auto& w : workers_) {
+            w.pinned.clear();
+            w.shared.clear();
+            w.timers.clear();
+            w.steals.store(0U, etl::memory_order_relaxed);
+        }
+        for (auto& owner : owner_) { owner.store(no_worker, etl::memory_order_relaxed); }
+    }
+
+    /*
+     * Queue idx on worker `home`: ready now when due <= now, otherwise on that
+     * worker's timer heap. Pinned tasks only ever run on `home`. Any context.
+     */
+    void schedule(u16 idx, u8 level, timestamp_t due, timestamp_t now, size_t home, bool pinned) noexcept {
+        if (idx >= MaxTasks) { return; }
+        remove(idx);
+        const size_t target = home % Workers;
+        worker& w = workers_[target];
+        w.cs.enter();
+        pinned_[idx] = pinned;
+        level_[idx] = level;
+        owner_[idx].store(static_cast<u8>(target), etl::memory_order_release);
+        if (due > now) {
+            w.timers.push(idx, due);
+        } else {
+            (pinned ? w.pinned : w.shared).push(idx, level);
+        }
+        w.cs.exit();
+    }
+
+    // Drop idx from whichever worker holds it; any context
+    void remove(u16 idx) noexcept {
+        (void)with_owner(idx, [this, idx](worker& w) noexcept {
+            w.pinned.remove(idx);
+            w.shared.remove(idx);
+            w.timers.remove(idx);
+            owner_[idx].store(no_worker, etl::memory_order_release);
+            return true;
+        });
+    }
+
+    // Move idx from its timer heap to the ready queue now; false if it was not sleeping
+    bool expedite(u16 idx) noexcept {
+        return with_owner(idx, [this, idx](worker& w) noexcept {
+            if (!w.timers.contains(idx)) { return false; }
+            w.timers.remove(idx);
+            (pinned_[idx] ? w.pinned : w.shared).push(idx, level_[idx]);
+            return true;
+        });
+    }
+
+    // New priority level for idx; re-queued at that level if it is ready now
+    void reprioritize(u16 idx, u8 level) noexcept {
+        if (idx >= MaxTasks) { return; }
+        const bool held = with_owner(idx, [this, idx, level](worker& w) noexcept {
+            level_[idx] = level;
+            auto& queue = pinned_[idx] ? w.pinned : w.shared;
+            if (queue.contains(idx)) {
+                queue.remove(idx);
+                queue.push(idx, level);
+            }
+            return true;
+        });
+        // Not queued (running or unscheduled): the next schedule() carries the level
+        if (!held) { level_[idx] = level; }
+    }
+
+    /*
+     * Next task for worker `self`: expire its due timers, serve its own queues,
+     * then try to steal, expiring each victim's due timers first. The task is
+     * handed over dequeued; the caller runs it and re-schedule()s it if it
+     * should run again. npos when there is nothing to run.
+     */
+    u16 next(size_t self, timestamp_t now) noexcept {
+        self %= Workers;
+        worker& w = workers_[self];
+        w.cs.enter();
+        promote_due(w, now);
+        u16 idx = pop_local(w);
+        if (idx != npos) { owner_[idx].store(no_worker, etl::memory_order_release); }
+        w.cs.exit();
+        if (idx != npos) { return idx; }
+
+        for (size_t k = 1; k < Workers; ++k) {
+            worker& victim = workers_[(self + k) % Workers];
+            victim.cs.enter();
+            // A busy victim has not expired its own timers; those tasks are stealable too
+            promote_due(victim, now);
+            idx = victim.shared.pop_highest();
+            if (idx != npos) { owner_[idx].store(no_worker, etl::memory_order_release); }
+            victim.cs.exit();
+            if (idx != npos) {
+                w.steals.fetch_add(1U, etl::memory_order_relaxed);
+                return idx;
+            }
+        }
+        return npos;
+    }
+
+    // Earliest timer on worker `self`; false when its heap is empty
+    bool next_due(size_t self, timestamp_t& due) noexcept {
+        worker& w = workers_[self % Workers];
+        w.cs.enter();
+        const bool any = !w.timers.empty();
+        if (any) { due = w.timers.next_due(); }
+        w.cs.exit();
+        return any;
+    }
+
+    [[nodiscard]] u32 steals(size_t self) const noexcept {
+        return workers_[self % Workers].steals.load(etl::memory_order_relaxed);
+    }
+
+private:
+    struct worker {
+        os::critical_section cs;
+        ready_queues<MaxTasks, Levels> pinned;
+        ready_queues<MaxTasks, Levels> shared;
+        timer_heap<MaxTasks> timers;
+        etl::atomic<u32> steals{0};
+    };
+
+    // Move w's due timers onto its ready queues; caller holds w.cs
+    void promote_due(worker& w, timestamp_t now) noexcept {
+        for (u16 idx = w.timers.pop_due(now); idx != npos; idx = w.timers.pop_due(now)) {
+            (pinned_[idx] ? w.pinned : w.shared).push(idx, level_[idx]);
+        }
+    }
+
+    // Run fn(worker&) under the lock of the worker holding idx; false if none does
+    template <typename Fn>
+    bool with_owner(u16 idx, Fn&& fn) noexcept {
+        if (idx >= MaxTasks) { return false; }
+        for (;;) {
+            const u8 owner = owner_[idx].load(etl::memory_order_acquire);
+            if (owner == no_worker) { return false; }
+            worker& w = workers_[owner];
+            w.cs.enter();
+            if (owner_[idx].load(etl::memory_order_relaxed) != owner) {
+                w.cs.exit();
+                continue;
+            }
+            const bool out = fn(w);
+            w.cs.exit();
+            return out;
+        }
+    }
+
+    static u16 pop_local(worker& w) noexcept {
+        const u32 pm = w.pinned.mask();
+        const u32 sm = w.shared.mask();
+        if (pm == 0U && sm == 0U) { return npos; }
+        if (sm == 0U || (pm != 0U && utils::highest_set_bit(pm) >= utils::highest_set_bit(sm))) {
+            return w.pinned.pop_highest();
+        }
+        return w.shared.pop_highest();
+    }
+
+    etl::array<worker, Workers> workers_{};
+    etl::array<etl::atomic<u8>, MaxTasks> owner_{};  // worker holding idx; written under that worker's lock
+    etl::array<bool, MaxTasks> pinned_{};
+    etl::array<u8, MaxTasks> level_{};
+};
+
+}  // namespace emCore::task
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <cstddef>
+
+#include "../core/types.hpp"
+#include "../utils/helpers.hpp"
+
+#include <etl/array.h>
+
+namespace emCore::task {
+
+/**
+ * @brief Power-of-two bucketed histogram with saturating u16 counters
+ *
+ * Bucket 0 counts zero, bucket k (k >= 1) counts [2^(k-1), 2^k); the last
+ * bucket also takes everything above. Recording is one clz and one increment.
+ */
+template <size_t Buckets>
+struct log2_histogram {
+    static_assert(Buckets >= 2 && Buckets <= 32, "log2_histogram needs 2..32 buckets");
+
+    etl::array<u16, Buckets> counts{};
+    u32 max_value{0};
+
+    void record(u32 value) noexcept {
+        const size_t bucket = (value == 0U) ? 0U : static_cast<size_t>(utils::highest_set_bit(value)) + 1U;
+        u16& slot = counts[(bucket < Buckets) ? bucket : (Buckets - 1U)];
+        if (slot != 0xFFFFU) { ++slot; }
+        if (value > max_value) { max_value = value; }
+    }
+
+    void clear() noexcept {
+        counts.fill(0);
+        max_value = 0;
+    }
+
+    // Smallest value that lands in bucket i
+    static constexpr u32 bucket_floor(size_t i) noexcept { return (i == 0U) ? 0U : (1U << (i - 1U)); }
+
+    [[nodiscard]] u32 total() const noexcept {
+        u32 n = 0;
+        for (const u16 c : counts) { n += c; }
+        return n;
+    }
+};
+
+/**
+ * @brief Tail percentiles read from a histogram (same unit as the recorded values)
+ */
+struct percentiles {
+    u32 p50{0};
+    u32 p90{0};
+    u32 p99{0};
+    u32 p999{0};
+};
+
+/**
+ * @brief HDR-style log-linear histogram with u32 counters
+ *
+ * Values below 2^SubBits get one bucket each; above that every power-of-two
+ * range is split into 2^(SubBits-1) equal sub-buckets, so the bucket width is
+ * at most 2^-(SubBits-1) of the value it holds. Values of 2^MaxBits and more
+ * share a final overflow bucket (max_value stays exact). record() is a clz,
+ * two shifts and an increment. Histograms with the same parameters are plain
+ * data, so a copy is a snapshot and merge() folds snapshots together.
+ */
+template <u8 SubBits, u8 MaxBits>
+struct log_linear_histogram {
+    static_assert(SubBits >= 1 && SubBits < MaxBits && MaxBits <= 32, "log_linear_histogram needs 1 <= SubBits < MaxBits <= 32");
+
+    static constexpr u32 linear_limit = 1U << SubBits;
+    static constexpr u32 half = 1U << (SubBits - 1U);
+    static constexpr size_t bucket_count = linear_limit + ((MaxBits - SubBits) * half) + 1U;
+    static constexpr size_t overflow_bucket = bucket_count - 1U;
+
+    etl::array<u32, bucket_count> counts{};
+    u32 total{0};
+    u32 min_value{0xFFFFFFFFU};
+    u32 max_value{0};
+
+    static constexpr size_t bucket_of(u32 value) noexcept {
+        if (value < linear_limit) {
+            return value;
+        }
+        const u8 msb = utils::highest_set_bit(value);
+        if (msb >= MaxBits) {
+            return overflow_bucket;
+        }
+        const u32 shift = static_cast<u32>(msb) - SubBits + 1U;
+        return (static_cast<size_t>(shift) << (SubBits - 1U)) + (value >> shift);
+    }
+
+    // Smallest value that lands in bucket i
+    static constexpr u32 bucket_floor(size_t i) noexcept {
+        if (i < linear_limit) {
+            return static_cast<u32>(i);
+        }
+        if (i >= overflow_bucket) {
+            return (MaxBits >= 32) ? 0xFFFFFFFFU : (1U << (MaxBits & 31U));
+        }
+        const u32 shift = static_cast<u32>(i >> (SubBits - 1U)) - 1U;
+        return (static_cast<u32>(i) - (shift << (SubBits - 1U))) << shift;
+    }
+
+    // Largest value that lands in bucket i
+    static constexpr u32 bucket_ceiling(size_t i) noexcept {
+        if (i < linear_limit) {
+            return static_cast<u32>(i);
+        }
+        if (i >= overflow_bucket) {
+            return 0xFFFFFFFFU;
+        }
+        const u32 shift = static_cast<u32>(i >> (SubBits - 1U)) - 1U;
+        return bucket_floor(i) + ((1U << shift) - 1U);
+    }
+
+    void record(u32 value) noexcept {
+        u32& slot = counts[bucket_of(value)];
+        if (slot != 0xFFFFFFFFU) { ++slot; }
+        if (total != 0xFFFFFFFFU) { ++total; }
+        if (value < min_value) { min_value = value; }
+        if (value > max_value) { max_value = value; }
+    }
+
+    void merge(const log_linear_histogram& other) noexcept {
+        for (size_t i = 0; i < bucket_count; ++i) {
+            const u32 sum = counts[i] + other.counts[i];
+            counts[i] = (sum < counts[i]) ? 0xFFFFFFFFU : sum;
+        }
+        const u32 sum = total + other.total;
+        total = (sum < total) ? 0xFFFFFFFFU : sum;
+        if (other.min_value < min_value) { min_value = other.min_value; }
+        if (other.max_value > max_value) { max_value = other.max_value; }
+    }
+
+    void clear() noexcept {
+        counts.fill(0);
+        total = 0;
+        min_value = 0xFFFFFFFFU;
+        max_value = 0;
+    }
+
+    /*
+     * Value at quantile q (parts per million), reported as the top of its bucket
+     * and clamped to max_value, so it never understates the tail. 0 when empty.
+     */
+    [[nodiscard]] u32 value_at(u32 q_ppm) const noexcept {
+        const percentiles p = quantiles(q_ppm, q_ppm, q_ppm, q_ppm);
+        return p.p50;
+    }
+
+    // p50 / p90 / p99 / p99.9 in one pass over the buckets
+    [[nodiscard]] percentiles summary() const noexcept { return quantiles(500000U, 900000U, 990000U, 999000U); }
+
+private:
+    [[nodiscard]] percentiles quantiles(u32 q0, u32 q1, u32 q2, u32 q3) const noexcept {
+        percentiles out{};
+        if (total == 0U) {
+            return out;
+        }
+        const etl::array<u32, 4> q{q0, q1, q2, q3};
+        etl::array<u64, 4> rank{};
+        for (size_t k = 0; k < 4U; ++k) {
+            // Ceiling of total * q, at least the first sample
+            rank[k] = ((static_cast<u64>(total) * q[k]) + 999999U) / 1000000U;
+            if (rank[k] == 0U) { rank[k] = 1U; }
+        }
+        etl::array<u32*, 4> dst{&out.p50, &out.p90, &out.p99, &out.p999};
+        u64 seen = 0;
+        size_t next = 0;
+        for (size_t i = 0; i < bucket_count && next < 4U; ++i) {
+            seen += counts[i];
+            while (next < 4U && seen >= rank[next]) {
+                const u32 top = bucket_ceiling(i);
+                *dst[next++] = (top < max_value) ? top : max_value;
+            }
+        }
+        while (next < 4U) { *dst[next++] = max_value; }
+        return out;
+    }
+};
+
+}  // namespace emCore::task
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <cstddef>
+
+#include "../core/types.hpp"
+#include "../utils/helpers.hpp"
+
+#include <etl/array.h>
+
+namespace emCore::task {
+
+/**
+ * @brief Per-priority FIFO ready queues over task indices with a level bitmap
+ *
+ * Intrusive doubly linked lists (prev/next index arrays) give O(1) push, remove
+ * and pop; the highest non-empty level is one highest_set_bit() on the bitmap.
+ * Each index is in at most one queue.
+ */
+template <size_t MaxTasks, size_t Levels>
+class ready_queues {
+    static_assert(Levels >= 1 && Levels <= 32, "ready_queues supports 1..32 priority levels");
+    static_assert(MaxTasks < 0xFFFF, "ready_queues indexes tasks with u16");
+
+public:
+    static constexpr u16 npos = 0xFFFF;
+
+    constexpr ready_queues() noexcept { clear(); }
+
+    constexpr void clear() noexcept {
+        mask_ = 0;
+        for (size_t l = 0; l < Levels; ++l) { head_[l] = npos; tail_[l] = npos; }
+        for (size_t i = 0; i < MaxTasks; ++i) { prev_[i] = npos; next_[i] = npos; level_[i] = none; }
+    }
+
+    // Append idx to the tail of its level (FIFO among equal priorities); no-op if already queued
+    void push(u16 idx, u8 level) noexcept {
+        if (idx >= MaxTasks || level_[idx] != none) { return; }
+        if (level >= Levels) { level = static_cast<u8>(Levels - 1U); }
+        level_[idx] = level;
+        prev_[idx] = tail_[level];
+        next_[idx] = npos;
+        if (tail_[level] != npos) { next_[tail_[level]] = idx; } else { head_[level] = idx; }
+        tail_[level] = idx;
+        mask_ |= (1U << level);
+    }
+
+    void remove(u16 idx) noexcept {
+        if (idx >= MaxTasks || level_[idx] == none) { return; }
+        const u8 level = level_[idx];
+        if (prev_[idx] != npos) { next_[prev_[idx]] = next_[idx]; } else { head_[level] = next_[idx]; }
+        if (next_[idx] != npos) { prev_[next_[idx]] = prev_[idx]; } else { tail_[level] = prev_[idx]; }
+        prev_[idx] = npos;
+        next_[idx] = npos;
+        level_[idx] = none;
+        if (head_[level] == npos) { mask_ &= ~(1U << level); }
+    }
+
+    // Head of the highest non-empty level, removed from its queue; npos when empty
+    u16 pop_highest() noexcept {
+        if (mask_ == 0U) { return npos; }
+        const u16 idx = head_[utils::highest_set_bit(mask_)];
+        remove(idx);
+        return idx;
+    }
+
+    [[nodiscard]] bool contains(u16 idx) const noexcept { return idx < MaxTasks && level_[idx] != none; }
+    [[nodiscard]] bool empty() const noexcept { return mask_ == 0U; }
+    [[nodiscard]] u32 mask() const noexcept { return mask_; }
+
+private:
+    static constexpr u8 none = 0xFF;
+
+    u32 mask_{0};
+    etl::array<u16, Levels> head_{};
+    etl::array<u16, Levels> tail_{};
+    etl::array<u16, MaxTasks> prev_{};
+    etl::array<u16, MaxTasks> next_{};
+    etl::array<u8, MaxTasks> level_{};
+};
+
+/**
+ * @brief Binary min-heap of task indices keyed by wake-up time
+ *
+ * Positions are tracked per index so a suspended or re-timed task can be pulled
+ * out in O(log n); expiring timers costs O(log n) each, nothing for idle ones.
+ */
+template <size_t MaxTasks>
+class timer_heap {
+    static_assert(MaxTasks < 0xFFFF, "timer_heap indexes tasks with u16");
+
+public:
+    static constexpr u16 npos = 0xFFFF;
+
+    constexpr timer_heap() noexcept { clear(); }
+
+    constexpr void clear() noexcept {
+        size_ = 0;
+        for (size_t i = 0; i < MaxTasks; ++i) { pos_[i] = npos; }
+    }
+
+    // Insert or re-key idx
+    void push(u16 idx, timestamp_t due) noexcept {
+        if (idx >= MaxTasks) { return; }
+        if (pos_[idx] != npos) { remove(idx); }
+        const size_t at = size_++;
+        heap_[at] = entry{due, idx};
+        pos_[idx] = static_cast<u16>(at);
+        sift_up(at);
+    }
+
+    void remove(u16 idx) noexcept {
+        if (idx >= MaxTasks || pos_[idx] == npos) { return; }
+        const size_t at = pos_[idx];
+        pos_[idx] = npos;
+        --size_;
+        if (at == size_) { return; }
+        const u16 moved = heap_[size_].idx;
+        place(at, heap_[size_]);
+        sift_up(at);
+        if (pos_[moved] == at) { sift_down(at); }
+    }
+
+    // Pop the earliest entry if it is due at now; npos otherwise
+    u16 pop_due(timestamp_t now) noexcept {
+        if (size_ == 0U || heap_[0].due > now) { return npos; }
+        const u16 idx = heap_[0].idx;
+        remove(idx);
+        return idx;
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0U; }
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool contains(u16 idx) const noexcept { return idx < MaxTasks && pos_[idx] != npos; }
+    // Earliest wake-up time; only meaningful when !empty()
+    [[nodiscard]] timestamp_t next_due() const noexcept { return heap_[0].due; }
+
+private:
+    struct entry {
+        timestamp_t due;
+        u16 idx;
+    };
+
+    void place(size_t at, const entry& e) noexcept {
+        heap_[at] = e;
+        pos_[e.idx] = static_cast<u16>(at);
+    }
+
+    void sift_up(size_t at) noexcept {
+        const entry e = heap_[at];
+        while (at > 0U) {
+            const size_t parent = (at - 1U) / 2U;
+            if (!(e.due < heap_[parent].due)) { break; }
+            place(at, heap_[parent]);
+            at = parent;
+        }
+        place(at, e);
+    }
+
+    void sift_down(size_t at) noexcept {
+        const entry e = heap_[at];
+        for (;;) {
+            const size_t left = (2U * at) + 1U;
+            if (left >= size_) { break; }
+            const size_t right = left + 1U;
+            const size_t child = (right < size_ && heap_[right].due < heap_[left].due) ? right : left;
+            if (!(heap_[child].due < e.due)) { break; }
+            place(at, heap_[child]);
+            at = child;
+        }
+        place(at, e);
+    }
+
+    etl::array<entry, MaxTasks> heap_{};
+    etl::array<u16, MaxTasks> pos_{};
+    size_t size_{0};
+};
+
+}  // namespace emCore::task
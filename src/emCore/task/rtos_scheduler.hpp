@@ -7,6 +7,8 @@
 #include "../os/tasks.hpp"
 #include "../platform/platform.hpp"
 
+#include <etl/algorithm.h>
+#include <etl/array.h>
 #include <etl/vector.h>
 #include <cstddef>
 
@@ -31,6 +33,24 @@ enum class yield_strategy : u8 {
     adaptive        // Yield based on system load
 };
 
+/**
+ * @brief What happens once a task overruns its execution budget
+ * Every overrun is counted and reported to the overrun callback; the action
+ * fires when consecutive overruns reach the task's overrun limit.
+ */
+enum class budget_action : u8 {
+    report,         // Count and report only
+    demote,         // Drop the task one priority level (cooperative tasks)
+    suspend         // Suspend the task until it is resumed explicitly
+};
+
+/**
+ * @brief Overrun notification: measured execution time against the budget, in us
+ */
+using overrun_callback_t = void (*)(task_id_t task_id, duration_t used_us, duration_t budget_us) noexcept;
+
+
+inline constexpr u8 no_requested_core = 0xFF;
 
 /**
  * @brief Task execution context for RTOS optimization
@@ -42,7 +62,8 @@ struct task_execution_context {
     size_t stack_high_water_mark{0};
     
     // CPU affinity (for multi-core MCUs like ESP32)
-    u8 cpu_core_id{0};
+    u8 cpu_core_id{0};                      // core the task is placed on (applied placements only)
+    u8 requested_core{no_requested_core};   // core asked for by set_cpu_affinity
     bool pin_to_core{false};
     
     // Scheduling behavior
@@ -54,31 +75,70 @@ struct task_execution_context {
     duration_t deadline_us{0}; // 0 = no deadline
     bool is_realtime{false};
     
+    // Execution budget enforcement (set_realtime_constraints / set_execution_budget)
+    bool enforce_budget{false};
+    budget_action on_overrun{budget_action::report};
+    u8 overrun_limit{1};            // Consecutive overruns before on_overrun fires
+    u8 consecutive_overruns{0};
+    u32 overrun_count{0};
+    u32 enforcement_count{0};       // Times on_overrun was applied
+    
     // Performance tracking
     u32 execution_count{0};
     duration_t total_execution_time_us{0};
+    duration_t last_execution_time_us{0};
+    duration_t worst_execution_time_us{0};
     timestamp_t last_execution_start{0};
+    u32 last_execution_start_cycles{0};
 };
 
+/**
+ * @brief Applies a core placement to a live task; returns true if it took effect
+ * Installed by taskmaster so set_cpu_affinity()/place() reach native task handles.
+ */
+using affinity_hook_t = bool (*)(task_id_t task_id, u8 core_id) noexcept;
+
+/**
+ * @brief Carries out a budget_action on a live task; returns true if it took effect
+ * Installed by taskmaster, which owns task priorities and suspension.
+ */
+using budget_hook_t = bool (*)(task_id_t task_id, budget_action action) noexcept;
+
 /**
  * @brief RTOS task scheduler with embedded optimizations
  */
 class rtos_scheduler {
 private:
     static constexpr size_t max_contexts = config::max_tasks;
+    static constexpr u8 no_slot = 0xFF;
+    static_assert(max_contexts < no_slot, "rtos_scheduler slot index is u8");
     
     etl::vector<task_execution_context, max_contexts> contexts_;
     etl::vector<task_id_t, max_contexts> task_ids_;
+    // Task ids are dense taskmaster indices: id -> slot without a scan
+    etl::array<u8, max_contexts> slot_of_{};
+    affinity_hook_t affinity_hook_{nullptr};
+    budget_hook_t budget_hook_{nullptr};
+    overrun_callback_t overrun_callback_{nullptr};
     
     // System load tracking
     u32 total_cpu_time_us_{0};
     u32 idle_time_us_{0};
     [[maybe_unused]] timestamp_t last_load_calculation_{0};
+    etl::array<u32, config::max_cpu_cores> core_busy_us_{};
     
     /**
-     * @brief Find execution context for task
+     * @brief Find execution context for task (O(1) for ids below max_tasks)
      */
     task_execution_context* find_context(task_id_t task_id) noexcept {
+        return const_cast<task_execution_context*>(static_cast<const rtos_scheduler*>(this)->find_context(task_id));  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+    }
+    const task_execution_context* find_context(task_id_t task_id) const noexcept {
+        const u16 id = task_id.value();
+        if (id < max_contexts) {
+            const u8 slot = slot_of_[id];
+            return (slot != no_slot) ? &contexts_[slot] : nullptr;
+        }
         for (size_t i = 0; i < task_ids_.size(); ++i) {
             if (task_ids_[i] == task_id) {
                 return &contexts_[i];
@@ -87,8 +147,43 @@ private:
         return nullptr;
     }
     
+    /*
+     * Time since start_execution_timing(): cycle-accurate while the activation
+     * is shorter than one cycle-counter wrap, microsecond timer beyond that
+     */
+    static duration_t elapsed_us(const task_execution_context& context) noexcept {
+        const timestamp_t coarse = os::time_us() - context.last_execution_start;
+        const u32 hz = os::cycle_hz();
+        const u64 wrap_us = (hz != 0U) ? ((1ULL << 32U) * 1000000ULL) / hz : 0U;
+        if (coarse + 1000U >= wrap_us) {
+            return static_cast<duration_t>(coarse);
+        }
+        return os::cycles_to_us(os::cycles() - context.last_execution_start_cycles);
+    }
+    
+    void check_budget(task_id_t task_id, task_execution_context& context, duration_t used_us) noexcept {
+        if (used_us <= context.max_execution_time_us) {
+            context.consecutive_overruns = 0;
+            return;
+        }
+        context.overrun_count++;
+        if (context.consecutive_overruns < 0xFFU) {
+            context.consecutive_overruns++;
+        }
+        if (overrun_callback_ != nullptr) {
+            overrun_callback_(task_id, used_us, context.max_execution_time_us);
+        }
+        if (context.on_overrun == budget_action::report || context.consecutive_overruns < context.overrun_limit) {
+            return;
+        }
+        context.consecutive_overruns = 0;
+        if (budget_hook_ != nullptr && budget_hook_(task_id, context.on_overrun)) {
+            context.enforcement_count++;
+        }
+    }
+    
 public:
-    rtos_scheduler() noexcept = default;
+    rtos_scheduler() noexcept { slot_of_.fill(no_slot); }
     
     /**
      * @brief Register task for RTOS scheduling optimization
@@ -98,6 +193,9 @@ public:
             return false;
         }
         
+        if (task_id.value() < max_contexts) {
+            slot_of_[task_id.value()] = static_cast<u8>(task_ids_.size());
+        }
         task_ids_.push_back(task_id);
         contexts_.push_back(context);
         return true;
@@ -108,19 +206,48 @@ public:
      * @param task_id Task identifier
      * @param core_id CPU core number (0 or 1 for ESP32)
      * @param pin_to_core Whether to pin task to specific core
+     * @return true when the task was moved now; otherwise the request is kept
+     *         in requested_core and applies at creation (taskmaster::create_native_task)
      */
-    void set_cpu_affinity(task_id_t task_id, cpu_core_id core_id, bool pin_to_core = true) noexcept {
+    bool set_cpu_affinity(task_id_t task_id, cpu_core_id core_id, bool pin_to_core = true) noexcept {
         auto* context = find_context(task_id);
-        if (context != nullptr) {
+        if (context == nullptr) {
+            return false;
+        }
+        context->requested_core = core_id.value();
+        context->pin_to_core = pin_to_core;
+        const bool applied = (affinity_hook_ != nullptr) && affinity_hook_(task_id, core_id.value());
+        if (applied) {
             context->cpu_core_id = core_id.value();
-            context->pin_to_core = pin_to_core;
-            
-            // Note: CPU core pinning would need integration with taskmaster 
-            // to get the actual task handle for platform-specific calls
-            // This is stored for future use when taskmaster integration is added
         }
+        return applied;
     }
     
+    /**
+     * @brief Balancer placement: move a task without marking it user-pinned
+     */
+    bool place(task_id_t task_id, u8 core_id) noexcept {
+        auto* context = find_context(task_id);
+        if (context == nullptr || context->pin_to_core) {
+            return false;
+        }
+        const bool applied = (affinity_hook_ != nullptr) && affinity_hook_(task_id, core_id);
+        if (applied) {
+            context->cpu_core_id = core_id;
+        }
+        return applied;
+    }
+    
+    /* Record a placement made outside the hook (native task creation) */
+    void set_placed_core(task_id_t task_id, u8 core_id) noexcept {
+        auto* context = find_context(task_id);
+        if (context != nullptr) {
+            context->cpu_core_id = core_id;
+        }
+    }
+    
+    void set_affinity_hook(affinity_hook_t hook) noexcept { affinity_hook_ = hook; }
+    
     /**
      * @brief Set real-time constraints for critical tasks
      * @param task_id Task identifier
@@ -134,10 +261,43 @@ public:
             context->max_execution_time_us = max_execution.value();
             context->deadline_us = deadline.value();
             context->is_realtime = true;
+            context->enforce_budget = true;
             context->yield_behavior = yield_strategy::never; // RT tasks don't yield
         }
     }
     
+    /**
+     * @brief Enforce an execution budget, measured with the cycle counter
+     * @param budget Longest allowed run per activation in microseconds
+     * @param action What to do after `limit` consecutive overruns
+     */
+    bool set_execution_budget(task_id_t task_id, execution_time_us budget,
+                              budget_action action = budget_action::report, u8 limit = 1) noexcept {
+        auto* context = find_context(task_id);
+        if (context == nullptr) {
+            return false;
+        }
+        context->max_execution_time_us = budget.value();
+        context->on_overrun = action;
+        context->overrun_limit = (limit != 0U) ? limit : 1U;
+        context->consecutive_overruns = 0;
+        context->enforce_budget = true;
+        return true;
+    }
+    
+    void set_overrun_callback(overrun_callback_t callback) noexcept { overrun_callback_ = callback; }
+    void set_budget_hook(budget_hook_t hook) noexcept { budget_hook_ = hook; }
+    
+    /**
+     * @brief Mid-run checkpoint for long handlers: true once the running
+     * activation has used up its budget, so the handler can bail out early
+     */
+    [[nodiscard]] bool budget_exceeded(task_id_t task_id) const noexcept {
+        const auto* context = find_context(task_id);
+        return (context != nullptr) && context->enforce_budget && (context->last_execution_start > 0) &&
+               (elapsed_us(*context) > context->max_execution_time_us);
+    }
+    
     /**
      * @brief Adaptive yield - call this in task loops
      */
@@ -187,6 +347,7 @@ public:
         auto* context = find_context(task_id);
         if (context != nullptr) {
             context->last_execution_start = os::time_us();
+            context->last_execution_start_cycles = os::cycles();
         }
     }
     
@@ -196,10 +357,15 @@ public:
     void end_execution_timing(task_id_t task_id) noexcept {
         auto* context = find_context(task_id);
         if (context != nullptr && context->last_execution_start > 0) {
-            timestamp_t now = os::time_us();
-            duration_t execution_time = now - context->last_execution_start;
+            const duration_t execution_time = elapsed_us(*context);
             
+            context->last_execution_time_us = execution_time;
+            context->worst_execution_time_us = etl::max(context->worst_execution_time_us, execution_time);
             context->total_execution_time_us += execution_time;
+            total_cpu_time_us_ += execution_time;
+            if (context->cpu_core_id < core_busy_us_.size()) {
+                core_busy_us_[context->cpu_core_id] += execution_time;
+            }
             
             // Check for deadline violations
             if (context->deadline_us > 0 && execution_time > context->deadline_us) {
@@ -207,6 +373,9 @@ public:
                 platform::logf("DEADLINE MISS: Task %u took %u us (limit: %u us)",
                               static_cast<u32>(task_id.value()), execution_time, context->deadline_us);
             }
+            if (context->enforce_budget) {
+                check_budget(task_id, *context, execution_time);
+            }
         }
     }
     
@@ -239,12 +408,17 @@ public:
      * @brief Get task execution statistics
      */
     const task_execution_context* get_task_context(task_id_t task_id) const noexcept {
-        for (size_t i = 0; i < task_ids_.size(); ++i) {
-            if (task_ids_[i] == task_id) {
-                return &contexts_[i];
-            }
-        }
-        return nullptr;
+        return find_context(task_id);
+    }
+    
+    /* Registered tasks, in registration order */
+    [[nodiscard]] size_t task_count() const noexcept { return task_ids_.size(); }
+    [[nodiscard]] task_id_t task_at(size_t i) const noexcept { return task_ids_[i]; }
+    [[nodiscard]] const task_execution_context& context_at(size_t i) const noexcept { return contexts_[i]; }
+    
+    /* Execution time accumulated on a core (by placement) since start, wrapping */
+    [[nodiscard]] u32 get_core_busy_us(u8 core) const noexcept {
+        return (core < core_busy_us_.size()) ? core_busy_us_[core] : 0U;
     }
     
     /**
@@ -6,6 +6,8 @@
 #include "../core/config.hpp"
 #include "../error/result.hpp"
 #include "../os/tasks.hpp"
+#include "../os/sync.hpp"
+#include "../os/wake.hpp"
 #include <new>
 #include "task_config.hpp"
 #include "../messaging/message_broker.hpp"
@@ -13,6 +15,10 @@
 #include "../messaging/broker_global.hpp"
 #if EMCORE_ENABLE_ZC
 #include "../messaging/zero_copy.hpp"
+#include "../messaging/fanout_broker.hpp"
+#endif
+#if EMCORE_ENABLE_SLAB_BROKER
+#include "../messaging/slab_message.hpp"
 #endif
 #if EMCORE_ENABLE_EVENT_LOGS
 #include "../messaging/event_log.hpp"
@@ -20,13 +26,32 @@
 #include "../messaging/qos_pubsub.hpp"
 #include "../messaging/distributed_state.hpp"
 #include "../memory/layout.hpp"
+#include "../memory/lazy_object.hpp"
 #include "../runtime.hpp"
 #include "rtos_scheduler.hpp"
+#include "ready_queue.hpp"
+#include "executor.hpp"
+#include "histogram.hpp"
 #include "watchdog.hpp"
+#if EMCORE_ENABLE_COROUTINES
+#include "coroutine.hpp"
+#endif
+#if EMCORE_ENABLE_EVENTS
+#include "../event/events_global.hpp"
+#endif
+#if EMCORE_ENABLE_SCRATCH_ARENA
+#include "../memory/scratch_arena.hpp"
+#endif
+#include "../diagnostics/trace_stream.hpp"
+#include "../diagnostics/profile_zone.hpp"
+#include "../diagnostics/boot_timeline.hpp"
 
 #include "../os/time.hpp"
 
 #include <etl/algorithm.h>
+#include <etl/array.h>
+#include <etl/atomic.h>
+#include <etl/type_traits.h>
 #include <etl/utility.h>
 #include "../messaging/broker_global.hpp"
 
@@ -51,12 +76,29 @@ enum class task_state : u8 {
 
 /* task_id_t and invalid_task_id now defined in core/types.hpp */
 
+/* What a periodic task does when a run ends past its next release */
+enum class overrun_policy : u8 {
+    skip,      /* drop the missed releases and stay on the original phase */
+    catch_up   /* run every missed release back to back */
+};
+
+/* How run() orders ready cooperative tasks */
+enum class scheduling_policy : u8 {
+    fixed_priority,           /* highest priority_level first, FIFO within a level */
+    earliest_deadline_first   /* earliest absolute deadline first; priority_level ignored */
+};
+
 struct task_statistics {
     duration_t min_execution_time{0xFFFFFFFF};
     duration_t max_execution_time{0};
     duration_t avg_execution_time{0};
     u32 missed_deadlines{0};
     u32 total_execution_time{0};
+    u32 overruns{0};          /* runs that ended past the next release */
+    u32 skipped_releases{0};  /* releases dropped by overrun_policy::skip */
+    /* Periodic tasks, in us: start vs. ideal release, and start vs. becoming ready */
+    task::log2_histogram<config::task_jitter_buckets> release_jitter{};
+    task::log2_histogram<config::task_jitter_buckets> start_latency{};
 };
 
 struct task_control_block {
@@ -77,37 +119,58 @@ struct task_control_block {
     os::task_handle_t native_handle{nullptr};  /* RTOS task handle */
     u32 stack_size{4096};  /* Stack size in bytes */
     bool is_native{false};  /* True if created as native RTOS task */
+    bool wake_on_message{false};  /* Periodic cooperative task runs early when a message arrives */
+    duration_t wcet_us{0};  /* Declared worst-case execution time (task_config::max_execution_time) */
+    overrun_policy on_overrun{overrun_policy::skip};
+    timestamp_t ready_us{0};  /* When the current release was queued as ready */
+#if EMCORE_ENABLE_SCRATCH_ARENA
+    u8 scratch_slot{0xFF};  /* Native tasks: own scratch slot (0xFF = none); cooperative use their worker's */
+    size_t scratch_peak{0};  /* Largest scratch usage of a single invocation */
+#endif
 };
 class taskmaster {
 private:
+    /* First member, so the stamp precedes every other member's construction */
+    struct boot_stamp {
+        explicit boot_stamp(diagnostics::boot_phase phase) noexcept { diagnostics::get_boot_timeline().mark(phase); }
+    };
+    boot_stamp boot_begin_{diagnostics::boot_phase::construct_begin};
     etl::vector<task_control_block, config::max_tasks> tasks_;
     task_id_t next_task_id_{invalid_task_id};
     bool initialized_{false};
     
     volatile bool tasks_ready_{false};  /* Flag to signal tasks can start */
     timestamp_t scheduler_start_time_{0};
-    u32 total_context_switches_{0};
-    // Brokers & pools
+    etl::atomic<u32> total_context_switches_{0};
+    // Brokers & pools, constructed on first use (EMCORE_LAZY_SUBSYSTEMS) or in the constructor
     using medium_broker_t = messaging::message_broker<medium_message, config::max_tasks>;
 
     #if EMCORE_ENABLE_SMALL_BROKER
     using small_broker_t = messaging::message_broker<small_message, config::max_tasks>;
-    alignas(small_broker_t) unsigned char EMCORE_BSS_ATTR small_broker_storage_[sizeof(small_broker_t)]{};
-    etl::unique_ptr<small_broker_t, messaging::pool_deleter<small_broker_t>> small_broker_{};
+    memory::lazy_object<small_broker_t> small_broker_;
+    #endif
+
+    // Slab broker: header + slab reference per queue slot, payloads in size classes
+    #if EMCORE_ENABLE_SLAB_BROKER
+    using slab_pool_t   = messaging::slab_pool;
+    using slab_msg_t    = messaging::slab_message;
+    using slab_broker_t = messaging::message_broker<slab_msg_t, config::max_tasks>;
+    memory::lazy_object<slab_pool_t> slab_pool_;
+    memory::lazy_object<slab_broker_t> slab_broker_;
     #endif
 
     // Zero-copy pool and broker (sized via config)
     #if EMCORE_ENABLE_ZC
     static constexpr size_t zc_block_size_  = config::zc_block_size;
     static constexpr size_t zc_block_count_ = config::zc_block_count;
-    using zc_pool_t = messaging::zero_copy_pool<zc_block_size_, zc_block_count_>;
+    using zc_pool_t = typename etl::conditional<config::zc_lock_free,
+                                                messaging::lockfree_zero_copy_pool<zc_block_size_, zc_block_count_>,
+                                                messaging::zero_copy_pool<zc_block_size_, zc_block_count_>>::type;
     using zc_msg_t  = messaging::zc_message_envelope<zc_pool_t>;
     using zc_broker_t = messaging::message_broker<zc_msg_t, config::max_tasks>;
 
-    alignas(zc_pool_t)   unsigned char EMCORE_BSS_ATTR zc_pool_storage_[sizeof(zc_pool_t)]{};
-    zc_pool_t* zc_pool_ptr_{nullptr};
-    alignas(zc_broker_t) unsigned char EMCORE_BSS_ATTR zc_broker_storage_[sizeof(zc_broker_t)]{};
-    etl::unique_ptr<zc_broker_t, messaging::pool_deleter<zc_broker_t>> zc_broker_{};
+    memory::lazy_object<zc_pool_t> zc_pool_;
+    memory::lazy_object<zc_broker_t> zc_broker_;
     #endif
 
     // Event logs (capacities via config)
@@ -115,17 +178,43 @@ private:
     using med_log_t   = messaging::event_log<medium_message, config::event_log_med_cap, true>;
     using small_log_t = messaging::event_log<small_message, config::event_log_sml_cap, true>;
     using zc_log_t    = messaging::event_log<zc_msg_t,      config::event_log_zc_cap,  true>;
-    alignas(med_log_t)   unsigned char EMCORE_BSS_ATTR med_log_storage_[sizeof(med_log_t)]{};
-    alignas(small_log_t) unsigned char EMCORE_BSS_ATTR small_log_storage_[sizeof(small_log_t)]{};
-    alignas(zc_log_t)    unsigned char EMCORE_BSS_ATTR zc_log_storage_[sizeof(zc_log_t)]{};
-    med_log_t*   med_log_{nullptr};
-    small_log_t* small_log_{nullptr};
-    zc_log_t*    zc_log_{nullptr};
+    memory::lazy_object<med_log_t>   med_log_;
+    memory::lazy_object<small_log_t> small_log_;
+    memory::lazy_object<zc_log_t>    zc_log_;
     #endif
     timestamp_t total_idle_time_{0};
     timestamp_t last_idle_time_{0};
+    /* Cooperative scheduling: due tasks per priority, sleeping periodic tasks by next_run_time */
+    static constexpr size_t priority_levels = static_cast<size_t>(priority::critical) + 1U;
+    static constexpr size_t no_worker_hint = static_cast<size_t>(-1);
+#if EMCORE_TASK_WORKERS > 1
+    task::work_stealing_executor<config::max_tasks, priority_levels, config::task_workers> executor_;
+    etl::array<os::task_handle_t, config::task_workers> worker_handles_{};
+#else
+    task::ready_queues<config::max_tasks, priority_levels> ready_;
+    task::timer_heap<config::max_tasks> timers_;
+    task::timer_heap<config::max_tasks> edf_;  /* Ready tasks keyed by absolute deadline (EDF policy) */
+#endif
+    scheduling_policy policy_{scheduling_policy::fixed_priority};
+    bool admission_control_{true};
+    /* Early-run requests posted by wake hooks (any context), drained by run() */
+    static constexpr size_t wake_words = (config::max_tasks + 31U) / 32U;
+    etl::array<etl::atomic<u32>, wake_words> pending_wake_{};
+    os::semaphore_handle_t idle_sem_{nullptr};  /* Tickless idle blocks here until the next due task */
+    etl::array<timestamp_t, config::task_workers> idle_us_{};  /* Per worker, written only by that worker */
+#if EMCORE_ENABLE_COROUTINES && EMCORE_COROUTINES_AVAILABLE
+    task::coroutine_scheduler<config::max_coroutines> coros_;  /* Resumed by worker 0 */
+#endif
+#if EMCORE_ENABLE_SCRATCH_ARENA
+    /* Slots 0..workers-1 serve the cooperative workers, the rest are handed to native tasks */
+    static constexpr size_t scratch_slots = config::task_workers + config::scratch_native_slots;
+    static constexpr u8 no_scratch_slot = 0xFF;
+    etl::array<memory::scratch_arena, scratch_slots> scratch_{};
+    size_t next_native_scratch_{0};
+#endif
     taskmaster() noexcept
-        : tasks_()
+        : boot_begin_{diagnostics::boot_phase::construct_begin}
+        , tasks_()
         , next_task_id_{invalid_task_id}
         , initialized_{false}
         , tasks_ready_{false}
@@ -134,26 +223,16 @@ private:
         , total_idle_time_{0}
         , last_idle_time_{0}
     {
-        /* Construct brokers/pools/logs in-place to avoid dynamic allocation */
-        // Medium broker now centralized via TLSF arena in messaging::global_medium_broker()
-        (void)messaging::global_medium_broker();
-        // Small broker
-        #if EMCORE_ENABLE_SMALL_BROKER
-        auto* sptr = new (static_cast<void*>(small_broker_storage_)) small_broker_t();
-        small_broker_ = etl::unique_ptr<small_broker_t, messaging::pool_deleter<small_broker_t>>(sptr, messaging::pool_deleter<small_broker_t>{nullptr});
-        #endif
-        // Zero-copy pool + broker
-        #if EMCORE_ENABLE_ZC
-        zc_pool_ptr_ = new (static_cast<void*>(zc_pool_storage_)) zc_pool_t();
-        auto* zbptr = new (static_cast<void*>(zc_broker_storage_)) zc_broker_t();
-        zc_broker_ = etl::unique_ptr<zc_broker_t, messaging::pool_deleter<zc_broker_t>>(zbptr, messaging::pool_deleter<zc_broker_t>{nullptr});
-        #endif
-        // Event logs
-        #if EMCORE_ENABLE_EVENT_LOGS
-        med_log_   = new (static_cast<void*>(med_log_storage_))   med_log_t();
-        small_log_ = new (static_cast<void*>(small_log_storage_)) small_log_t();
-        zc_log_    = new (static_cast<void*>(zc_log_storage_))    zc_log_t();
-        #endif
+        /* Brokers/pools/logs live in-place (no dynamic allocation); eager mode builds them all now */
+        if constexpr (!config::lazy_subsystems) {
+            construct_brokers();
+            #if EMCORE_ENABLE_EVENT_LOGS
+            (void)med_log_.get();
+            (void)small_log_.get();
+            (void)zc_log_.get();
+            #endif
+        }
+        diagnostics::get_boot_timeline().mark(diagnostics::boot_phase::constructed);
     }
     
     
@@ -201,10 +280,37 @@ public:
         tasks_.clear();
         next_task_id_.value() = 0;
         scheduler_start_time_ = get_current_time();
-        total_context_switches_ = 0;
+        total_context_switches_.store(0U, etl::memory_order_relaxed);
         total_idle_time_ = 0;
         last_idle_time_ = 0;
+#if EMCORE_TASK_WORKERS > 1
+        executor_.clear();
+#else
+        ready_.clear();
+        timers_.clear();
+        edf_.clear();
+#endif
+        idle_us_.fill(0);
+#if EMCORE_ENABLE_SCRATCH_ARENA
+        for (size_t slot = 0; slot < scratch_slots; ++slot) {
+            scratch_[slot].attach(static_cast<u8*>(runtime::scratch_region()) + (slot * config::scratch_arena_bytes),
+                                  config::scratch_arena_bytes);
+        }
+        next_native_scratch_ = 0;
+#endif
+        for (auto& word : pending_wake_) {
+            word.store(0U, etl::memory_order_relaxed);
+        }
+        if (config::task_tickless_idle && idle_sem_ == nullptr) {
+            idle_sem_ = os::create_binary_semaphore();
+        }
+        /* ISRs may publish, and lazy_object must not be first touched from one */
+        construct_brokers();
+        os::set_cooperative_wake(&taskmaster::cooperative_wake);
+        task::get_global_scheduler().set_affinity_hook(&taskmaster::apply_affinity);
+        task::get_global_scheduler().set_budget_hook(&taskmaster::apply_budget);
         initialized_ = true;
+        diagnostics::get_boot_timeline().mark(diagnostics::boot_phase::initialized);
         
         return ok();
     }
@@ -215,6 +321,11 @@ public:
             return result<void, error_code>(error_code::not_initialized);
         }
         
+        auto admitted = check_schedulability(config_table, N);
+        if (admitted.is_error()) {
+            return result<void, error_code>(admitted.error());
+        }
+        
         for (size_t i = 0; i < N; ++i) {
             if (config_table[i].enabled) {
                 /* Check config flag to decide native vs cooperative */
@@ -235,6 +346,7 @@ public:
             }
         }
         
+        diagnostics::get_boot_timeline().mark(diagnostics::boot_phase::tasks_created);
         return ok();
     }
     
@@ -259,9 +371,11 @@ public:
         tcb.created_time = get_current_time();
         tcb.period_ms = cfg.period_ms;
         tcb.next_run_time = tcb.created_time;
+        tcb.wcet_us = cfg.max_execution_time.value();
         tcb.is_native = false;
         
         tasks_.push_back(tcb);
+        schedule(tasks_.back(), tcb.created_time);
         
         return result<task_id_t, error_code>(new_id);
     }
@@ -286,7 +400,15 @@ public:
         tcb.created_time = get_current_time();
         tcb.period_ms = cfg.period_ms;
         tcb.stack_size = cfg.stack_size.value();
+        tcb.wcet_us = cfg.max_execution_time.value();
         tcb.is_native = true;
+#if EMCORE_ENABLE_SCRATCH_ARENA
+        if (next_native_scratch_ < config::scratch_native_slots) {
+            tcb.scratch_slot = static_cast<u8>(config::task_workers + next_native_scratch_++);
+        }
+#endif
+        
+        const native_placement where = place_native(tcb, cfg);
         
         /* Reserve space to prevent reallocation invalidating pointers */
         if (tasks_.available() == 0) {
@@ -312,8 +434,8 @@ public:
             cfg.rtos_priority.value(),
             handle_ptr,  /* Use stable pointer */
             false,  /* start_suspended */
-            (cfg.cpu_affinity.value() >= 0),  /* pin_to_core */
-            static_cast<int>(cfg.cpu_affinity.value())  /* core_id */
+            where.core >= 0,  /* pin_to_core */
+            where.core  /* core_id */
         };
         
         if (!os::create_native_task(params)) {
@@ -321,6 +443,18 @@ public:
             return result<task_id_t, error_code>(error_code::invalid_parameter);
         }
         
+        /* Record the placement so the balancer and set_cpu_affinity see it */
+        auto& sched = task::get_global_scheduler();
+        if (sched.get_task_context(tcb.id) == nullptr) {
+            task::task_execution_context ctx{};
+            ctx.stack_size_bytes = cfg.stack_size.value();
+            ctx.cpu_core_id = static_cast<u8>((where.core >= 0) ? where.core : 0);
+            ctx.pin_to_core = where.user_pinned;
+            (void)sched.register_task(tcb.id, ctx);
+        } else if (where.core >= 0) {
+            sched.set_placed_core(tcb.id, static_cast<u8>(where.core));
+        }
+        
         return result<task_id_t, error_code>(tcb.id);
     }
 
@@ -334,6 +468,8 @@ public:
         
         if (task->state == task_state::suspended) {
             task->state = task_state::ready;
+            schedule(*task, get_current_time());
+            wake();
             return ok();
         }
         
@@ -347,15 +483,158 @@ public:
         }
         
         task->state = task_state::suspended;
+        unschedule(*task);
         return ok();
     }
     
     result<void, error_code> resume_task(task_id_t task_id) noexcept {
         return start_task(task_id);
     }
+
+    /* Let a message or notify_wake() pull a periodic cooperative task's next run forward */
+    result<void, error_code> set_wake_on_message(task_id_t task_id, bool enable) noexcept {
+        auto* task = find_task(task_id);
+        if (task == nullptr) {
+            return result<void, error_code>(error_code::not_found);
+        }
+        task->wake_on_message = enable;
+        return ok();
+    }
+
+    /* What a periodic task does when it overruns its next release (default skip) */
+    result<void, error_code> set_overrun_policy(task_id_t task_id, overrun_policy policy) noexcept {
+        auto* task = find_task(task_id);
+        if (task == nullptr) {
+            return result<void, error_code>(error_code::not_found);
+        }
+        task->on_overrun = policy;
+        return ok();
+    }
+
+    /*
+     * Request an early run of task_id (honoured when it opted in via
+     * set_wake_on_message) and end a tickless idle sleep. Safe from any task or
+     * ISR; invalid_task_id only wakes the scheduler. Installed as the
+     * os::wake_cooperative() hook by initialize().
+     */
+    void notify_wake(task_id_t task_id) noexcept {
+        const u16 idx = task_id.value();
+        if (idx < config::max_tasks) {
+            pending_wake_[idx / 32U].fetch_or(1U << (idx % 32U), etl::memory_order_release);
+        }
+#if EMCORE_ENABLE_COROUTINES && EMCORE_COROUTINES_AVAILABLE
+        coros_.notify(task_id);
+#endif
+        wake();
+    }
+
+#if EMCORE_ENABLE_COROUTINES && EMCORE_COROUTINES_AVAILABLE
+    /*
+     * Run a co_task alongside the cooperative tasks; run() on worker 0 resumes
+     * it whenever an awaited message, event or deadline arrives. out_of_memory
+     * when no frame could be allocated or every coroutine slot is taken.
+     */
+    result<void, error_code> spawn(task::co_task&& coroutine) noexcept {
+        const auto r = coros_.spawn(etl::move(coroutine));
+        if (r.is_ok()) {
+            wake();
+        }
+        return r;
+    }
+    [[nodiscard]] size_t get_coroutine_count() const noexcept { return coros_.count(); }
+    task::coroutine_scheduler<config::max_coroutines>& get_coroutines() noexcept { return coros_; }
+#endif
+
+    /* End a tickless idle sleep so run() re-evaluates its queues */
+    void wake() noexcept {
+        if (idle_sem_ != nullptr) {
+            (void)os::semaphore_give(idle_sem_);
+        }
+    }
+    
+    /*
+     * Select how ready cooperative tasks are ordered; queued tasks move over.
+     * EDF needs the single-worker scheduler (EMCORE_TASK_WORKERS == 1).
+     */
+    result<void, error_code> set_scheduling_policy(scheduling_policy policy) noexcept {
+#if EMCORE_TASK_WORKERS > 1
+        if (policy != scheduling_policy::fixed_priority) {
+            return result<void, error_code>(error_code::invalid_parameter);
+        }
+        policy_ = policy;
+#else
+        if (policy == policy_) {
+            return ok();
+        }
+        const timestamp_t now = get_current_time();
+        policy_ = policy;
+        for (auto& tcb : tasks_) {
+            const u16 idx = tcb.id.value();
+            if (ready_.contains(idx) || edf_.contains(idx)) {
+                ready_.remove(idx);
+                edf_.remove(idx);
+                make_ready(idx, now);
+            }
+        }
+#endif
+        return ok();
+    }
+    [[nodiscard]] scheduling_policy get_scheduling_policy() const noexcept { return policy_; }
+    
+    /* Reject task tables whose cooperative utilization exceeds the policy's bound (default on) */
+    void set_admission_control(bool enable) noexcept { admission_control_ = enable; }
+    
+    /*
+     * Admission test for adding `count` configs to the current cooperative set.
+     * Each periodic task contributes WCET / min(deadline, period), with WCET the
+     * larger of the declared max_execution_time and the measured maximum; tasks
+     * without either contribute nothing. EDF admits up to 100 %, fixed
+     * priority up to the Liu & Layland bound n(2^(1/n) - 1). Returns the
+     * resulting load in parts per million, or not_schedulable.
+     */
+    result<u32, error_code> check_schedulability(const task_config* configs, size_t count) const noexcept {
+        u64 load_ppm = 0;
+        size_t periodic = 0;
+        for (const auto& tcb : tasks_) {
+            if (tcb.is_native || tcb.period_ms == 0 || tcb.state == task_state::completed) {
+                continue;
+            }
+            const duration_t measured_us = tcb.stats.max_execution_time * 1000U;
+            load_ppm += density_ppm(etl::max(tcb.wcet_us, measured_us), tcb.period_ms, tcb.deadline_ms);
+            ++periodic;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            const task_config& cfg = configs[i];
+            if (!cfg.enabled || cfg.create_native || cfg.period_ms == 0) {
+                continue;
+            }
+            load_ppm += density_ppm(cfg.max_execution_time.value(), cfg.period_ms, 0);
+            ++periodic;
+        }
+        const u32 load = (load_ppm > 0xFFFFFFFFULL) ? 0xFFFFFFFFU : static_cast<u32>(load_ppm);
+        if (admission_control_ && load > utilization_bound_ppm(policy_, periodic)) {
+            return result<u32, error_code>(error_code::not_schedulable);
+        }
+        return result<u32, error_code>(load);
+    }
+    
+    /* Schedulable utilization in parts per million for n periodic tasks */
+    static constexpr u32 utilization_bound_ppm(scheduling_policy policy, size_t n) noexcept {
+        // n(2^(1/n) - 1) for n = 1..10; ln 2 beyond
+        constexpr u32 liu_layland[] = {1000000U, 828427U, 779763U, 756828U, 743492U,
+                                       734772U, 728627U, 724062U, 720538U, 717735U};
+        if (policy == scheduling_policy::earliest_deadline_first || n == 0U) {
+            return 1000000U;
+        }
+        return (n <= 10U) ? liu_layland[n - 1U] : 693147U;
+    }
     
     /* Create all tasks from configuration table */
     result<void, error_code> create_all_tasks(const task_config* configs, size_t count) noexcept {
+        auto admitted = check_schedulability(configs, count);
+        if (admitted.is_error()) {
+            return result<void, error_code>(admitted.error());
+        }
         for (size_t i = 0; i < count; ++i) {
             auto res = configs[i].create_native ? 
                 create_native_task(configs[i]) : 
@@ -372,49 +651,68 @@ public:
                 get_broker().register_task(task_id, tcb->native_handle);
             }
         }
+        diagnostics::get_boot_timeline().mark(diagnostics::boot_phase::tasks_created);
         return ok();
     }
     
     void run() noexcept {
+        run_worker(0);
+    }
+    
+    /*
+     * One scheduling pass on worker context `worker`. With EMCORE_TASK_WORKERS > 1
+     * the cooperative task set is spread over that many contexts: run() is
+     * worker 0, start_workers() spawns the rest, and idle workers steal ready
+     * tasks from busy ones. Tasks must all be created before workers start.
+     */
+    void run_worker(size_t worker) noexcept {
         if (!initialized_) {
             return;
         }
         
         timestamp_t current_time = get_current_time();
         
-        // Find highest priority ready task
-        task_control_block* task_to_run = nullptr;
-        priority highest_priority = priority::idle;
-        
-        for (auto& task : tasks_) {
-            if (task.state != task_state::ready) {
-                continue;
-            }
-            
-            // Check if periodic task is due
-            if (task.period_ms > 0 && current_time < task.next_run_time) {
-                continue;
-            }
-            
-            // Select highest priority task
-            if (task.priority_level > highest_priority) {
-                highest_priority = task.priority_level;
-                task_to_run = &task;
-            }
+        drain_wakes(current_time);
+#if EMCORE_ENABLE_EVENTS
+        // Timed events (post_after / post_every) share this one timer source
+        if (worker == 0U) {
+            (void)events::global_event_bus().advance_timers(current_time);
         }
+#endif
+        
+#if EMCORE_ENABLE_COROUTINES && EMCORE_COROUTINES_AVAILABLE
+        const bool coroutines_ran = (worker == 0U) && (coros_.poll(current_time) != 0U);
+#else
+        const bool coroutines_ran = false;
+#endif
+        
+        task_control_block* task_to_run = pick(worker, current_time);
         
         // Execute the selected task
         if (task_to_run != nullptr && task_to_run->function != nullptr) {
             task_to_run->state = task_state::running;
             task_to_run->last_run_time = current_time;
             
+            if (task_to_run->period_ms > 0) {
+                record_release(*task_to_run);
+            }
             timestamp_t start_time = get_current_time();
+            /* Budgets set through rtos_scheduler are enforced for cooperative tasks too */
+            task::get_global_scheduler().start_execution_timing(task_to_run->id);
+            EMCORE_TRACE(task_switch, task_to_run->id.value(), worker);
+            EMCORE_PROFILE_ENTER_TASK(task_to_run->id);
             task_to_run->function(task_to_run->parameters);
+            EMCORE_PROFILE_LEAVE_TASK();
+            EMCORE_TRACE(task_end, task_to_run->id.value(), worker);
+            task::get_global_scheduler().end_execution_timing(task_to_run->id);
             timestamp_t end_time = get_current_time();
+#if EMCORE_ENABLE_SCRATCH_ARENA
+            release_scratch(*task_to_run, worker % config::task_workers);
+#endif
             
             task_to_run->execution_time = static_cast<duration_t>(end_time - start_time);
             task_to_run->run_count++;
-            total_context_switches_++;
+            total_context_switches_.fetch_add(1U, etl::memory_order_relaxed);
             
             /* Update statistics */
             task_to_run->stats.min_execution_time = etl::min(task_to_run->execution_time, task_to_run->stats.min_execution_time);
@@ -427,19 +725,55 @@ public:
                 task_to_run->stats.missed_deadlines++;
             }
             
-            // Update next run time for periodic tasks
+            // Update next run time for periodic tasks (unless the task suspended itself)
+            if (task_to_run->state != task_state::running) {
+                return;
+            }
             if (task_to_run->period_ms > 0) {
-                task_to_run->next_run_time = current_time + task_to_run->period_ms;
+                advance_release(*task_to_run, end_time);
                 task_to_run->state = task_state::ready;
+                schedule(*task_to_run, get_current_time(), worker);
             } else {
                 task_to_run->state = task_state::completed;
             }
-        } else {
-            // No task ready to run - yield to prevent watchdog timeout
-            os::delay_ms(1);
+        } else if (!coroutines_ran) {
+            idle(worker, current_time);
+        }
+    }
+    
+#if EMCORE_TASK_WORKERS > 1
+    /*
+     * Spawn workers 1..N-1 as native tasks; worker w is pinned to core w so
+     * rtos_scheduler affinity hints map straight onto cores. The caller keeps
+     * being worker 0 through run().
+     */
+    result<void, error_code> start_workers(u32 stack_bytes = 4096, u32 rtos_priority = 5) noexcept {
+        for (size_t w = 1; w < config::task_workers; ++w) {
+            if (worker_handles_[w] != nullptr) {
+                continue;
+            }
+            os::task_create_params params{
+                &taskmaster::worker_entry,
+                "emcore_worker",
+                stack_bytes,
+                reinterpret_cast<void*>(static_cast<uintptr_t>(w)),  // NOLINT(performance-no-int-to-ptr)
+                rtos_priority,
+                &worker_handles_[w],
+                false,
+                true,
+                static_cast<int>(w)
+            };
+            if (!os::create_native_task(params)) {
+                return result<void, error_code>(error_code::out_of_memory);
+            }
         }
+        return ok();
     }
     
+    /* Tasks worker w took from other workers */
+    [[nodiscard]] u32 get_worker_steals(size_t worker) const noexcept { return executor_.steals(worker); }
+#endif
+    
     [[nodiscard]] result<const task_control_block*, error_code> get_task_info(task_id_t task_id) const noexcept {
         for (const auto& task : tasks_) {
             if (task.id == task_id) {
@@ -475,6 +809,46 @@ public:
         return invalid_task_id;
     }
     
+#if EMCORE_ENABLE_SCRATCH_ARENA
+    /*
+     * Scratch arena of the calling context: the calling native task's slot, or
+     * the slot of the cooperative worker running the caller. Everything taken
+     * from it is released when the current task invocation returns. nullptr
+     * for native tasks created after the native slots ran out.
+     */
+    memory::scratch_arena* scratch() noexcept {
+        auto* current_handle = os::current_task();
+        if (current_handle != nullptr) {
+            for (const auto& task : tasks_) {
+                if (task.is_native && task.native_handle == current_handle) {
+                    return (task.scratch_slot < scratch_slots) ? &scratch_[task.scratch_slot] : nullptr;
+                }
+            }
+#if EMCORE_TASK_WORKERS > 1
+            for (size_t w = 1; w < config::task_workers; ++w) {
+                if (worker_handles_[w] == current_handle) {
+                    return &scratch_[w];
+                }
+            }
+#endif
+        }
+        return &scratch_[0];
+    }
+    
+    /* Largest scratch usage of one invocation of task_id, in bytes */
+    result<size_t, error_code> get_scratch_peak(task_id_t task_id) const noexcept {
+        if (task_id.value() >= tasks_.size() || tasks_[task_id.value()].id != task_id) {
+            return result<size_t, error_code>(error_code::not_found);
+        }
+        return result<size_t, error_code>(tasks_[task_id.value()].scratch_peak);
+    }
+    
+    /* Scratch slot statistics (high_water, failures) */
+    [[nodiscard]] const memory::scratch_arena& get_scratch_slot(size_t slot) const noexcept {
+        return scratch_[(slot < scratch_slots) ? slot : 0U];
+    }
+#endif
+    
     /* Task priority management */
     result<void, error_code> set_task_priority(task_id_t task_id, priority new_priority) noexcept {
         auto* task = find_task(task_id);
@@ -482,6 +856,14 @@ public:
             return result<void, error_code>(error_code::not_found);
         }
         task->priority_level = new_priority;
+#if EMCORE_TASK_WORKERS > 1
+        executor_.reprioritize(task_id.value(), static_cast<u8>(new_priority));
+#else
+        if (ready_.contains(task_id.value())) {
+            ready_.remove(task_id.value());
+            ready_.push(task_id.value(), static_cast<u8>(new_priority));
+        }
+#endif
         return ok();
     }
     
@@ -505,7 +887,7 @@ public:
         return ok();
     }
     
-    /* Task deadline management */
+    /* Task deadline management (relative; 0 = implicit, equal to the period) */
    
     result<void, error_code> set_task_deadline(task_id_t task_id, duration_t deadline_ms) noexcept {
         auto* task = find_task(task_id);
@@ -513,6 +895,12 @@ public:
             return result<void, error_code>(error_code::not_found);
         }
         task->deadline_ms = deadline_ms;
+#if EMCORE_TASK_WORKERS == 1
+        if (edf_.contains(task_id.value())) {
+            edf_.remove(task_id.value());
+            make_ready(task_id.value(), get_current_time());
+        }
+#endif
         return ok();
     }
     
@@ -538,7 +926,7 @@ public:
     }
     
     /* Get scheduler statistics */
-    [[nodiscard]] u32 get_total_context_switches() const noexcept { return total_context_switches_; }
+    [[nodiscard]] u32 get_total_context_switches() const noexcept { return total_context_switches_.load(etl::memory_order_relaxed); }
     [[nodiscard]] duration_t get_uptime() const noexcept { 
         return static_cast<duration_t>(get_current_time() - scheduler_start_time_); 
     }
@@ -608,6 +996,21 @@ public:
     }
     #endif
 
+    /* Slab (variable-length) wrappers */
+    #if EMCORE_ENABLE_SLAB_BROKER
+    static result<void, error_code> subscribe_slab(topic_id_t topic_id, task_id_t task_id) noexcept {
+        return taskmaster::broker_slab().subscribe(topic_id, task_id);
+    }
+
+    static result<void, error_code> publish_slab(u16 topic_id, const u8* data, u16 size, task_id_t from) noexcept {
+        return messaging::publish_slab(taskmaster::broker_slab(), taskmaster::slab_pool(), topic_id, data, size, from);
+    }
+
+    static result<slab_msg_t, error_code> receive_slab(task_id_t self, timeout_ms_t timeout) noexcept {
+        return taskmaster::broker_slab().receive(self, timeout);
+    }
+    #endif
+
     /* QoS helpers (non-owning, no dynamic allocation) */
     static messaging::qos_publisher<messaging::medium_message>
     make_qos_publisher_medium(task_id_t from_task_id, u16 ack_topic_id) noexcept {
@@ -702,16 +1105,31 @@ public:
     // Accessors to unified messaging package
     static messaging::Ibroker<medium_message>& broker_medium() noexcept { return messaging::global_medium_broker(); }
     #if EMCORE_ENABLE_SMALL_BROKER
-    static messaging::Ibroker<small_message>&  broker_small()  noexcept { return *(taskmaster::instance().small_broker_); }
+    static messaging::Ibroker<small_message>&  broker_small()  noexcept { return taskmaster::instance().small_broker_.get(); }
+    #endif
+    #if EMCORE_ENABLE_SLAB_BROKER
+    static messaging::Ibroker<slab_msg_t>&     broker_slab()   noexcept { return taskmaster::instance().slab_broker_.get(); }
+    static slab_pool_t&                        slab_pool()     noexcept { return taskmaster::instance().slab_pool_.get(); }
     #endif
     #if EMCORE_ENABLE_ZC
-    static messaging::Ibroker<zc_msg_t>&       broker_zero()   noexcept { return *(taskmaster::instance().zc_broker_); }
-    static zc_pool_t&                          zc_pool()       noexcept { return *(taskmaster::instance().zc_pool_ptr_); }
+    static messaging::Ibroker<zc_msg_t>&       broker_zero()   noexcept { return taskmaster::instance().zc_broker_.get(); }
+    static zc_pool_t&                          zc_pool()       noexcept { return taskmaster::instance().zc_pool_.get(); }
+    // Medium broker front-end that moves hot topics onto the zero-copy pool; its shared lane is the
+    // zero-copy broker, so fan-out users register and subscribe through it to be reachable on both lanes
+    static messaging::fanout_broker<medium_message, zc_pool_t>& broker_fanout() noexcept {
+        static messaging::fanout_broker<medium_message, zc_pool_t> fanout(
+            get_broker(), taskmaster::instance().zc_broker_.get(), taskmaster::instance().zc_pool_.get());
+        return fanout;
+    }
     #endif
     #if EMCORE_ENABLE_EVENT_LOGS
-    static med_log_t&                          event_log_medium() noexcept { return *(taskmaster::instance().med_log_); }
-    static small_log_t&                        event_log_small()  noexcept { return *(taskmaster::instance().small_log_); }
-    static zc_log_t&                           event_log_zero()   noexcept { return *(taskmaster::instance().zc_log_); }
+    static med_log_t&                          event_log_medium() noexcept { return taskmaster::instance().med_log_.get(); }
+    static small_log_t&                        event_log_small()  noexcept { return taskmaster::instance().small_log_.get(); }
+    static zc_log_t&                           event_log_zero()   noexcept { return taskmaster::instance().zc_log_.get(); }
+    #endif
+
+    #if EMCORE_ENABLE_SLAB_BROKER
+    using slab_message_type = slab_msg_t;
     #endif
 
     // Public aliases for zero-copy types
@@ -721,7 +1139,23 @@ public:
     #endif
 
 private:
-    /* Broker owned by taskmaster (constructed in ctor) */
+    /* Build every broker and pool now; event logs are only written from tasks and stay lazy */
+    void construct_brokers() noexcept {
+        (void)messaging::global_medium_broker();
+        #if EMCORE_ENABLE_SMALL_BROKER
+        (void)small_broker_.get();
+        #endif
+        #if EMCORE_ENABLE_SLAB_BROKER
+        (void)slab_pool_.get();
+        (void)slab_broker_.get();
+        #endif
+        #if EMCORE_ENABLE_ZC
+        (void)zc_pool_.get();
+        (void)zc_broker_.get();
+        #endif
+    }
+
+    /* Medium broker, constructed by its first user (messaging::global_medium_broker) */
     static messaging::message_broker<medium_message, config::max_tasks>& get_broker() noexcept {
         return messaging::global_medium_broker();
     }
@@ -732,6 +1166,338 @@ private:
         return os::time_ms();
     }
     
+    /* Queue a ready cooperative task: due now -> ready queue, otherwise timer heap */
+    /* worker: context that last ran the task (locality hint when it has no affinity) */
+    void schedule(task_control_block& tcb, timestamp_t now, size_t worker = no_worker_hint) noexcept {
+        if (tcb.is_native || tcb.state != task_state::ready) {
+            return;
+        }
+        const u16 idx = tcb.id.value();
+        tcb.ready_us = os::time_us();
+#if EMCORE_TASK_WORKERS > 1
+        // Affinity from rtos_scheduler::set_cpu_affinity pins the task to worker core % N
+        size_t home = (worker == no_worker_hint) ? static_cast<size_t>(idx) : worker;
+        bool pinned = false;
+        const auto* ctx = task::get_global_scheduler().get_task_context(tcb.id);
+        if (ctx != nullptr && ctx->pin_to_core) {
+            home = (ctx->requested_core != task::no_requested_core) ? ctx->requested_core : ctx->cpu_core_id;
+            pinned = true;
+        }
+        const timestamp_t due = (tcb.period_ms > 0) ? tcb.next_run_time : now;
+        executor_.schedule(idx, static_cast<u8>(tcb.priority_level), due, now, home, pinned);
+#else
+        (void)worker;
+        if (tcb.period_ms > 0 && now < tcb.next_run_time) {
+            timers_.push(idx, tcb.next_run_time);
+        } else {
+            make_ready(idx, now);
+        }
+#endif
+    }
+    
+    /*
+     * Phase-locked release: the next release is one period after the previous
+     * one, not after this run, so execution time and idle granularity do not
+     * accumulate into drift. A run ending past that release is an overrun.
+     */
+    static void advance_release(task_control_block& tcb, timestamp_t now) noexcept {
+        tcb.next_run_time += tcb.period_ms;
+        if (tcb.next_run_time >= now) {
+            return;
+        }
+        ++tcb.stats.overruns;
+        if (tcb.on_overrun == overrun_policy::skip) {
+            const timestamp_t missed = (now - tcb.next_run_time + tcb.period_ms - 1U) / tcb.period_ms;
+            tcb.next_run_time += missed * tcb.period_ms;
+            tcb.stats.skipped_releases += static_cast<u32>(missed);
+        }
+    }
+    
+    static void record_release(task_control_block& tcb) noexcept {
+        diagnostics::get_boot_timeline().mark(diagnostics::boot_phase::first_release);
+        const timestamp_t start_us = os::time_us();
+        const timestamp_t release_us = tcb.next_run_time * 1000U;
+        const timestamp_t ready_us = etl::max(tcb.ready_us, release_us);
+        tcb.stats.release_jitter.record(clamp_us(start_us, release_us));
+        tcb.stats.start_latency.record(clamp_us(start_us, ready_us));
+    }
+    
+    static constexpr u32 clamp_us(timestamp_t later, timestamp_t earlier) noexcept {
+        if (later <= earlier) {
+            return 0U;
+        }
+        const timestamp_t d = later - earlier;
+        return (d > 0xFFFFFFFFULL) ? 0xFFFFFFFFU : static_cast<u32>(d);
+    }
+    
+    static constexpr u64 density_ppm(duration_t wcet_us, duration_t period_ms, duration_t deadline_ms) noexcept {
+        const duration_t window_ms = (deadline_ms != 0U && deadline_ms < period_ms) ? deadline_ms : period_ms;
+        return (window_ms == 0U) ? 0U : (static_cast<u64>(wcet_us) * 1000U) / window_ms;
+    }
+    
+#if EMCORE_TASK_WORKERS == 1
+    /*
+     * Released at next_run_time (now for one-shot tasks); due by release plus the
+     * relative deadline, or the period when none is set. Tasks with neither run
+     * in the background after every deadline-bound task.
+     */
+    [[nodiscard]] timestamp_t absolute_deadline(const task_control_block& tcb, timestamp_t now) const noexcept {
+        const duration_t relative = (tcb.deadline_ms != 0U) ? tcb.deadline_ms : tcb.period_ms;
+        if (relative == 0U) {
+            return static_cast<timestamp_t>(-1);
+        }
+        const timestamp_t release = (tcb.period_ms > 0U) ? tcb.next_run_time : now;
+        return release + relative;
+    }
+    
+    /* Put idx on the ready structure of the active policy */
+    void make_ready(u16 idx, timestamp_t now) noexcept {
+        const task_control_block& tcb = tasks_[idx];
+        if (policy_ == scheduling_policy::earliest_deadline_first) {
+            edf_.push(idx, absolute_deadline(tcb, now));
+        } else {
+            ready_.push(idx, static_cast<u8>(tcb.priority_level));
+        }
+    }
+#endif
+    
+    /* Next ready cooperative task for this worker; nullptr when none */
+    task_control_block* pick(size_t worker, timestamp_t now) noexcept {
+#if EMCORE_TASK_WORKERS > 1
+        for (u16 idx = executor_.next(worker, now); idx != executor_.npos; idx = executor_.next(worker, now)) {
+            if (tasks_[idx].state == task_state::ready) {
+                return &tasks_[idx];
+            }
+        }
+#else
+        (void)worker;
+        // Move expired periodic tasks onto their ready queue
+        for (u16 idx = timers_.pop_due(now); idx != timers_.npos; idx = timers_.pop_due(now)) {
+            if (tasks_[idx].state == task_state::ready) {
+                tasks_[idx].ready_us = os::time_us();
+                make_ready(idx, now);
+            }
+        }
+        if (policy_ == scheduling_policy::earliest_deadline_first) {
+            // Earliest absolute deadline: heap root
+            constexpr auto any_deadline = static_cast<timestamp_t>(-1);
+            for (u16 idx = edf_.pop_due(any_deadline); idx != edf_.npos; idx = edf_.pop_due(any_deadline)) {
+                if (tasks_[idx].state == task_state::ready) {
+                    return &tasks_[idx];
+                }
+            }
+            return nullptr;
+        }
+        // Highest priority ready task: find-first-set on the level bitmap
+        for (u16 idx = ready_.pop_highest(); idx != ready_.npos; idx = ready_.pop_highest()) {
+            if (tasks_[idx].state == task_state::ready) {
+                return &tasks_[idx];
+            }
+        }
+#endif
+        return nullptr;
+    }
+    
+    /* Pull opted-in sleepers whose mailbox was written since the last pass onto the ready queue */
+    void drain_wakes(timestamp_t now) noexcept {
+        for (size_t word = 0; word < wake_words; ++word) {
+            u32 bits = pending_wake_[word].exchange(0U, etl::memory_order_acquire);
+            while (bits != 0U) {
+                const u16 idx = static_cast<u16>((word * 32U) + utils::lowest_set_bit(bits));
+                bits &= bits - 1U;
+                if (idx >= tasks_.size()) {
+                    continue;
+                }
+                task_control_block& tcb = tasks_[idx];
+                if (!tcb.wake_on_message || tcb.state != task_state::ready) {
+                    continue;
+                }
+#if EMCORE_TASK_WORKERS > 1
+                (void)now;
+                (void)executor_.expedite(idx);
+#else
+                if (timers_.contains(idx)) {
+                    timers_.remove(idx);
+                    tcb.next_run_time = now;
+                    make_ready(idx, now);
+                }
+#endif
+            }
+        }
+    }
+    
+    /*
+     * Nothing ready. Tickless: block until the earliest next_run_time (capped by
+     * task_tickless_max_sleep_ms) or until a wake hook gives idle_sem_. Otherwise,
+     * and always with several workers, poll with a 1 ms delay. Either way the
+     * time slept counts as idle.
+     */
+    void idle(size_t worker, timestamp_t now) noexcept {
+#if EMCORE_DEFERRED_LOG && EMCORE_DEFERRED_LOG_IDLE_FLUSH > 0
+        // Idle is the lowest priority there is: format queued log records before sleeping
+        if (worker == 0U && platform::log_flush(EMCORE_DEFERRED_LOG_IDLE_FLUSH) != 0U) {
+            return;
+        }
+#endif
+        duration_t sleep_ms = 1;
+        const timestamp_t start_us = os::time_us();
+#if EMCORE_TASK_WORKERS > 1
+        // Work may appear on any worker, so extra workers keep polling
+        (void)now;
+        os::delay_ms(sleep_ms);
+#else
+        if (config::task_tickless_idle) {
+            sleep_ms = config::task_tickless_max_sleep_ms;
+            timestamp_t due = timers_.empty() ? static_cast<timestamp_t>(-1) : timers_.next_due();
+#if EMCORE_ENABLE_COROUTINES && EMCORE_COROUTINES_AVAILABLE
+            due = etl::min(due, coros_.next_deadline());
+#endif
+#if EMCORE_ENABLE_EVENTS
+            due = etl::min(due, events::global_event_bus().next_timer_due());
+#endif
+            if (due != static_cast<timestamp_t>(-1)) {
+                if (due <= now) {
+                    return;
+                }
+                if (due - now < sleep_ms) {
+                    sleep_ms = static_cast<duration_t>(due - now);
+                }
+            }
+        }
+        if (config::task_tickless_idle && idle_sem_ != nullptr) {
+            (void)os::semaphore_take(idle_sem_, static_cast<duration_t>(sleep_ms * 1000U));
+        } else {
+            os::delay_ms(sleep_ms);
+        }
+#endif
+        const timestamp_t end_us = os::time_us();
+        idle_us_[worker % config::task_workers] += end_us - start_us;
+        // Average over workers; only worker 0 publishes it
+        if (worker == 0U) {
+            timestamp_t sum = 0;
+            for (const timestamp_t us : idle_us_) {
+                sum += us;
+            }
+            total_idle_time_ = sum / (config::task_workers * 1000U);
+            last_idle_time_ = end_us / 1000U;
+        }
+    }
+    
+    static void cooperative_wake(task_id_t task_id) noexcept {
+        instance().notify_wake(task_id);
+    }
+    
+    /* rtos_scheduler affinity hook: re-pin a live native task */
+    static bool apply_affinity(task_id_t task_id, u8 core_id) noexcept {
+        auto* tcb = instance().find_task(task_id);
+        return (tcb != nullptr) && tcb->is_native && (tcb->native_handle != nullptr) &&
+               os::set_task_affinity(tcb->native_handle, static_cast<int>(core_id));
+    }
+    
+    /*
+     * rtos_scheduler budget hook. Demotion lowers a cooperative task's priority
+     * level by one (native priorities are left to the kernel); suspension works
+     * for both, a native task suspending itself from its own trampoline.
+     */
+    static bool apply_budget(task_id_t task_id, task::budget_action action) noexcept {
+        auto& task_mgr = instance();
+        auto* tcb = task_mgr.find_task(task_id);
+        if (tcb == nullptr) {
+            return false;
+        }
+        switch (action) {
+            case task::budget_action::demote:
+                if (tcb->is_native || tcb->priority_level == priority::idle) {
+                    return false;
+                }
+                return task_mgr.set_task_priority(task_id,
+                    static_cast<priority>(static_cast<u8>(tcb->priority_level) - 1U)).is_ok();
+            case task::budget_action::suspend:
+                if (tcb->is_native) {
+                    tcb->state = task_state::suspended;
+                    return (tcb->native_handle != nullptr) && os::suspend_native_task(tcb->native_handle);
+                }
+                return task_mgr.suspend_task(task_id).is_ok();
+            case task::budget_action::report:
+                break;
+        }
+        return false;
+    }
+    
+    struct native_placement {
+        int core{-1};            /* -1 = let the kernel float the task */
+        bool user_pinned{false};
+    };
+    
+    /*
+     * Core for a new native task: an affinity already given to rtos_scheduler
+     * for this id, then task_config::cpu_affinity, then (auto placement) the
+     * core with the least declared native load, WCET / period.
+     */
+    [[nodiscard]] native_placement place_native(const task_control_block& tcb, const task_config& cfg) const noexcept {
+        const auto& sched = task::get_global_scheduler();
+        const auto* ctx = sched.get_task_context(tcb.id);
+        if (ctx != nullptr && ctx->requested_core != task::no_requested_core) {
+            return native_placement{static_cast<int>(ctx->requested_core), ctx->pin_to_core};
+        }
+        if (ctx != nullptr && ctx->pin_to_core) {
+            return native_placement{static_cast<int>(ctx->cpu_core_id), true};
+        }
+        if (cfg.cpu_affinity.value() >= 0) {
+            return native_placement{static_cast<int>(cfg.cpu_affinity.value()), true};
+        }
+        const size_t cores = etl::min(static_cast<size_t>(os::cpu_core_count()), config::max_cpu_cores);
+        if (!config::task_auto_placement || cores < 2U) {
+            return native_placement{};
+        }
+        etl::array<u64, config::max_cpu_cores> load{};
+        for (const auto& other : tasks_) {
+            const auto* octx = other.is_native ? sched.get_task_context(other.id) : nullptr;
+            if (octx != nullptr && octx->cpu_core_id < cores) {
+                // Tasks with no declared load still count, so they spread round-robin
+                const u64 declared = density_ppm(other.wcet_us, other.period_ms, 0);
+                load[octx->cpu_core_id] += (declared != 0U) ? declared : 1U;
+            }
+        }
+        size_t best = 0;
+        for (size_t c = 1; c < cores; ++c) {
+            if (load[c] < load[best]) {
+                best = c;
+            }
+        }
+        return native_placement{static_cast<int>(best), false};
+    }
+    
+#if EMCORE_TASK_WORKERS > 1
+    static void worker_entry(void* param) noexcept {
+        const auto worker = static_cast<size_t>(reinterpret_cast<uintptr_t>(param));
+        auto& task_mgr = taskmaster::instance();
+        task_mgr.wait_until_ready();
+        for (;;) {
+            task_mgr.run_worker(worker);
+        }
+    }
+#endif
+    
+#if EMCORE_ENABLE_SCRATCH_ARENA
+    /* End of an invocation: drop its scratch allocations and keep the task's peak */
+    void release_scratch(task_control_block& tcb, size_t slot) noexcept {
+        if (slot < scratch_slots) {
+            tcb.scratch_peak = etl::max(tcb.scratch_peak, scratch_[slot].reset());
+        }
+    }
+#endif
+    
+    void unschedule(const task_control_block& tcb) noexcept {
+#if EMCORE_TASK_WORKERS > 1
+        executor_.remove(tcb.id.value());
+#else
+        ready_.remove(tcb.id.value());
+        timers_.remove(tcb.id.value());
+        edf_.remove(tcb.id.value());
+#endif
+    }
+    
     task_control_block* find_task(task_id_t task_id) noexcept {
         // O(1) lookup using task_id as direct index
         if (task_id.value() >= tasks_.size()) {
@@ -763,20 +1529,41 @@ private:
         void* user_param = (tcb->parameters != nullptr) ? tcb->parameters : static_cast<void*>(tcb);
 
         if (tcb->period_ms > 0) {
+            /* Phase-locked: sleep until the next release rather than a full period */
+            tcb->next_run_time = get_current_time();
             for (;;) {
+                record_release(*tcb);
                 emCore::task::get_global_scheduler().start_execution_timing(tid);
+                EMCORE_TRACE(task_switch, tid.value(), diagnostics::trace_native_worker);
+                EMCORE_PROFILE_ENTER_TASK(tid);
                 user_fn(user_param);
+                EMCORE_PROFILE_LEAVE_TASK();
+                EMCORE_TRACE(task_end, tid.value(), diagnostics::trace_native_worker);
                 emCore::task::get_global_scheduler().end_execution_timing(tid);
+#if EMCORE_ENABLE_SCRATCH_ARENA
+                task_mgr.release_scratch(*tcb, tcb->scratch_slot);
+#endif
                 emCore::get_global_watchdog().feed(tid);
                 emCore::task::get_global_scheduler().update_stack_usage(tid);
                 emCore::task::get_global_scheduler().adaptive_yield(tid);
-                emCore::os::delay_ms(tcb->period_ms);
+                const timestamp_t now = get_current_time();
+                advance_release(*tcb, now);
+                if (tcb->next_run_time > now) {
+                    emCore::os::delay_ms(static_cast<duration_t>(tcb->next_run_time - now));
+                }
             }
         } else {
             /* Non-periodic: call once; user may implement its own loop */
             emCore::task::get_global_scheduler().start_execution_timing(tid);
+            EMCORE_TRACE(task_switch, tid.value(), diagnostics::trace_native_worker);
+            EMCORE_PROFILE_ENTER_TASK(tid);
             user_fn(user_param);
+            EMCORE_PROFILE_LEAVE_TASK();
+            EMCORE_TRACE(task_end, tid.value(), diagnostics::trace_native_worker);
             emCore::task::get_global_scheduler().end_execution_timing(tid);
+#if EMCORE_ENABLE_SCRATCH_ARENA
+            task_mgr.release_scratch(*tcb, tcb->scratch_slot);
+#endif
             /* One-time feed to avoid early false positive */
             emCore::get_global_watchdog().feed(tid);
         }
@@ -6,8 +6,11 @@
 #include "../os/time.hpp"
 #include "../error/result.hpp"
 #include "../error/error_handler.hpp"
+#include "../os/sync.hpp"
+#include "../utils/helpers.hpp"
 
-#include <etl/vector.h>
+#include <etl/array.h>
+#include <etl/atomic.h>
 
 namespace emCore {
 
@@ -35,13 +38,17 @@ using recovery_fn = void(*)(task_id_t task_id) noexcept;
  * @brief Watchdog entry for a single task
  */
 struct watchdog_entry {
+    static constexpr u8 no_slot = 0xFF;
+
     task_id_t task_id{invalid_task_id};
-    volatile timestamp_t last_feed_time{0};  // Volatile to prevent compiler optimization races
+    etl::atomic<u32> last_feed_ms{0};  // Low 32 bits of os::time_ms(); written by feed() from any context
     duration_t timeout_ms{5000};
     watchdog_action action{watchdog_action::log_warning};
     recovery_fn recovery_callback{nullptr};
     u32 timeout_count{0};
     bool enabled{false};
+    u8 next{no_slot};     // Next entry in the same wheel slot
+    bool linked{false};   // Currently on the wheel
     
     watchdog_entry() noexcept = default;
 };
@@ -49,24 +56,101 @@ struct watchdog_entry {
 /**
  * @brief Task watchdog monitor
  * Monitors task health and triggers recovery actions
+ *
+ * feed() is one relaxed atomic store into a slot found by task id, so it is
+ * safe from ISRs and other cores. Entries sit on a timing wheel at the tick of
+ * the deadline they had when last examined; check_all() only visits the slots
+ * that have come due since the previous check. A visited entry that was fed
+ * meanwhile is simply re-linked at its new deadline, so each entry costs about
+ * one visit per timeout (plus one per wheel revolution for timeouts longer
+ * than the wheel span) however often checks run. Expiry is detected up to one
+ * tick (config::watchdog_tick_ms) late.
  */
 class task_watchdog {
 private:
-    etl::vector<watchdog_entry, config::max_tasks> entries_;
+    static constexpr size_t max_entries = (config::max_tasks < 0xFF) ? config::max_tasks : 0xFE;
+    static constexpr size_t wheel_slots = config::watchdog_wheel_slots;
+    static constexpr u8 tick_shift = utils::highest_set_bit(static_cast<u32>(config::watchdog_tick_ms));
+    static constexpr u8 no_slot = watchdog_entry::no_slot;
+
+    etl::array<watchdog_entry, max_entries> entries_{};
+    size_t count_{0};
+    // Task ids are dense taskmaster indices: id -> entry without a scan
+    etl::array<u8, max_entries> slot_of_{};
+    etl::array<u8, wheel_slots> wheel_{};
+    u64 processed_tick_{0};  // Last wheel tick check_all() has handled
+    u32 last_examined_{0};
+    os::critical_section cs_;  // Wheel links; feed() never takes it
     bool system_watchdog_enabled_{false};
     duration_t system_timeout_ms_{10000};
-    timestamp_t last_system_feed_{0};
+    etl::atomic<u32> last_system_feed_{0};
+    
+    static u32 now_ms32() noexcept { return static_cast<u32>(os::time_ms()); }
+    
+    // Milliseconds since the last feed, wrap-safe
+    static u32 since_feed(const watchdog_entry& entry, u32 now32) noexcept {
+        return now32 - entry.last_feed_ms.load(etl::memory_order_relaxed);
+    }
     
     /**
      * @brief Find watchdog entry for task
      */
     watchdog_entry* find_entry(task_id_t task_id) noexcept {
-        for (auto& entry : entries_) {
-            if (entry.task_id == task_id && entry.enabled) {
-                return &entry;
+        const u8 slot = slot_index(task_id);
+        return (slot != no_slot && entries_[slot].enabled) ? &entries_[slot] : nullptr;
+    }
+    
+    [[nodiscard]] const watchdog_entry* find_entry(task_id_t task_id) const noexcept {
+        const u8 slot = slot_index(task_id);
+        return (slot != no_slot && entries_[slot].enabled) ? &entries_[slot] : nullptr;
+    }
+    
+    [[nodiscard]] u8 slot_index(task_id_t task_id) const noexcept {
+        const u16 id = task_id.value();
+        if (id < max_entries) {
+            return slot_of_[id];
+        }
+        for (size_t i = 0; i < count_; ++i) {
+            if (entries_[i].task_id == task_id) {
+                return static_cast<u8>(i);
             }
         }
-        return nullptr;
+        return no_slot;
+    }
+    
+    // Put entry `slot` on the wheel at the tick holding deadline_ms (never a tick already handled); cs_ held
+    void link(u8 slot, u64 deadline_ms) noexcept {
+        watchdog_entry& entry = entries_[slot];
+        if (entry.linked) {
+            unlink(slot);
+        }
+        u64 tick = deadline_ms >> tick_shift;
+        if (tick <= processed_tick_) {
+            tick = processed_tick_ + 1U;
+        }
+        const size_t at = static_cast<size_t>(tick & (wheel_slots - 1U));
+        entry.next = wheel_[at];
+        entry.linked = true;
+        wheel_[at] = slot;
+    }
+    
+    void unlink(u8 slot) noexcept {
+        for (u8& at : wheel_) {
+            for (u8* cur = &at; *cur != no_slot; cur = &entries_[*cur].next) {
+                if (*cur == slot) {
+                    *cur = entries_[slot].next;
+                    entries_[slot].next = no_slot;
+                    entries_[slot].linked = false;
+                    return;
+                }
+            }
+        }
+    }
+    
+    // Absolute deadline (ms on the os::time_ms() scale) of an entry as of now
+    static u64 deadline_of(const watchdog_entry& entry, u64 now, u32 now32) noexcept {
+        const u32 elapsed = since_feed(entry, now32);
+        return (elapsed >= entry.timeout_ms) ? now : now + (entry.timeout_ms - elapsed);
     }
     
     /**
@@ -103,16 +187,21 @@ private:
                 break;
                 
             case watchdog_action::system_reset:
-                platform::log("WATCHDOG: SYSTEM RESET TRIGGERED!");
+                // Drain deferred records first: nothing queued survives the reset
+                (void)platform::log_flush();
+                platform::log_now("WATCHDOG: SYSTEM RESET TRIGGERED!");
                 // Trigger system reset via platform abstraction
-                os::delay_ms(100); // Allow log to flush
+                os::delay_ms(100); // Allow the log transport to drain
                 platform::system_reset(); // Clean platform abstraction
                 break;
         }
     }
     
 public:
-    task_watchdog() noexcept = default;
+    task_watchdog() noexcept {
+        slot_of_.fill(no_slot);
+        wheel_.fill(no_slot);
+    }
     task_watchdog(const task_watchdog&) = delete;
     task_watchdog& operator=(const task_watchdog&) = delete;
     task_watchdog(task_watchdog&&) = delete;
@@ -129,30 +218,39 @@ public:
         watchdog_timeout_ms timeout,
         watchdog_action action = watchdog_action::log_warning
     ) noexcept {
-        if (entries_.full()) {
+        if (count_ >= max_entries) {
             return result<void, error_code>(error_code::out_of_memory);
         }
+        if (slot_index(task_id) != no_slot) {
+            return result<void, error_code>(error_code::already_exists);
+        }
         
-        watchdog_entry entry;
+        const u8 slot = static_cast<u8>(count_);
+        watchdog_entry& entry = entries_[slot];
         entry.task_id = task_id;
         entry.timeout_ms = timeout.value();
         entry.action = action;
-        entry.last_feed_time = os::time_us();
+        entry.last_feed_ms.store(now_ms32(), etl::memory_order_relaxed);
         entry.enabled = true;
+        if (task_id.value() < max_entries) {
+            slot_of_[task_id.value()] = slot;
+        }
+        ++count_;
         
-        entries_.push_back(entry);
+        cs_.enter();
+        link(slot, os::time_ms() + entry.timeout_ms);
+        cs_.exit();
         return ok();
     }
     
     /**
      * @brief Feed the watchdog for a task (task is alive)
+     * O(1) and lock-free; safe from ISRs and other cores
      */
     void feed(task_id_t task_id) noexcept {
-        auto* entry = find_entry(task_id);
-        if (entry != nullptr) {
-            // Use volatile write to prevent compiler reordering
-            timestamp_t now = os::time_us();
-            entry->last_feed_time = now;
+        const u8 slot = slot_index(task_id);
+        if (slot != no_slot) {
+            entries_[slot].last_feed_ms.store(now_ms32(), etl::memory_order_relaxed);
         }
     }
     
@@ -167,7 +265,12 @@ public:
             return result<void, error_code>(error_code::not_found);
         }
         
+        cs_.enter();
         entry->timeout_ms = timeout.value();
+        // A shorter timeout must not wait for the slot of the old deadline
+        const u64 now = os::time_ms();
+        link(slot_index(task_id), deadline_of(*entry, now, static_cast<u32>(now)));
+        cs_.exit();
         return ok();
     }
     
@@ -201,47 +304,65 @@ public:
      * @brief Check if task is alive (within timeout)
      */
     bool is_alive(task_id_t task_id) const noexcept {
-        for (const auto& entry : entries_) {
-            if (entry.task_id == task_id && entry.enabled) {
-                timestamp_t now = platform::get_system_time_us();
-                timestamp_t elapsed_us = now - entry.last_feed_time;
-                return (elapsed_us / 1000) < entry.timeout_ms;
-            }
-        }
-        return false;
+        const auto* entry = find_entry(task_id);
+        return (entry != nullptr) && (since_feed(*entry, now_ms32()) < entry->timeout_ms);
     }
     
     /**
      * @brief Check all watchdogs and trigger timeouts
-     * Should be called periodically from a dedicated watchdog task
+     * Should be called periodically from a dedicated watchdog task; visits
+     * only the wheel slots that came due since the previous call
      */
     void check_all() noexcept {
-        timestamp_t now = platform::get_system_time_us();
+        const u64 now = os::time_ms();
+        const u32 now32 = static_cast<u32>(now);
+        const u64 now_tick = now >> tick_shift;
+        u32 examined = 0;
+        etl::array<u8, max_entries> expired{};
+        size_t expired_count = 0;
         
-        for (auto& entry : entries_) {
-            if (!entry.enabled) {
-                continue;
-            }
-            
-            // Volatile read to get consistent timestamp
-            timestamp_t last_feed = entry.last_feed_time;
-            timestamp_t elapsed_us = now - last_feed;
-            duration_t elapsed_ms = static_cast<duration_t>(elapsed_us / 1000);
-            
-            if (elapsed_ms >= entry.timeout_ms) {
-                trigger_timeout(entry);
-                // Reset timer after triggering
-                entry.last_feed_time = now;
+        cs_.enter();
+        // After a long gap one revolution covers every slot
+        if (now_tick > processed_tick_ + wheel_slots) {
+            processed_tick_ = now_tick - wheel_slots;
+        }
+        while (processed_tick_ < now_tick) {
+            ++processed_tick_;
+            const size_t at = static_cast<size_t>(processed_tick_ & (wheel_slots - 1U));
+            u8 slot = wheel_[at];
+            wheel_[at] = no_slot;
+            while (slot != no_slot) {
+                watchdog_entry& entry = entries_[slot];
+                const u8 next = entry.next;
+                entry.next = no_slot;
+                entry.linked = false;
+                ++examined;
+                if (entry.enabled) {
+                    if (since_feed(entry, now32) >= entry.timeout_ms && expired_count < expired.size()) {
+                        expired[expired_count++] = slot;
+                        // Reset timer after triggering
+                        entry.last_feed_ms.store(now32, etl::memory_order_relaxed);
+                    }
+                    link(slot, deadline_of(entry, now, now32));
+                }
+                slot = next;
             }
         }
+        cs_.exit();
+        last_examined_ = examined;
+        
+        // Recovery actions run outside the wheel lock
+        for (size_t i = 0; i < expired_count; ++i) {
+            trigger_timeout(entries_[expired[i]]);
+        }
         
         // Check system watchdog
         if (system_watchdog_enabled_) {
-            timestamp_t system_elapsed_us = now - last_system_feed_;
-            duration_t system_elapsed_ms = static_cast<duration_t>(system_elapsed_us / 1000);
+            const u32 system_elapsed_ms = now32 - last_system_feed_.load(etl::memory_order_relaxed);
             
             if (system_elapsed_ms >= system_timeout_ms_) {
-                platform::log("SYSTEM WATCHDOG TIMEOUT!");
+                (void)platform::log_flush();
+                platform::log_now("SYSTEM WATCHDOG TIMEOUT!");
                 os::delay_ms(100);
                 // Trigger system reset via platform abstraction
                 platform::system_reset();
@@ -249,15 +370,25 @@ public:
         }
     }
     
+    /**
+     * @brief Entries examined by the last check_all()
+     */
+    [[nodiscard]] u32 get_last_examined() const noexcept { return last_examined_; }
+    
 
     void enable_task(task_id_t task_id, bool enable) noexcept {
-        auto* entry = find_entry(task_id);
-        if (entry != nullptr) {
-            entry->enabled = enable;
-            if (enable) {
-                entry->last_feed_time = os::time_us();
-            }
+        const u8 slot = slot_index(task_id);
+        if (slot == no_slot) {
+            return;
+        }
+        watchdog_entry& entry = entries_[slot];
+        cs_.enter();
+        entry.enabled = enable;
+        if (enable) {
+            entry.last_feed_ms.store(now_ms32(), etl::memory_order_relaxed);
+            link(slot, os::time_ms() + entry.timeout_ms);
         }
+        cs_.exit();
     }
     
     /**
@@ -265,7 +396,7 @@ public:
     void enable_system_watchdog(duration_t timeout_ms) noexcept {
         system_watchdog_enabled_ = true;
         system_timeout_ms_ = timeout_ms;
-        last_system_feed_ = os::time_us();
+        last_system_feed_.store(now_ms32(), etl::memory_order_relaxed);
         
         platform::logf("System watchdog enabled: %u ms timeout", timeout_ms);
     }
@@ -274,27 +405,23 @@ public:
      * @brief Feed system watchdog
      */
     void feed_system() noexcept {
-        last_system_feed_ = os::time_us();
+        last_system_feed_.store(now_ms32(), etl::memory_order_relaxed);
     }
     
     /**
      * @brief Get timeout count for task
      */
     u32 get_timeout_count(task_id_t task_id) const noexcept {
-        for (const auto& entry : entries_) {
-            if (entry.task_id == task_id && entry.enabled) {
-                return entry.timeout_count;
-            }
-        }
-        return 0;
+        const auto* entry = find_entry(task_id);
+        return (entry != nullptr) ? entry->timeout_count : 0U;
     }
     
     /**
      * @brief Reset all statistics
      */
     void reset_statistics() noexcept {
-        for (auto& entry : entries_) {
-            entry.timeout_count = 0;
+        for (size_t i = 0; i < count_; ++i) {
+            entries_[i].timeout_count = 0;
         }
     }
 };
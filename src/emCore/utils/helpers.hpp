@@ -78,6 +78,32 @@ namespace emCore {
             return value ^ (T(1) << bit);
         }
         
+        /**
+         * @brief Index of the lowest set bit (find-first-set); value must be non-zero
+         */
+        constexpr u8 lowest_set_bit(u32 value) noexcept {
+        #if defined(__GNUC__) || defined(__clang__)
+            return static_cast<u8>(__builtin_ctz(value));
+        #else
+            u8 index = 0;
+            while ((value & 1U) == 0U) { value >>= 1U; ++index; }
+            return index;
+        #endif
+        }
+        
+        /**
+         * @brief Index of the highest set bit; value must be non-zero
+         */
+        constexpr u8 highest_set_bit(u32 value) noexcept {
+        #if defined(__GNUC__) || defined(__clang__)
+            return static_cast<u8>(31 - __builtin_clz(value));
+        #else
+            u8 index = 0;
+            while ((value >>= 1U) != 0U) { ++index; }
+            return index;
+        #endif
+        }
+        
         /**
          * @brief CRC-8 calculation for data integrity
          */